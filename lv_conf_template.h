@@ -40,6 +40,13 @@
  * Requires `LV_COLOR_DEPTH = 32` colors and the screen's style should be modified: `style.body.opa = ...`*/
 #define LV_COLOR_SCREEN_TRANSP    0
 
+/* 1: Enable converting the rendered pixels to an other pixel format before `flush_cb`.
+ * Set `out_fmt` and `out_buf` in the display driver (`lv_disp_drv_t`) to use it.
+ * While `flush_cb` sends the converted pixels the next part of the screen can be rendered.
+ * With `LV_COLOR_DEPTH 32` and `out_dither = 1` the gradients are dithered for 16 or 8 bit displays.
+ * Gray scale and monochrome displays can get packed 8, 4, 2 or 1 bit pixels (e.g. `LV_COLOR_FMT_I1`).*/
+#define LV_USE_DISP_OUT_CONV      0
+
 /*Images pixels with this color will not be drawn (with chroma keying)*/
 #define LV_COLOR_TRANSP    LV_COLOR_LIME         /*LV_COLOR_LIME: pure green*/
 
@@ -138,6 +145,26 @@ typedef void * lv_anim_user_data_t;
 /* 1: Enable shadow drawing*/
 #define LV_USE_SHADOW           1
 
+/* Number of gradients (color pairs and lengths) whose colors are cached.
+ * Gradients in the cache are drawn without mixing the colors again. Must be >= 1 */
+#define LV_GRAD_CACHE_NUM       4
+
+/* 1: Record the drawing commands of an area once and replay them for every part of the display buffer.
+ * Useful if the display buffer is much smaller than the screen: the objects are walked
+ * and their styles are resolved only once per area. */
+#define LV_USE_DRAW_LIST        0
+#if LV_USE_DRAW_LIST
+/* Size of the draw list in bytes (roughly 100 bytes per drawn object part).
+ * If the commands of an area don't fit into it the area is drawn without the list.
+ * Allocated from `LV_MEM_SIZE` when first used. */
+#  define LV_DRAW_LIST_BUF_SIZE   (8U * 1024U)
+#endif
+
+/* 1: Enable drawing objects with `lv_obj_set_opa_layer()` into a layer to apply their opa scale as a group.
+ * The layer is allocated from `LV_MEM_SIZE` while the object is drawn
+ * (max. the size of the display buffer, i.e. `sizeof(lv_color_t)` bytes per pixel). */
+#define LV_USE_OPA_LAYER        1
+
 /* 1: Enable object groups (for keyboard/encoder navigation) */
 #define LV_USE_GROUP            1
 #if LV_USE_GROUP
@@ -147,6 +174,18 @@ typedef void * lv_group_user_data_t;
 /* 1: Enable GPU interface*/
 #define LV_USE_GPU              1
 
+/* 1: Enable `lv_draw_backend_thread`: a software draw backend which splits the large fills and
+ * image blits among worker threads. Requires POSIX threads (link with `-lpthread`).
+ * Set `draw_backend = &lv_draw_backend_thread` in the display driver to use it. */
+#define LV_USE_DRAW_THREAD      0
+#if LV_USE_DRAW_THREAD
+/* Number of worker threads. The calling thread works too while it waits for them. */
+#  define LV_DRAW_THREAD_CNT        3
+
+/* Areas smaller than this [px] are drawn by the calling thread because of the overhead of the threads */
+#  define LV_DRAW_THREAD_MIN_SIZE   (8U * 1024U)
+#endif
+
 /* 1: Enable file system (might be required for images */
 #define LV_USE_FILESYSTEM       1
 #if LV_USE_FILESYSTEM
@@ -167,6 +206,10 @@ typedef void * lv_fs_drv_user_data_t;
 /* 1: Enable alpha indexed images */
 #define LV_IMG_CF_ALPHA         1
 
+/* 1: Enable run-length compressed true color images (`LV_IMG_CF_TRUE_COLOR_..._RLE`).
+ * Convert images with `scripts/img_conv_rle.py` */
+#define LV_IMG_CF_RLE           1
+
 /* Default image cache size. Image caching keeps the images opened.
  * If only the built-in image formats are used there is no real advantage of caching.
  * (I.e. no new image decoder is added)
@@ -175,6 +218,32 @@ typedef void * lv_fs_drv_user_data_t;
  * LV_IMG_CACHE_DEF_SIZE must be >= 1 */
 #define LV_IMG_CACHE_DEF_SIZE       1
 
+/* Default limit of RAM (in bytes) used by the images opened in the cache. 0: no limit.
+ * If a newly opened image doesn't fit the least valuable images are closed.
+ * (Images which were not used recently and are large but quick to open)
+ * Can be changed in run time with `lv_img_cache_set_mem_limit()`*/
+#define LV_IMG_CACHE_DEF_MEM_LIMIT  0
+
+/* Max. RAM (in bytes) used to keep images decoded in the display's color format.
+ * Decoding is enabled per image source with `lv_img_decoder_set_decode_to_ram()`.
+ * Such images are decoded once when opened (e.g. read from the file, palette applied)
+ * and drawn later as quickly as the true color images in the flash.
+ * If an image doesn't fit it's read line by line as usual.
+ * Can be changed in run time with `lv_img_decoder_set_ram_limit()`. 0: don't decode to RAM*/
+#define LV_IMG_DECODE_RAM_LIMIT     0
+
+/* Maximal number of lines read from an image decoder at once if it can't give the whole image.
+ * (I.e. images from files, indexed and alpha images)
+ * More lines mean less decoding and drawing overhead per line but a bigger draw buffer
+ * (max. `LV_HOR_RES_MAX * LV_IMG_DRAW_AREA_MAX_LINES * 4` bytes, but see `LV_IMG_DRAW_BUF_MAX` too)
+ * LV_IMG_DRAW_AREA_MAX_LINES must be >= 1 */
+#define LV_IMG_DRAW_AREA_MAX_LINES  16
+
+/* Maximal size of the draw buffer for the lines of an image [bytes].
+ * Wide images are read in fewer lines to not use more memory (but at least 1 line is read).
+ * If even this much memory is not available the lines are halved until the buffer can be allocated. */
+#define LV_IMG_DRAW_BUF_MAX         (8U * 1024U)
+
 /*Declare the type of the user data of image decoder (can be e.g. `void *`, `int`, `struct`)*/
 typedef void * lv_img_decoder_user_data_t;
 
@@ -331,12 +400,31 @@ typedef void * lv_indev_drv_user_data_t;            /*Type of user data in the i
  * but with > 10,000 characters if you see issues probably you need to enable it.*/
 #define LV_FONT_FMT_TXT_LARGE   0
 
+/* 1: Enable loading fonts at run time from binary files
+ * created with `lv_font_conv --format bin` (or `built_in_font_gen.py --format bin`).
+ * Only the font header, the character maps and the glyph descriptors are kept in RAM,
+ * the glyph bitmaps are read on demand into a small cache. */
+#define LV_USE_FONT_LOADER      0
+#if LV_USE_FONT_LOADER
+/* Number of glyph bitmaps cached per loaded font. Must be a power of 2.
+ * Every slot keeps a buffer as large as the largest glyph it held so far.*/
+#  define LV_FONT_LOADER_CACHE_SLOTS    32
+
+/* 1: Add `lv_font_load_mmap()` to map the font file into the memory with POSIX `mmap()` (e.g. on Linux).
+ * The glyph bitmaps are used directly from the mapping if they are byte aligned in the file. */
+#  define LV_FONT_LOADER_MMAP           0
+#endif
+
 /* Set the pixel order of the display.
  * Important only if "subpx fonts" are used.
  * With "normal" font it doesn't matter.
  */
 #define LV_FONT_SUBPX_BGR    0
 
+/* 1: Filter the subpixel glyphs while drawing to reduce their color fringes.
+ * Set to 0 if the subpixel fonts are converted with a prefilter (without `--no-prefilter`). */
+#define LV_FONT_SUBPX_FILTER 1
+
 /*Declare the type of the user data of fonts (can be e.g. `void *`, `int`, `struct`)*/
 typedef void * lv_font_user_data_t;
 
@@ -445,6 +533,15 @@ typedef void * lv_obj_user_data_t;
 #  define LV_CHART_AXIS_TICK_LABEL_MAX_LEN    20
 #endif
 
+/*Console (dependencies: -)*/
+#define LV_USE_CONSOLE  0
+#if LV_USE_CONSOLE != 0
+/*Default buffer size. The text of the lines is stored in `LV_CONSOLE_DEF_TXT_SIZE` bytes.
+ * The lines use ~8 bytes each.*/
+#  define LV_CONSOLE_DEF_LINE_MAX   64
+#  define LV_CONSOLE_DEF_TXT_SIZE   2048
+#endif
+
 /*Container (dependencies: -*/
 #define LV_USE_CONT     1
 
@@ -488,6 +585,11 @@ typedef void * lv_obj_user_data_t;
 
 /*Store extra some info in labels (12 bytes) to speed up drawing of very long texts*/
 #  define LV_LABEL_LONG_TXT_HINT          0
+
+/*Store the start and width of the lines in labels (~20 bytes + 12 bytes/line)
+ * to draw them and find their letters without breaking the text into lines again.
+ * With `LV_USE_BIDI` the lines in visual order are stored too (~text length + 2 bytes/letter)*/
+#  define LV_LABEL_LINE_CACHE             1
 #endif
 
 /*LED (dependencies: -)*/
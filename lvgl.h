@@ -35,6 +35,7 @@ extern "C" {
 
 #include "src/lv_font/lv_font.h"
 #include "src/lv_font/lv_font_fmt_txt.h"
+#include "src/lv_font/lv_font_loader.h"
 #include "src/lv_misc/lv_bidi.h"
 #include "src/lv_misc/lv_printf.h"
 
@@ -45,6 +46,7 @@ extern "C" {
 #include "src/lv_objx/lv_line.h"
 #include "src/lv_objx/lv_page.h"
 #include "src/lv_objx/lv_cont.h"
+#include "src/lv_objx/lv_console.h"
 #include "src/lv_objx/lv_list.h"
 #include "src/lv_objx/lv_chart.h"
 #include "src/lv_objx/lv_table.h"
@@ -4,7 +4,8 @@ import os
 import sys
 
 parser = argparse.ArgumentParser(description="""Create fonts for LittelvGL including the built-in symbols. lv_font_conv needs to be installed. See https://github.com/littlevgl/lv_font_conv
-Example: python built_in_font_gen.py --size 16 -o lv_font_roboto_16.c --bpp 4 -r 0x20-0x7F""", formatter_class=RawTextHelpFormatter)
+Example: python built_in_font_gen.py --size 16 -o lv_font_roboto_16.c --bpp 4 -r 0x20-0x7F
+Binary font for lv_font_load(): python built_in_font_gen.py --size 16 -o roboto_16.bin --bpp 4 --format bin""", formatter_class=RawTextHelpFormatter)
 parser.add_argument('-s', '--size', 
 					type=int, 
 					metavar = 'px', 
@@ -31,6 +32,10 @@ parser.add_argument('-o', '--output',
 					help='Output file name. E.g. my_font_20.c')
 parser.add_argument('--compressed', action='store_true',
                     help='Compress the bitmaps')
+parser.add_argument('--format',
+					choices=['lvgl', 'bin'],
+					default='lvgl',
+					help='lvgl: C array to compile in (default)\nbin: binary file to load at run time with lv_font_load()')
                     
 args = parser.parse_args()
 
@@ -43,5 +48,5 @@ else:
 syms = "61441,61448,61451,61452,61452,61453,61457,61459,61461,61465,61468,61473,61478,61479,61480,61502,61512,61515,61516,61517,61521,61522,61523,61524,61543,61544,61550,61552,61553,61556,61559,61560,61561,61563,61587,61589,61636,61637,61639,61671,61674,61683,61724,61732,61787,61931,62016,62017,62018,62019,62020,62087,62099,62212,62189,62810,63426,63650"
 
 #Run the command
-cmd = "lv_font_conv {} --bpp {} --size {} --font Roboto-Regular.woff -r {} --font FontAwesome5-Solid+Brands+Regular.woff -r {} --format lvgl -o {} --force-fast-kern-format".format(compr, args.bpp, args.size, args.range[0], syms, args.output)
+cmd = "lv_font_conv {} --bpp {} --size {} --font Roboto-Regular.woff -r {} --font FontAwesome5-Solid+Brands+Regular.woff -r {} --format {} -o {} --force-fast-kern-format".format(compr, args.bpp, args.size, args.range[0], syms, args.format, args.output)
 os.system(cmd)
@@ -0,0 +1,254 @@
+#!/usr/bin/env python3
+
+'''
+Convert a PNG image to a run-length compressed LittlevGL image (LV_IMG_CF_TRUE_COLOR_..._RLE).
+Only the Python standard library is used.
+
+Data layout (after the 4 byte header in binary files):
+  - (h + 1) little endian uint32 offsets of the rows from the beginning of the data.
+    The last one is the end of the last row.
+  - the rows. Every row consists of chunks starting with a control byte:
+      0x00..0x7F: (ctrl + 1) pixels follow as they are
+      0x80..0xFF: the next pixel is repeated (ctrl - 0x80 + 1) times
+    A pixel is an lv_color_t and an alpha byte with LV_IMG_CF_TRUE_COLOR_ALPHA_RLE
+    (with 32 bit color depth the alpha is in the lv_color_t)
+
+Example:
+  python3 img_conv_rle.py bg.png -o bg.c --color-depth 16
+  python3 img_conv_rle.py icon.png -o icon.bin --cf true_color_alpha --color-depth 16
+'''
+
+import argparse
+from argparse import RawTextHelpFormatter
+import os
+import struct
+import sys
+import zlib
+
+CF_IDS = {
+    'true_color': 15,
+    'true_color_alpha': 16,
+    'true_color_chroma_keyed': 17,
+}
+
+CF_NAMES = {
+    'true_color': 'LV_IMG_CF_TRUE_COLOR_RLE',
+    'true_color_alpha': 'LV_IMG_CF_TRUE_COLOR_ALPHA_RLE',
+    'true_color_chroma_keyed': 'LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED_RLE',
+}
+
+RLE_CTRL_RUN = 0x80
+RLE_CNT_MAX = 128
+
+
+def png_read(path):
+    '''Read an 8 bit per channel, not interlaced PNG file. Return (w, h, rows of (r, g, b, a) tuples)'''
+    with open(path, 'rb') as f:
+        data = f.read()
+
+    if data[:8] != b'\x89PNG\r\n\x1a\n':
+        sys.exit('Not a PNG file: ' + path)
+
+    pos = 8
+    idat = b''
+    palette = []
+    trns = b''
+    while pos < len(data):
+        length, ctype = struct.unpack('>I4s', data[pos:pos + 8])
+        chunk = data[pos + 8:pos + 8 + length]
+        pos += 12 + length
+        if ctype == b'IHDR':
+            w, h, depth, color_type, _, _, interlace = struct.unpack('>IIBBBBB', chunk)
+        elif ctype == b'PLTE':
+            palette = [tuple(chunk[i:i + 3]) for i in range(0, len(chunk), 3)]
+        elif ctype == b'tRNS':
+            trns = chunk
+        elif ctype == b'IDAT':
+            idat += chunk
+        elif ctype == b'IEND':
+            break
+
+    if depth != 8 or interlace != 0:
+        sys.exit('Only 8 bit per channel, not interlaced PNG files are supported')
+
+    channels = {0: 1, 2: 3, 3: 1, 4: 2, 6: 4}.get(color_type)
+    if channels is None:
+        sys.exit('Unknown PNG color type: %d' % color_type)
+
+    raw = zlib.decompress(idat)
+    stride = w * channels
+    rows = []
+    prev = bytearray(stride)
+    i = 0
+    for y in range(h):
+        ftype = raw[i]
+        line = bytearray(raw[i + 1:i + 1 + stride])
+        i += 1 + stride
+        for x in range(stride):
+            a = line[x - channels] if x >= channels else 0
+            b = prev[x]
+            c = prev[x - channels] if x >= channels else 0
+            if ftype == 1:
+                line[x] = (line[x] + a) & 0xFF
+            elif ftype == 2:
+                line[x] = (line[x] + b) & 0xFF
+            elif ftype == 3:
+                line[x] = (line[x] + ((a + b) >> 1)) & 0xFF
+            elif ftype == 4:
+                p = a + b - c
+                pa, pb, pc = abs(p - a), abs(p - b), abs(p - c)
+                pred = a if pa <= pb and pa <= pc else (b if pb <= pc else c)
+                line[x] = (line[x] + pred) & 0xFF
+        prev = line
+
+        px = []
+        for x in range(w):
+            v = line[x * channels:(x + 1) * channels]
+            if color_type == 0:
+                px.append((v[0], v[0], v[0], 255))
+            elif color_type == 2:
+                px.append((v[0], v[1], v[2], 255))
+            elif color_type == 3:
+                alpha = trns[v[0]] if v[0] < len(trns) else 255
+                px.append(palette[v[0]] + (alpha,))
+            elif color_type == 4:
+                px.append((v[0], v[0], v[0], v[1]))
+            else:
+                px.append(tuple(v))
+        rows.append(px)
+
+    return w, h, rows
+
+
+def px_to_bytes(px, color_depth, alpha):
+    '''Convert an (r, g, b, a) pixel to the bytes of lv_color_t (and the alpha byte)'''
+    r, g, b, a = px
+    if color_depth == '8':
+        out = bytes([(r & 0xE0) | ((g >> 3) & 0x1C) | (b >> 6)])
+    elif color_depth == '16':
+        c = ((r >> 3) << 11) | ((g >> 2) << 5) | (b >> 3)
+        out = struct.pack('<H', c)
+    elif color_depth == '16swap':
+        c = ((r >> 3) << 11) | ((g >> 2) << 5) | (b >> 3)
+        out = struct.pack('>H', c)
+    else:
+        # With 32 bit color depth the alpha is stored in the color's alpha byte
+        return bytes([b, g, r, a if alpha else 0xFF])
+
+    if alpha:
+        out += bytes([a])
+    return out
+
+
+def rle_encode_row(pixels):
+    '''Run-length encode a row of pixels (list of bytes objects)'''
+    out = bytearray()
+    literal = []
+    i = 0
+    n = len(pixels)
+
+    def flush_literal():
+        while literal:
+            part = literal[:RLE_CNT_MAX]
+            del literal[:RLE_CNT_MAX]
+            out.append(len(part) - 1)
+            for p in part:
+                out.extend(p)
+
+    while i < n:
+        run = 1
+        while i + run < n and run < RLE_CNT_MAX and pixels[i + run] == pixels[i]:
+            run += 1
+
+        # 2 equal pixels are already shorter as a run than as literals
+        if run >= 2:
+            flush_literal()
+            out.append(RLE_CTRL_RUN | (run - 1))
+            out.extend(pixels[i])
+            i += run
+        else:
+            literal.append(pixels[i])
+            i += 1
+
+    flush_literal()
+    return bytes(out)
+
+
+def convert(w, h, rows, cf, color_depth):
+    alpha = cf == 'true_color_alpha'
+    encoded = []
+    for row in rows:
+        encoded.append(rle_encode_row([px_to_bytes(p, color_depth, alpha) for p in row]))
+
+    ofs = 4 * (h + 1)
+    table = bytearray()
+    for e in encoded:
+        table += struct.pack('<I', ofs)
+        ofs += len(e)
+    table += struct.pack('<I', ofs)
+
+    return bytes(table) + b''.join(encoded)
+
+
+def write_c(path, name, w, h, cf, color_depth, data):
+    depth = {'8': 8, '16': 16, '16swap': 16, '32': 32}[color_depth]
+    swap = 1 if color_depth == '16swap' else 0
+
+    with open(path, 'w') as f:
+        f.write('#include "lvgl/lvgl.h"\n\n')
+        f.write('#ifndef LV_ATTRIBUTE_MEM_ALIGN\n#define LV_ATTRIBUTE_MEM_ALIGN\n#endif\n\n')
+        f.write('#if LV_COLOR_DEPTH != %d%s\n' % (depth, ' || LV_COLOR_16_SWAP != %d' % swap if depth == 16 else ''))
+        f.write('#error "%s was converted with --color-depth %s"\n#endif\n\n' % (name, color_depth))
+        f.write('const LV_ATTRIBUTE_MEM_ALIGN uint8_t %s_map[] = {\n' % name)
+        for i in range(0, len(data), 16):
+            f.write('  ' + ', '.join('0x%02x' % v for v in data[i:i + 16]) + ',\n')
+        f.write('};\n\n')
+        f.write('const lv_img_dsc_t %s = {\n' % name)
+        f.write('  .header.always_zero = 0,\n')
+        f.write('  .header.w = %d,\n' % w)
+        f.write('  .header.h = %d,\n' % h)
+        f.write('  .data_size = %d,\n' % len(data))
+        f.write('  .header.cf = %s,\n' % CF_NAMES[cf])
+        f.write('  .data = %s_map,\n' % name)
+        f.write('};\n')
+
+
+def write_bin(path, w, h, cf, data):
+    header = CF_IDS[cf] | (w << 10) | (h << 21)
+    with open(path, 'wb') as f:
+        f.write(struct.pack('<I', header))
+        f.write(data)
+
+
+parser = argparse.ArgumentParser(description=__doc__, formatter_class=RawTextHelpFormatter)
+parser.add_argument('input', metavar='file.png', help='The image to convert')
+parser.add_argument('-o', '--output', metavar='file', required=True,
+                    help='Output file name. *.c: C array to compile in; *.bin: binary file to open from a file system')
+parser.add_argument('--cf', choices=sorted(CF_IDS.keys()), default='true_color',
+                    help='Color format (default: true_color)')
+parser.add_argument('--color-depth', choices=['8', '16', '16swap', '32'], default='16',
+                    help='LV_COLOR_DEPTH (16swap: LV_COLOR_16_SWAP = 1). Default: 16')
+parser.add_argument('--name', help='Name of the image variable. Default: the output file name')
+
+args = parser.parse_args()
+
+if args.output.endswith('.c') and args.name is None:
+    args.name = os.path.splitext(os.path.basename(args.output))[0]
+
+w, h, rows = png_read(args.input)
+if w > 2047 or h > 2047:
+    sys.exit('The image is too large. Max. 2047x2047')
+
+data = convert(w, h, rows, args.cf, args.color_depth)
+
+if args.output.endswith('.bin'):
+    write_bin(args.output, w, h, args.cf, data)
+else:
+    write_c(args.output, args.name, w, h, args.cf, args.color_depth, data)
+
+px_size = {'8': 1, '16': 2, '16swap': 2, '32': 4}[args.color_depth]
+if args.cf == 'true_color_alpha' and args.color_depth != '32':
+    px_size += 1
+raw_size = w * h * px_size
+print('%s: %dx%d, %d bytes (not compressed: %d bytes, %.1f%%)' %
+      (args.output, w, h, len(data), raw_size, 100.0 * len(data) / raw_size))
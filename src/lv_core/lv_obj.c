@@ -14,6 +14,7 @@
 #include "../lv_core/lv_debug.h"
 #include "../lv_themes/lv_theme.h"
 #include "../lv_draw/lv_draw.h"
+#include "../lv_draw/lv_draw_grad.h"
 #include "../lv_misc/lv_anim.h"
 #include "../lv_misc/lv_task.h"
 #include "../lv_misc/lv_async.h"
@@ -124,6 +125,8 @@ void lv_init(void)
 #if LV_ENABLE_GC || !LV_MEM_CUSTOM
 void lv_deinit(void)
 {
+    /*With `LV_MEM_CUSTOM` the memory is not reset so free the caches before forgetting them*/
+    lv_draw_grad_cache_free();
     lv_gc_clear_roots();
 #if LV_USE_LOG
     lv_log_register_print_cb(NULL);
@@ -222,6 +225,7 @@ lv_obj_t * lv_obj_create(lv_obj_t * parent, const lv_obj_t * copy)
         new_obj->protect      = LV_PROTECT_NONE;
         new_obj->opa_scale_en = 0;
         new_obj->opa_scale    = LV_OPA_COVER;
+        new_obj->opa_layer    = 0;
         new_obj->parent_event = 0;
 #if LV_USE_BIDI
         new_obj->base_dir     = LV_BIDI_BASE_DIR_DEF;
@@ -324,6 +328,7 @@ lv_obj_t * lv_obj_create(lv_obj_t * parent, const lv_obj_t * copy)
         new_obj->protect      = LV_PROTECT_NONE;
         new_obj->opa_scale    = LV_OPA_COVER;
         new_obj->opa_scale_en = 0;
+        new_obj->opa_layer    = 0;
         new_obj->parent_event = 0;
         new_obj->reserved     = 0;
 
@@ -375,6 +380,7 @@ lv_obj_t * lv_obj_create(lv_obj_t * parent, const lv_obj_t * copy)
         new_obj->opa_scale_en = copy->opa_scale_en;
         new_obj->protect      = copy->protect;
         new_obj->opa_scale    = copy->opa_scale;
+        new_obj->opa_layer    = copy->opa_layer;
 
         new_obj->style_p = copy->style_p;
 
@@ -1431,6 +1437,24 @@ void lv_obj_set_opa_scale(lv_obj_t * obj, lv_opa_t opa_scale)
     lv_obj_invalidate(obj);
 }
 
+/**
+ * Apply the opa scale of an object on the object and its children as a group.
+ * They are drawn opaque into a layer which is blended with the opa scale at once.
+ * This way the overlapping children are not visible through each other,
+ * and it's also faster than scaling the opacity of every drawn part.
+ * Requires `LV_USE_OPA_LAYER` and memory for an area of the display buffer. If it's not possible,
+ * the opacity of the parts is scaled.
+ * @param obj pointer to an object
+ * @param en true: enable the layer; false: scale the opacity of every drawn part
+ */
+void lv_obj_set_opa_layer(lv_obj_t * obj, bool en)
+{
+    LV_ASSERT_OBJ(obj, LV_OBJX_NAME);
+
+    obj->opa_layer = en ? 1 : 0;
+    lv_obj_invalidate(obj);
+}
+
 /**
  * Set a bit or bits in the protect filed
  * @param obj pointer to an object
@@ -2209,6 +2233,18 @@ lv_opa_t lv_obj_get_opa_scale(const lv_obj_t * obj)
     return LV_OPA_COVER;
 }
 
+/**
+ * Get whether the opa scale of an object is applied on a layer
+ * @param obj pointer to an object
+ * @return true: the object and its children are drawn into a layer
+ */
+bool lv_obj_get_opa_layer(const lv_obj_t * obj)
+{
+    LV_ASSERT_OBJ(obj, LV_OBJX_NAME);
+
+    return obj->opa_layer == 0 ? false : true;
+}
+
 /**
  * Get the protect field of an object
  * @param obj pointer to an object
@@ -222,7 +222,8 @@ typedef struct _lv_obj_t
     uint8_t parent_event : 1;   /**< 1: Send the object's events to the parent too. */
     lv_drag_dir_t drag_dir : 2; /**<  Which directions the object can be dragged in */
     lv_bidi_dir_t base_dir : 2; /**< Base direction of texts related to this object */
-    uint8_t reserved : 3;       /**<  Reserved for future use*/
+    uint8_t opa_layer : 1;      /**< 1: Draw the object and its children into a layer and apply `opa_scale` on it*/
+    uint8_t reserved : 2;       /**<  Reserved for future use*/
     uint8_t protect;            /**< Automatically happening actions can be prevented. 'OR'ed values from
                                    `lv_protect_t`*/
     lv_opa_t opa_scale;         /**< Scale down the opacity by this factor. Effects all children as well*/
@@ -550,6 +551,18 @@ void lv_obj_set_opa_scale_enable(lv_obj_t * obj, bool en);
  */
 void lv_obj_set_opa_scale(lv_obj_t * obj, lv_opa_t opa_scale);
 
+/**
+ * Apply the opa scale of an object on the object and its children as a group.
+ * They are drawn opaque into a layer which is blended with the opa scale at once.
+ * This way the overlapping children are not visible through each other,
+ * and it's also faster than scaling the opacity of every drawn part.
+ * Requires `LV_USE_OPA_LAYER` and memory for an area of the display buffer. If it's not possible,
+ * the opacity of the parts is scaled.
+ * @param obj pointer to an object
+ * @param en true: enable the layer; false: scale the opacity of every drawn part
+ */
+void lv_obj_set_opa_layer(lv_obj_t * obj, bool en);
+
 /**
  * Set a bit or bits in the protect filed
  * @param obj pointer to an object
@@ -889,6 +902,13 @@ lv_opa_t lv_obj_get_opa_scale_enable(const lv_obj_t * obj);
  */
 lv_opa_t lv_obj_get_opa_scale(const lv_obj_t * obj);
 
+/**
+ * Get whether the opa scale of an object is applied on a layer
+ * @param obj pointer to an object
+ * @return true: the object and its children are drawn into a layer
+ */
+bool lv_obj_get_opa_layer(const lv_obj_t * obj);
+
 /**
  * Get the protect field of an object
  * @param obj pointer to an object
@@ -15,6 +15,8 @@
 #include "../lv_misc/lv_mem.h"
 #include "../lv_misc/lv_gc.h"
 #include "../lv_draw/lv_draw.h"
+#include "../lv_draw/lv_draw_list.h"
+#include "../lv_draw/lv_draw_layer.h"
 
 #if defined(LV_GC_INCLUDE)
 #include LV_GC_INCLUDE
@@ -37,6 +39,9 @@ static void lv_refr_join_area(void);
 static void lv_refr_areas(void);
 static void lv_refr_area(const lv_area_t * area_p);
 static void lv_refr_area_part(const lv_area_t * area_p);
+#if LV_USE_DRAW_LIST
+static bool lv_refr_area_record(const lv_area_t * area_p);
+#endif
 static lv_obj_t * lv_refr_get_top_obj(const lv_area_t * area_p, lv_obj_t * obj);
 static void lv_refr_obj_and_children(lv_obj_t * top_p, const lv_area_t * mask_p);
 static void lv_refr_obj(lv_obj_t * obj, const lv_area_t * mask_ori_p);
@@ -47,6 +52,9 @@ static void lv_refr_vdb_flush(void);
  **********************/
 static uint32_t px_num;
 static lv_disp_t * disp_refr; /*Display being refreshed*/
+#if LV_USE_DRAW_LIST
+static bool draw_list_valid; /*The drawing commands of the area are recorded so replay them for every part*/
+#endif
 
 /**********************
  *      MACROS
@@ -339,6 +347,16 @@ static void lv_refr_area(const lv_area_t * area_p)
             }
         }
 
+#if LV_USE_DRAW_LIST
+        /*If the area is refreshed in more parts collect the drawing commands only once*/
+        if(max_row < y2 - area_p->y1 + 1) {
+            lv_area_t rec_area;
+            lv_area_copy(&rec_area, area_p);
+            rec_area.y2     = y2;
+            draw_list_valid = lv_refr_area_record(&rec_area);
+        }
+#endif
+
         /*Always use the full row*/
         lv_coord_t row;
         lv_coord_t row_last = 0;
@@ -364,6 +382,13 @@ static void lv_refr_area(const lv_area_t * area_p)
             /*Refresh this part too*/
             lv_refr_area_part(area_p);
         }
+
+#if LV_USE_DRAW_LIST
+        draw_list_valid = false;
+#if LV_USE_OPA_LAYER
+        lv_draw_layer_free_reserved();
+#endif
+#endif
     }
 }
 
@@ -390,15 +415,23 @@ static void lv_refr_area_part(const lv_area_t * area_p)
     lv_area_t start_mask;
     lv_area_intersect(&start_mask, area_p, &vdb->area);
 
-    /*Get the most top object which is not covered by others*/
-    top_p = lv_refr_get_top_obj(&start_mask, lv_disp_get_scr_act(disp_refr));
+#if LV_USE_DRAW_LIST
+    /*The objects were already drawn into the draw list. Just draw the commands on this part.*/
+    if(draw_list_valid) {
+        lv_draw_list_replay(&start_mask);
+    } else
+#endif
+    {
+        /*Get the most top object which is not covered by others*/
+        top_p = lv_refr_get_top_obj(&start_mask, lv_disp_get_scr_act(disp_refr));
 
-    /*Do the refreshing from the top object*/
-    lv_refr_obj_and_children(top_p, &start_mask);
+        /*Do the refreshing from the top object*/
+        lv_refr_obj_and_children(top_p, &start_mask);
 
-    /*Also refresh top and sys layer unconditionally*/
-    lv_refr_obj_and_children(lv_disp_get_layer_top(disp_refr), &start_mask);
-    lv_refr_obj_and_children(lv_disp_get_layer_sys(disp_refr), &start_mask);
+        /*Also refresh top and sys layer unconditionally*/
+        lv_refr_obj_and_children(lv_disp_get_layer_top(disp_refr), &start_mask);
+        lv_refr_obj_and_children(lv_disp_get_layer_sys(disp_refr), &start_mask);
+    }
 
     /* In true double buffered mode flush only once when all areas were rendered.
      * In normal mode flush after every area */
@@ -407,6 +440,25 @@ static void lv_refr_area_part(const lv_area_t * area_p)
     }
 }
 
+#if LV_USE_DRAW_LIST
+/**
+ * Record the drawing commands of all objects on an area into the draw list
+ * @param area_p pointer to an area to refresh
+ * @return true: the commands are recorded; false: the draw list is full, draw the parts normally
+ */
+static bool lv_refr_area_record(const lv_area_t * area_p)
+{
+    lv_draw_list_start();
+
+    lv_obj_t * top_p = lv_refr_get_top_obj(area_p, lv_disp_get_scr_act(disp_refr));
+    lv_refr_obj_and_children(top_p, area_p);
+    lv_refr_obj_and_children(lv_disp_get_layer_top(disp_refr), area_p);
+    lv_refr_obj_and_children(lv_disp_get_layer_sys(disp_refr), area_p);
+
+    return lv_draw_list_stop() == LV_RES_OK ? true : false;
+}
+#endif
+
 /**
  * Search the most top object which fully covers an area
  * @param area_p pointer to an area
@@ -513,6 +565,20 @@ static void lv_refr_obj(lv_obj_t * obj, const lv_area_t * mask_ori_p)
     /*Draw the parent and its children only if they ore on 'mask_parent'*/
     if(union_ok != false) {
 
+#if LV_USE_OPA_LAYER
+        /* Draw the object and its children opaque into a layer and blend the layer with the opa scale at once.
+         * The opa scale is hidden from the children while they are drawn into the layer.*/
+        bool layer         = false;
+        lv_opa_t layer_opa = obj->opa_scale;
+        if(obj->opa_layer && obj->opa_scale_en && layer_opa <= LV_OPA_MAX) {
+            /*A transparent group has nothing to draw*/
+            if(layer_opa < LV_OPA_MIN) return;
+
+            layer = true;
+            if(lv_draw_layer_start(&obj_ext_mask)) obj->opa_scale = LV_OPA_COVER;
+        }
+#endif
+
         /* Redraw the object */
         obj->design_cb(obj, &obj_ext_mask, LV_DESIGN_DRAW_MAIN);
 
@@ -551,6 +617,13 @@ static void lv_refr_obj(lv_obj_t * obj, const lv_area_t * mask_ori_p)
 
         /* If all the children are redrawn make 'post draw' design */
         obj->design_cb(obj, &obj_ext_mask, LV_DESIGN_DRAW_POST);
+
+#if LV_USE_OPA_LAYER
+        if(layer) {
+            obj->opa_scale = layer_opa;
+            lv_draw_layer_finish(&obj_ext_mask, layer_opa);
+        }
+#endif
     }
 }
 
@@ -561,6 +634,9 @@ static void lv_refr_vdb_flush(void)
 {
     lv_disp_buf_t * vdb = lv_disp_get_buf(disp_refr);
 
+    /*Let the draw backend finish the drawing of this part*/
+    lv_draw_backend_wait();
+
     /*In double buffered mode wait until the other buffer is flushed before flushing the current
      * one*/
     if(lv_disp_is_double_buf(disp_refr)) {
@@ -568,11 +644,52 @@ static void lv_refr_vdb_flush(void)
             ;
     }
 
-    vdb->flushing = 1;
-
-    /*Flush the rendered content to the display*/
     lv_disp_t * disp = lv_refr_get_disp_refreshing();
-    if(disp->driver.flush_cb) disp->driver.flush_cb(&disp->driver, &vdb->area, vdb->buf_act);
+
+#if LV_USE_DISP_OUT_CONV
+    if(disp->driver.out_fmt != LV_COLOR_FMT_NATIVE && disp->driver.out_buf) {
+        /*Wait until the previously converted pixels are sent*/
+        while(vdb->out_flushing)
+            ;
+
+        if(disp->driver.out_dither || lv_color_fmt_get_bpp(disp->driver.out_fmt) < 8) {
+            /* The dither thresholds depend on the screen coordinates
+             * and the rows of the packed formats start on a new byte so convert row by row*/
+            lv_coord_t w             = lv_area_get_width(&vdb->area);
+            uint32_t row_size        = lv_color_fmt_get_row_size(disp->driver.out_fmt, w);
+            uint8_t * out_p          = disp->driver.out_buf;
+            const lv_color_t * buf_p = vdb->buf_act;
+            lv_coord_t y;
+            for(y = vdb->area.y1; y <= vdb->area.y2; y++) {
+                if(disp->driver.out_dither) {
+                    lv_color_conv_dither(out_p, buf_p, w, disp->driver.out_fmt, vdb->area.x1, y);
+                } else {
+                    lv_color_conv(out_p, buf_p, w, disp->driver.out_fmt);
+                }
+                out_p += row_size;
+                buf_p += w;
+            }
+        } else {
+            lv_color_conv(disp->driver.out_buf, vdb->buf_act, lv_area_get_size(&vdb->area), disp->driver.out_fmt);
+        }
+
+#if LV_COLOR_SCREEN_TRANSP
+        if(disp->driver.screen_transp) {
+            memset(vdb->buf_act, 0x00, vdb->size * sizeof(lv_color32_t));
+        }
+#endif
+
+        /*The display buffer is free again: the next part can be rendered while `out_buf` is sent*/
+        vdb->out_flushing = 1;
+        if(disp->driver.flush_cb) disp->driver.flush_cb(&disp->driver, &vdb->area, disp->driver.out_buf);
+    } else
+#endif
+    {
+        vdb->flushing = 1;
+
+        /*Flush the rendered content to the display*/
+        if(disp->driver.flush_cb) disp->driver.flush_cb(&disp->driver, &vdb->area, vdb->buf_act);
+    }
 
     if(vdb->buf1 && vdb->buf2) {
         if(vdb->buf_act == vdb->buf1)
@@ -50,6 +50,14 @@ enum {
 };
 typedef uint8_t lv_shadow_type_t;
 
+/*Gradient directions*/
+enum {
+    LV_GRAD_DIR_VER = 0, /**< `main_color` on the top, `grad_color` on the bottom */
+    LV_GRAD_DIR_HOR,     /**< `main_color` on the left, `grad_color` on the right */
+    LV_GRAD_DIR_DIAG,    /**< `main_color` on the top left, `grad_color` on the bottom right corner */
+};
+typedef uint8_t lv_grad_dir_t;
+
 /**
  * Objects in LittlevGL can be assigned a style - which holds information about
  * how the object should be drawn.
@@ -66,6 +74,7 @@ typedef struct
     {
         lv_color_t main_color; /**< Object's main background color. */
         lv_color_t grad_color; /**< Second color. If not equal to `main_color` a gradient will be drawn for the background. */
+        lv_grad_dir_t grad_dir; /**< Direction of the gradient. */
         lv_coord_t radius; /**< Object's corner radius. You can use #LV_RADIUS_CIRCLE if you want to draw a circle. */
         lv_opa_t opa; /**< Object's opacity (0-255). */
 
@@ -52,22 +52,31 @@ static uint32_t draw_buf_size = 0;
  * @param size the required size
  */
 void * lv_draw_get_buf(uint32_t size)
+{
+    void * buf = lv_draw_try_get_buf(size);
+    LV_ASSERT_MEM(buf);
+    return buf;
+}
+
+/**
+ * Give a buffer with the given size to use during drawing or NULL if there is not enough memory.
+ * Unlike `lv_draw_get_buf()` it doesn't assert on failure and the current buffer is kept.
+ * Useful if the caller can work with a smaller buffer too.
+ * @param size the required size
+ * @return pointer to the buffer or NULL
+ */
+void * lv_draw_try_get_buf(uint32_t size)
 {
     if(size <= draw_buf_size) return LV_GC_ROOT(_lv_draw_buf);
 
     LV_LOG_TRACE("lv_draw_get_buf: allocate");
 
-    draw_buf_size = size;
-
-    if(LV_GC_ROOT(_lv_draw_buf) == NULL) {
-        LV_GC_ROOT(_lv_draw_buf) = lv_mem_alloc(size);
-        LV_ASSERT_MEM(LV_GC_ROOT(_lv_draw_buf));
-        return LV_GC_ROOT(_lv_draw_buf);
-    }
+    void * buf = lv_mem_realloc(LV_GC_ROOT(_lv_draw_buf), size);
+    if(buf == NULL) return NULL;
 
-    LV_GC_ROOT(_lv_draw_buf) = lv_mem_realloc(LV_GC_ROOT(_lv_draw_buf), size);
-    LV_ASSERT_MEM(LV_GC_ROOT(_lv_draw_buf));
-    return LV_GC_ROOT(_lv_draw_buf);
+    LV_GC_ROOT(_lv_draw_buf) = buf;
+    draw_buf_size            = size;
+    return buf;
 }
 
 /**
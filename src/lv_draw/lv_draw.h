@@ -42,6 +42,15 @@ extern "C" {
  */
 void * lv_draw_get_buf(uint32_t size);
 
+/**
+ * Give a buffer with the given size to use during drawing or NULL if there is not enough memory.
+ * Unlike `lv_draw_get_buf()` it doesn't assert on failure and the current buffer is kept.
+ * Useful if the caller can work with a smaller buffer too.
+ * @param size the required size
+ * @return pointer to the buffer or NULL
+ */
+void * lv_draw_try_get_buf(uint32_t size);
+
 /**
  * Free the draw buffer
  */
@@ -101,6 +110,7 @@ void lv_draw_aa_hor_seg(lv_coord_t x, lv_coord_t y, lv_coord_t length, const lv_
 #include "lv_draw_line.h"
 #include "lv_draw_triangle.h"
 #include "lv_draw_arc.h"
+#include "lv_draw_backend.h"
 
 #ifdef __cplusplus
 } /* extern "C" */
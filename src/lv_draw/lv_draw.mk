@@ -8,6 +8,13 @@ CSRCS += lv_draw_arc.c
 CSRCS += lv_draw_triangle.c
 CSRCS += lv_img_decoder.c
 CSRCS += lv_img_cache.c
+CSRCS += lv_img_transform.c
+CSRCS += lv_draw_list.c
+CSRCS += lv_draw_grad.c
+CSRCS += lv_draw_layer.c
+CSRCS += lv_draw_backend.c
+CSRCS += lv_draw_sw.c
+CSRCS += lv_draw_thread.c
 
 DEPPATH += --dep-path $(LVGL_DIR)/lvgl/src/lv_draw
 VPATH += :$(LVGL_DIR)/lvgl/src/lv_draw
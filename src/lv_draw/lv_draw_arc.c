@@ -6,26 +6,59 @@
 /*********************
  *      INCLUDES
  *********************/
+#include <string.h>
 #include "lv_draw_arc.h"
+#include "../lv_core/lv_refr.h"
 #include "../lv_misc/lv_math.h"
+#include "lv_draw_list.h"
 
 /*********************
  *      DEFINES
  *********************/
+/*The distances are calculated with this many fractional bits*/
+#define ARC_FRACT_SHIFT 8
+#define ARC_FRACT_ONE (1 << ARC_FRACT_SHIFT)
+#define ARC_FRACT_HALF (1 << (ARC_FRACT_SHIFT - 1))
+
+/*Safety margin for the rounding errors when a pixel is surely in or out [1/ARC_FRACT_ONE px]*/
+#define ARC_MARGIN 16
 
 /**********************
  *      TYPEDEFS
  **********************/
+enum {
+    ARC_WEDGE_NONE, /*Full ring*/
+    ARC_WEDGE_AND,  /*At most 180 deg: the pixels after the start AND before the end*/
+    ARC_WEDGE_OR,   /*More than 180 deg: the pixels after the start OR before the end*/
+};
+typedef uint8_t arc_wedge_t;
+
+typedef struct
+{
+    int32_t r_out;      /*Outer radius [1/ARC_FRACT_ONE px]*/
+    int32_t r_in;       /*Inner radius [1/ARC_FRACT_ONE px]*/
+    int32_t start_sin;  /*Direction of the start angle [1/LV_TRIGO_SIN_MAX]*/
+    int32_t start_cos;
+    int32_t end_sin;    /*Direction of the end angle [1/LV_TRIGO_SIN_MAX]*/
+    int32_t end_cos;
+    int32_t cap_x[2];   /*Center of the round ends relative to the center [1/ARC_FRACT_ONE px]*/
+    int32_t cap_y[2];
+    int32_t cap_r;      /*Radius of the round ends [1/ARC_FRACT_ONE px]*/
+    arc_wedge_t wedge;
+    uint8_t rounded : 1;
+    uint8_t aa : 1;
+} arc_dsc_t;
 
 /**********************
  *  STATIC PROTOTYPES
  **********************/
-static void ver_line(lv_coord_t x, lv_coord_t y, const lv_area_t * mask, lv_coord_t len, lv_color_t color,
-                     lv_opa_t opa);
-static void hor_line(lv_coord_t x, lv_coord_t y, const lv_area_t * mask, lv_coord_t len, lv_color_t color,
-                     lv_opa_t opa);
-static bool deg_test_norm(uint16_t deg, uint16_t start, uint16_t end);
-static bool deg_test_inv(uint16_t deg, uint16_t start, uint16_t end);
+static void arc_cov_row(const arc_dsc_t * arc, lv_coord_t y, lv_coord_t x_min, lv_coord_t x_max, lv_opa_t * cov,
+                        lv_coord_t * x1_res, lv_coord_t * x2_res);
+static void arc_cov_range(const arc_dsc_t * arc, lv_coord_t y, lv_coord_t x1, lv_coord_t x2, lv_coord_t in_x1,
+                          lv_coord_t in_x2, lv_opa_t * cov);
+static void wedge_limit(int32_t side, int32_t side_step, lv_coord_t * x1, lv_coord_t * x2);
+static int32_t row_half_len(int32_t r, int32_t y);
+static int32_t dist_get(int32_t x, int32_t y);
 
 /**********************
  *  STATIC VARIABLES
@@ -47,205 +80,310 @@ static bool deg_test_inv(uint16_t deg, uint16_t start, uint16_t end);
  * @param mask the arc will be drawn only in this mask
  * @param start_angle the start angle of the arc (0 deg on the bottom, 90 deg on the right)
  * @param end_angle the end angle of the arc
- * @param style style of the arc (`body.thickness`, `body.main_color`, `body.opa` is used)
+ * @param style style of the arc (`line.width`, `line.color`, `line.rounded`, `body.opa` is used)
  * @param opa_scale scale down all opacities by the factor
  */
 void lv_draw_arc(lv_coord_t center_x, lv_coord_t center_y, uint16_t radius, const lv_area_t * mask,
                  uint16_t start_angle, uint16_t end_angle, const lv_style_t * style, lv_opa_t opa_scale)
 {
+#if LV_USE_DRAW_LIST
+    if(lv_draw_list_is_recording()) {
+        lv_draw_list_add_arc(center_x, center_y, radius, mask, start_angle, end_angle, style, opa_scale);
+        return;
+    }
+#endif
+
     lv_coord_t thickness = style->line.width;
     if(thickness > radius) thickness = radius;
+    if(thickness == 0) return;
 
-#if LV_ANTIALIAS
-    thickness--;
-    radius--;
-#endif
+    lv_opa_t opa = opa_scale == LV_OPA_COVER ? style->body.opa : (uint16_t)((uint16_t)style->body.opa * opa_scale) >> 8;
+    if(opa < LV_OPA_MIN) return;
+
+    /*Only the rows and columns of the mask are processed*/
+    lv_area_t draw_area;
+    draw_area.x1 = center_x - radius;
+    draw_area.y1 = center_y - radius;
+    draw_area.x2 = center_x + radius;
+    draw_area.y2 = center_y + radius;
+    if(lv_area_intersect(&draw_area, &draw_area, mask) == false) return;
+
+    arc_dsc_t arc;
+    arc.aa      = lv_disp_get_antialiasing(lv_refr_get_disp_refreshing()) ? 1 : 0;
+    arc.r_out   = ((int32_t)radius << ARC_FRACT_SHIFT) - ARC_FRACT_HALF;
+    arc.r_in    = arc.r_out - ((int32_t)thickness << ARC_FRACT_SHIFT);
+    arc.rounded = style->line.rounded;
+
+    start_angle = start_angle % 360;
+    end_angle   = end_angle == 360 ? 360 : end_angle % 360;
+    uint16_t span = start_angle <= end_angle ? end_angle - start_angle : 360 - start_angle + end_angle;
+    if(span >= 360) {
+        arc.wedge   = ARC_WEDGE_NONE;
+        arc.rounded = 0;
+    } else {
+        arc.wedge = span <= 180 ? ARC_WEDGE_AND : ARC_WEDGE_OR;
+    }
 
-    lv_coord_t r_out = radius;
-    lv_coord_t r_in  = r_out - thickness;
-    int16_t deg_base;
-    int16_t deg;
-    lv_coord_t x_start[4];
-    lv_coord_t x_end[4];
+    /*The angles are measured from the bottom towards the right*/
+    arc.start_sin = lv_trigo_sin(start_angle);
+    arc.start_cos = lv_trigo_sin(start_angle + 90);
+    arc.end_sin   = lv_trigo_sin(end_angle);
+    arc.end_cos   = lv_trigo_sin(end_angle + 90);
+
+    int32_t r_mid = (arc.r_out + arc.r_in) >> 1;
+    arc.cap_r     = (arc.r_out - arc.r_in) >> 1;
+    arc.cap_x[0]  = (int32_t)(((int64_t)r_mid * arc.start_sin) >> LV_TRIGO_SHIFT);
+    arc.cap_y[0]  = (int32_t)(((int64_t)r_mid * arc.start_cos) >> LV_TRIGO_SHIFT);
+    arc.cap_x[1]  = (int32_t)(((int64_t)r_mid * arc.end_sin) >> LV_TRIGO_SHIFT);
+    arc.cap_y[1]  = (int32_t)(((int64_t)r_mid * arc.end_cos) >> LV_TRIGO_SHIFT);
+
+    lv_coord_t draw_w = lv_area_get_width(&draw_area);
+    lv_opa_t * cov    = lv_draw_get_buf(draw_w);
+    if(cov == NULL) return;
+    memset(cov, 0, draw_w);
+
+    lv_coord_t y;
+    for(y = draw_area.y1; y <= draw_area.y2; y++) {
+        /*Collect the coverage of the row relative to the center and draw the touched part*/
+        lv_coord_t x1;
+        lv_coord_t x2;
+        arc_cov_row(&arc, y - center_y, draw_area.x1 - center_x, draw_area.x2 - center_x, cov, &x1, &x2);
+        if(x1 > x2) continue;
+
+        lv_opa_t * row_cov = &cov[x1 - (draw_area.x1 - center_x)];
+        lv_draw_cov_row(center_x + x1, y, x2 - x1 + 1, row_cov, mask, style->line.color, opa);
+        memset(row_cov, 0, x2 - x1 + 1);
+    }
+}
 
-    lv_color_t color = style->line.color;
-    lv_opa_t opa = opa_scale == LV_OPA_COVER ? style->body.opa : (uint16_t)((uint16_t)style->body.opa * opa_scale) >> 8;
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
 
-    bool (*deg_test)(uint16_t, uint16_t, uint16_t);
-    if(start_angle <= end_angle)
-        deg_test = deg_test_norm;
-    else
-        deg_test = deg_test_inv;
+/**
+ * Calculate the coverage of a row of an arc. Only the pixels close to the arc are checked.
+ * @param arc pointer to an arc descriptor
+ * @param y the row relative to the center
+ * @param x_min the first pixel to check (relative to the center)
+ * @param x_max the last pixel to check (relative to the center)
+ * @param cov coverage of the pixels from `x_min`
+ * @param x1_res store the first touched pixel here
+ * @param x2_res store the last touched pixel here (`x2_res < x1_res` if there is nothing to draw)
+ */
+static void arc_cov_row(const arc_dsc_t * arc, lv_coord_t y, lv_coord_t x_min, lv_coord_t x_max, lv_opa_t * cov,
+                        lv_coord_t * x1_res, lv_coord_t * x2_res)
+{
+    *x1_res = 0;
+    *x2_res = -1;
+
+    int32_t y_fract = (int32_t)y << ARC_FRACT_SHIFT;
+
+    /*The ranges to check: the left and right part of the ring and the 2 round ends*/
+    lv_coord_t range_x1[4];
+    lv_coord_t range_x2[4];
+    uint8_t range_cnt = 0;
+
+    /*The ring*/
+    int32_t out_len = row_half_len(arc->r_out + ARC_FRACT_HALF + ARC_MARGIN, y_fract);
+    lv_coord_t ring_in_x1 = 0;
+    lv_coord_t ring_in_x2 = -1;
+    if(out_len >= 0) {
+        lv_coord_t x_out = out_len >> ARC_FRACT_SHIFT;
+
+        /*The pixels of the hole in the middle are surely not covered*/
+        int32_t hole_len  = row_half_len(arc->r_in - ARC_FRACT_HALF - ARC_MARGIN, y_fract);
+        lv_coord_t x_hole = hole_len >= 0 ? hole_len >> ARC_FRACT_SHIFT : -1;
+
+        /*The pixels between these distances are surely covered (if they are in the wedge)*/
+        int32_t in_len1 = row_half_len(arc->r_in + ARC_FRACT_HALF + ARC_MARGIN, y_fract);
+        int32_t in_len2 = row_half_len(arc->r_out - ARC_FRACT_HALF - ARC_MARGIN, y_fract);
+        if(in_len2 >= 0) {
+            ring_in_x1 = in_len1 >= 0 ? (in_len1 >> ARC_FRACT_SHIFT) + 1 : 0;
+            ring_in_x2 = in_len2 >> ARC_FRACT_SHIFT;
+        }
 
-    int middle_r_out = r_out;
-#if !LV_ANTIALIAS
-    thickness--;
-    middle_r_out = r_out - 1;
-#endif
-    if(deg_test(270, start_angle, end_angle))
-        hor_line(center_x - middle_r_out, center_y, mask, thickness, color, opa); /*Left Middle*/
-    if(deg_test(90, start_angle, end_angle))
-        hor_line(center_x + r_in, center_y, mask, thickness, color, opa); /*Right Middle*/
-    if(deg_test(180, start_angle, end_angle))
-        ver_line(center_x, center_y - middle_r_out, mask, thickness, color, opa); /*Top Middle*/
-    if(deg_test(0, start_angle, end_angle))
-        ver_line(center_x, center_y + r_in, mask, thickness, color, opa); /*Bottom middle*/
-
-    uint32_t r_out_sqr = r_out * r_out;
-    uint32_t r_in_sqr  = r_in * r_in;
-#if LV_ANTIALIAS
-    uint32_t r_out_aa_sqr = (r_out + 1) * (r_out + 1);
-    uint32_t r_in_aa_sqr  = (r_in - 1) * (r_in - 1);
-#endif
-    int16_t xi;
-    int16_t yi;
-    for(yi = -r_out; yi < 0; yi++) {
-        x_start[0] = LV_COORD_MIN;
-        x_start[1] = LV_COORD_MIN;
-        x_start[2] = LV_COORD_MIN;
-        x_start[3] = LV_COORD_MIN;
-        x_end[0]   = LV_COORD_MIN;
-        x_end[1]   = LV_COORD_MIN;
-        x_end[2]   = LV_COORD_MIN;
-        x_end[3]   = LV_COORD_MIN;
-        int xe     = 0;
-        for(xi = -r_out; xi < 0; xi++) {
-
-            uint32_t r_act_sqr = xi * xi + yi * yi;
-#if LV_ANTIALIAS
-            if(r_act_sqr > r_out_aa_sqr) {
-                continue;
+        range_x1[0] = -x_out;
+        range_x2[0] = -x_hole - 1;
+        range_x1[1] = x_hole + 1;
+        range_x2[1] = x_out;
+
+        /*Only the parts in the wedge are interesting if the wedge is convex*/
+        if(arc->wedge == ARC_WEDGE_AND) {
+            uint8_t i;
+            for(i = 0; i < 2; i++) {
+                wedge_limit(-arc->start_sin * y, arc->start_cos, &range_x1[i], &range_x2[i]);
+                wedge_limit(arc->end_sin * y, -arc->end_cos, &range_x1[i], &range_x2[i]);
             }
-#else
-            if(r_act_sqr > r_out_sqr) continue;
-#endif
+        }
+        range_cnt = 2;
+    }
 
-            deg_base = lv_atan2(xi, yi) - 180;
-
-#if LV_ANTIALIAS
-            int opa2 = -1;
-            if(r_act_sqr > r_out_sqr) {
-                opa2 = LV_OPA_100 * (r_out + 1) - lv_sqrt(LV_OPA_100 * LV_OPA_100 * r_act_sqr);
-                if(opa2 < LV_OPA_0)
-                    opa2 = LV_OPA_0;
-                else if(opa2 > LV_OPA_100)
-                    opa2 = LV_OPA_100;
-            } else if(r_act_sqr < r_in_sqr) {
-                if(xe == 0) xe = xi;
-                opa2 = lv_sqrt(LV_OPA_100 * LV_OPA_100 * r_act_sqr) - LV_OPA_100 * (r_in - 1);
-                if(opa2 < LV_OPA_0)
-                    opa2 = LV_OPA_0;
-                else if(opa2 > LV_OPA_100)
-                    opa2 = LV_OPA_100;
-                if(r_act_sqr < r_in_aa_sqr)
-                    break; /*No need to continue the iteration in x once we found the inner edge of the
-                              arc*/
-            }
-            if(opa2 != -1) {
-                if(deg_test(180 + deg_base, start_angle, end_angle)) {
-                    lv_draw_px(center_x + xi, center_y + yi, mask, color, opa2);
-                }
-                if(deg_test(360 - deg_base, start_angle, end_angle)) {
-                    lv_draw_px(center_x + xi, center_y - yi, mask, color, opa2);
-                }
-                if(deg_test(180 - deg_base, start_angle, end_angle)) {
-                    lv_draw_px(center_x - xi, center_y + yi, mask, color, opa2);
-                }
-                if(deg_test(deg_base, start_angle, end_angle)) {
-                    lv_draw_px(center_x - xi, center_y - yi, mask, color, opa2);
-                }
-                continue;
-            }
-#endif
+    /*The round ends*/
+    if(arc->rounded) {
+        int32_t cap_ext = arc->cap_r + ARC_FRACT_HALF + ARC_MARGIN;
+        uint8_t i;
+        for(i = 0; i < 2; i++) {
+            if(y_fract < arc->cap_y[i] - cap_ext || y_fract > arc->cap_y[i] + cap_ext) continue;
+            range_x1[range_cnt] = (arc->cap_x[i] - cap_ext) >> ARC_FRACT_SHIFT;
+            range_x2[range_cnt] = (arc->cap_x[i] + cap_ext + ARC_FRACT_ONE - 1) >> ARC_FRACT_SHIFT;
+            range_cnt++;
+        }
+    }
 
-            deg = 180 + deg_base;
-            if(deg_test(deg, start_angle, end_angle)) {
-                if(x_start[0] == LV_COORD_MIN) x_start[0] = xi;
-            } else if(x_start[0] != LV_COORD_MIN && x_end[0] == LV_COORD_MIN) {
-                x_end[0] = xi - 1;
-            }
+    /*Check the ranges in the mask from left to right. Overlapping ranges are checked once.*/
+    lv_coord_t x_next = x_min;
+    while(1) {
+        /*Find the range starting first*/
+        int8_t first = -1;
+        uint8_t i;
+        for(i = 0; i < range_cnt; i++) {
+            if(range_x2[i] < x_next || range_x1[i] > range_x2[i]) continue;
+            if(first < 0 || range_x1[i] < range_x1[first]) first = i;
+        }
+        if(first < 0) break;
 
-            deg = 360 - deg_base;
-            if(deg_test(deg, start_angle, end_angle)) {
-                if(x_start[1] == LV_COORD_MIN) x_start[1] = xi;
-            } else if(x_start[1] != LV_COORD_MIN && x_end[1] == LV_COORD_MIN) {
-                x_end[1] = xi - 1;
-            }
+        lv_coord_t x1 = LV_MATH_MAX(range_x1[first], x_next);
+        lv_coord_t x2 = LV_MATH_MIN(range_x2[first], x_max);
+        range_x2[first] = LV_COORD_MIN; /*Mark as processed*/
+        if(x1 > x2) continue;
 
-            deg = 180 - deg_base;
-            if(deg_test(deg, start_angle, end_angle)) {
-                if(x_start[2] == LV_COORD_MIN) x_start[2] = xi;
-            } else if(x_start[2] != LV_COORD_MIN && x_end[2] == LV_COORD_MIN) {
-                x_end[2] = xi - 1;
-            }
+        arc_cov_range(arc, y, x1, x2, ring_in_x1, ring_in_x2, &cov[x1 - x_min]);
 
-            deg = deg_base;
-            if(deg_test(deg, start_angle, end_angle)) {
-                if(x_start[3] == LV_COORD_MIN) x_start[3] = xi;
-            } else if(x_start[3] != LV_COORD_MIN && x_end[3] == LV_COORD_MIN) {
-                x_end[3] = xi - 1;
-            }
+        if(*x1_res > *x2_res) *x1_res = x1;
+        *x2_res = x2;
+        x_next  = x2 + 1;
+    }
+}
 
-            if(r_act_sqr < r_in_sqr) {
-                xe = xi;
-                break; /*No need to continue the iteration in x once we found the inner edge of the
-                          arc*/
-            }
+/**
+ * Calculate the coverage of some pixels in a row of an arc
+ * @param arc pointer to an arc descriptor
+ * @param y the row relative to the center
+ * @param x1 the first pixel relative to the center
+ * @param x2 the last pixel relative to the center
+ * @param in_x1 the pixels between `in_x1` and `in_x2` and between `-in_x2` and `-in_x1` are in the ring
+ * @param in_x2 see `in_x1`
+ * @param cov coverage of the pixels from `x1`
+ */
+static void arc_cov_range(const arc_dsc_t * arc, lv_coord_t y, lv_coord_t x1, lv_coord_t x2, lv_coord_t in_x1,
+                          lv_coord_t in_x2, lv_opa_t * cov)
+{
+    int32_t y_fract = (int32_t)y << ARC_FRACT_SHIFT;
+
+    /*Distance from the lines of the start and end angle. Positive on the side of the arc. [1/LV_TRIGO_SIN_MAX px]*/
+    int32_t side_start = arc->start_cos * x1 - arc->start_sin * y;
+    int32_t side_end   = arc->end_sin * y - arc->end_cos * x1;
+
+    lv_coord_t x;
+    for(x = x1; x <= x2; x++, side_start += arc->start_cos, side_end -= arc->end_cos) {
+        int32_t x_fract = (int32_t)x << ARC_FRACT_SHIFT;
+
+        /*Signed distance from the edge. Negative inside.*/
+        int32_t dist;
+        lv_coord_t x_abs = LV_MATH_ABS(x);
+        if(x_abs >= in_x1 && x_abs <= in_x2) {
+            dist = -ARC_FRACT_ONE;
+        } else {
+            int32_t r = dist_get(x_fract, y_fract);
+            dist      = LV_MATH_MAX(r - arc->r_out, arc->r_in - r);
         }
 
-        if(x_start[0] != LV_COORD_MIN) {
-            if(x_end[0] == LV_COORD_MIN) x_end[0] = xe - 1;
-            hor_line(center_x + x_start[0], center_y + yi, mask, x_end[0] - x_start[0], color, opa);
+        if(arc->wedge != ARC_WEDGE_NONE) {
+            int32_t out_start = -(side_start >> (LV_TRIGO_SHIFT - ARC_FRACT_SHIFT));
+            int32_t out_end   = -(side_end >> (LV_TRIGO_SHIFT - ARC_FRACT_SHIFT));
+            int32_t out_wedge;
+            if(arc->wedge == ARC_WEDGE_AND) out_wedge = LV_MATH_MAX(out_start, out_end);
+            else out_wedge = LV_MATH_MIN(out_start, out_end);
+            dist = LV_MATH_MAX(dist, out_wedge);
         }
 
-        if(x_start[1] != LV_COORD_MIN) {
-            if(x_end[1] == LV_COORD_MIN) x_end[1] = xe - 1;
-            hor_line(center_x + x_start[1], center_y - yi, mask, x_end[1] - x_start[1], color, opa);
+        if(arc->rounded && dist > -ARC_FRACT_HALF) {
+            int32_t cap_ext = arc->cap_r + ARC_FRACT_HALF;
+            uint8_t i;
+            for(i = 0; i < 2; i++) {
+                int32_t dx = x_fract - arc->cap_x[i];
+                int32_t dy = y_fract - arc->cap_y[i];
+                if(LV_MATH_ABS(dx) >= cap_ext || LV_MATH_ABS(dy) >= cap_ext) continue;
+                dist = LV_MATH_MIN(dist, dist_get(dx, dy) - arc->cap_r);
+            }
         }
 
-        if(x_start[2] != LV_COORD_MIN) {
-            if(x_end[2] == LV_COORD_MIN) x_end[2] = xe - 1;
-            hor_line(center_x - x_end[2], center_y + yi, mask, LV_MATH_ABS(x_end[2] - x_start[2]), color, opa);
-        }
+        /*A pixel whose center is on the edge is half covered*/
+        int32_t c;
+        if(arc->aa) c = ARC_FRACT_HALF - dist;
+        else c = dist < 0 ? ARC_FRACT_ONE : 0;
 
-        if(x_start[3] != LV_COORD_MIN) {
-            if(x_end[3] == LV_COORD_MIN) x_end[3] = xe - 1;
-            hor_line(center_x - x_end[3], center_y - yi, mask, LV_MATH_ABS(x_end[3] - x_start[3]), color, opa);
-        }
+        if(c <= 0) continue;
+        cov[x - x1] = c >= ARC_FRACT_ONE ? LV_OPA_COVER : (lv_opa_t)((c * LV_OPA_COVER) >> ARC_FRACT_SHIFT);
     }
 }
 
-/**********************
- *   STATIC FUNCTIONS
- **********************/
-static void ver_line(lv_coord_t x, lv_coord_t y, const lv_area_t * mask, lv_coord_t len, lv_color_t color, lv_opa_t opa)
+/**
+ * Limit a range of a row to the side of an angle's line where a pixel can be in the arc
+ * @param side the distance of pixel 0 from the line [1/LV_TRIGO_SIN_MAX px]
+ * @param side_step change of the distance per pixel
+ * @param x1 pointer to the first pixel of the range. Increased if required.
+ * @param x2 pointer to the last pixel of the range. Decreased if required.
+ */
+static void wedge_limit(int32_t side, int32_t side_step, lv_coord_t * x1, lv_coord_t * x2)
 {
-    lv_area_t area;
-    lv_area_set(&area, x, y, x, y + len);
-
-    lv_draw_fill(&area, mask, color, opa);
+    /*The pixels at least this far on the other side are surely not covered*/
+    int32_t lim = -((int32_t)(ARC_FRACT_HALF + ARC_MARGIN) << (LV_TRIGO_SHIFT - ARC_FRACT_SHIFT));
+
+    /*side + x * side_step >= lim*/
+    if(side_step == 0) {
+        if(side < lim) *x2 = *x1 - 1;
+    } else if(side_step > 0) {
+        int32_t n = lim - side;
+        lv_coord_t x_lim = n >= 0 ? (n + side_step - 1) / side_step : -((-n) / side_step);
+        if(*x1 < x_lim) *x1 = x_lim;
+    } else {
+        int32_t n = side - lim;
+        lv_coord_t x_lim = n >= 0 ? n / (-side_step) : -((-n - side_step - 1) / (-side_step));
+        if(*x2 > x_lim) *x2 = x_lim;
+    }
 }
 
-static void hor_line(lv_coord_t x, lv_coord_t y, const lv_area_t * mask, lv_coord_t len, lv_color_t color, lv_opa_t opa)
+/**
+ * Get the half length of a circle's chord on a row
+ * @param r radius of the circle [1/ARC_FRACT_ONE px]
+ * @param y the row relative to the center [1/ARC_FRACT_ONE px]
+ * @return the half length of the chord [1/ARC_FRACT_ONE px] or -1 if the row doesn't cross the circle
+ */
+static int32_t row_half_len(int32_t r, int32_t y)
 {
-    lv_area_t area;
-    lv_area_set(&area, x, y, x + len, y);
+    if(y < 0) y = -y;
+    if(r <= 0 || y >= r) return -1;
+
+    /*Avoid overflow with large circles*/
+    uint8_t shift = 0;
+    while(r > 0x7FFF) {
+        r >>= 1;
+        y >>= 1;
+        shift++;
+    }
 
-    lv_draw_fill(&area, mask, color, opa);
+    return (int32_t)(lv_sqrt((uint32_t)(r * r) - (uint32_t)(y * y)) << shift);
 }
 
-static bool deg_test_norm(uint16_t deg, uint16_t start, uint16_t end)
+/**
+ * Get the distance of a point from the origo
+ * @param x x coordinate of the point [1/ARC_FRACT_ONE px]
+ * @param y y coordinate of the point [1/ARC_FRACT_ONE px]
+ * @return the distance [1/ARC_FRACT_ONE px]
+ */
+static int32_t dist_get(int32_t x, int32_t y)
 {
-    if(deg >= start && deg <= end)
-        return true;
-    else
-        return false;
-}
+    if(x < 0) x = -x;
+    if(y < 0) y = -y;
+
+    /*Avoid overflow with large distances*/
+    uint8_t shift = 0;
+    while(x > 0x7FFF || y > 0x7FFF) {
+        x >>= 1;
+        y >>= 1;
+        shift++;
+    }
 
-static bool deg_test_inv(uint16_t deg, uint16_t start, uint16_t end)
-{
-    if(deg >= start || deg <= end) {
-        return true;
-    } else
-        return false;
+    return (int32_t)(lv_sqrt((uint32_t)(x * x) + (uint32_t)(y * y)) << shift);
 }
@@ -0,0 +1,64 @@
+/**
+ * @file lv_draw_backend.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_draw_backend.h"
+#include "../lv_core/lv_refr.h"
+#include "../lv_hal/lv_hal_disp.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+/**
+ * Get the draw backend of the display which is being refreshed
+ * @return the draw backend set in the display driver or `lv_draw_backend_sw`
+ */
+const lv_draw_backend_t * lv_draw_backend_get_act(void)
+{
+    lv_disp_t * disp = lv_refr_get_disp_refreshing();
+    if(disp && disp->driver.draw_backend) return disp->driver.draw_backend;
+
+    return &lv_draw_backend_sw;
+}
+
+/**
+ * Wait until the draw backend of the display which is being refreshed finishes every operation.
+ * Required before accessing the display buffer directly.
+ */
+void lv_draw_backend_wait(void)
+{
+    lv_disp_t * disp = lv_refr_get_disp_refreshing();
+    if(disp == NULL) return;
+
+    const lv_draw_backend_t * backend = disp->driver.draw_backend;
+    if(backend && backend->wait) backend->wait(&disp->driver);
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
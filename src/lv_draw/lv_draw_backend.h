@@ -0,0 +1,108 @@
+/**
+ * @file lv_draw_backend.h
+ *
+ */
+
+#ifndef LV_DRAW_BACKEND_H
+#define LV_DRAW_BACKEND_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#ifdef LV_CONF_INCLUDE_SIMPLE
+#include "lv_conf.h"
+#else
+#include "../../../lv_conf.h"
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "../lv_font/lv_font.h"
+#include "../lv_misc/lv_color.h"
+#include "../lv_misc/lv_area.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+struct _disp_drv_t;
+
+/**
+ * Pixel operations of a draw backend.
+ * The `lv_draw_...` functions clip the drawings and call these functions to write the pixels.
+ * Every operation gets the display driver, the buffer to draw (usually the display buffer, but can be a layer too)
+ * and the width of the buffer. The areas are relative to the buffer and are already clipped.
+ * The source data (`src`, `mask`, `bitmap`, `map`) might be reused by the caller after an operation returns
+ * so it needs to be used (or copied) before returning. Writing the buffer can be finished later, see `wait`.
+ */
+typedef struct _lv_draw_backend_t
+{
+    /** Fill an area with a color*/
+    void (*fill)(struct _disp_drv_t * drv, lv_color_t * buf, lv_coord_t buf_w, const lv_area_t * area,
+                 lv_color_t color, lv_opa_t opa);
+
+    /** Blend a color map to an area. `src` is the first pixel for `area` and its width is `src_w`*/
+    void (*blend)(struct _disp_drv_t * drv, lv_color_t * buf, lv_coord_t buf_w, const lv_area_t * area,
+                  const lv_color_t * src, lv_coord_t src_w, lv_opa_t opa);
+
+    /** Fill an area with a color using the coverage of the pixels (E.g. for anti-aliased shapes).
+     * `mask` is the coverage of the first pixel of `area` and its width is `mask_w`*/
+    void (*fill_mask)(struct _disp_drv_t * drv, lv_color_t * buf, lv_coord_t buf_w, const lv_area_t * area,
+                      const lv_opa_t * mask, lv_coord_t mask_w, lv_color_t color, lv_opa_t opa);
+
+    /** Draw a glyph of a font. `pos` is the top left corner of the glyph's box,
+     * `area` is the part of the box to draw. With `subpx` every pixel has 3 values (R, G, B coverage) in `bitmap`
+     * and `area` can be 1 pixel wider than the box on both sides for the color filter.*/
+    void (*glyph)(struct _disp_drv_t * drv, lv_color_t * buf, lv_coord_t buf_w, const lv_area_t * area,
+                  const lv_point_t * pos, const lv_font_glyph_dsc_t * g, const uint8_t * bitmap, bool subpx,
+                  lv_color_t color, lv_opa_t opa);
+
+    /** Draw an image with alpha byte, chroma keying and/or recoloring.
+     * `map` is the first pixel for `area` and the width of the image is `map_w`*/
+    void (*map)(struct _disp_drv_t * drv, lv_color_t * buf, lv_coord_t buf_w, const lv_area_t * area,
+                const uint8_t * map, lv_coord_t map_w, lv_opa_t opa, bool chroma_key, bool alpha_byte,
+                lv_color_t recolor, lv_opa_t recolor_opa);
+
+    /** OPTIONAL: Wait until the previous operations have written the pixels.
+     * Called before the buffer is accessed directly (e.g. flushed). NULL if every operation is synchronous.*/
+    void (*wait)(struct _disp_drv_t * drv);
+} lv_draw_backend_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Get the draw backend of the display which is being refreshed
+ * @return the draw backend set in the display driver or `lv_draw_backend_sw`
+ */
+const lv_draw_backend_t * lv_draw_backend_get_act(void);
+
+/**
+ * Wait until the draw backend of the display which is being refreshed finishes every operation.
+ * Required before accessing the display buffer directly.
+ */
+void lv_draw_backend_wait(void);
+
+/**********************
+ *      MACROS
+ **********************/
+
+/*********************
+ *   POST INCLUDES
+ *********************/
+#include "lv_draw_sw.h"
+#include "lv_draw_thread.h"
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /*LV_DRAW_BACKEND_H*/
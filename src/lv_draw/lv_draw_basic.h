@@ -45,6 +45,19 @@ void lv_draw_px(lv_coord_t x, lv_coord_t y, const lv_area_t * mask_p, lv_color_t
  */
 void lv_draw_fill(const lv_area_t * cords_p, const lv_area_t * mask_p, lv_color_t color, lv_opa_t opa);
 
+/**
+ * Draw a row of pixels with different coverage (e.g. a row of an anti-aliased shape)
+ * @param x x coordinate of the first pixel
+ * @param y y coordinate of the row
+ * @param len number of pixels
+ * @param cov coverage of the pixels (`LV_OPA_COVER`: fully covered, `LV_OPA_TRANSP`: not covered)
+ * @param mask_p draw only on this area (truncated to VDB area)
+ * @param color color of the pixels
+ * @param opa opacity of the fully covered pixels
+ */
+void lv_draw_cov_row(lv_coord_t x, lv_coord_t y, lv_coord_t len, const lv_opa_t * cov, const lv_area_t * mask_p,
+                     lv_color_t color, lv_opa_t opa);
+
 /**
  * Draw a letter in the Virtual Display Buffer
  * @param pos_p left-top coordinate of the latter
@@ -71,6 +84,25 @@ void lv_draw_letter(const lv_point_t * pos_p, const lv_area_t * mask_p, const lv
 void lv_draw_map(const lv_area_t * cords_p, const lv_area_t * mask_p, const uint8_t * map_p, lv_opa_t opa,
                  bool chroma_key, bool alpha_byte, lv_color_t recolor, lv_opa_t recolor_opa);
 
+/**
+ * Draw an indexed or alpha only map (image) with 1, 2, 4 or 8 bit per pixel.
+ * The pixels are decoded and blended in one step without a line buffer.
+ * @param cords_p coordinates the map
+ * @param mask_p the map will drawn only on this area  (truncated to VDB area)
+ * @param map_p pointer to the indices or alpha values. Every row starts on a new byte.
+ * @param bpp bit per pixel: 1, 2, 4 or 8
+ * @param palette colors of the indices. NULL for alpha only maps.
+ * @param palette_opa opacity of the indices. NULL for alpha only maps.
+ * @param color color of the alpha only maps
+ * @param opa opacity of the map
+ * @param chroma_keyed true: enable transparency of LV_IMG_LV_COLOR_TRANSP color pixels
+ * @param recolor mix the pixels with this color
+ * @param recolor_opa the intense of recoloring
+ */
+void lv_draw_map_indexed(const lv_area_t * cords_p, const lv_area_t * mask_p, const uint8_t * map_p, uint8_t bpp,
+                         const lv_color_t * palette, const lv_opa_t * palette_opa, lv_color_t color, lv_opa_t opa,
+                         bool chroma_key, lv_color_t recolor, lv_opa_t recolor_opa);
+
 /**********************
  *      MACROS
  **********************/
@@ -0,0 +1,142 @@
+/**
+ * @file lv_draw_grad.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include <string.h>
+#include "lv_draw_grad.h"
+#include "../lv_core/lv_debug.h"
+#include "../lv_misc/lv_mem.h"
+#include "../lv_misc/lv_gc.h"
+
+#if defined(LV_GC_INCLUDE)
+#include LV_GC_INCLUDE
+#endif /* LV_ENABLE_GC */
+
+/*********************
+ *      DEFINES
+ *********************/
+#if LV_GRAD_CACHE_NUM < 1
+#error "LV_GRAD_CACHE_NUM must be >= 1. See lv_conf.h"
+#endif
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef struct
+{
+    lv_color_t * colors;
+    uint32_t last_use; /*Value of `use_cnt` when last used. 0: free entry*/
+    uint16_t len;
+    uint16_t size; /*Number of allocated colors in `colors`*/
+    lv_color_t main_color;
+    lv_color_t grad_color;
+} lv_grad_cache_entry_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static uint32_t use_cnt;
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+/**
+ * Get the colors of a gradient. They are calculated only if the gradient is not cached yet.
+ * @param main_color color of the first pixel
+ * @param grad_color the last pixel's color is `grad_color`
+ * @param len length of the gradient in pixels
+ * @return pointer to `len` colors or NULL if there was no memory.
+ *         Valid until `LV_GRAD_CACHE_NUM` other gradients are requested.
+ */
+const lv_color_t * lv_draw_grad_get(lv_color_t main_color, lv_color_t grad_color, uint16_t len)
+{
+    if(len == 0) return NULL;
+
+    if(LV_GC_ROOT(_lv_grad_cache) == NULL) {
+        LV_GC_ROOT(_lv_grad_cache) = lv_mem_alloc(sizeof(lv_grad_cache_entry_t) * LV_GRAD_CACHE_NUM);
+        LV_ASSERT_MEM(LV_GC_ROOT(_lv_grad_cache));
+        if(LV_GC_ROOT(_lv_grad_cache) == NULL) return NULL;
+        memset(LV_GC_ROOT(_lv_grad_cache), 0, sizeof(lv_grad_cache_entry_t) * LV_GRAD_CACHE_NUM);
+    }
+
+    lv_grad_cache_entry_t * cache = LV_GC_ROOT(_lv_grad_cache);
+
+    /*Restart the counting before it overflows. Entries used before will look old.*/
+    if(use_cnt == UINT32_MAX) {
+        uint16_t i;
+        for(i = 0; i < LV_GRAD_CACHE_NUM; i++) {
+            if(cache[i].last_use) cache[i].last_use = 1;
+        }
+        use_cnt = 1;
+    }
+    use_cnt++;
+
+    /*Find the gradient or the least recently used entry*/
+    lv_grad_cache_entry_t * entry = &cache[0];
+    uint16_t i;
+    for(i = 0; i < LV_GRAD_CACHE_NUM; i++) {
+        if(cache[i].last_use && cache[i].len == len && cache[i].main_color.full == main_color.full &&
+           cache[i].grad_color.full == grad_color.full) {
+            cache[i].last_use = use_cnt;
+            return cache[i].colors;
+        }
+
+        if(cache[i].last_use < entry->last_use) entry = &cache[i];
+    }
+
+    /*Not cached: calculate it into the least recently used entry*/
+    if(entry->size < len) {
+        lv_color_t * colors = lv_mem_realloc(entry->colors, len * sizeof(lv_color_t));
+        LV_ASSERT_MEM(colors);
+        if(colors == NULL) return NULL;
+        entry->colors = colors;
+        entry->size   = len;
+    }
+
+    /*The same mixing as the rows of the vertical gradients had before*/
+    for(i = 0; i < len; i++) {
+        uint8_t mix      = (uint32_t)((uint32_t)(len - 1 - i) * 255) / len;
+        entry->colors[i] = lv_color_mix(main_color, grad_color, mix);
+    }
+
+    entry->main_color = main_color;
+    entry->grad_color = grad_color;
+    entry->len        = len;
+    entry->last_use   = use_cnt;
+
+    return entry->colors;
+}
+
+/**
+ * Free the cached gradients
+ */
+void lv_draw_grad_cache_free(void)
+{
+    lv_grad_cache_entry_t * cache = LV_GC_ROOT(_lv_grad_cache);
+    if(cache == NULL) return;
+
+    uint16_t i;
+    for(i = 0; i < LV_GRAD_CACHE_NUM; i++) {
+        if(cache[i].colors) lv_mem_free(cache[i].colors);
+    }
+
+    lv_mem_free(cache);
+    LV_GC_ROOT(_lv_grad_cache) = NULL;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
@@ -0,0 +1,60 @@
+/**
+ * @file lv_draw_grad.h
+ *
+ */
+
+#ifndef LV_DRAW_GRAD_H
+#define LV_DRAW_GRAD_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#ifdef LV_CONF_INCLUDE_SIMPLE
+#include "lv_conf.h"
+#else
+#include "../../../lv_conf.h"
+#endif
+
+#include <stdint.h>
+#include "../lv_misc/lv_color.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Get the colors of a gradient. They are calculated only if the gradient is not cached yet.
+ * @param main_color color of the first pixel
+ * @param grad_color the last pixel's color is `grad_color`
+ * @param len length of the gradient in pixels
+ * @return pointer to `len` colors or NULL if there was no memory.
+ *         Valid until `LV_GRAD_CACHE_NUM` other gradients are requested.
+ */
+const lv_color_t * lv_draw_grad_get(lv_color_t main_color, lv_color_t grad_color, uint16_t len);
+
+/**
+ * Free the cached gradients
+ */
+void lv_draw_grad_cache_free(void);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /*LV_DRAW_GRAD_H*/
@@ -8,8 +8,11 @@
  *********************/
 #include "lv_draw_img.h"
 #include "lv_img_cache.h"
+#include "../lv_core/lv_refr.h"
 #include "../lv_misc/lv_log.h"
 #include "../lv_misc/lv_mem.h"
+#include "../lv_misc/lv_math.h"
+#include "lv_draw_list.h"
 
 /*********************
  *      DEFINES
@@ -23,7 +26,13 @@
  *  STATIC PROTOTYPES
  **********************/
 static lv_res_t lv_img_draw_core(const lv_area_t * coords, const lv_area_t * mask, const void * src,
-                                 const lv_style_t * style, lv_opa_t opa_scale);
+                                 const lv_style_t * style, lv_opa_t opa_scale, int16_t angle, uint16_t zoom,
+                                 const lv_point_t * pivot, bool antialias);
+static lv_res_t lv_img_draw_transformed_core(const lv_area_t * coords, const lv_area_t * mask,
+                                             lv_img_cache_entry_t * cdsc, const lv_style_t * style, lv_opa_t opa,
+                                             int16_t angle, uint16_t zoom, const lv_point_t * pivot,
+                                             bool antialias);
+static uint8_t * get_block_buf(lv_coord_t width, uint8_t px_size, lv_coord_t * block_h);
 
 /**********************
  *  STATIC VARIABLES
@@ -47,21 +56,48 @@ static lv_res_t lv_img_draw_core(const lv_area_t * coords, const lv_area_t * mas
  */
 void lv_draw_img(const lv_area_t * coords, const lv_area_t * mask, const void * src, const lv_style_t * style,
                  lv_opa_t opa_scale)
+{
+    lv_draw_img_transformed(coords, mask, src, style, opa_scale, 0, LV_IMG_ZOOM_NONE, NULL, false);
+}
+
+/**
+ * Draw a rotated and/or zoomed image
+ * @param coords the coordinates of the not transformed image
+ * @param mask the image will be drawn only in this area
+ * @param src pointer to a lv_color_t array which contains the pixels of the image
+ * @param style style of the image
+ * @param opa_scale scale down all opacities by the factor
+ * @param angle rotation angle clockwise [0.1 degree]
+ * @param zoom zoom factor: 256 (LV_IMG_ZOOM_NONE): no zoom, 128: half size, 512: double size
+ * @param pivot rotate and zoom around this point of the image (relative to `coords`).
+ *              NULL to use the center of the image.
+ * @param antialias true: use bilinear filtering; false: nearest neighbour
+ */
+void lv_draw_img_transformed(const lv_area_t * coords, const lv_area_t * mask, const void * src,
+                             const lv_style_t * style, lv_opa_t opa_scale, int16_t angle, uint16_t zoom,
+                             const lv_point_t * pivot, bool antialias)
 {
     if(src == NULL) {
         LV_LOG_WARN("Image draw: src is NULL");
         lv_draw_rect(coords, mask, &lv_style_plain, LV_OPA_COVER);
-        lv_draw_label(coords, mask, &lv_style_plain, LV_OPA_COVER, "No\ndata", LV_TXT_FLAG_NONE, NULL, NULL, NULL, LV_BIDI_DIR_LTR);
+        lv_draw_label(coords, mask, &lv_style_plain, LV_OPA_COVER, "No\ndata", LV_TXT_FLAG_NONE, NULL, NULL, NULL, NULL, LV_BIDI_DIR_LTR);
+        return;
+    }
+
+#if LV_USE_DRAW_LIST
+    if(lv_draw_list_is_recording()) {
+        lv_draw_list_add_img(coords, mask, src, style, opa_scale, angle, zoom, pivot, antialias);
         return;
     }
+#endif
 
     lv_res_t res;
-    res = lv_img_draw_core(coords, mask, src, style, opa_scale);
+    res = lv_img_draw_core(coords, mask, src, style, opa_scale, angle, zoom, pivot, antialias);
 
     if(res == LV_RES_INV) {
         LV_LOG_WARN("Image draw error");
         lv_draw_rect(coords, mask, &lv_style_plain, LV_OPA_COVER);
-        lv_draw_label(coords, mask, &lv_style_plain, LV_OPA_COVER, "No\ndata", LV_TXT_FLAG_NONE, NULL,  NULL, NULL, LV_BIDI_DIR_LTR);
+        lv_draw_label(coords, mask, &lv_style_plain, LV_OPA_COVER, "No\ndata", LV_TXT_FLAG_NONE, NULL,  NULL, NULL, NULL, LV_BIDI_DIR_LTR);
         return;
     }
 }
@@ -362,7 +398,7 @@ void lv_img_buf_set_palette(lv_img_dsc_t * dsc, uint8_t id, lv_color_t c)
 }
 
 /**
- * Get the pixel size of a color format in bits
+ * Get the pixel size of a color format in bits. (The size of the decoded pixels for compressed formats)
  * @param cf a color format (`LV_IMG_CF_...`)
  * @return the pixel size in bits
  */
@@ -374,8 +410,11 @@ uint8_t lv_img_color_format_get_px_size(lv_img_cf_t cf)
         case LV_IMG_CF_UNKNOWN:
         case LV_IMG_CF_RAW: px_size = 0; break;
         case LV_IMG_CF_TRUE_COLOR:
-        case LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED: px_size = LV_COLOR_SIZE; break;
-        case LV_IMG_CF_TRUE_COLOR_ALPHA: px_size = LV_IMG_PX_SIZE_ALPHA_BYTE << 3; break;
+        case LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED:
+        case LV_IMG_CF_TRUE_COLOR_RLE:
+        case LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED_RLE: px_size = LV_COLOR_SIZE; break;
+        case LV_IMG_CF_TRUE_COLOR_ALPHA:
+        case LV_IMG_CF_TRUE_COLOR_ALPHA_RLE: px_size = LV_IMG_PX_SIZE_ALPHA_BYTE << 3; break;
         case LV_IMG_CF_INDEXED_1BIT:
         case LV_IMG_CF_ALPHA_1BIT: px_size = 1; break;
         case LV_IMG_CF_INDEXED_2BIT:
@@ -401,6 +440,7 @@ bool lv_img_color_format_is_chroma_keyed(lv_img_cf_t cf)
 
     switch(cf) {
         case LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED:
+        case LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED_RLE:
         case LV_IMG_CF_RAW_CHROMA_KEYED:
 #if LV_INDEXED_CHROMA
         case LV_IMG_CF_INDEXED_1BIT:
@@ -427,6 +467,7 @@ bool lv_img_color_format_has_alpha(lv_img_cf_t cf)
 
     switch(cf) {
         case LV_IMG_CF_TRUE_COLOR_ALPHA:
+        case LV_IMG_CF_TRUE_COLOR_ALPHA_RLE:
         case LV_IMG_CF_RAW_ALPHA:
         case LV_IMG_CF_INDEXED_1BIT:
         case LV_IMG_CF_INDEXED_2BIT:
@@ -538,12 +579,34 @@ uint32_t lv_img_buf_get_img_size(lv_coord_t w, lv_coord_t h, lv_img_cf_t cf)
  **********************/
 
 static lv_res_t lv_img_draw_core(const lv_area_t * coords, const lv_area_t * mask, const void * src,
-                                 const lv_style_t * style, lv_opa_t opa_scale)
+                                 const lv_style_t * style, lv_opa_t opa_scale, int16_t angle, uint16_t zoom,
+                                 const lv_point_t * pivot, bool antialias)
 {
+    bool transformed = angle % 3600 != 0 || zoom != LV_IMG_ZOOM_NONE;
+
+    lv_point_t pivot_center;
+    if(pivot == NULL) {
+        pivot_center.x = lv_area_get_width(coords) / 2;
+        pivot_center.y = lv_area_get_height(coords) / 2;
+        pivot          = &pivot_center;
+    }
+
+    /*The transformed image can be out of its original coordinates*/
+    lv_area_t coords_tr;
+    if(transformed) {
+        lv_img_transform_get_area(&coords_tr, lv_area_get_width(coords), lv_area_get_height(coords), angle, zoom,
+                                  pivot);
+        coords_tr.x1 += coords->x1;
+        coords_tr.y1 += coords->y1;
+        coords_tr.x2 += coords->x1;
+        coords_tr.y2 += coords->y1;
+    } else {
+        lv_area_copy(&coords_tr, coords);
+    }
 
     lv_area_t mask_com; /*Common area of mask and coords*/
     bool union_ok;
-    union_ok = lv_area_intersect(&mask_com, mask, coords);
+    union_ok = lv_area_intersect(&mask_com, mask, &coords_tr);
     if(union_ok == false) {
         return LV_RES_OK; /*Out of mask. There is nothing to draw so the image is drawn
                              successfully.*/
@@ -558,11 +621,18 @@ static lv_res_t lv_img_draw_core(const lv_area_t * coords, const lv_area_t * mas
 
     bool chroma_keyed = lv_img_color_format_is_chroma_keyed(cdsc->dec_dsc.header.cf);
     bool alpha_byte   = lv_img_color_format_has_alpha(cdsc->dec_dsc.header.cf);
+    const uint8_t * map;
+    const lv_color_t * palette;
+    const lv_opa_t * palette_opa;
 
     if(cdsc->dec_dsc.error_msg != NULL) {
         LV_LOG_WARN("Image draw error");
         lv_draw_rect(coords, mask, &lv_style_plain, LV_OPA_COVER);
-        lv_draw_label(coords, mask, &lv_style_plain, LV_OPA_COVER, cdsc->dec_dsc.error_msg, LV_TXT_FLAG_NONE, NULL, NULL, NULL, LV_BIDI_DIR_LTR);
+        lv_draw_label(coords, mask, &lv_style_plain, LV_OPA_COVER, cdsc->dec_dsc.error_msg, LV_TXT_FLAG_NONE, NULL, NULL, NULL, NULL, LV_BIDI_DIR_LTR);
+    }
+    /* The transformed images are sampled from the memory*/
+    else if(transformed) {
+        return lv_img_draw_transformed_core(coords, &mask_com, cdsc, style, opa, angle, zoom, pivot, antialias);
     }
     /* The decoder open could open the image and gave the entire uncompressed image.
      * Just draw it!*/
@@ -570,32 +640,155 @@ static lv_res_t lv_img_draw_core(const lv_area_t * coords, const lv_area_t * mas
         lv_draw_map(coords, mask, cdsc->dec_dsc.img_data, opa, chroma_keyed, alpha_byte, style->image.color,
                     style->image.intense);
     }
-    /* The whole uncompressed image is not available. Try to read it line-by-line*/
+    /* Indexed and alpha only images in the memory are decoded and drawn in one step*/
+    else if(lv_img_decoder_get_indexed_map(&cdsc->dec_dsc, &map, &palette, &palette_opa) == LV_RES_OK) {
+        lv_draw_map_indexed(coords, mask, map, lv_img_color_format_get_px_size(cdsc->dec_dsc.header.cf), palette,
+                            palette_opa, style->image.color, opa, chroma_keyed, style->image.color,
+                            style->image.intense);
+    }
+    /* The whole uncompressed image is not available.
+     * Read it in blocks of lines to set up the decoding and drawing only once per block*/
     else {
-        lv_coord_t width = lv_area_get_width(&mask_com);
+        lv_coord_t width     = lv_area_get_width(&mask_com);
+        lv_coord_t height    = lv_area_get_height(&mask_com);
+        lv_coord_t block_h   = height < LV_IMG_DRAW_AREA_MAX_LINES ? height : LV_IMG_DRAW_AREA_MAX_LINES;
+        uint8_t px_size_byte = lv_img_decoder_get_px_size(&cdsc->dec_dsc);
+
+        uint8_t * buf = get_block_buf(width, px_size_byte, &block_h);
+        if(buf == NULL) {
+            LV_LOG_WARN("Image draw: not enough memory to read a line");
+            return LV_RES_INV;
+        }
 
-        uint8_t  * buf = lv_draw_get_buf(lv_area_get_width(&mask_com) * LV_IMG_PX_SIZE_ALPHA_BYTE);  /*space for the possible alpha byte*/
+        lv_area_t block;       /*The block on the screen*/
+        lv_area_t block_img;   /*The same block relative to the image*/
+        block.x1     = mask_com.x1;
+        block.x2     = mask_com.x2;
+        block_img.x1 = mask_com.x1 - coords->x1;
+        block_img.x2 = mask_com.x2 - coords->x1;
 
-        lv_area_t line;
-        lv_area_copy(&line, &mask_com);
-        lv_area_set_height(&line, 1);
-        lv_coord_t x = mask_com.x1 - coords->x1;
-        lv_coord_t y = mask_com.y1 - coords->y1;
-        lv_coord_t row;
         lv_res_t read_res;
-        for(row = mask_com.y1; row <= mask_com.y2; row++) {
-            read_res = lv_img_decoder_read_line(&cdsc->dec_dsc, x, y, width, buf);
+        lv_coord_t row;
+        for(row = mask_com.y1; row <= mask_com.y2; row += block_h) {
+            block.y1 = row;
+            block.y2 = LV_MATH_MIN(row + block_h - 1, mask_com.y2);
+            block_img.y1 = block.y1 - coords->y1;
+            block_img.y2 = block.y2 - coords->y1;
+
+            read_res = lv_img_decoder_read_area(&cdsc->dec_dsc, &block_img, buf);
             if(read_res != LV_RES_OK) {
-                lv_img_decoder_close(&cdsc->dec_dsc);
-                LV_LOG_WARN("Image draw can't read the line");
+                lv_img_cache_invalidate_src(src);
+                LV_LOG_WARN("Image draw can't read the area");
                 return LV_RES_INV;
             }
-            lv_draw_map(&line, mask, buf, opa, chroma_keyed, alpha_byte, style->image.color, style->image.intense);
-            line.y1++;
-            line.y2++;
-            y++;
+            lv_draw_map(&block, mask, buf, opa, chroma_keyed, alpha_byte, style->image.color, style->image.intense);
         }
     }
 
     return LV_RES_OK;
 }
+
+/**
+ * Draw a rotated and/or zoomed image whose pixels are available in the memory
+ * @param coords the coordinates of the not transformed image
+ * @param mask_com the area to draw. Already clipped to the transformed image.
+ * @param cdsc the opened image
+ * @param style style of the image
+ * @param opa opacity of the image
+ * @param angle rotation angle clockwise [0.1 degree]
+ * @param zoom zoom factor
+ * @param pivot rotate and zoom around this point of the image (relative to `coords`)
+ * @param antialias true: use bilinear filtering; false: nearest neighbour
+ * @return LV_RES_OK: drawn; LV_RES_INV: the image can't be transformed
+ */
+static lv_res_t lv_img_draw_transformed_core(const lv_area_t * coords, const lv_area_t * mask_com,
+                                             lv_img_cache_entry_t * cdsc, const lv_style_t * style, lv_opa_t opa,
+                                             int16_t angle, uint16_t zoom, const lv_point_t * pivot,
+                                             bool antialias)
+{
+    lv_img_decoder_dsc_t * dec_dsc = &cdsc->dec_dsc;
+
+    /*The sampler needs random access to the pixels*/
+    lv_img_dsc_t img;
+    img.header    = dec_dsc->header;
+    img.data_size = 0;
+    if(dec_dsc->img_data) {
+        /*`img_data` has a true color layout*/
+        if(lv_img_color_format_has_alpha(dec_dsc->header.cf)) img.header.cf = LV_IMG_CF_TRUE_COLOR_ALPHA;
+        else if(lv_img_color_format_is_chroma_keyed(dec_dsc->header.cf)) img.header.cf = LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED;
+        else img.header.cf = LV_IMG_CF_TRUE_COLOR;
+        img.data = dec_dsc->img_data;
+    } else if(dec_dsc->src_type == LV_IMG_SRC_VARIABLE &&
+              dec_dsc->header.cf >= LV_IMG_CF_TRUE_COLOR && dec_dsc->header.cf <= LV_IMG_CF_ALPHA_8BIT) {
+        img.data = ((const lv_img_dsc_t *)dec_dsc->src)->data;
+    } else {
+        LV_LOG_WARN("Image draw: only images in the memory can be transformed. "
+                    "Use `lv_img_decoder_set_decode_to_ram()` for files and compressed images.");
+        return LV_RES_INV;
+    }
+
+    lv_img_transform_dsc_t tr_dsc;
+    tr_dsc.img       = &img;
+    tr_dsc.color     = style->image.color;
+    tr_dsc.angle     = angle;
+    tr_dsc.zoom      = zoom;
+    tr_dsc.pivot     = *pivot;
+    tr_dsc.antialias = antialias ? 1 : 0;
+    lv_img_transform_init(&tr_dsc);
+
+    lv_disp_t * disp = lv_refr_get_disp_refreshing();
+    tr_dsc.chroma_key = disp->driver.color_chroma_key;
+
+    lv_coord_t width   = lv_area_get_width(mask_com);
+    lv_coord_t height  = lv_area_get_height(mask_com);
+    lv_coord_t block_h = height < LV_IMG_DRAW_AREA_MAX_LINES ? height : LV_IMG_DRAW_AREA_MAX_LINES;
+
+    uint8_t * buf = get_block_buf(width, LV_IMG_PX_SIZE_ALPHA_BYTE, &block_h);
+    if(buf == NULL) {
+        LV_LOG_WARN("Image draw: not enough memory to transform a line");
+        return LV_RES_INV;
+    }
+
+    lv_area_t block;
+    block.x1 = mask_com->x1;
+    block.x2 = mask_com->x2;
+
+    lv_coord_t row;
+    lv_coord_t y;
+    for(row = mask_com->y1; row <= mask_com->y2; row += block_h) {
+        block.y1 = row;
+        block.y2 = LV_MATH_MIN(row + block_h - 1, mask_com->y2);
+
+        uint8_t * buf_row = buf;
+        for(y = block.y1; y <= block.y2; y++) {
+            lv_img_transform_row(&tr_dsc, block.x1 - coords->x1, y - coords->y1, width, buf_row);
+            buf_row += (uint32_t)width * LV_IMG_PX_SIZE_ALPHA_BYTE;
+        }
+
+        lv_draw_map(&block, mask_com, buf, opa, false, true, style->image.color, style->image.intense);
+    }
+
+    return LV_RES_OK;
+}
+
+/**
+ * Get the draw buffer for a block of image lines.
+ * The block is limited to `LV_IMG_DRAW_BUF_MAX` bytes and halved while the buffer can't be allocated.
+ * @param width width of the lines in pixels
+ * @param px_size size of a pixel in bytes
+ * @param block_h the preferred number of lines. Set to the number of lines fitting into the buffer.
+ * @return pointer to the buffer or NULL if not even 1 line can be allocated
+ */
+static uint8_t * get_block_buf(lv_coord_t width, uint8_t px_size, lv_coord_t * block_h)
+{
+    uint32_t line_size = (uint32_t)width * px_size;
+    uint32_t max_h     = LV_IMG_DRAW_BUF_MAX / line_size;
+    if(max_h < 1) max_h = 1;
+    if((uint32_t)*block_h > max_h) *block_h = max_h;
+
+    while(1) {
+        uint8_t * buf = lv_draw_try_get_buf(line_size * *block_h);
+        if(buf != NULL || *block_h == 1) return buf;
+        *block_h = *block_h >> 1;
+    }
+}
@@ -15,6 +15,7 @@ extern "C" {
  *********************/
 #include "lv_draw.h"
 #include "lv_img_decoder.h"
+#include "lv_img_transform.h"
 
 /*********************
  *      DEFINES
@@ -59,6 +60,22 @@ extern "C" {
 void lv_draw_img(const lv_area_t * coords, const lv_area_t * mask, const void * src, const lv_style_t * style,
                  lv_opa_t opa_scale);
 
+/**
+ * Draw a rotated and/or zoomed image
+ * @param coords the coordinates of the not transformed image
+ * @param mask the image will be drawn only in this area
+ * @param src pointer to a lv_color_t array which contains the pixels of the image
+ * @param style style of the image
+ * @param opa_scale scale down all opacities by the factor
+ * @param angle rotation angle clockwise [0.1 degree]
+ * @param zoom zoom factor: 256 (LV_IMG_ZOOM_NONE): no zoom, 128: half size, 512: double size
+ * @param pivot rotate and zoom around this point of the image (relative to `coords`)
+ * @param antialias true: use bilinear filtering; false: nearest neighbour
+ */
+void lv_draw_img_transformed(const lv_area_t * coords, const lv_area_t * mask, const void * src,
+                             const lv_style_t * style, lv_opa_t opa_scale, int16_t angle, uint16_t zoom,
+                             const lv_point_t * pivot, bool antialias);
+
 /**
  * Get the type of an image source
  * @param src pointer to an image source:
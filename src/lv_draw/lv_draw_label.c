@@ -9,12 +9,15 @@
 #include "lv_draw_label.h"
 #include "../lv_misc/lv_math.h"
 #include "../lv_misc/lv_bidi.h"
+#include "../lv_misc/lv_mem.h"
+#include "lv_draw_list.h"
 
 /*********************
  *      DEFINES
  *********************/
 #define LABEL_RECOLOR_PAR_LENGTH 6
 #define LV_LABEL_HINT_UPDATE_TH 1024 /*Update the "hint" if the label's y coordinates have changed more then this*/
+#define LINES_ALLOC_STEP 8 /*Allocate the line break cache for this many lines first*/
 
 /**********************
  *      TYPEDEFS
@@ -30,6 +33,13 @@ typedef uint8_t cmd_state_t;
  *  STATIC PROTOTYPES
  **********************/
 static uint8_t hex_char_to_num(char hex);
+static bool lines_build(lv_draw_label_lines_t * lines, const char * txt);
+static uint32_t lines_break(const lv_draw_label_lines_t * lines, const char * txt, lv_draw_label_line_t * line);
+#if LV_USE_BIDI
+static void bidi_free(lv_draw_label_lines_t * lines);
+static bool bidi_buf_replace(void ** buf, uint32_t item_size, uint32_t cnt, uint32_t pos, uint32_t del_cnt,
+                             uint32_t ins_cnt);
+#endif
 
 /**********************
  *  STATIC VARIABLES
@@ -53,10 +63,13 @@ static uint8_t hex_char_to_num(char hex);
  * @param flag settings for the text from 'txt_flag_t' enum
  * @param offset text offset in x and y direction (NULL if unused)
  * @param sel make the text selected in the range by drawing a background there
+ * @param hint pointer to a hint to find the first visible line of long texts faster (NULL if unused)
+ * @param lines pointer to a line break cache of `txt` (NULL if unused)
+ * @param bidi_dir base direction of the text
  */
 void lv_draw_label(const lv_area_t * coords, const lv_area_t * mask, const lv_style_t * style, lv_opa_t opa_scale,
                    const char * txt, lv_txt_flag_t flag, lv_point_t * offset, lv_draw_label_txt_sel_t * sel,
-                   lv_draw_label_hint_t * hint, lv_bidi_dir_t bidi_dir)
+                   lv_draw_label_hint_t * hint, lv_draw_label_lines_t * lines, lv_bidi_dir_t bidi_dir)
 {
     const lv_font_t * font = style->text.font;
     lv_coord_t w;
@@ -64,7 +77,26 @@ void lv_draw_label(const lv_area_t * coords, const lv_area_t * mask, const lv_st
     /*No need to waste processor time if string is empty*/
     if (txt[0] == '\0')  return;
 
-    if((flag & LV_TXT_FLAG_EXPAND) == 0) {
+#if LV_USE_DRAW_LIST
+    if(lv_draw_list_is_recording()) {
+        lv_draw_list_add_label(coords, mask, style, opa_scale, txt, flag, offset, sel, hint, lines, bidi_dir);
+        return;
+    }
+#endif
+
+    /*Rebuild the line break cache if it was built with different parameters.
+     *Without memory draw the text without the cache.*/
+    if(lines) {
+        if(lv_draw_label_lines_update(lines, txt, font, style->text.letter_space, lv_area_get_width(coords),
+                                      flag) == false) {
+            lines = NULL;
+        }
+    }
+
+    if(lines) {
+        /*The lines are already broken so the width is not used*/
+        w = 0;
+    } else if((flag & LV_TXT_FLAG_EXPAND) == 0) {
         /*Normally use the label's width as width*/
         w = lv_area_get_width(coords);
     } else {
@@ -92,8 +124,22 @@ void lv_draw_label(const lv_area_t * coords, const lv_area_t * mask, const lv_st
     }
 
     uint32_t line_start     = 0;
+    uint32_t line_end;
+    uint32_t line_i         = 0;
     int32_t last_line_start = -1;
 
+    /*With the line break cache just jump to the first visible line*/
+    if(lines) {
+        if(line_height > 0 && pos.y + line_height < mask->y1) {
+            line_i = (mask->y1 - pos.y - 1) / line_height;
+            if(line_i >= lines->line_cnt) return;
+            pos.y += line_i * line_height;
+        }
+        line_start = lines->lines[line_i].start;
+        line_end   = lines->lines[line_i + 1].start;
+        hint       = NULL;
+    }
+
     /*Check the hint to use the cached info*/
     if(hint && y_ofs == 0 && coords->y1 < 0) {
         /*If the label changed too much recalculate the hint.*/
@@ -110,10 +156,12 @@ void lv_draw_label(const lv_area_t * coords, const lv_area_t * mask, const lv_st
     }
 
 
-    uint32_t line_end = line_start + lv_txt_get_next_line(&txt[line_start], font, style->text.letter_space, w, flag);
+    if(lines == NULL) {
+        line_end = line_start + lv_txt_get_next_line(&txt[line_start], font, style->text.letter_space, w, flag);
+    }
 
     /*Go the first visible line*/
-    while(pos.y + line_height < mask->y1) {
+    while(lines == NULL && pos.y + line_height < mask->y1) {
         /*Go to next line*/
         line_start = line_end;
         line_end += lv_txt_get_next_line(&txt[line_start], font, style->text.letter_space, w, flag);
@@ -131,14 +179,16 @@ void lv_draw_label(const lv_area_t * coords, const lv_area_t * mask, const lv_st
 
     /*Align to middle*/
     if(flag & LV_TXT_FLAG_CENTER) {
-        line_width = lv_txt_get_width(&txt[line_start], line_end - line_start, font, style->text.letter_space, flag);
+        if(lines) line_width = lines->lines[line_i].width;
+        else line_width = lv_txt_get_width(&txt[line_start], line_end - line_start, font, style->text.letter_space, flag);
 
         pos.x += (lv_area_get_width(coords) - line_width) / 2;
 
     }
     /*Align to the right*/
     else if(flag & LV_TXT_FLAG_RIGHT) {
-        line_width = lv_txt_get_width(&txt[line_start], line_end - line_start, font, style->text.letter_space, flag);
+        if(lines) line_width = lines->lines[line_i].width;
+        else line_width = lv_txt_get_width(&txt[line_start], line_end - line_start, font, style->text.letter_space, flag);
         pos.x += lv_area_get_width(coords) - line_width;
     }
 
@@ -175,28 +225,43 @@ void lv_draw_label(const lv_area_t * coords, const lv_area_t * mask, const lv_st
         i         = 0;
         uint32_t letter;
         uint32_t letter_next;
+
+        /*The index of the first letter of the line. Required only for the selection*/
+        uint32_t line_char_start = 0;
+        if(sel_start != 0xFFFF && sel_end != 0xFFFF) {
+            if(lines) line_char_start = lines->lines[line_i].char_start;
+            else line_char_start = lv_txt_encoded_get_char_id(txt, line_start);
+        }
+
 #if LV_USE_BIDI
-        char *bidi_txt = lv_draw_get_buf(line_end - line_start + 1);
-        lv_bidi_process_paragraph(txt + line_start, bidi_txt, line_end - line_start, bidi_dir, NULL, 0);
+        /*Get the line in visual order from the cache or process it now*/
+        const char * bidi_txt = NULL;
+        const uint16_t * bidi_pos = NULL;
+        if(lines) bidi_txt = lv_draw_label_lines_get_bidi(lines, txt, line_i, bidi_dir, &bidi_pos);
+        if(bidi_txt == NULL) {
+            char * bidi_buf;
+            bidi_pos = lv_bidi_get_pos_conv(txt + line_start, &bidi_buf, line_end - line_start, bidi_dir);
+            bidi_txt = bidi_buf;
+        }
 #else
         (void)bidi_dir;
         const char *bidi_txt = txt + line_start;
 #endif
 
+        uint32_t char_i = 0; /*Index of the letter in the line in visual order*/
         while(i < line_end - line_start) {
             uint16_t logical_char_pos = 0;
             if(sel_start != 0xFFFF && sel_end != 0xFFFF) {
 #if LV_USE_BIDI
-                logical_char_pos = lv_txt_encoded_get_char_id(txt, line_start);
-                uint16_t t = lv_txt_encoded_get_char_id(bidi_txt, i);
-                logical_char_pos += lv_bidi_get_logical_pos(bidi_txt, NULL, line_end - line_start, bidi_dir, t, NULL);
+                logical_char_pos = line_char_start + LV_BIDI_POS_GET(bidi_pos[char_i]);
 #else
-                logical_char_pos = lv_txt_encoded_get_char_id(txt, line_start + i);
+                logical_char_pos = line_char_start + char_i;
 #endif
             }
 
             letter      = lv_txt_encoded_next(bidi_txt, &i);
             letter_next = lv_txt_encoded_next(&bidi_txt[i], NULL);
+            char_i++;
 
 
             /*Handle the re-color command*/
@@ -261,12 +326,19 @@ void lv_draw_label(const lv_area_t * coords, const lv_area_t * mask, const lv_st
         }
         /*Go to next line*/
         line_start = line_end;
-        line_end += lv_txt_get_next_line(&txt[line_start], font, style->text.letter_space, w, flag);
+        if(lines) {
+            line_i++;
+            if(line_i >= lines->line_cnt) return;
+            line_end = lines->lines[line_i + 1].start;
+        } else {
+            line_end += lv_txt_get_next_line(&txt[line_start], font, style->text.letter_space, w, flag);
+        }
 
         pos.x = coords->x1;
         /*Align to middle*/
         if(flag & LV_TXT_FLAG_CENTER) {
-            line_width =
+            if(lines) line_width = lines->lines[line_i].width;
+            else line_width =
                     lv_txt_get_width(&txt[line_start], line_end - line_start, font, style->text.letter_space, flag);
 
             pos.x += (lv_area_get_width(coords) - line_width) / 2;
@@ -274,7 +346,8 @@ void lv_draw_label(const lv_area_t * coords, const lv_area_t * mask, const lv_st
         }
         /*Align to the right*/
         else if(flag & LV_TXT_FLAG_RIGHT) {
-            line_width =
+            if(lines) line_width = lines->lines[line_i].width;
+            else line_width =
                     lv_txt_get_width(&txt[line_start], line_end - line_start, font, style->text.letter_space, flag);
             pos.x += lv_area_get_width(coords) - line_width;
         }
@@ -286,10 +359,363 @@ void lv_draw_label(const lv_area_t * coords, const lv_area_t * mask, const lv_st
     }
 }
 
+/**
+ * Initialize a line break cache
+ * @param lines pointer to a line break cache
+ */
+void lv_draw_label_lines_init(lv_draw_label_lines_t * lines)
+{
+    lines->lines        = NULL;
+    lines->line_cnt     = 0;
+    lines->font         = NULL;
+    lines->w            = 0;
+    lines->letter_space = 0;
+    lines->flag         = LV_TXT_FLAG_NONE;
+#if LV_USE_BIDI
+    lines->bidi_txt     = NULL;
+    lines->bidi_pos     = NULL;
+    lines->bidi_dir     = LV_BIDI_DIR_LTR;
+#endif
+}
+
+/**
+ * Invalidate a line break cache and free its memory. It will be rebuilt when it's used next time.
+ * @param lines pointer to a line break cache
+ */
+void lv_draw_label_lines_invalidate(lv_draw_label_lines_t * lines)
+{
+    if(lines->lines) lv_mem_free(lines->lines);
+    lines->lines    = NULL;
+    lines->line_cnt = 0;
+#if LV_USE_BIDI
+    bidi_free(lines);
+#endif
+}
+
+/**
+ * Build a line break cache if it's not built yet or it was built with different parameters
+ * @param lines pointer to a line break cache
+ * @param txt a '\0' terminated text
+ * @param font pointer to a font
+ * @param letter_space letter space
+ * @param w width of the text area (max width of the lines)
+ * @param flag settings for the text from 'txt_flag_t' enum
+ * @return true: the lines are ready to use; false: out of memory
+ */
+bool lv_draw_label_lines_update(lv_draw_label_lines_t * lines, const char * txt, const lv_font_t * font,
+                                lv_coord_t letter_space, lv_coord_t w, lv_txt_flag_t flag)
+{
+    /*The alignment doesn't change the lines*/
+    flag &= LV_TXT_FLAG_RECOLOR | LV_TXT_FLAG_EXPAND;
+
+    if(lines->lines && lines->font == font && lines->letter_space == letter_space && lines->w == w &&
+       lines->flag == flag) {
+        return true;
+    }
+
+    lv_draw_label_lines_invalidate(lines);
+    lines->font         = font;
+    lines->letter_space = letter_space;
+    lines->w            = w;
+    lines->flag         = flag;
+
+    return lines_build(lines, txt);
+}
+
+/**
+ * Update a line break cache after a part of the text was replaced.
+ * Only the lines from the word of the change until the first unchanged line break are broken again.
+ * @param lines pointer to a line break cache. Not built caches are ignored.
+ * @param txt the new text
+ * @param pos byte index of the change
+ * @param del_len number of bytes deleted from `pos` of the old text
+ * @param ins_len number of bytes inserted to `pos` of the new text
+ */
+void lv_draw_label_lines_edit(lv_draw_label_lines_t * lines, const char * txt, uint32_t pos, uint32_t del_len,
+                              uint32_t ins_len)
+{
+    if(lines->lines == NULL) return;
+
+    int32_t diff = (int32_t)ins_len - (int32_t)del_len;
+
+    /* A long word can be broken on more lines and how it's broken depends on its whole length.
+     * So start from the word of the change (with the letter before it because of the kerning)
+     * and one more line before it because the beginning of the word might fit there.
+     * The text before `pos` is the same in the old and new text.*/
+    uint32_t word_start = pos;
+    if(word_start > 0) lv_txt_encoded_prev(txt, &word_start);
+    while(word_start > 0) {
+        uint32_t prev = word_start;
+        uint32_t letter = lv_txt_encoded_prev(txt, &prev);
+        if(letter == '\n' || letter == '\r' || lv_txt_is_break_char(letter)) break;
+        word_start = prev;
+    }
+
+    uint32_t first = lv_draw_label_lines_find_byte(lines, word_start);
+    if(first > 0) first--;
+
+#if LV_USE_BIDI
+    /*Size of the processed lines and the end of the changed lines (the end of the text if not synced)*/
+    uint32_t bidi_txt_size = lines->lines[lines->line_cnt].start + lines->line_cnt + 1;
+    uint32_t bidi_pos_size = lines->lines[lines->line_cnt].char_start + 1;
+    uint32_t old_end = lines->line_cnt;
+    uint32_t old_end_start = lines->lines[old_end].start;
+    uint32_t old_end_char_start = lines->lines[old_end].char_start;
+#endif
+
+    /*Break the changed lines into a temporal array until a new line starts where an old line
+     *after the change started. The lines from there are the same, only shifted.*/
+    lv_draw_label_line_t * new_lines = NULL;
+    uint32_t new_cnt = 0;
+    uint32_t cap = 0;
+    uint32_t old_i = first + 1;
+    uint32_t start = lines->lines[first].start;
+    uint32_t char_start = lines->lines[first].char_start;
+    bool synced = false;
+    while(1) {
+        if(new_cnt + 1 >= cap) {
+            cap = cap == 0 ? LINES_ALLOC_STEP : cap * 2;
+            lv_draw_label_line_t * tmp = lv_mem_realloc(new_lines, cap * sizeof(lv_draw_label_line_t));
+            if(tmp == NULL) {
+                if(new_lines) lv_mem_free(new_lines);
+                lv_draw_label_lines_invalidate(lines);
+                return;
+            }
+            new_lines = tmp;
+        }
+
+        lv_draw_label_line_t * line = &new_lines[new_cnt];
+        line->start = start;
+        line->char_start = char_start;
+        line->width = 0;
+        if(txt[start] == '\0') break;    /*The last item is the end of the text*/
+
+        uint32_t end = lines_break(lines, txt, line);
+        char_start += lv_txt_encoded_get_char_id(&txt[start], end - start);
+        start = end;
+        new_cnt++;
+
+        /*Skip the old lines starting before the change or before the new line*/
+        while(old_i < lines->line_cnt &&
+              (lines->lines[old_i].start < pos + del_len || (int32_t)lines->lines[old_i].start + diff < (int32_t)start)) {
+            old_i++;
+        }
+
+        if(old_i < lines->line_cnt && (int32_t)lines->lines[old_i].start + diff == (int32_t)start) {
+            synced = true;
+            break;
+        }
+    }
+
+    /*Replace the old lines from `first` with the new lines. If synced keep the old lines from `old_i`,
+     *else the end of the text is a new item too.*/
+    uint32_t keep_cnt = 0;
+    if(synced) {
+#if LV_USE_BIDI
+        old_end = old_i;
+        old_end_start = lines->lines[old_i].start;
+        old_end_char_start = lines->lines[old_i].char_start;
+#endif
+        keep_cnt = lines->line_cnt + 1 - old_i;
+        int32_t char_diff = (int32_t)char_start - (int32_t)lines->lines[old_i].char_start;
+        uint32_t i;
+        for(i = old_i; i <= lines->line_cnt; i++) {
+            lines->lines[i].start += diff;
+            lines->lines[i].char_start += char_diff;
+        }
+    } else {
+        old_i = lines->line_cnt + 1;
+        new_cnt++;
+    }
+
+    uint32_t item_cnt = first + new_cnt + keep_cnt;
+    if(item_cnt > lines->line_cnt + 1) {
+        lv_draw_label_line_t * tmp = lv_mem_realloc(lines->lines, item_cnt * sizeof(lv_draw_label_line_t));
+        if(tmp == NULL) {
+            lv_mem_free(new_lines);
+            lv_draw_label_lines_invalidate(lines);
+            return;
+        }
+        lines->lines = tmp;
+    }
+
+    memmove(&lines->lines[first + new_cnt], &lines->lines[old_i], keep_cnt * sizeof(lv_draw_label_line_t));
+    memcpy(&lines->lines[first], new_lines, new_cnt * sizeof(lv_draw_label_line_t));
+    lv_mem_free(new_lines);
+
+    if(item_cnt < lines->line_cnt + 1) {
+        lv_draw_label_line_t * tmp = lv_mem_realloc(lines->lines, item_cnt * sizeof(lv_draw_label_line_t));
+        if(tmp) lines->lines = tmp;
+    }
+#if LV_USE_BIDI
+    /*Move the processed lines after the change to their new place. The changed lines need to be processed again.*/
+    if(lines->bidi_txt) {
+        uint32_t new_end = synced ? first + new_cnt : item_cnt - 1;
+        lv_draw_label_line_t * first_line = &lines->lines[first];
+        lv_draw_label_line_t * end_line = &lines->lines[new_end];
+        bool ok;
+
+        ok = bidi_buf_replace((void **)&lines->bidi_txt, sizeof(char), bidi_txt_size, first_line->start + first,
+                              old_end_start + old_end - (first_line->start + first),
+                              end_line->start + new_end - (first_line->start + first));
+        if(ok) {
+            ok = bidi_buf_replace((void **)&lines->bidi_pos, sizeof(uint16_t), bidi_pos_size, first_line->char_start,
+                                  old_end_char_start - first_line->char_start,
+                                  end_line->char_start - first_line->char_start);
+        }
+
+        if(ok == false) {
+            bidi_free(lines);
+        } else if(lines->bidi_dir == LV_BIDI_DIR_AUTO) {
+            /*The base direction of a line is detected from the rest of the text*/
+            uint32_t i;
+            for(i = 0; i < first; i++) lines->lines[i].bidi_ready = 0;
+        }
+    }
+#endif
+
+    lines->line_cnt = item_cnt - 1;
+}
+
+/**
+ * Find the line of a byte in a line break cache
+ * @param lines pointer to a built line break cache
+ * @param byte_id a byte index in the text
+ * @return index of the line with `byte_id` (the last line if `byte_id` is after the text)
+ */
+uint32_t lv_draw_label_lines_find_byte(const lv_draw_label_lines_t * lines, uint32_t byte_id)
+{
+    if(lines->line_cnt == 0) return 0;
+
+    /*Binary search for the last line starting before or at `byte_id`*/
+    uint32_t min = 0;
+    uint32_t max = lines->line_cnt - 1;
+    while(min < max) {
+        uint32_t mid = (min + max + 1) >> 1;
+        if(lines->lines[mid].start <= byte_id) min = mid;
+        else max = mid - 1;
+    }
+
+    return min;
+}
+
+/**
+ * Find the line of a character in a line break cache
+ * @param lines pointer to a built line break cache
+ * @param char_id a character index in the text
+ * @return index of the line with `char_id` (the last line if `char_id` is after the text)
+ */
+uint32_t lv_draw_label_lines_find_char(const lv_draw_label_lines_t * lines, uint32_t char_id)
+{
+    if(lines->line_cnt == 0) return 0;
+
+    /*Binary search for the last line starting before or at `char_id`*/
+    uint32_t min = 0;
+    uint32_t max = lines->line_cnt - 1;
+    while(min < max) {
+        uint32_t mid = (min + max + 1) >> 1;
+        if(lines->lines[mid].char_start <= char_id) min = mid;
+        else max = mid - 1;
+    }
+
+    return min;
+}
+
+#if LV_USE_BIDI
+/**
+ * Get a line of a line break cache in visual order.
+ * The line is processed only if it's used first after the text or the base direction has changed.
+ * @param lines pointer to a built line break cache
+ * @param txt the text of the cache
+ * @param line_i index of the line
+ * @param base_dir base direction of the text
+ * @param pos_conv if not NULL the logical character index (in the line) of every visual character
+ *                 will be stored here (see `LV_BIDI_POS_GET/IS_RTL`)
+ * @return the '\0' terminated line in visual order or NULL if `line_i` is invalid or out of memory
+ */
+const char * lv_draw_label_lines_get_bidi(lv_draw_label_lines_t * lines, const char * txt, uint32_t line_i,
+                                          lv_bidi_dir_t base_dir, const uint16_t ** pos_conv)
+{
+    if(lines->lines == NULL || line_i >= lines->line_cnt) return NULL;
+
+    /*Allocate the buffers for the whole text but process the lines only when they are used*/
+    uint32_t i;
+    if(lines->bidi_txt == NULL) {
+        lv_draw_label_line_t * end = &lines->lines[lines->line_cnt];
+        lines->bidi_txt = lv_mem_alloc(end->start + lines->line_cnt + 1);
+        lines->bidi_pos = lv_mem_alloc((end->char_start + 1) * sizeof(uint16_t));
+        if(lines->bidi_txt == NULL || lines->bidi_pos == NULL) {
+            bidi_free(lines);
+            return NULL;
+        }
+
+        for(i = 0; i < lines->line_cnt; i++) lines->lines[i].bidi_ready = 0;
+        lines->bidi_dir = base_dir;
+    } else if(lines->bidi_dir != base_dir) {
+        for(i = 0; i < lines->line_cnt; i++) lines->lines[i].bidi_ready = 0;
+        lines->bidi_dir = base_dir;
+    }
+
+    lv_draw_label_line_t * line = &lines->lines[line_i];
+    char * line_txt = &lines->bidi_txt[line->start + line_i];
+    uint16_t * line_pos = &lines->bidi_pos[line->char_start];
+    if(line->bidi_ready == 0) {
+        lv_bidi_process_paragraph(&txt[line->start], line_txt, line[1].start - line->start, base_dir, line_pos,
+                                  line[1].char_start - line->char_start);
+        line->bidi_ready = 1;
+    }
+
+    if(pos_conv) *pos_conv = line_pos;
+    return line_txt;
+}
+#endif
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
 
+/**
+ * Break a text into lines and save the lines into a line break cache
+ * @param lines pointer to an empty line break cache with the parameters set
+ * @param txt a '\0' terminated text
+ * @return true: the lines are saved; false: out of memory
+ */
+static bool lines_build(lv_draw_label_lines_t * lines, const char * txt)
+{
+    uint32_t cap = 0;
+    uint32_t start = 0;
+    uint32_t char_start = 0;
+    while(1) {
+        /*Allocate one more item for the end of the text*/
+        if(lines->line_cnt + 1 >= cap) {
+            cap = cap == 0 ? LINES_ALLOC_STEP : cap * 2;
+            lv_draw_label_line_t * new_lines = lv_mem_realloc(lines->lines, cap * sizeof(lv_draw_label_line_t));
+            if(new_lines == NULL) {
+                lv_draw_label_lines_invalidate(lines);
+                return false;
+            }
+            lines->lines = new_lines;
+        }
+
+        lv_draw_label_line_t * line = &lines->lines[lines->line_cnt];
+        line->start = start;
+        line->char_start = char_start;
+        line->width = 0;
+        if(txt[start] == '\0') break;
+
+        uint32_t end = lines_break(lines, txt, line);
+        char_start += lv_txt_encoded_get_char_id(&txt[start], end - start);
+        start = end;
+        lines->line_cnt++;
+    }
+
+    /*Free the unused items*/
+    lv_draw_label_line_t * new_lines = lv_mem_realloc(lines->lines, (lines->line_cnt + 1) * sizeof(lv_draw_label_line_t));
+    if(new_lines) lines->lines = new_lines;
+
+    return true;
+}
+
 /**
  * Convert a hexadecimal characters to a number (0..15)
  * @param hex Pointer to a hexadecimal character (0..9, A..F)
@@ -317,3 +743,67 @@ static uint8_t hex_char_to_num(char hex)
 
     return result;
 }
+
+/**
+ * Find the end of a line and save its width
+ * @param lines pointer to a line break cache with the parameters set
+ * @param txt a '\0' terminated text
+ * @param line pointer to a line with `start` set. Its `width` will be set.
+ * @return byte index of the start of the next line
+ */
+static uint32_t lines_break(const lv_draw_label_lines_t * lines, const char * txt, lv_draw_label_line_t * line)
+{
+    uint32_t len = lv_txt_get_next_line(&txt[line->start], lines->font, lines->letter_space, lines->w, lines->flag);
+    line->width = lv_txt_get_width(&txt[line->start], len, lines->font, lines->letter_space, lines->flag);
+#if LV_USE_BIDI
+    line->bidi_ready = 0;
+#endif
+
+    return line->start + len;
+}
+
+#if LV_USE_BIDI
+/**
+ * Free the processed lines of a line break cache
+ * @param lines pointer to a line break cache
+ */
+static void bidi_free(lv_draw_label_lines_t * lines)
+{
+    if(lines->bidi_txt) lv_mem_free(lines->bidi_txt);
+    if(lines->bidi_pos) lv_mem_free(lines->bidi_pos);
+    lines->bidi_txt = NULL;
+    lines->bidi_pos = NULL;
+}
+
+/**
+ * Replace some items of a buffer with new (not initialized) items and keep the items after them
+ * @param buf pointer to buffer allocated with `lv_mem_alloc`. Might be reallocated.
+ * @param item_size size of an item in bytes
+ * @param cnt number of items in the buffer
+ * @param pos index of the first item to replace
+ * @param del_cnt number of items to delete from `pos`
+ * @param ins_cnt number of items to insert to `pos`
+ * @return true: the items are replaced; false: out of memory (the buffer is not changed)
+ */
+static bool bidi_buf_replace(void ** buf, uint32_t item_size, uint32_t cnt, uint32_t pos, uint32_t del_cnt,
+                             uint32_t ins_cnt)
+{
+    uint32_t new_cnt = cnt - del_cnt + ins_cnt;
+    uint8_t * p = *buf;
+
+    if(new_cnt > cnt) {
+        p = lv_mem_realloc(p, new_cnt * item_size);
+        if(p == NULL) return false;
+        *buf = p;
+    }
+
+    memmove(&p[(pos + ins_cnt) * item_size], &p[(pos + del_cnt) * item_size], (cnt - pos - del_cnt) * item_size);
+
+    if(new_cnt < cnt) {
+        p = lv_mem_realloc(p, new_cnt * item_size);
+        if(p) *buf = p;
+    }
+
+    return true;
+}
+#endif
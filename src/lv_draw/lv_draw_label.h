@@ -49,6 +49,42 @@ typedef struct {
     int32_t coord_y;
 }lv_draw_label_hint_t;
 
+/** A line of a text in `lv_draw_label_lines_t`*/
+typedef struct {
+    uint32_t start;         /**< Byte index of the first character of the line*/
+    uint32_t char_start;    /**< Character index of the first character of the line*/
+    lv_coord_t width;       /**< Width of the line*/
+#if LV_USE_BIDI
+    uint8_t bidi_ready;     /**< 1: the line is processed in `bidi_txt` and `bidi_pos` of the cache*/
+#endif
+}lv_draw_label_line_t;
+
+/** Store the line breaks of a text to draw it and find its letters without processing the text again.
+ * It's built by `lv_draw_label()` and used while the font, letter space, width and flags are the same.
+ * The owner needs to invalidate it with `lv_draw_label_lines_invalidate()` or update it with
+ * `lv_draw_label_lines_edit()` if the text changes.
+ * The `y` coordinate of a line is `index * (line height + line space)`.*/
+typedef struct {
+    /** `line_cnt` lines and the end of the text as a last item. NULL if not built yet*/
+    lv_draw_label_line_t * lines;
+    uint32_t line_cnt;
+
+    /** The parameters used to build the lines*/
+    const lv_font_t * font;
+    lv_coord_t w;
+    lv_coord_t letter_space;
+    lv_txt_flag_t flag;     /*Only `LV_TXT_FLAG_RECOLOR/EXPAND` as the others don't affect the lines*/
+
+#if LV_USE_BIDI
+    /** The lines in visual order and the logical character index (in the line) of every visual character.
+     * Line `i` is at `start + i` in `bidi_txt` (to close every line with '\0') and at `char_start` in `bidi_pos`.
+     * A line is processed only when it's used first. NULL if not used yet.*/
+    char * bidi_txt;
+    uint16_t * bidi_pos;
+    lv_bidi_dir_t bidi_dir; /*The base direction used to process the lines*/
+#endif
+}lv_draw_label_lines_t;
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -63,11 +99,82 @@ typedef struct {
  * @param flag settings for the text from 'txt_flag_t' enum
  * @param offset text offset in x and y direction (NULL if unused)
  * @param sel_start start index of selected area (`LV_LABEL_TXT_SEL_OFF` if none)
+ * @param hint pointer to a hint to find the first visible line of long texts faster (NULL if unused)
+ * @param lines pointer to a line break cache of `txt` (NULL if unused)
  * @param bidi_dir base direction of the text
  */
 void lv_draw_label(const lv_area_t * coords, const lv_area_t * mask, const lv_style_t * style, lv_opa_t opa_scale,
                    const char * txt, lv_txt_flag_t flag, lv_point_t * offset, lv_draw_label_txt_sel_t * sel,
-                   lv_draw_label_hint_t * hint, lv_bidi_dir_t bidi_dir);
+                   lv_draw_label_hint_t * hint, lv_draw_label_lines_t * lines, lv_bidi_dir_t bidi_dir);
+
+/**
+ * Initialize a line break cache
+ * @param lines pointer to a line break cache
+ */
+void lv_draw_label_lines_init(lv_draw_label_lines_t * lines);
+
+/**
+ * Invalidate a line break cache and free its memory. It will be rebuilt when it's used next time.
+ * @param lines pointer to a line break cache
+ */
+void lv_draw_label_lines_invalidate(lv_draw_label_lines_t * lines);
+
+/**
+ * Build a line break cache if it's not built yet or it was built with different parameters
+ * @param lines pointer to a line break cache
+ * @param txt a '\0' terminated text
+ * @param font pointer to a font
+ * @param letter_space letter space
+ * @param w width of the text area (max width of the lines)
+ * @param flag settings for the text from 'txt_flag_t' enum
+ * @return true: the lines are ready to use; false: out of memory
+ */
+bool lv_draw_label_lines_update(lv_draw_label_lines_t * lines, const char * txt, const lv_font_t * font,
+                                lv_coord_t letter_space, lv_coord_t w, lv_txt_flag_t flag);
+
+/**
+ * Update a line break cache after a part of the text was replaced.
+ * Only the lines from the word of the change until the first unchanged line break are broken again.
+ * @param lines pointer to a line break cache. Not built caches are ignored.
+ * @param txt the new text
+ * @param pos byte index of the change
+ * @param del_len number of bytes deleted from `pos` of the old text
+ * @param ins_len number of bytes inserted to `pos` of the new text
+ */
+void lv_draw_label_lines_edit(lv_draw_label_lines_t * lines, const char * txt, uint32_t pos, uint32_t del_len,
+                              uint32_t ins_len);
+
+/**
+ * Find the line of a byte in a line break cache
+ * @param lines pointer to a built line break cache
+ * @param byte_id a byte index in the text
+ * @return index of the line with `byte_id` (the last line if `byte_id` is after the text)
+ */
+uint32_t lv_draw_label_lines_find_byte(const lv_draw_label_lines_t * lines, uint32_t byte_id);
+
+/**
+ * Find the line of a character in a line break cache
+ * @param lines pointer to a built line break cache
+ * @param char_id a character index in the text
+ * @return index of the line with `char_id` (the last line if `char_id` is after the text)
+ */
+uint32_t lv_draw_label_lines_find_char(const lv_draw_label_lines_t * lines, uint32_t char_id);
+
+#if LV_USE_BIDI
+/**
+ * Get a line of a line break cache in visual order.
+ * The line is processed only if it's used first after the text or the base direction has changed.
+ * @param lines pointer to a built line break cache
+ * @param txt the text of the cache
+ * @param line_i index of the line
+ * @param base_dir base direction of the text
+ * @param pos_conv if not NULL the logical character index (in the line) of every visual character
+ *                 will be stored here (see `LV_BIDI_POS_GET/IS_RTL`)
+ * @return the '\0' terminated line in visual order or NULL if `line_i` is invalid or out of memory
+ */
+const char * lv_draw_label_lines_get_bidi(lv_draw_label_lines_t * lines, const char * txt, uint32_t line_i,
+                                          lv_bidi_dir_t base_dir, const uint16_t ** pos_conv);
+#endif
 
 /**********************
  *      MACROS
@@ -0,0 +1,243 @@
+/**
+ * @file lv_draw_layer.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_draw_layer.h"
+#if LV_USE_OPA_LAYER
+
+#include <string.h>
+#include "../lv_core/lv_refr.h"
+#include "../lv_misc/lv_mem.h"
+#include "../lv_misc/lv_math.h"
+#include "../lv_misc/lv_log.h"
+#include "lv_draw_list.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+/*Max. number of nested layers. The deeper layers are drawn normally.*/
+#define LAYER_DEPTH_MAX 4
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef struct
+{
+    lv_color_t * buf;      /*Pixels of the layer. NULL if the layer couldn't be created*/
+    lv_area_t area;        /*Area of the layer*/
+    lv_color_t * buf_ori;  /*The original buffer of the VDB*/
+    lv_area_t area_ori;    /*The original area of the VDB*/
+    uint8_t reserved : 1;  /*1: `buf` is a reserved buffer, don't free it*/
+    uint8_t recorded : 1;  /*1: the start of the layer is recorded into the draw list*/
+} layer_dsc_t;
+
+/*A buffer reserved while recording the draw list for the layers on a level*/
+typedef struct
+{
+    lv_color_t * buf;
+    uint32_t px_cnt;
+} layer_reserve_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static bool layer_open(layer_dsc_t * layer, const lv_area_t * area, lv_color_t * buf);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static layer_dsc_t layers[LAYER_DEPTH_MAX];
+static uint8_t layer_depth; /*Number of started layers (can be more than `LAYER_DEPTH_MAX`)*/
+#if LV_USE_DRAW_LIST
+static layer_reserve_t reserved[LAYER_DEPTH_MAX]; /*Buffers of the recorded layers for every nesting level*/
+#endif
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+/**
+ * Redirect the drawing into a layer. The layer starts with the current content of the display buffer
+ * and it's blended back at once with `lv_draw_layer_finish()`.
+ * `lv_draw_layer_finish()` needs to be called after every `lv_draw_layer_start()` even if it failed.
+ * While the draw list is recording the layer's buffer is reserved here, so if the start is recorded
+ * it can't fail when the list is replayed.
+ * @param area the area of the layer. Only the part on the display buffer is used.
+ * @return true: the drawing goes to the layer;
+ *         false: the layer can't be created (no memory, `set_px_cb` or `screen_transp`), draw normally
+ */
+bool lv_draw_layer_start(const lv_area_t * area)
+{
+    layer_depth++;
+    if(layer_depth > LAYER_DEPTH_MAX) return false;
+
+    layer_dsc_t * layer = &layers[layer_depth - 1];
+    layer->buf          = NULL;
+    layer->reserved     = 0;
+    layer->recorded     = 0;
+
+    lv_disp_t * disp = lv_refr_get_disp_refreshing();
+
+    /*The layer is a plain `lv_color_t` array so it can't be used with special display buffers*/
+    if(disp->driver.set_px_cb) return false;
+#if LV_COLOR_DEPTH == 32 && LV_COLOR_SCREEN_TRANSP
+    if(disp->driver.screen_transp) return false;
+#endif
+
+#if LV_USE_DRAW_LIST
+    if(lv_draw_list_is_recording()) {
+        /* The layer is replayed on the parts of the display buffer so it's never larger than the display buffer.
+         * The layers on the same level are replayed after each other so they can share a buffer.*/
+        layer_reserve_t * res = &reserved[layer_depth - 1];
+        uint32_t px_cnt       = LV_MATH_MIN(lv_area_get_size(area), lv_disp_get_buf(disp)->size);
+        if(res->px_cnt < px_cnt) {
+            lv_color_t * buf = lv_mem_realloc(res->buf, px_cnt * sizeof(lv_color_t));
+            if(buf == NULL) {
+                LV_LOG_WARN("lv_draw_layer_start: no memory for the layer");
+                return false;
+            }
+            res->buf    = buf;
+            res->px_cnt = px_cnt;
+        }
+
+        if(lv_draw_list_add_layer_start(area, layer_depth - 1) == false) return false;
+        layer->recorded = 1;
+        return true;
+    }
+#endif
+
+    return layer_open(layer, area, NULL);
+}
+
+#if LV_USE_DRAW_LIST
+/**
+ * Start a layer recorded into the draw list. Used when the draw list is replayed.
+ * @param area the area of the layer. Only the part on the display buffer is used.
+ * @param level the nesting level of the layer when it was recorded. Its reserved buffer is used.
+ * @return true: the drawing goes to the layer; false: the layer is not on the display buffer
+ */
+bool lv_draw_layer_start_recorded(const lv_area_t * area, uint8_t level)
+{
+    layer_depth++;
+    if(layer_depth > LAYER_DEPTH_MAX) return false;
+
+    layer_dsc_t * layer = &layers[layer_depth - 1];
+    layer->buf          = NULL;
+    layer->reserved     = 1;
+    layer->recorded     = 0;
+
+    return layer_open(layer, area, reserved[level].buf);
+}
+
+/**
+ * Free the buffers reserved for the layers while the draw list was recording.
+ * Call it when the draw list won't be replayed anymore.
+ */
+void lv_draw_layer_free_reserved(void)
+{
+    uint8_t i;
+    for(i = 0; i < LAYER_DEPTH_MAX; i++) {
+        lv_mem_free(reserved[i].buf);
+        reserved[i].buf    = NULL;
+        reserved[i].px_cnt = 0;
+    }
+}
+#endif
+
+/**
+ * Blend the last started layer back with an opacity and continue drawing where it was before the layer
+ * @param area the same area which was used in `lv_draw_layer_start()`
+ * @param opa opacity of the layer
+ */
+void lv_draw_layer_finish(const lv_area_t * area, lv_opa_t opa)
+{
+    if(layer_depth == 0) return;
+
+    layer_depth--;
+    if(layer_depth >= LAYER_DEPTH_MAX) return;
+
+    layer_dsc_t * layer = &layers[layer_depth];
+
+#if LV_USE_DRAW_LIST
+    if(lv_draw_list_is_recording()) {
+        /*Record the finish only if the start was recorded too*/
+        if(layer->recorded) lv_draw_list_add_layer_finish(area, opa);
+        layer->recorded = 0;
+        return;
+    }
+#endif
+
+    if(layer->buf == NULL) return;
+
+    /*The layer has to be ready before it's blended*/
+    lv_draw_backend_wait();
+
+    lv_disp_buf_t * vdb = lv_disp_get_buf(lv_refr_get_disp_refreshing());
+    vdb->buf_act        = layer->buf_ori;
+    lv_area_copy(&vdb->area, &layer->area_ori);
+
+    lv_draw_map(&layer->area, &layer->area, (const uint8_t *)layer->buf, opa, false, false, LV_COLOR_BLACK,
+                LV_OPA_TRANSP);
+
+    if(layer->reserved == 0) lv_mem_free(layer->buf);
+    layer->buf = NULL;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Copy the content of the display buffer into a layer and redirect the drawing into it
+ * @param layer pointer to a layer descriptor
+ * @param area the area of the layer. Only the part on the display buffer is used.
+ * @param buf buffer for the layer (large enough for the display buffer) or NULL to allocate it
+ * @return true: the drawing goes to the layer; false: the layer can't be created
+ */
+static bool layer_open(layer_dsc_t * layer, const lv_area_t * area, lv_color_t * buf)
+{
+    lv_disp_buf_t * vdb = lv_disp_get_buf(lv_refr_get_disp_refreshing());
+
+    if(lv_area_intersect(&layer->area, area, &vdb->area) == false) return false;
+
+    if(buf == NULL) {
+        buf = lv_mem_alloc(lv_area_get_size(&layer->area) * sizeof(lv_color_t));
+        if(buf == NULL) {
+            LV_LOG_WARN("lv_draw_layer_start: no memory for the layer");
+            return false;
+        }
+    }
+    layer->buf = buf;
+
+    /*Start from the current content: the pixels not drawn in the layer will be blended to themselves*/
+    lv_draw_backend_wait();
+    lv_coord_t vdb_w         = lv_area_get_width(&vdb->area);
+    lv_coord_t layer_w       = lv_area_get_width(&layer->area);
+    const lv_color_t * src_p = vdb->buf_act;
+    src_p += (uint32_t)(layer->area.y1 - vdb->area.y1) * vdb_w + (layer->area.x1 - vdb->area.x1);
+    lv_color_t * dest_p = layer->buf;
+    lv_coord_t y;
+    for(y = layer->area.y1; y <= layer->area.y2; y++) {
+        memcpy(dest_p, src_p, layer_w * sizeof(lv_color_t));
+        dest_p += layer_w;
+        src_p += vdb_w;
+    }
+
+    /*Draw into the layer as if it was the display buffer*/
+    layer->buf_ori = vdb->buf_act;
+    lv_area_copy(&layer->area_ori, &vdb->area);
+    vdb->buf_act = layer->buf;
+    lv_area_copy(&vdb->area, &layer->area);
+
+    return true;
+}
+
+#endif /*LV_USE_OPA_LAYER*/
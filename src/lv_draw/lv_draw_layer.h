@@ -0,0 +1,83 @@
+/**
+ * @file lv_draw_layer.h
+ *
+ */
+
+#ifndef LV_DRAW_LAYER_H
+#define LV_DRAW_LAYER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#ifdef LV_CONF_INCLUDE_SIMPLE
+#include "lv_conf.h"
+#else
+#include "../../../lv_conf.h"
+#endif
+
+#if LV_USE_OPA_LAYER
+
+#include "lv_draw.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Redirect the drawing into a layer. The layer starts with the current content of the display buffer
+ * and it's blended back at once with `lv_draw_layer_finish()`.
+ * `lv_draw_layer_finish()` needs to be called after every `lv_draw_layer_start()` even if it failed.
+ * While the draw list is recording the layer's buffer is reserved here, so if the start is recorded
+ * it can't fail when the list is replayed.
+ * @param area the area of the layer. Only the part on the display buffer is used.
+ * @return true: the drawing goes to the layer;
+ *         false: the layer can't be created (no memory, `set_px_cb` or `screen_transp`), draw normally
+ */
+bool lv_draw_layer_start(const lv_area_t * area);
+
+#if LV_USE_DRAW_LIST
+/**
+ * Start a layer recorded into the draw list. Used when the draw list is replayed.
+ * @param area the area of the layer. Only the part on the display buffer is used.
+ * @param level the nesting level of the layer when it was recorded. Its reserved buffer is used.
+ * @return true: the drawing goes to the layer; false: the layer is not on the display buffer
+ */
+bool lv_draw_layer_start_recorded(const lv_area_t * area, uint8_t level);
+
+/**
+ * Free the buffers reserved for the layers while the draw list was recording.
+ * Call it when the draw list won't be replayed anymore.
+ */
+void lv_draw_layer_free_reserved(void);
+#endif
+
+/**
+ * Blend the last started layer back with an opacity and continue drawing where it was before the layer
+ * @param area the same area which was used in `lv_draw_layer_start()`
+ * @param opa opacity of the layer
+ */
+void lv_draw_layer_finish(const lv_area_t * area, lv_opa_t opa);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /*LV_USE_OPA_LAYER*/
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /*LV_DRAW_LAYER_H*/
@@ -8,52 +8,66 @@
  *********************/
 #include <stdio.h>
 #include <stdbool.h>
+#include <string.h>
 #include "lv_draw.h"
 #include "../lv_core/lv_refr.h"
 #include "../lv_misc/lv_math.h"
+#include "lv_draw_list.h"
 
 /*********************
  *      DEFINES
  *********************/
+/*The distances are calculated with this many fractional bits*/
+#define LINE_FRACT_SHIFT 8
+#define LINE_FRACT_ONE (1 << LINE_FRACT_SHIFT)
+#define LINE_FRACT_HALF (1 << (LINE_FRACT_SHIFT - 1))
+
+/* Max. number of segments drawn together (~80 bytes per segment in the draw buffer).
+ * The joints of the chunks are blended twice.*/
+#define LINE_SEG_CHUNK_MAX 64
 
 /**********************
  *      TYPEDEFS
  **********************/
 
+/*A segment of a polyline*/
 typedef struct
 {
     lv_point_t p1;
-    lv_point_t p2;
-    lv_point_t p_act;
     lv_coord_t dx;
-    lv_coord_t sx; /*-1: x1 < x2; 1: x2 >= x1*/
     lv_coord_t dy;
-    lv_coord_t sy; /*-1: y1 < y2; 1: y2 >= y1*/
-    lv_coord_t err;
-    lv_coord_t e2;
-    bool hor; /*Rather horizontal or vertical*/
-} line_draw_t;
-
-typedef struct
-{
-    lv_coord_t width;
-    lv_coord_t width_1;
-    lv_coord_t width_half;
-} line_width_t;
+    int32_t len;       /*Length of the segment [1/LINE_FRACT_ONE px]*/
+    int32_t len_sqr;   /*Square of the length [px^2]*/
+    int32_t len_inv;   /*(1 << 28) / len: converts the cross and dot products to distances*/
+    int64_t x_step;    /*dx / dy [1/65536 px]*/
+    int32_t x_half;    /*Horizontal half width of the pixels around the segment [1/LINE_FRACT_ONE px]*/
+    int32_t x_in_half; /*Horizontal half width of the surely covered pixels [1/LINE_FRACT_ONE px]*/
+    int64_t dot_step;  /*Change of the scaled dot product on a row per pixel*/
+    int64_t crs_step;  /*Change of the scaled cross product on a row per pixel*/
+    lv_area_t area;    /*The segment's pixels are on this area*/
+    lv_line_cap_t cap_start;
+    lv_line_cap_t cap_end;
+} line_seg_t;
 
 /**********************
  *  STATIC PROTOTYPES
  **********************/
-static void line_draw_hor(line_draw_t * main_line, const lv_area_t * mask, const lv_style_t * style,
-                          lv_opa_t opa_scale);
-static void line_draw_ver(line_draw_t * main_line, const lv_area_t * mask, const lv_style_t * style,
-                          lv_opa_t opa_scale);
-static void line_draw_skew(line_draw_t * main_line, bool dir_ori, const lv_area_t * mask, const lv_style_t * style,
-                           lv_opa_t opa_scale);
-static void line_init(line_draw_t * line, const lv_point_t * p1, const lv_point_t * p2);
-static bool line_next(line_draw_t * line);
-static bool line_next_y(line_draw_t * line);
-static bool line_next_x(line_draw_t * line);
+static void line_draw_hor(const lv_point_t * p1, const lv_point_t * p2, const lv_area_t * mask,
+                          const lv_style_t * style, lv_opa_t opa_scale);
+static void line_draw_ver(const lv_point_t * p1, const lv_point_t * p2, const lv_area_t * mask,
+                          const lv_style_t * style, lv_opa_t opa_scale);
+static void polyline_draw(const lv_point_t * points, uint32_t point_cnt, const lv_area_t * mask,
+                          const lv_style_t * style, lv_opa_t opa_scale, lv_line_cap_t cap);
+static bool seg_is_on(const lv_point_t * p1, const lv_point_t * p2, lv_coord_t ext, const lv_area_t * area);
+static void segs_draw(line_seg_t * segs, uint32_t seg_cnt, lv_opa_t * cov, const lv_area_t * draw_area,
+                      int32_t half_w, bool aa, const lv_area_t * mask, lv_color_t color, lv_opa_t opa);
+static void seg_init(line_seg_t * seg, const lv_point_t * p1, const lv_point_t * p2, int32_t half_w, lv_coord_t ext,
+                     const lv_area_t * draw_area);
+static void seg_cov_row(const line_seg_t * seg, lv_coord_t y, int32_t half_w, bool aa, lv_opa_t * cov,
+                        lv_coord_t cov_x, lv_coord_t * x1_res, lv_coord_t * x2_res);
+static int32_t cap_dist(int32_t perp, int32_t out, int32_t half_w, lv_line_cap_t cap);
+static void lin_range(int32_t c, int32_t s, int32_t lo, int32_t hi, int32_t * k1, int32_t * k2);
+static int32_t div_floor(int32_t n, int32_t d);
 
 /**********************
  *  STATIC VARIABLES
@@ -82,556 +96,464 @@ void lv_draw_line(const lv_point_t * point1, const lv_point_t * point2, const lv
     if(style->line.width == 0) return;
     if(point1->x == point2->x && point1->y == point2->y) return;
 
+#if LV_USE_DRAW_LIST
+    if(lv_draw_list_is_recording()) {
+        lv_draw_list_add_line(point1, point2, mask, style, opa_scale);
+        return;
+    }
+#endif
+
     /*Return if the points are out of the mask*/
     if(point1->x < mask->x1 - style->line.width && point2->x < mask->x1 - style->line.width) return;
     if(point1->x > mask->x2 + style->line.width && point2->x > mask->x2 + style->line.width) return;
     if(point1->y < mask->y1 - style->line.width && point2->y < mask->y1 - style->line.width) return;
     if(point1->y > mask->y2 + style->line.width && point2->y > mask->y2 + style->line.width) return;
 
-    line_draw_t main_line;
-    lv_point_t p1;
-    lv_point_t p2;
-
-    /*If the line if rather vertical then be sure y1 < y2 else x1 < x2*/
-
-    if(LV_MATH_ABS(point1->x - point2->x) > LV_MATH_ABS(point1->y - point2->y)) {
-
-        /*Steps less in y then x -> rather horizontal*/
-        if(point1->x < point2->x) {
-            p1.x = point1->x;
-            p1.y = point1->y;
-            p2.x = point2->x;
-            p2.y = point2->y;
-        } else {
-            p1.x = point2->x;
-            p1.y = point2->y;
-            p2.x = point1->x;
-            p2.y = point1->y;
-        }
-    } else {
-        /*Steps less in x then y -> rather vertical*/
-        if(point1->y < point2->y) {
-            p1.x = point1->x;
-            p1.y = point1->y;
-            p2.x = point2->x;
-            p2.y = point2->y;
-        } else {
-            p1.x = point2->x;
-            p1.y = point2->y;
-            p2.x = point1->x;
-            p2.y = point1->y;
-        }
-    }
-
-    line_init(&main_line, &p1, &p2);
-
     /*Special case draw a horizontal line*/
-    if(main_line.p1.y == main_line.p2.y) {
-        line_draw_hor(&main_line, mask, style, opa_scale);
+    if(point1->y == point2->y) {
+        line_draw_hor(point1, point2, mask, style, opa_scale);
     }
     /*Special case draw a vertical line*/
-    else if(main_line.p1.x == main_line.p2.x) {
-        line_draw_ver(&main_line, mask, style, opa_scale);
+    else if(point1->x == point2->x) {
+        line_draw_ver(point1, point2, mask, style, opa_scale);
     }
     /*Arbitrary skew line*/
     else {
-        bool dir_ori = false;
-#if LV_ANTIALIAS
-        bool aa = lv_disp_get_antialiasing(lv_refr_get_disp_refreshing());
-        if(aa) {
-            lv_point_t p_tmp;
-
-            if(main_line.hor) {
-                if(main_line.p1.y < main_line.p2.y) {
-                    dir_ori = true;
-                    p_tmp.x = main_line.p2.x;
-                    p_tmp.y = main_line.p2.y - 1;
-                    line_init(&main_line, &p1, &p_tmp);
-                    main_line.sy = LV_MATH_ABS(main_line.sy); /*The sign can change if the line becomes horizontal*/
-                } else if(main_line.p1.y > main_line.p2.y) {
-                    dir_ori = false;
-                    p_tmp.x = main_line.p2.x;
-                    p_tmp.y = main_line.p2.y + 1;
-                    line_init(&main_line, &p1, &p_tmp);
-                    main_line.sy = -LV_MATH_ABS(main_line.sy); /*The sign can change if the line becomes horizontal*/
-                }
-            } else {
-                if(main_line.p1.x < main_line.p2.x) {
-                    dir_ori = true;
-                    p_tmp.x = main_line.p2.x - 1;
-                    p_tmp.y = main_line.p2.y;
-                    line_init(&main_line, &p1, &p_tmp);
-                    main_line.sx = LV_MATH_ABS(main_line.sx); /*The sign can change if the line becomes vertical*/
-                } else if(main_line.p1.x > main_line.p2.x) {
-                    dir_ori = false;
-                    p_tmp.x = main_line.p2.x + 1;
-                    p_tmp.y = main_line.p2.y;
-                    line_init(&main_line, &p1, &p_tmp);
-                    main_line.sx = -LV_MATH_ABS(main_line.sx); /*The sign can change if the line becomes vertical*/
-                }
-            }
-        }
-#endif
-        line_draw_skew(&main_line, dir_ori, mask, style, opa_scale);
+        lv_point_t points[2];
+        points[0] = *point1;
+        points[1] = *point2;
+        polyline_draw(points, 2, mask, style, opa_scale, LV_LINE_CAP_BUTT);
     }
 }
 
+/**
+ * Draw connected lines. The joints are rounded and overlapping segments are not blended twice.
+ * Faster than drawing the segments one by one with `lv_draw_line()`.
+ * @param points array of points
+ * @param point_cnt number of points
+ * @param mask the lines will be drawn only on this area
+ * @param style pointer to a line's style
+ * @param opa_scale scale down all opacities by the factor
+ * @param cap shape of the two ends of the polyline. E.g. `LV_LINE_CAP_ROUND`
+ */
+void lv_draw_polyline(const lv_point_t * points, uint32_t point_cnt, const lv_area_t * mask,
+                      const lv_style_t * style, lv_opa_t opa_scale, lv_line_cap_t cap)
+{
+    if(style->line.width == 0 || point_cnt < 2 || points == NULL) return;
+
+#if LV_USE_DRAW_LIST
+    if(lv_draw_list_is_recording()) {
+        lv_draw_list_add_polyline(points, point_cnt, mask, style, opa_scale, cap);
+        return;
+    }
+#endif
+
+    polyline_draw(points, point_cnt, mask, style, opa_scale, cap);
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
 
-static void line_draw_hor(line_draw_t * main_line, const lv_area_t * mask, const lv_style_t * style, lv_opa_t opa_scale)
+static void line_draw_hor(const lv_point_t * p1, const lv_point_t * p2, const lv_area_t * mask,
+                          const lv_style_t * style, lv_opa_t opa_scale)
 {
     lv_coord_t width      = style->line.width - 1;
     lv_coord_t width_half = width >> 1;
     lv_coord_t width_1    = width & 0x1;
     lv_opa_t opa = opa_scale == LV_OPA_COVER ? style->line.opa : (uint16_t)((uint16_t)style->line.opa * opa_scale) >> 8;
 
-    lv_area_t act_area;
-    act_area.x1 = main_line->p1.x;
-    act_area.x2 = main_line->p2.x;
-    act_area.y1 = main_line->p1.y - width_half - width_1;
-    act_area.y2 = main_line->p2.y + width_half;
-
     lv_area_t draw_area;
-    draw_area.x1 = LV_MATH_MIN(act_area.x1, act_area.x2);
-    draw_area.x2 = LV_MATH_MAX(act_area.x1, act_area.x2);
-    draw_area.y1 = LV_MATH_MIN(act_area.y1, act_area.y2);
-    draw_area.y2 = LV_MATH_MAX(act_area.y1, act_area.y2);
+    draw_area.x1 = LV_MATH_MIN(p1->x, p2->x);
+    draw_area.x2 = LV_MATH_MAX(p1->x, p2->x);
+    draw_area.y1 = p1->y - width_half - width_1;
+    draw_area.y2 = p1->y + width_half;
     lv_draw_fill(&draw_area, mask, style->line.color, opa);
 }
 
-static void line_draw_ver(line_draw_t * main_line, const lv_area_t * mask, const lv_style_t * style, lv_opa_t opa_scale)
+static void line_draw_ver(const lv_point_t * p1, const lv_point_t * p2, const lv_area_t * mask,
+                          const lv_style_t * style, lv_opa_t opa_scale)
 {
     lv_coord_t width      = style->line.width - 1;
     lv_coord_t width_half = width >> 1;
     lv_coord_t width_1    = width & 0x1;
     lv_opa_t opa = opa_scale == LV_OPA_COVER ? style->line.opa : (uint16_t)((uint16_t)style->line.opa * opa_scale) >> 8;
 
-    lv_area_t act_area;
-    act_area.x1 = main_line->p1.x - width_half;
-    act_area.x2 = main_line->p2.x + width_half + width_1;
-    act_area.y1 = main_line->p1.y;
-    act_area.y2 = main_line->p2.y;
-
     lv_area_t draw_area;
-    draw_area.x1 = LV_MATH_MIN(act_area.x1, act_area.x2);
-    draw_area.x2 = LV_MATH_MAX(act_area.x1, act_area.x2);
-    draw_area.y1 = LV_MATH_MIN(act_area.y1, act_area.y2);
-    draw_area.y2 = LV_MATH_MAX(act_area.y1, act_area.y2);
+    draw_area.x1 = p1->x - width_half;
+    draw_area.x2 = p1->x + width_half + width_1;
+    draw_area.y1 = LV_MATH_MIN(p1->y, p2->y);
+    draw_area.y2 = LV_MATH_MAX(p1->y, p2->y);
     lv_draw_fill(&draw_area, mask, style->line.color, opa);
 }
 
-static void line_draw_skew(line_draw_t * main_line, bool dir_ori, const lv_area_t * mask, const lv_style_t * style,
-                           lv_opa_t opa_scale)
+/**
+ * Draw a polyline row by row. The coverage of the pixels is calculated from their distance to the segments.
+ * The coverage of a row is collected from the segments (max. `LINE_SEG_CHUNK_MAX` at once) and drawn as one span.
+ * @param points array of points
+ * @param point_cnt number of points (>= 2)
+ * @param mask the lines will be drawn only on this area
+ * @param style pointer to a line's style
+ * @param opa_scale scale down all opacities by the factor
+ * @param cap shape of the two ends of the polyline
+ */
+static void polyline_draw(const lv_point_t * points, uint32_t point_cnt, const lv_area_t * mask,
+                          const lv_style_t * style, lv_opa_t opa_scale, lv_line_cap_t cap)
 {
-
     lv_opa_t opa = opa_scale == LV_OPA_COVER ? style->line.opa : (uint16_t)((uint16_t)style->line.opa * opa_scale) >> 8;
-#if LV_ANTIALIAS
+    if(opa < LV_OPA_MIN) return;
+
     bool aa = lv_disp_get_antialiasing(lv_refr_get_disp_refreshing());
-#endif
-    lv_point_t vect_main, vect_norm;
-    vect_main.x = main_line->p2.x - main_line->p1.x;
-    vect_main.y = main_line->p2.y - main_line->p1.y;
-
-    if(main_line->hor) {
-        if(main_line->p1.y < main_line->p2.y + dir_ori) {
-            vect_norm.x = -vect_main.y;
-            vect_norm.y = vect_main.x;
-        } else {
-            vect_norm.x = vect_main.y;
-            vect_norm.y = -vect_main.x;
-        }
-    } else {
-        if(main_line->p1.x < main_line->p2.x + dir_ori) {
-            vect_norm.x = vect_main.y;
-            vect_norm.y = -vect_main.x;
-        } else {
-            vect_norm.x = -vect_main.y;
-            vect_norm.y = vect_main.x;
-        }
+
+    /*Half width of the line and the farthest pixel from the points (round and square caps + 1 px anti-aliasing)*/
+    int32_t half_w = (int32_t)style->line.width << (LINE_FRACT_SHIFT - 1);
+    lv_coord_t ext = (style->line.width >> 1) + 2;
+
+    lv_area_t draw_area;
+    draw_area.x1 = LV_COORD_MAX;
+    draw_area.y1 = LV_COORD_MAX;
+    draw_area.x2 = LV_COORD_MIN;
+    draw_area.y2 = LV_COORD_MIN;
+    uint32_t i;
+    for(i = 0; i < point_cnt; i++) {
+        draw_area.x1 = LV_MATH_MIN(draw_area.x1, points[i].x - ext);
+        draw_area.y1 = LV_MATH_MIN(draw_area.y1, points[i].y - ext);
+        draw_area.x2 = LV_MATH_MAX(draw_area.x2, points[i].x + ext);
+        draw_area.y2 = LV_MATH_MAX(draw_area.y2, points[i].y + ext);
+    }
+    if(lv_area_intersect(&draw_area, &draw_area, mask) == false) return;
+
+    /*The first and last segments get `cap`, the inner ends are round to join them without gaps*/
+    uint32_t seg_first = point_cnt;
+    uint32_t seg_last  = 0;
+    uint32_t vis_cnt   = 0;
+    for(i = 0; i < point_cnt - 1; i++) {
+        if(points[i].x == points[i + 1].x && points[i].y == points[i + 1].y) continue;
+        if(seg_first == point_cnt) seg_first = i;
+        seg_last = i;
+        if(seg_is_on(&points[i], &points[i + 1], ext, &draw_area)) vis_cnt++;
+    }
+    if(vis_cnt == 0) return;
+
+    /*Only the segments on the draw area are stored, in chunks if there are many or there is not enough memory.
+     *The segments and the coverage of a row share the draw buffer.*/
+    lv_coord_t draw_w  = lv_area_get_width(&draw_area);
+    uint32_t chunk_max = LV_MATH_MIN(vis_cnt, LINE_SEG_CHUNK_MAX);
+    uint8_t * buf;
+    while(1) {
+        buf = lv_draw_try_get_buf(chunk_max * sizeof(line_seg_t) + draw_w);
+        if(buf != NULL || chunk_max == 1) break;
+        chunk_max = chunk_max >> 1;
+    }
+    if(buf == NULL) {
+        LV_LOG_WARN("lv_draw_polyline: no memory to draw the line");
+        return;
     }
 
-    /* In case of a short but tick line the perpendicular ending is longer then the real line.
-     * it would break the calculations so make the normal vector larger*/
-    vect_norm.x = vect_norm.x << 4;
-    vect_norm.y = vect_norm.y << 4;
-
-    lv_coord_t width;
-    width = style->line.width;
-
-    /* The pattern stores the points of the line ending. It has the good direction and length.
-     * The worth case is the 45° line where pattern can have 1.41 x `width` points*/
-
-    lv_coord_t pattern_size = width * 2;
-    lv_point_t * pattern = lv_draw_get_buf(pattern_size * sizeof(lv_point_t));
-    lv_coord_t i = 0;
-
-    /*Create a perpendicular pattern (a small line)*/
-    if(width != 0) {
-        line_draw_t pattern_line;
-        lv_point_t p0 = {0, 0};
-        line_init(&pattern_line, &p0, &vect_norm);
-
-        uint32_t width_sqr = width * width;
-        /* Run for a lot of times. Meanwhile the real width will be determined as well */
-        for(i = 0; i < (lv_coord_t)pattern_size - 1; i++) {
-            pattern[i].x = pattern_line.p_act.x;
-            pattern[i].y = pattern_line.p_act.y;
-
-            /*Finish the pattern line if it's length equal to the desired width (Use Pythagoras
-             * theorem)*/
-            uint32_t sqr = pattern_line.p_act.x * pattern_line.p_act.x + pattern_line.p_act.y * pattern_line.p_act.y;
-            if(sqr >= width_sqr) {
-                width = i;
-#if LV_ANTIALIAS
-                if(aa) width--;
-#endif
-                break;
-            }
+    line_seg_t * segs = (line_seg_t *)buf;
+    lv_opa_t * cov    = (lv_opa_t *)(buf + chunk_max * sizeof(line_seg_t));
+    memset(cov, 0, draw_w);
 
-            line_next(&pattern_line);
+    uint32_t seg_cnt = 0;
+    for(i = seg_first; i <= seg_last; i++) {
+        if(points[i].x == points[i + 1].x && points[i].y == points[i + 1].y) continue;
+        if(seg_is_on(&points[i], &points[i + 1], ext, &draw_area) == false) continue;
+
+        seg_init(&segs[seg_cnt], &points[i], &points[i + 1], half_w, ext, &draw_area);
+        segs[seg_cnt].cap_start = i == seg_first ? cap : LV_LINE_CAP_ROUND;
+        segs[seg_cnt].cap_end   = i == seg_last ? cap : LV_LINE_CAP_ROUND;
+        seg_cnt++;
+
+        if(seg_cnt == chunk_max) {
+            segs_draw(segs, seg_cnt, cov, &draw_area, half_w, aa, mask, style->line.color, opa);
+            seg_cnt = 0;
         }
     }
 
-#if LV_ANTIALIAS
-    lv_coord_t aa_last_corner;
-    lv_coord_t width_safe = width;
-    if(aa) {
-        if(width == 0) width_safe = 1;
+    if(seg_cnt) segs_draw(segs, seg_cnt, cov, &draw_area, half_w, aa, mask, style->line.color, opa);
+}
 
-        aa_last_corner = 0;
-    }
-#endif
+/**
+ * Tell whether a segment of a polyline can have pixels on an area
+ * @param p1 start point
+ * @param p2 end point
+ * @param ext the farthest pixel of the segment from the points
+ * @param area the area to check
+ * @return true: the segment can be on the area
+ */
+static bool seg_is_on(const lv_point_t * p1, const lv_point_t * p2, lv_coord_t ext, const lv_area_t * area)
+{
+    if(LV_MATH_MAX(p1->x, p2->x) + ext < area->x1) return false;
+    if(LV_MATH_MIN(p1->x, p2->x) - ext > area->x2) return false;
+    if(LV_MATH_MAX(p1->y, p2->y) + ext < area->y1) return false;
+    if(LV_MATH_MIN(p1->y, p2->y) - ext > area->y2) return false;
 
-    lv_coord_t x_center_ofs = 0;
-    lv_coord_t y_center_ofs = 0;
+    return true;
+}
 
-    if(width != 0) {
-        x_center_ofs = pattern[width - 1].x / 2;
-        y_center_ofs = pattern[width - 1].y / 2;
-    } else {
-        if(main_line->hor && main_line->p1.y >= main_line->p2.y + dir_ori) pattern[0].y--;
-        if(!main_line->hor && main_line->p1.x >= main_line->p2.x + dir_ori) pattern[0].x--;
+/**
+ * Draw segments of a polyline row by row. Where the segments overlap the pixels are blended only once.
+ * @param segs array of initialized segments
+ * @param seg_cnt number of segments
+ * @param cov coverage buffer for a row of `draw_area`. Cleared.
+ * @param draw_area the area of the segments
+ * @param half_w half width of the line [1/LINE_FRACT_ONE px]
+ * @param aa true: anti-aliasing
+ * @param mask the lines will be drawn only on this area
+ * @param color color of the line
+ * @param opa opacity of the line
+ */
+static void segs_draw(line_seg_t * segs, uint32_t seg_cnt, lv_opa_t * cov, const lv_area_t * draw_area,
+                      int32_t half_w, bool aa, const lv_area_t * mask, lv_color_t color, lv_opa_t opa)
+{
+    /*Draw only the rows of the segments*/
+    lv_coord_t y1 = LV_COORD_MAX;
+    lv_coord_t y2 = LV_COORD_MIN;
+    uint32_t i;
+    for(i = 0; i < seg_cnt; i++) {
+        y1 = LV_MATH_MIN(y1, segs[i].area.y1);
+        y2 = LV_MATH_MAX(y2, segs[i].area.y2);
     }
 
-    /* Make the coordinates relative to the center */
-    for(i = 0; i < width; i++) {
-        pattern[i].x -= x_center_ofs;
-        pattern[i].y -= y_center_ofs;
-#if LV_ANTIALIAS
-        if(aa) {
-            if(i != 0) {
-                if(main_line->hor) {
-                    if(pattern[i - 1].x != pattern[i].x) {
-                        lv_coord_t seg_w = pattern[i].y - pattern[aa_last_corner].y;
-                        if(main_line->sy < 0) {
-                            lv_draw_aa_ver_seg(main_line->p1.x + pattern[aa_last_corner].x - 1,
-                                               main_line->p1.y + pattern[aa_last_corner].y + seg_w + 1, seg_w, mask,
-                                               style->line.color, opa);
-
-                            lv_draw_aa_ver_seg(main_line->p2.x + pattern[aa_last_corner].x + 1,
-                                               main_line->p2.y + pattern[aa_last_corner].y + seg_w + 1, -seg_w, mask,
-                                               style->line.color, opa);
-                        } else {
-                            lv_draw_aa_ver_seg(main_line->p1.x + pattern[aa_last_corner].x - 1,
-                                               main_line->p1.y + pattern[aa_last_corner].y, seg_w, mask,
-                                               style->line.color, opa);
-
-                            lv_draw_aa_ver_seg(main_line->p2.x + pattern[aa_last_corner].x + 1,
-                                               main_line->p2.y + pattern[aa_last_corner].y, -seg_w, mask,
-                                               style->line.color, opa);
-                        }
-                        aa_last_corner = i;
-                    }
-                } else {
-                    if(pattern[i - 1].y != pattern[i].y) {
-                        lv_coord_t seg_w = pattern[i].x - pattern[aa_last_corner].x;
-                        if(main_line->sx < 0) {
-                            lv_draw_aa_hor_seg(main_line->p1.x + pattern[aa_last_corner].x + seg_w + 1,
-                                               main_line->p1.y + pattern[aa_last_corner].y - 1, seg_w, mask,
-                                               style->line.color, opa);
-
-                            lv_draw_aa_hor_seg(main_line->p2.x + pattern[aa_last_corner].x + seg_w + 1,
-                                               main_line->p2.y + pattern[aa_last_corner].y + 1, -seg_w, mask,
-                                               style->line.color, opa);
-                        } else {
-                            lv_draw_aa_hor_seg(main_line->p1.x + pattern[aa_last_corner].x,
-                                               main_line->p1.y + pattern[aa_last_corner].y - 1, seg_w, mask,
-                                               style->line.color, opa);
-
-                            lv_draw_aa_hor_seg(main_line->p2.x + pattern[aa_last_corner].x,
-                                               main_line->p2.y + pattern[aa_last_corner].y + 1, -seg_w, mask,
-                                               style->line.color, opa);
-                        }
-                        aa_last_corner = i;
-                    }
-                }
-            }
-        }
-#endif
-    }
+    lv_coord_t y;
+    for(y = y1; y <= y2; y++) {
+        /*The covered part of the row*/
+        lv_coord_t row_x1 = LV_COORD_MAX;
+        lv_coord_t row_x2 = LV_COORD_MIN;
 
-#if LV_ANTIALIAS
-    /*Add the last part of anti-aliasing for the perpendicular ending*/
-    if(width != 0 && aa) { /*Due to rounding error with very thin lines it looks ugly*/
-        if(main_line->hor) {
-            lv_coord_t seg_w = pattern[width_safe - 1].y - pattern[aa_last_corner].y;
-            if(main_line->sy < 0) {
-                lv_draw_aa_ver_seg(main_line->p1.x + pattern[aa_last_corner].x - 1,
-                                   main_line->p1.y + pattern[aa_last_corner].y + seg_w, seg_w + main_line->sy, mask,
-                                   style->line.color, opa);
-
-                lv_draw_aa_ver_seg(main_line->p2.x + pattern[aa_last_corner].x + 1,
-                                   main_line->p2.y + pattern[aa_last_corner].y + seg_w, -(seg_w + main_line->sy), mask,
-                                   style->line.color, opa);
-
-            } else {
-                lv_draw_aa_ver_seg(main_line->p1.x + pattern[aa_last_corner].x - 1,
-                                   main_line->p1.y + pattern[aa_last_corner].y, seg_w + main_line->sy, mask,
-                                   style->line.color, opa);
-
-                lv_draw_aa_ver_seg(main_line->p2.x + pattern[aa_last_corner].x + 1,
-                                   main_line->p2.y + pattern[aa_last_corner].y, -(seg_w + main_line->sy), mask,
-                                   style->line.color, opa);
-            }
-        } else {
-            lv_coord_t seg_w = pattern[width_safe - 1].x - pattern[aa_last_corner].x;
-            if(main_line->sx < 0) {
-                lv_draw_aa_hor_seg(main_line->p1.x + pattern[aa_last_corner].x + seg_w,
-                                   main_line->p1.y + pattern[aa_last_corner].y - 1, seg_w + main_line->sx, mask,
-                                   style->line.color, opa);
-
-                lv_draw_aa_hor_seg(main_line->p2.x + pattern[aa_last_corner].x + seg_w,
-                                   main_line->p2.y + pattern[aa_last_corner].y + 1, -(seg_w + main_line->sx), mask,
-                                   style->line.color, opa);
-
-            } else {
-                lv_draw_aa_hor_seg(main_line->p1.x + pattern[aa_last_corner].x,
-                                   main_line->p1.y + pattern[aa_last_corner].y - 1, seg_w + main_line->sx, mask,
-                                   style->line.color, opa);
-
-                lv_draw_aa_hor_seg(main_line->p2.x + pattern[aa_last_corner].x,
-                                   main_line->p2.y + pattern[aa_last_corner].y + 1, -(seg_w + main_line->sx), mask,
-                                   style->line.color, opa);
-            }
-        }
-    }
-#endif
+        for(i = 0; i < seg_cnt; i++) {
+            line_seg_t * seg = &segs[i];
+            if(y < seg->area.y1 || y > seg->area.y2) continue;
 
-#if LV_ANTIALIAS
-
-    /*Shift the anti aliasing on the edges (-1, 1 or 0 (zero only in case width == 0))*/
-    lv_coord_t aa_shift1 = 0;
-    lv_coord_t aa_shift2 = 0;
-    if(aa) {
-        if(main_line->hor == false) {
-            if(main_line->sx < 0) {
-                aa_shift1 = -1;
-                aa_shift2 = width == 0 ? 0 : aa_shift1;
-            } else {
-                aa_shift2 = 1;
-                aa_shift1 = width == 0 ? 0 : aa_shift2;
-            }
-        } else {
-            if(main_line->sy < 0) {
-                aa_shift1 = -1;
-                aa_shift2 = width == 0 ? 0 : aa_shift1;
-            } else {
-                aa_shift2 = 1;
-                aa_shift1 = width == 0 ? 0 : aa_shift2;
-            }
+            lv_coord_t x1;
+            lv_coord_t x2;
+            seg_cov_row(seg, y, half_w, aa, cov, draw_area->x1, &x1, &x2);
+            if(x1 > x2) continue;
+
+            row_x1 = LV_MATH_MIN(row_x1, x1);
+            row_x2 = LV_MATH_MAX(row_x2, x2);
         }
+
+        if(row_x1 > row_x2) continue;
+
+        lv_opa_t * row_cov = &cov[row_x1 - draw_area->x1];
+        lv_draw_cov_row(row_x1, y, row_x2 - row_x1 + 1, row_cov, mask, color, opa);
+        memset(row_cov, 0, row_x2 - row_x1 + 1);
     }
-#endif
+}
 
-    volatile lv_point_t prev_p;
-    prev_p.x = main_line->p1.x;
-    prev_p.y = main_line->p1.y;
-    lv_area_t draw_area;
-    bool first_run = true;
-
-    if(main_line->hor) {
-        while(line_next_y(main_line)) {
-            for(i = 0; i < width; i++) {
-                draw_area.x1 = prev_p.x + pattern[i].x;
-                draw_area.y1 = prev_p.y + pattern[i].y;
-                draw_area.x2 = draw_area.x1 + main_line->p_act.x - prev_p.x - 1;
-                draw_area.y2 = draw_area.y1;
-                lv_draw_fill(&draw_area, mask, style->line.color, opa);
-
-                /* Fill the gaps
-                 * When stepping in y one pixel remains empty on every corner (don't do this on the
-                 * first segment ) */
-                if(i != 0 && pattern[i].x != pattern[i - 1].x && !first_run) {
-                    lv_draw_px(draw_area.x1, draw_area.y1 - main_line->sy, mask, style->line.color, opa);
-                }
-            }
-
-#if LV_ANTIALIAS
-            if(aa) {
-                lv_draw_aa_hor_seg(prev_p.x + pattern[0].x, prev_p.y + pattern[0].y - aa_shift1,
-                                   -(main_line->p_act.x - prev_p.x), mask, style->line.color, opa);
-                lv_draw_aa_hor_seg(prev_p.x + pattern[width_safe - 1].x,
-                                   prev_p.y + pattern[width_safe - 1].y + aa_shift2, main_line->p_act.x - prev_p.x,
-                                   mask, style->line.color, opa);
-            }
-#endif
+/**
+ * Initialize a segment of a polyline
+ * @param seg pointer to a segment to initialize
+ * @param p1 start point
+ * @param p2 end point (not equal to `p1`)
+ * @param half_w half width of the line [1/LINE_FRACT_ONE px]
+ * @param ext the farthest pixel of the segment from the points
+ * @param draw_area the pixels of the segments are drawn only on this area
+ */
+static void seg_init(line_seg_t * seg, const lv_point_t * p1, const lv_point_t * p2, int32_t half_w, lv_coord_t ext,
+                     const lv_area_t * draw_area)
+{
+    seg->p1 = *p1;
+    seg->dx = p2->x - p1->x;
+    seg->dy = p2->y - p1->y;
+
+    /*Length with 4 fractional bits if it fits, else in whole pixels*/
+    uint32_t len_sqr = (uint32_t)((int32_t)seg->dx * seg->dx) + (uint32_t)((int32_t)seg->dy * seg->dy);
+    seg->len_sqr     = len_sqr;
+    if(len_sqr < (1UL << 24)) seg->len = lv_sqrt(len_sqr << 8) << (LINE_FRACT_SHIFT - 4);
+    else seg->len = lv_sqrt(len_sqr) << LINE_FRACT_SHIFT;
+    seg->len_inv = (1L << 28) / seg->len;
+
+    /*Where the center of the segment is on a row and how far its pixels can be from there*/
+    if(seg->dy != 0) {
+        int32_t dy_abs = LV_MATH_ABS(seg->dy) << LINE_FRACT_SHIFT;
+        seg->x_step    = ((int64_t)seg->dx << 16) / seg->dy;
+        seg->x_half    = (int32_t)(((int64_t)(half_w + LINE_FRACT_HALF + 8) * seg->len) / dy_abs);
+        seg->x_in_half = (int32_t)(((int64_t)(half_w - LINE_FRACT_HALF - 16) * seg->len) / dy_abs);
+    }
 
-            first_run = false;
+    seg->dot_step = (int64_t)seg->dx * seg->len_inv;
+    seg->crs_step = (int64_t)seg->dy * seg->len_inv;
 
-            prev_p.x = main_line->p_act.x;
-            prev_p.y = main_line->p_act.y;
-        }
+    seg->area.x1 = LV_MATH_MAX(LV_MATH_MIN(p1->x, p2->x) - ext, draw_area->x1);
+    seg->area.x2 = LV_MATH_MIN(LV_MATH_MAX(p1->x, p2->x) + ext, draw_area->x2);
+    seg->area.y1 = LV_MATH_MAX(LV_MATH_MIN(p1->y, p2->y) - ext, draw_area->y1);
+    seg->area.y2 = LV_MATH_MIN(LV_MATH_MAX(p1->y, p2->y) + ext, draw_area->y2);
+}
 
-        for(i = 0; i < width; i++) {
-            draw_area.x1 = prev_p.x + pattern[i].x;
-            draw_area.y1 = prev_p.y + pattern[i].y;
-            draw_area.x2 = draw_area.x1 + main_line->p_act.x - prev_p.x;
-            draw_area.y2 = draw_area.y1;
-            lv_draw_fill(&draw_area, mask, style->line.color, opa);
-
-            /* Fill the gaps
-             * When stepping in y one pixel remains empty on every corner */
-            if(i != 0 && pattern[i].x != pattern[i - 1].x && !first_run) {
-                lv_draw_px(draw_area.x1, draw_area.y1 - main_line->sy, mask, style->line.color, opa);
-            }
+/**
+ * Add the coverage of a segment to a row
+ * @param seg pointer to a segment
+ * @param y the row (on the segment's area)
+ * @param half_w half width of the line [1/LINE_FRACT_ONE px]
+ * @param aa true: anti-aliasing
+ * @param cov coverage of the row. Increased where the segment covers a pixel more.
+ * @param cov_x x coordinate of `cov[0]`
+ * @param x1_res store the first checked pixel here
+ * @param x2_res store the last checked pixel here (`x2_res < x1_res` if the segment is not on the row)
+ */
+static void seg_cov_row(const line_seg_t * seg, lv_coord_t y, int32_t half_w, bool aa, lv_opa_t * cov,
+                        lv_coord_t cov_x, lv_coord_t * x1_res, lv_coord_t * x2_res)
+{
+    *x1_res = 0;
+    *x2_res = -1;
+
+    /*Only the pixels close to the line are checked. On horizontal segments it's the whole area.
+     *The surely covered pixels are in the middle.*/
+    lv_coord_t x1    = seg->area.x1;
+    lv_coord_t x2    = seg->area.x2;
+    lv_coord_t in_x1 = 0;
+    lv_coord_t in_x2 = -1;
+    int32_t ry       = y - seg->p1.y;
+    if(seg->dy != 0) {
+        int32_t x_mid =
+            ((int32_t)seg->p1.x << LINE_FRACT_SHIFT) + (int32_t)((ry * seg->x_step) >> (16 - LINE_FRACT_SHIFT));
+        x1 = LV_MATH_MAX(x1, (x_mid - seg->x_half) >> LINE_FRACT_SHIFT);
+        x2 = LV_MATH_MIN(x2, (x_mid + seg->x_half + LINE_FRACT_ONE - 1) >> LINE_FRACT_SHIFT);
+        if(seg->x_in_half > 0) {
+            in_x1 = LV_MATH_MAX(x1, (x_mid - seg->x_in_half + LINE_FRACT_ONE - 1) >> LINE_FRACT_SHIFT);
+            in_x2 = LV_MATH_MIN(x2, (x_mid + seg->x_in_half) >> LINE_FRACT_SHIFT);
         }
-
-#if LV_ANTIALIAS
-        if(aa) {
-            lv_draw_aa_hor_seg(prev_p.x + pattern[0].x, prev_p.y + pattern[0].y - aa_shift1,
-                               -(main_line->p_act.x - prev_p.x + 1), mask, style->line.color, opa);
-            lv_draw_aa_hor_seg(prev_p.x + pattern[width_safe - 1].x, prev_p.y + pattern[width_safe - 1].y + aa_shift2,
-                               main_line->p_act.x - prev_p.x + 1, mask, style->line.color, opa);
+    } else if((LV_MATH_ABS(ry) << LINE_FRACT_SHIFT) <= half_w - LINE_FRACT_HALF - 16) {
+        in_x1 = x1;
+        in_x2 = x2;
+    }
+    if(x1 > x2) return;
+
+    *x1_res = x1;
+    *x2_res = x2;
+
+    /*Dot and cross product of (pixel - p1) and the direction scaled by the length.
+     *They are the distance along the segment and the distance from the segment.*/
+    int32_t rx     = x1 - seg->p1.x;
+    int64_t dot_sc = (int64_t)(rx * seg->dx + ry * seg->dy) * seg->len_inv;
+    int64_t crs_sc = (int64_t)(rx * seg->dy - ry * seg->dx) * seg->len_inv;
+
+    /*The inner pixels are covered only if they are not beyond the ends*/
+    if(in_x1 <= in_x2) {
+        int32_t along1 = (int32_t)((dot_sc + (in_x1 - x1) * seg->dot_step) >> (28 - 2 * LINE_FRACT_SHIFT));
+        int32_t along2 = (int32_t)((dot_sc + (in_x2 - x1) * seg->dot_step) >> (28 - 2 * LINE_FRACT_SHIFT));
+        if(along1 < 0 || along1 > seg->len || along2 < 0 || along2 > seg->len) {
+            int32_t in_k1 = in_x1 - x1;
+            int32_t in_k2 = in_x2 - x1;
+            lin_range(rx * seg->dx + ry * seg->dy, seg->dx, 1, seg->len_sqr - 1, &in_k1, &in_k2);
+            in_x1 = x1 + in_k1;
+            in_x2 = x1 + in_k2;
         }
-#endif
     }
-    /*Rather a vertical line*/
-    else {
-
-        while(line_next_x(main_line)) {
-            for(i = 0; i < width; i++) {
-                draw_area.x1 = prev_p.x + pattern[i].x;
-                draw_area.y1 = prev_p.y + pattern[i].y;
-                draw_area.x2 = draw_area.x1;
-                draw_area.y2 = draw_area.y1 + main_line->p_act.y - prev_p.y - 1;
-
-                lv_draw_fill(&draw_area, mask, style->line.color, opa);
-
-                /* Fill the gaps
-                 * When stepping in x one pixel remains empty on every corner (don't do this on the
-                 * first segment ) */
-                if(i != 0 && pattern[i].y != pattern[i - 1].y && !first_run) {
-                    lv_draw_px(draw_area.x1 - main_line->sx, draw_area.y1, mask, style->line.color, opa);
-                }
-            }
-
-#if LV_ANTIALIAS
-            if(aa) {
-                lv_draw_aa_ver_seg(prev_p.x + pattern[0].x - aa_shift1, prev_p.y + pattern[0].y,
-                                   -(main_line->p_act.y - prev_p.y), mask, style->line.color, opa);
-                lv_draw_aa_ver_seg(prev_p.x + pattern[width_safe - 1].x + aa_shift2,
-                                   prev_p.y + pattern[width_safe - 1].y, main_line->p_act.y - prev_p.y, mask,
-                                   style->line.color, opa);
-            }
-#endif
-
-            first_run = false;
 
-            prev_p.x = main_line->p_act.x;
-            prev_p.y = main_line->p_act.y;
+    cov += x1 - cov_x;
+    lv_coord_t x;
+    for(x = x1; x <= x2; x++, dot_sc += seg->dot_step, crs_sc += seg->crs_step) {
+        if(x == in_x1 && in_x1 <= in_x2) {
+            memset(&cov[x - x1], LV_OPA_COVER, in_x2 - in_x1 + 1);
+            dot_sc += (in_x2 - in_x1) * seg->dot_step;
+            crs_sc += (in_x2 - in_x1) * seg->crs_step;
+            x = in_x2;
+            continue;
         }
 
-        /*Draw the last part*/
-        for(i = 0; i < width; i++) {
-            draw_area.x1 = prev_p.x + pattern[i].x;
-            draw_area.y1 = prev_p.y + pattern[i].y;
-            draw_area.x2 = draw_area.x1;
-            draw_area.y2 = draw_area.y1 + main_line->p_act.y - prev_p.y;
+        /*Already covered by an other segment*/
+        if(cov[x - x1] == LV_OPA_COVER) continue;
 
-            lv_draw_fill(&draw_area, mask, style->line.color, opa);
+        int32_t along = (int32_t)(dot_sc >> (28 - 2 * LINE_FRACT_SHIFT));
+        int32_t perp  = (int32_t)(crs_sc >> (28 - 2 * LINE_FRACT_SHIFT));
+        if(perp < 0) perp = -perp;
 
-            /* Fill the gaps
-             * When stepping in x one pixel remains empty on every corner */
-            if(i != 0 && pattern[i].y != pattern[i - 1].y && !first_run) {
-                lv_draw_px(draw_area.x1 - main_line->sx, draw_area.y1, mask, style->line.color, opa);
-            }
-        }
+        /*Signed distance from the edge of the line. Negative inside.*/
+        int32_t dist;
+        if(along < 0) dist = cap_dist(perp, -along, half_w, seg->cap_start);
+        else if(along > seg->len) dist = cap_dist(perp, along - seg->len, half_w, seg->cap_end);
+        else dist = perp - half_w;
 
-#if LV_ANTIALIAS
-        if(aa) {
-            lv_draw_aa_ver_seg(prev_p.x + pattern[0].x - aa_shift1, prev_p.y + pattern[0].y,
-                               -(main_line->p_act.y - prev_p.y + 1), mask, style->line.color, opa);
-            lv_draw_aa_ver_seg(prev_p.x + pattern[width_safe - 1].x + aa_shift2, prev_p.y + pattern[width_safe - 1].y,
-                               main_line->p_act.y - prev_p.y + 1, mask, style->line.color, opa);
-        }
-#endif
+        /*A pixel whose center is on the edge is half covered*/
+        int32_t c;
+        if(aa) c = LINE_FRACT_HALF - dist;
+        else c = dist < 0 ? LINE_FRACT_ONE : 0;
+
+        if(c <= 0) continue;
+        lv_opa_t px_cov = c >= LINE_FRACT_ONE ? LV_OPA_COVER : (lv_opa_t)((c * LV_OPA_COVER) >> LINE_FRACT_SHIFT);
+        if(px_cov > cov[x - x1]) cov[x - x1] = px_cov;
     }
 }
 
-static void line_init(line_draw_t * line, const lv_point_t * p1, const lv_point_t * p2)
+/**
+ * Get the signed distance of a pixel from the edge of a line's end
+ * @param perp distance of the pixel from the line [1/LINE_FRACT_ONE px]
+ * @param out distance of the pixel beyond the end point along the line [1/LINE_FRACT_ONE px]
+ * @param half_w half width of the line [1/LINE_FRACT_ONE px]
+ * @param cap shape of the end
+ * @return the distance from the edge [1/LINE_FRACT_ONE px]. Negative inside.
+ */
+static int32_t cap_dist(int32_t perp, int32_t out, int32_t half_w, lv_line_cap_t cap)
 {
-    line->p1.x = p1->x;
-    line->p1.y = p1->y;
-    line->p2.x = p2->x;
-    line->p2.y = p2->y;
-
-    line->dx  = LV_MATH_ABS(line->p2.x - line->p1.x);
-    line->sx  = line->p1.x < line->p2.x ? 1 : -1;
-    line->dy  = LV_MATH_ABS(line->p2.y - line->p1.y);
-    line->sy  = line->p1.y < line->p2.y ? 1 : -1;
-    line->err = (line->dx > line->dy ? line->dx : -line->dy) / 2;
-    line->e2  = 0;
-    line->hor = line->dx > line->dy ? true : false; /*Rather horizontal or vertical*/
-
-    line->p_act.x = line->p1.x;
-    line->p_act.y = line->p1.y;
-}
+    if(cap == LV_LINE_CAP_ROUND) {
+        /*Certainly out of the circle*/
+        int32_t r_out = half_w + LINE_FRACT_HALF;
+        if(perp >= r_out || out >= r_out) return LINE_FRACT_ONE;
+
+        /*Avoid overflow with very wide lines*/
+        int32_t r_in  = half_w - LINE_FRACT_HALF;
+        uint8_t shift = 0;
+        while(r_out > 0x7FFF) {
+            perp >>= 1;
+            out >>= 1;
+            r_in >>= 1;
+            r_out >>= 1;
+            shift++;
+        }
 
-static bool line_next(line_draw_t * line)
-{
-    if(line->p_act.x == line->p2.x && line->p_act.y == line->p2.y) return false;
-    line->e2 = line->err;
-    if(line->e2 > -line->dx) {
-        line->err -= line->dy;
-        line->p_act.x += line->sx;
-    }
-    if(line->e2 < line->dy) {
-        line->err += line->dx;
-        line->p_act.y += line->sy;
+        /*Only the pixels on the edge of the circle need the exact distance*/
+        uint32_t sqr = (uint32_t)(perp * perp) + (uint32_t)(out * out);
+        if(r_in > 0 && sqr <= (uint32_t)(r_in * r_in)) return -LINE_FRACT_ONE;
+        if(sqr >= (uint32_t)(r_out * r_out)) return LINE_FRACT_ONE;
+
+        return (int32_t)(lv_sqrt(sqr) << shift) - half_w;
     }
-    return true;
+
+    /*Butt ends contain the pixel of the end point: add half pixel*/
+    int32_t cap_ext = cap == LV_LINE_CAP_SQUARE ? LV_MATH_MAX(half_w, LINE_FRACT_HALF) : LINE_FRACT_HALF;
+    return LV_MATH_MAX(perp - half_w, out - cap_ext);
 }
 
 /**
- * Iterate until step one in y direction.
- * @param line
- * @return
+ * Limit a range of steps to where a linear function is in an interval
+ * @param c value of the function at step 0
+ * @param s change of the function per step
+ * @param lo lower limit of the function's value
+ * @param hi upper limit of the function's value
+ * @param k1 pointer to the first step of the range. Increased if required.
+ * @param k2 pointer to the last step of the range. Decreased if required.
  */
-static bool line_next_y(line_draw_t * line)
+static void lin_range(int32_t c, int32_t s, int32_t lo, int32_t hi, int32_t * k1, int32_t * k2)
 {
-    lv_coord_t last_y = line->p_act.y;
+    if(s == 0) {
+        if(c < lo || c > hi) *k2 = *k1 - 1;
+        return;
+    }
 
-    do {
-        if(!line_next(line)) return false;
-    } while(last_y == line->p_act.y);
+    /*Mirror the function to increase*/
+    if(s < 0) {
+        int32_t tmp = lo;
+        lo          = -hi;
+        hi          = -tmp;
+        c           = -c;
+        s           = -s;
+    }
 
-    return true;
+    *k1 = LV_MATH_MAX(*k1, -div_floor(c - lo, s));
+    *k2 = LV_MATH_MIN(*k2, div_floor(hi - c, s));
 }
 
 /**
- * Iterate until step one in x direction.
- * @param line
- * @return
+ * Divide and round towards negative infinity
+ * @param n numerator
+ * @param d denominator (> 0)
+ * @return floor(n / d)
  */
-static bool line_next_x(line_draw_t * line)
+static int32_t div_floor(int32_t n, int32_t d)
 {
-    lv_coord_t last_x = line->p_act.x;
-
-    do {
-        if(!line_next(line)) return false;
-    } while(last_x == line->p_act.x);
-
-    return true;
+    if(n >= 0) return n / d;
+    else return -((-n + d - 1) / d);
 }
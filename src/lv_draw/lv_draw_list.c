@@ -0,0 +1,613 @@
+/**
+ * @file lv_draw_list.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_draw_list.h"
+#if LV_USE_DRAW_LIST
+
+#include <string.h>
+#include "../lv_misc/lv_math.h"
+#include "../lv_misc/lv_mem.h"
+#include "../lv_misc/lv_gc.h"
+#include "../lv_core/lv_debug.h"
+#include "lv_draw_layer.h"
+
+#if defined(LV_GC_INCLUDE)
+#include LV_GC_INCLUDE
+#endif /* LV_ENABLE_GC */
+
+/*********************
+ *      DEFINES
+ *********************/
+/*Align the data in the list to pointer size*/
+#define LIST_ALIGN(s) (((s) + sizeof(void *) - 1) & ~(sizeof(void *) - 1))
+
+/*Number of the last stored styles to compare with the new styles*/
+#define STYLE_RECENT_NUM 4
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+enum {
+    LV_DRAW_LIST_CMD_RECT,
+    LV_DRAW_LIST_CMD_LABEL,
+    LV_DRAW_LIST_CMD_IMG,
+    LV_DRAW_LIST_CMD_LINE,
+    LV_DRAW_LIST_CMD_POLYLINE,
+    LV_DRAW_LIST_CMD_ARC,
+    LV_DRAW_LIST_CMD_POLYGON,
+    LV_DRAW_LIST_CMD_LAYER_START,
+    LV_DRAW_LIST_CMD_LAYER_FINISH,
+};
+typedef uint8_t lv_draw_list_cmd_type_t;
+
+/*The common part of the commands*/
+typedef struct
+{
+    lv_draw_list_cmd_type_t type;
+    lv_opa_t opa_scale;
+    uint16_t size;             /*Size of the command in bytes*/
+    lv_area_t area;            /*Bounding box of the drawn pixels (used to skip the command)*/
+    lv_area_t mask;            /*The original mask of the command*/
+    const lv_style_t * style;  /*Copy of the style in the list*/
+} lv_draw_list_cmd_t;
+
+typedef struct
+{
+    lv_draw_list_cmd_t base;
+    lv_area_t coords;
+} lv_draw_list_rect_t;
+
+typedef struct
+{
+    lv_draw_list_cmd_t base;
+    lv_area_t coords;
+    const char * txt;              /*Copy of the text in the list*/
+    lv_draw_label_hint_t * hint;   /*Owned by the caller (typically a label)*/
+    lv_draw_label_lines_t * lines; /*Owned by the caller (typically a label)*/
+    lv_point_t offset;
+    lv_draw_label_txt_sel_t sel;
+    lv_txt_flag_t flag;
+    lv_bidi_dir_t bidi_dir;
+    uint8_t has_offset : 1;
+    uint8_t has_sel : 1;
+} lv_draw_list_label_t;
+
+typedef struct
+{
+    lv_draw_list_cmd_t base;
+    lv_area_t coords;
+    const void * src;   /*File names and symbols are copied to the list*/
+    lv_point_t pivot;
+    int16_t angle;
+    uint16_t zoom;
+    uint8_t has_pivot : 1;
+    uint8_t antialias : 1;
+} lv_draw_list_img_t;
+
+typedef struct
+{
+    lv_draw_list_cmd_t base;
+    lv_point_t p1;
+    lv_point_t p2;
+} lv_draw_list_line_t;
+
+typedef struct
+{
+    lv_draw_list_cmd_t base;
+    const lv_point_t * points; /*Copy of the points in the list*/
+    uint32_t point_cnt;
+    lv_line_cap_t cap;
+} lv_draw_list_polyline_t;
+
+typedef struct
+{
+    lv_draw_list_cmd_t base;
+    lv_coord_t center_x;
+    lv_coord_t center_y;
+    uint16_t radius;
+    uint16_t start_angle;
+    uint16_t end_angle;
+} lv_draw_list_arc_t;
+
+typedef struct
+{
+    lv_draw_list_cmd_t base;
+    const lv_point_t * points; /*Copy of the points in the list*/
+    uint32_t point_cnt;
+    lv_polygon_rule_t rule;
+} lv_draw_list_polygon_t;
+
+typedef struct
+{
+    lv_draw_list_cmd_t base;
+    uint8_t level; /*Nesting level of the layer, selects its reserved buffer*/
+} lv_draw_list_layer_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void * cmd_alloc(lv_draw_list_cmd_type_t type, uint32_t size, const lv_area_t * area, const lv_area_t * mask,
+                        const lv_style_t * style, lv_opa_t opa_scale);
+static void * data_alloc(uint32_t size);
+static const lv_style_t * style_store(const lv_style_t * style);
+static void get_points_area(const lv_point_t * points, uint32_t point_cnt, lv_coord_t ext_size, lv_area_t * res);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static uint32_t cmd_end;          /*End of the commands from the start of the buffer*/
+static uint32_t data_start;       /*Start of the data (texts, styles, etc) which grows from the end of the buffer*/
+static const lv_style_t * style_recent[STYLE_RECENT_NUM]; /*The last stored styles. Reused if a new style is the same*/
+static uint8_t style_recent_next;
+static bool recording;
+static bool overflow;
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+/**
+ * Start recording the drawing commands instead of drawing them.
+ * The `lv_draw_rect/label/img/line/arc/triangle/polygon` functions add a command to the list until
+ * `lv_draw_list_stop()`.
+ */
+void lv_draw_list_start(void)
+{
+    if(LV_GC_ROOT(_lv_draw_list_buf) == NULL) {
+        LV_GC_ROOT(_lv_draw_list_buf) = lv_mem_alloc(LV_DRAW_LIST_BUF_SIZE);
+        LV_ASSERT_MEM(LV_GC_ROOT(_lv_draw_list_buf));
+    }
+
+    cmd_end    = 0;
+    data_start = LV_DRAW_LIST_BUF_SIZE;
+    memset(style_recent, 0, sizeof(style_recent));
+    style_recent_next = 0;
+    recording  = true;
+    overflow   = LV_GC_ROOT(_lv_draw_list_buf) == NULL ? true : false;
+}
+
+/**
+ * Stop recording the drawing commands
+ * @return LV_RES_OK: all the commands are recorded; LV_RES_INV: the list was full or there was no memory
+ */
+lv_res_t lv_draw_list_stop(void)
+{
+    recording = false;
+
+    if(overflow) {
+        LV_LOG_TRACE("lv_draw_list_stop: the draw list is full");
+        cmd_end = 0;
+        return LV_RES_INV;
+    }
+
+    return LV_RES_OK;
+}
+
+/**
+ * Tell whether the drawing commands are being recorded
+ * @return true: recording
+ */
+bool lv_draw_list_is_recording(void)
+{
+    return recording;
+}
+
+/**
+ * Draw the recorded commands which are on an area
+ * @param mask draw only on this area (typically the area of the display buffer)
+ */
+void lv_draw_list_replay(const lv_area_t * mask)
+{
+    uint8_t * buf = LV_GC_ROOT(_lv_draw_list_buf);
+    uint32_t i    = 0;
+    lv_area_t cmd_mask;
+
+    while(i < cmd_end) {
+        lv_draw_list_cmd_t * cmd = (lv_draw_list_cmd_t *)&buf[i];
+        i += cmd->size;
+
+        /*Skip the commands which have nothing to draw on this area*/
+        if(lv_area_is_on(&cmd->area, mask) == false) continue;
+        if(lv_area_intersect(&cmd_mask, &cmd->mask, mask) == false) continue;
+
+        switch(cmd->type) {
+            case LV_DRAW_LIST_CMD_RECT: {
+                lv_draw_list_rect_t * c = (lv_draw_list_rect_t *)cmd;
+                lv_draw_rect(&c->coords, &cmd_mask, cmd->style, cmd->opa_scale);
+                break;
+            }
+            case LV_DRAW_LIST_CMD_LABEL: {
+                lv_draw_list_label_t * c = (lv_draw_list_label_t *)cmd;
+                lv_draw_label(&c->coords, &cmd_mask, cmd->style, cmd->opa_scale, c->txt, c->flag,
+                              c->has_offset ? &c->offset : NULL, c->has_sel ? &c->sel : NULL, c->hint, c->lines,
+                              c->bidi_dir);
+                break;
+            }
+            case LV_DRAW_LIST_CMD_IMG: {
+                lv_draw_list_img_t * c = (lv_draw_list_img_t *)cmd;
+                lv_draw_img_transformed(&c->coords, &cmd_mask, c->src, cmd->style, cmd->opa_scale, c->angle, c->zoom,
+                                        c->has_pivot ? &c->pivot : NULL, c->antialias);
+                break;
+            }
+            case LV_DRAW_LIST_CMD_LINE: {
+                lv_draw_list_line_t * c = (lv_draw_list_line_t *)cmd;
+                lv_draw_line(&c->p1, &c->p2, &cmd_mask, cmd->style, cmd->opa_scale);
+                break;
+            }
+            case LV_DRAW_LIST_CMD_POLYLINE: {
+                lv_draw_list_polyline_t * c = (lv_draw_list_polyline_t *)cmd;
+                lv_draw_polyline(c->points, c->point_cnt, &cmd_mask, cmd->style, cmd->opa_scale, c->cap);
+                break;
+            }
+            case LV_DRAW_LIST_CMD_ARC: {
+                lv_draw_list_arc_t * c = (lv_draw_list_arc_t *)cmd;
+                lv_draw_arc(c->center_x, c->center_y, c->radius, &cmd_mask, c->start_angle, c->end_angle, cmd->style,
+                            cmd->opa_scale);
+                break;
+            }
+            case LV_DRAW_LIST_CMD_POLYGON: {
+                lv_draw_list_polygon_t * c = (lv_draw_list_polygon_t *)cmd;
+                lv_draw_polygon_rule(c->points, c->point_cnt, &cmd_mask, cmd->style, cmd->opa_scale, c->rule);
+                break;
+            }
+#if LV_USE_OPA_LAYER
+            case LV_DRAW_LIST_CMD_LAYER_START: {
+                lv_draw_list_layer_t * c = (lv_draw_list_layer_t *)cmd;
+                lv_draw_layer_start_recorded(&cmd_mask, c->level);
+                break;
+            }
+            case LV_DRAW_LIST_CMD_LAYER_FINISH: {
+                lv_draw_layer_finish(&cmd_mask, cmd->opa_scale);
+                break;
+            }
+#endif
+        }
+    }
+}
+
+/**
+ * Record an `lv_draw_rect()` call. The parameters are the same as `lv_draw_rect()`'s.
+ */
+void lv_draw_list_add_rect(const lv_area_t * coords, const lv_area_t * mask, const lv_style_t * style,
+                           lv_opa_t opa_scale)
+{
+    /*The shadow is drawn out of the coordinates*/
+    lv_area_t area;
+    lv_area_copy(&area, coords);
+#if LV_USE_SHADOW
+    area.x1 -= style->body.shadow.width;
+    area.y1 -= style->body.shadow.width;
+    area.x2 += style->body.shadow.width;
+    area.y2 += style->body.shadow.width;
+#endif
+
+    lv_draw_list_rect_t * c =
+        cmd_alloc(LV_DRAW_LIST_CMD_RECT, sizeof(lv_draw_list_rect_t), &area, mask, style, opa_scale);
+    if(c == NULL) return;
+
+    lv_area_copy(&c->coords, coords);
+}
+
+/**
+ * Record an `lv_draw_label()` call. The parameters are the same as `lv_draw_label()`'s.
+ */
+void lv_draw_list_add_label(const lv_area_t * coords, const lv_area_t * mask, const lv_style_t * style,
+                            lv_opa_t opa_scale, const char * txt, lv_txt_flag_t flag, const lv_point_t * offset,
+                            const lv_draw_label_txt_sel_t * sel, lv_draw_label_hint_t * hint, lv_draw_label_lines_t * lines,
+                            lv_bidi_dir_t bidi_dir)
+{
+    if(txt[0] == '\0') return;
+
+    /*The letters can be out of the label's coordinates so use only the mask*/
+    lv_draw_list_label_t * c =
+        cmd_alloc(LV_DRAW_LIST_CMD_LABEL, sizeof(lv_draw_list_label_t), mask, mask, style, opa_scale);
+    if(c == NULL) return;
+
+    /*The text can be in a temporal buffer so save it*/
+    uint32_t len = strlen(txt) + 1;
+    char * txt_copy = data_alloc(len);
+    if(txt_copy == NULL) return;
+    memcpy(txt_copy, txt, len);
+
+    lv_area_copy(&c->coords, coords);
+    c->txt        = txt_copy;
+    c->hint       = hint;
+    c->lines      = lines;
+    c->flag       = flag;
+    c->bidi_dir   = bidi_dir;
+    c->has_offset = offset ? 1 : 0;
+    c->has_sel    = sel ? 1 : 0;
+    if(offset) c->offset = *offset;
+    if(sel) c->sel = *sel;
+}
+
+/**
+ * Record an `lv_draw_img_transformed()` call. The parameters are the same as `lv_draw_img_transformed()`'s.
+ */
+void lv_draw_list_add_img(const lv_area_t * coords, const lv_area_t * mask, const void * src,
+                          const lv_style_t * style, lv_opa_t opa_scale, int16_t angle, uint16_t zoom,
+                          const lv_point_t * pivot, bool antialias)
+{
+    lv_area_t area;
+    if(angle == 0 && zoom == LV_IMG_ZOOM_NONE) {
+        lv_area_copy(&area, coords);
+    } else {
+        lv_point_t pivot_center;
+        if(pivot == NULL) {
+            pivot_center.x = lv_area_get_width(coords) / 2;
+            pivot_center.y = lv_area_get_height(coords) / 2;
+        }
+        lv_img_transform_get_area(&area, lv_area_get_width(coords), lv_area_get_height(coords), angle, zoom,
+                                  pivot ? pivot : &pivot_center);
+        area.x1 += coords->x1;
+        area.y1 += coords->y1;
+        area.x2 += coords->x1;
+        area.y2 += coords->y1;
+    }
+
+    lv_draw_list_img_t * c = cmd_alloc(LV_DRAW_LIST_CMD_IMG, sizeof(lv_draw_list_img_t), &area, mask, style, opa_scale);
+    if(c == NULL) return;
+
+    /*The file names and symbols can be in a temporal buffer so save them*/
+    lv_img_src_t src_type = lv_img_src_get_type(src);
+    if(src_type == LV_IMG_SRC_FILE || src_type == LV_IMG_SRC_SYMBOL) {
+        uint32_t len = strlen(src) + 1;
+        char * src_copy = data_alloc(len);
+        if(src_copy == NULL) return;
+        memcpy(src_copy, src, len);
+        c->src = src_copy;
+    } else {
+        c->src = src;
+    }
+
+    lv_area_copy(&c->coords, coords);
+    c->angle     = angle;
+    c->zoom      = zoom;
+    c->antialias = antialias ? 1 : 0;
+    c->has_pivot = pivot ? 1 : 0;
+    if(pivot) c->pivot = *pivot;
+}
+
+/**
+ * Record an `lv_draw_line()` call. The parameters are the same as `lv_draw_line()`'s.
+ */
+void lv_draw_list_add_line(const lv_point_t * point1, const lv_point_t * point2, const lv_area_t * mask,
+                           const lv_style_t * style, lv_opa_t opa_scale)
+{
+    lv_point_t points[2];
+    points[0] = *point1;
+    points[1] = *point2;
+
+    lv_area_t area;
+    get_points_area(points, 2, style->line.width, &area);
+
+    lv_draw_list_line_t * c =
+        cmd_alloc(LV_DRAW_LIST_CMD_LINE, sizeof(lv_draw_list_line_t), &area, mask, style, opa_scale);
+    if(c == NULL) return;
+
+    c->p1 = *point1;
+    c->p2 = *point2;
+}
+
+/**
+ * Record an `lv_draw_polyline()` call. The parameters are the same as `lv_draw_polyline()`'s.
+ */
+void lv_draw_list_add_polyline(const lv_point_t * points, uint32_t point_cnt, const lv_area_t * mask,
+                               const lv_style_t * style, lv_opa_t opa_scale, lv_line_cap_t cap)
+{
+    if(point_cnt < 2 || points == NULL) return;
+
+    lv_area_t area;
+    get_points_area(points, point_cnt, style->line.width, &area);
+
+    lv_draw_list_polyline_t * c =
+        cmd_alloc(LV_DRAW_LIST_CMD_POLYLINE, sizeof(lv_draw_list_polyline_t), &area, mask, style, opa_scale);
+    if(c == NULL) return;
+
+    lv_point_t * points_copy = data_alloc(point_cnt * sizeof(lv_point_t));
+    if(points_copy == NULL) return;
+    memcpy(points_copy, points, point_cnt * sizeof(lv_point_t));
+
+    c->points    = points_copy;
+    c->point_cnt = point_cnt;
+    c->cap       = cap;
+}
+
+/**
+ * Record an `lv_draw_arc()` call. The parameters are the same as `lv_draw_arc()`'s.
+ */
+void lv_draw_list_add_arc(lv_coord_t center_x, lv_coord_t center_y, uint16_t radius, const lv_area_t * mask,
+                          uint16_t start_angle, uint16_t end_angle, const lv_style_t * style, lv_opa_t opa_scale)
+{
+    lv_area_t area;
+    area.x1 = center_x - radius - 1;
+    area.y1 = center_y - radius - 1;
+    area.x2 = center_x + radius + 1;
+    area.y2 = center_y + radius + 1;
+
+    lv_draw_list_arc_t * c = cmd_alloc(LV_DRAW_LIST_CMD_ARC, sizeof(lv_draw_list_arc_t), &area, mask, style, opa_scale);
+    if(c == NULL) return;
+
+    c->center_x    = center_x;
+    c->center_y    = center_y;
+    c->radius      = radius;
+    c->start_angle = start_angle;
+    c->end_angle   = end_angle;
+}
+
+/**
+ * Record an `lv_draw_triangle()` or `lv_draw_polygon/_rule()` call.
+ * The parameters are the same as `lv_draw_polygon_rule()`'s.
+ */
+void lv_draw_list_add_polygon(const lv_point_t * points, uint32_t point_cnt, const lv_area_t * mask,
+                              const lv_style_t * style, lv_opa_t opa_scale, lv_polygon_rule_t rule)
+{
+    if(point_cnt < 3 || points == NULL) return;
+
+    lv_area_t area;
+    get_points_area(points, point_cnt, 1, &area);
+
+    lv_draw_list_polygon_t * c =
+        cmd_alloc(LV_DRAW_LIST_CMD_POLYGON, sizeof(lv_draw_list_polygon_t), &area, mask, style, opa_scale);
+    if(c == NULL) return;
+
+    lv_point_t * points_copy = data_alloc(point_cnt * sizeof(lv_point_t));
+    if(points_copy == NULL) return;
+    memcpy(points_copy, points, point_cnt * sizeof(lv_point_t));
+
+    c->points    = points_copy;
+    c->point_cnt = point_cnt;
+    c->rule      = rule;
+}
+
+#if LV_USE_OPA_LAYER
+/**
+ * Record an `lv_draw_layer_start()` call
+ * @param area the area of the layer
+ * @param level nesting level of the layer. Its buffer is reserved by `lv_draw_layer_start()`.
+ * @return true: the command is recorded; false: the list is full or the layer is not visible
+ */
+bool lv_draw_list_add_layer_start(const lv_area_t * area, uint8_t level)
+{
+    lv_draw_list_layer_t * c =
+        cmd_alloc(LV_DRAW_LIST_CMD_LAYER_START, sizeof(lv_draw_list_layer_t), area, area, NULL, LV_OPA_COVER);
+    if(c == NULL) return false;
+
+    c->level = level;
+    return true;
+}
+
+/**
+ * Record an `lv_draw_layer_finish()` call. The parameters are the same as `lv_draw_layer_finish()`'s.
+ */
+void lv_draw_list_add_layer_finish(const lv_area_t * area, lv_opa_t opa)
+{
+    cmd_alloc(LV_DRAW_LIST_CMD_LAYER_FINISH, sizeof(lv_draw_list_cmd_t), area, area, NULL, opa);
+}
+#endif
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Add a new command to the list
+ * @param type type of the command
+ * @param size size of the command's descriptor
+ * @param area bounding box of the drawn pixels
+ * @param mask mask of the command
+ * @param style style of the command. It will be copied to the list. (Can be NULL)
+ * @param opa_scale opacity scale of the command
+ * @return pointer to the new command or NULL if it's not visible or the list is full
+ */
+static void * cmd_alloc(lv_draw_list_cmd_type_t type, uint32_t size, const lv_area_t * area, const lv_area_t * mask,
+                        const lv_style_t * style, lv_opa_t opa_scale)
+{
+    if(overflow) return NULL;
+
+    /*Don't save the commands which won't draw anything*/
+    lv_area_t vis_area;
+    if(lv_area_intersect(&vis_area, area, mask) == false) return NULL;
+
+    size = LIST_ALIGN(size);
+    if(cmd_end + size > data_start) {
+        overflow = true;
+        return NULL;
+    }
+
+    lv_draw_list_cmd_t * cmd = (lv_draw_list_cmd_t *)&((uint8_t *)LV_GC_ROOT(_lv_draw_list_buf))[cmd_end];
+
+    if(style) {
+        cmd->style = style_store(style);
+        if(cmd->style == NULL) return NULL;
+    } else {
+        cmd->style = NULL;
+    }
+
+    cmd->type      = type;
+    cmd->size      = size;
+    cmd->opa_scale = opa_scale;
+    lv_area_copy(&cmd->area, &vis_area);
+    lv_area_copy(&cmd->mask, mask);
+
+    /*Add the command to the list only if everything went well*/
+    cmd_end += size;
+
+    return cmd;
+}
+
+/**
+ * Allocate data for a command. The data is allocated from the end of the buffer.
+ * @param size size of the data in bytes
+ * @return pointer to the allocated data or NULL if the list is full. (The list is invalidated in this case.)
+ */
+static void * data_alloc(uint32_t size)
+{
+    size = LIST_ALIGN(size);
+    if(data_start < cmd_end + size) {
+        overflow = true;
+        return NULL;
+    }
+
+    data_start -= size;
+    return &((uint8_t *)LV_GC_ROOT(_lv_draw_list_buf))[data_start];
+}
+
+/**
+ * Copy a style to the list. The styles are often modified on the stack so they need to be copied.
+ * @param style the style to copy
+ * @return pointer to the copy or NULL if the list is full
+ */
+static const lv_style_t * style_store(const lv_style_t * style)
+{
+    /*Similar objects use the same few styles after each other (e.g. a button and its label)*/
+    uint8_t i;
+    for(i = 0; i < STYLE_RECENT_NUM; i++) {
+        if(style_recent[i] && memcmp(style_recent[i], style, sizeof(lv_style_t)) == 0) return style_recent[i];
+    }
+
+    lv_style_t * style_copy = data_alloc(sizeof(lv_style_t));
+    if(style_copy == NULL) return NULL;
+
+    memcpy(style_copy, style, sizeof(lv_style_t));
+    style_recent[style_recent_next] = style_copy;
+    style_recent_next++;
+    if(style_recent_next >= STYLE_RECENT_NUM) style_recent_next = 0;
+
+    return style_copy;
+}
+
+/**
+ * Get the bounding box of points
+ * @param points array of points
+ * @param point_cnt number of points (> 0)
+ * @param ext_size enlarge the area by this value in every direction
+ * @param res store the result here
+ */
+static void get_points_area(const lv_point_t * points, uint32_t point_cnt, lv_coord_t ext_size, lv_area_t * res)
+{
+    lv_area_set(res, points[0].x, points[0].y, points[0].x, points[0].y);
+    uint32_t i;
+    for(i = 1; i < point_cnt; i++) {
+        res->x1 = LV_MATH_MIN(res->x1, points[i].x);
+        res->y1 = LV_MATH_MIN(res->y1, points[i].y);
+        res->x2 = LV_MATH_MAX(res->x2, points[i].x);
+        res->y2 = LV_MATH_MAX(res->y2, points[i].y);
+    }
+
+    res->x1 -= ext_size;
+    res->y1 -= ext_size;
+    res->x2 += ext_size;
+    res->y2 += ext_size;
+}
+
+#endif /*LV_USE_DRAW_LIST*/
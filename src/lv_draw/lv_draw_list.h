@@ -0,0 +1,135 @@
+/**
+ * @file lv_draw_list.h
+ *
+ */
+
+#ifndef LV_DRAW_LIST_H
+#define LV_DRAW_LIST_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#ifdef LV_CONF_INCLUDE_SIMPLE
+#include "lv_conf.h"
+#else
+#include "../../../lv_conf.h"
+#endif
+
+#if LV_USE_DRAW_LIST
+
+#include "lv_draw.h"
+#include "../lv_misc/lv_bidi.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Start recording the drawing commands instead of drawing them.
+ * The `lv_draw_rect/label/img/line/arc/triangle/polygon` functions add a command to the list until
+ * `lv_draw_list_stop()`.
+ */
+void lv_draw_list_start(void);
+
+/**
+ * Stop recording the drawing commands
+ * @return LV_RES_OK: all the commands are recorded; LV_RES_INV: the list was full or there was no memory
+ */
+lv_res_t lv_draw_list_stop(void);
+
+/**
+ * Tell whether the drawing commands are being recorded
+ * @return true: recording
+ */
+bool lv_draw_list_is_recording(void);
+
+/**
+ * Draw the recorded commands which are on an area
+ * @param mask draw only on this area (typically the area of the display buffer)
+ */
+void lv_draw_list_replay(const lv_area_t * mask);
+
+/**
+ * Record an `lv_draw_rect()` call. The parameters are the same as `lv_draw_rect()`'s.
+ */
+void lv_draw_list_add_rect(const lv_area_t * coords, const lv_area_t * mask, const lv_style_t * style,
+                           lv_opa_t opa_scale);
+
+/**
+ * Record an `lv_draw_label()` call. The parameters are the same as `lv_draw_label()`'s.
+ */
+void lv_draw_list_add_label(const lv_area_t * coords, const lv_area_t * mask, const lv_style_t * style,
+                            lv_opa_t opa_scale, const char * txt, lv_txt_flag_t flag, const lv_point_t * offset,
+                            const lv_draw_label_txt_sel_t * sel, lv_draw_label_hint_t * hint, lv_draw_label_lines_t * lines,
+                            lv_bidi_dir_t bidi_dir);
+
+/**
+ * Record an `lv_draw_img_transformed()` call. The parameters are the same as `lv_draw_img_transformed()`'s.
+ */
+void lv_draw_list_add_img(const lv_area_t * coords, const lv_area_t * mask, const void * src,
+                          const lv_style_t * style, lv_opa_t opa_scale, int16_t angle, uint16_t zoom,
+                          const lv_point_t * pivot, bool antialias);
+
+/**
+ * Record an `lv_draw_line()` call. The parameters are the same as `lv_draw_line()`'s.
+ */
+void lv_draw_list_add_line(const lv_point_t * point1, const lv_point_t * point2, const lv_area_t * mask,
+                           const lv_style_t * style, lv_opa_t opa_scale);
+
+/**
+ * Record an `lv_draw_polyline()` call. The parameters are the same as `lv_draw_polyline()`'s.
+ */
+void lv_draw_list_add_polyline(const lv_point_t * points, uint32_t point_cnt, const lv_area_t * mask,
+                               const lv_style_t * style, lv_opa_t opa_scale, lv_line_cap_t cap);
+
+/**
+ * Record an `lv_draw_arc()` call. The parameters are the same as `lv_draw_arc()`'s.
+ */
+void lv_draw_list_add_arc(lv_coord_t center_x, lv_coord_t center_y, uint16_t radius, const lv_area_t * mask,
+                          uint16_t start_angle, uint16_t end_angle, const lv_style_t * style, lv_opa_t opa_scale);
+
+/**
+ * Record an `lv_draw_triangle()` or `lv_draw_polygon/_rule()` call.
+ * The parameters are the same as `lv_draw_polygon_rule()`'s.
+ */
+void lv_draw_list_add_polygon(const lv_point_t * points, uint32_t point_cnt, const lv_area_t * mask,
+                              const lv_style_t * style, lv_opa_t opa_scale, lv_polygon_rule_t rule);
+
+#if LV_USE_OPA_LAYER
+/**
+ * Record an `lv_draw_layer_start()` call
+ * @param area the area of the layer
+ * @param level nesting level of the layer. Its buffer is reserved by `lv_draw_layer_start()`.
+ * @return true: the command is recorded; false: the list is full or the layer is not visible
+ */
+bool lv_draw_list_add_layer_start(const lv_area_t * area, uint8_t level);
+
+/**
+ * Record an `lv_draw_layer_finish()` call. The parameters are the same as `lv_draw_layer_finish()`'s.
+ */
+void lv_draw_list_add_layer_finish(const lv_area_t * area, lv_opa_t opa);
+#endif
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /*LV_USE_DRAW_LIST*/
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /*LV_DRAW_LIST_H*/
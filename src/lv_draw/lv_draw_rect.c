@@ -10,6 +10,8 @@
 #include "../lv_misc/lv_circ.h"
 #include "../lv_misc/lv_math.h"
 #include "../lv_core/lv_refr.h"
+#include "lv_draw_list.h"
+#include "lv_draw_grad.h"
 
 /*********************
  *      DEFINES
@@ -27,6 +29,15 @@
 /**********************
  *      TYPEDEFS
  **********************/
+/*Describes the background color of a rectangle*/
+typedef struct
+{
+    const lv_area_t * coords;
+    const lv_color_t * colors; /*Colors of the gradient. NULL: fill with `color`*/
+    lv_color_t color;
+    uint16_t len;              /*Number of colors in `colors`*/
+    lv_grad_dir_t dir;
+} lv_draw_rect_grad_t;
 
 /**********************
  *  STATIC PROTOTYPES
@@ -52,8 +63,12 @@ static void lv_draw_shadow_full_straight(const lv_area_t * coords, const lv_area
 #endif
 
 static uint16_t lv_draw_cont_radius_corr(uint16_t r, lv_coord_t w, lv_coord_t h);
+static void grad_init(lv_draw_rect_grad_t * grad, const lv_area_t * coords, const lv_style_t * style);
+static void grad_fill(const lv_area_t * area, const lv_area_t * mask, const lv_draw_rect_grad_t * grad, lv_opa_t opa);
 
 #if LV_ANTIALIAS
+static void grad_draw_px(const lv_draw_rect_grad_t * grad, lv_coord_t x, lv_coord_t y, const lv_area_t * mask,
+                         lv_color_t ver_color, lv_opa_t opa);
 static lv_opa_t antialias_get_opa_circ(lv_coord_t seg, lv_coord_t px_id, lv_opa_t opa);
 #endif
 
@@ -80,6 +95,13 @@ void lv_draw_rect(const lv_area_t * coords, const lv_area_t * mask, const lv_sty
 {
     if(lv_area_get_height(coords) < 1 || lv_area_get_width(coords) < 1) return;
 
+#if LV_USE_DRAW_LIST
+    if(lv_draw_list_is_recording()) {
+        lv_draw_list_add_rect(coords, mask, style, opa_scale);
+        return;
+    }
+#endif
+
 #if LV_USE_SHADOW
     if(style->body.shadow.width != 0) {
         lv_draw_shadow(coords, mask, style, opa_scale);
@@ -125,9 +147,6 @@ static void lv_draw_rect_main_mid(const lv_area_t * coords, const lv_area_t * ma
     uint16_t radius = style->body.radius;
     bool aa         = lv_disp_get_antialiasing(lv_refr_get_disp_refreshing());
 
-    lv_color_t mcolor = style->body.main_color;
-    lv_color_t gcolor = style->body.grad_color;
-    uint8_t mix;
     lv_coord_t height = lv_area_get_height(coords);
     lv_coord_t width  = lv_area_get_width(coords);
     lv_opa_t opa = opa_scale == LV_OPA_COVER ? style->body.opa : (uint16_t)((uint16_t)style->body.opa * opa_scale) >> 8;
@@ -140,49 +159,22 @@ static void lv_draw_rect_main_mid(const lv_area_t * coords, const lv_area_t * ma
     lv_area_t work_area;
     work_area.x1 = coords->x1;
     work_area.x2 = coords->x2;
+    work_area.y1 = coords->y1 + radius;
+    work_area.y2 = coords->y2 - radius;
 
-    if(mcolor.full == gcolor.full) {
-        work_area.y1 = coords->y1 + radius;
-        work_area.y2 = coords->y2 - radius;
-
-        if(style->body.radius != 0) {
-
-            if(aa) {
-                work_area.y1 += 2;
-                work_area.y2 -= 2;
-            } else {
-                work_area.y1 += 1;
-                work_area.y2 -= 1;
-            }
-        }
-
-        lv_draw_fill(&work_area, mask, mcolor, opa);
-    } else {
-        lv_coord_t row;
-        lv_coord_t row_start = coords->y1 + radius;
-        lv_coord_t row_end   = coords->y2 - radius;
-        lv_color_t act_color;
-
-        if(style->body.radius != 0) {
-            if(aa) {
-                row_start += 2;
-                row_end -= 2;
-            } else {
-                row_start += 1;
-                row_end -= 1;
-            }
-        }
-        if(row_start < 0) row_start = 0;
-
-        for(row = row_start; row <= row_end; row++) {
-            work_area.y1 = row;
-            work_area.y2 = row;
-            mix          = (uint32_t)((uint32_t)(coords->y2 - work_area.y1) * 255) / height;
-            act_color    = lv_color_mix(mcolor, gcolor, mix);
-
-            lv_draw_fill(&work_area, mask, act_color, opa);
+    if(style->body.radius != 0) {
+        if(aa) {
+            work_area.y1 += 2;
+            work_area.y2 -= 2;
+        } else {
+            work_area.y1 += 1;
+            work_area.y2 -= 1;
         }
     }
+
+    lv_draw_rect_grad_t grad;
+    grad_init(&grad, coords, style);
+    grad_fill(&work_area, mask, &grad, opa);
 }
 /**
  * Draw the top and bottom parts (corners) of a rectangle
@@ -197,16 +189,21 @@ static void lv_draw_rect_main_corner(const lv_area_t * coords, const lv_area_t *
     uint16_t radius = style->body.radius;
     bool aa         = lv_disp_get_antialiasing(lv_refr_get_disp_refreshing());
 
+    lv_opa_t opa = opa_scale == LV_OPA_COVER ? style->body.opa : (uint16_t)((uint16_t)style->body.opa * opa_scale) >> 8;
+#if LV_ANTIALIAS
+    /*Used to mix the colors of the anti-aliased edges*/
     lv_color_t mcolor = style->body.main_color;
     lv_color_t gcolor = style->body.grad_color;
-    lv_color_t act_color;
-    lv_opa_t opa = opa_scale == LV_OPA_COVER ? style->body.opa : (uint16_t)((uint16_t)style->body.opa * opa_scale) >> 8;
     uint8_t mix;
+#endif
     lv_coord_t height = lv_area_get_height(coords);
     lv_coord_t width  = lv_area_get_width(coords);
 
     radius = lv_draw_cont_radius_corr(radius, width, height);
 
+    lv_draw_rect_grad_t grad;
+    grad_init(&grad, coords, style);
+
     lv_point_t lt_origo; /*Left  Top    origo*/
     lv_point_t lb_origo; /*Left  Bottom origo*/
     lv_point_t rt_origo; /*Right Top    origo*/
@@ -282,27 +279,27 @@ static void lv_draw_rect_main_corner(const lv_area_t * coords, const lv_area_t *
                         aa_opa = opa - lv_draw_aa_get_opa(seg_size, i, opa);
                     }
 
-                    lv_draw_px(rb_origo.x + LV_CIRC_OCT2_X(aa_p) + i, rb_origo.y + LV_CIRC_OCT2_Y(aa_p) + 1, mask,
-                               aa_color_hor_bottom, aa_opa);
-                    lv_draw_px(lb_origo.x + LV_CIRC_OCT3_X(aa_p) - i, lb_origo.y + LV_CIRC_OCT3_Y(aa_p) + 1, mask,
-                               aa_color_hor_bottom, aa_opa);
-                    lv_draw_px(lt_origo.x + LV_CIRC_OCT6_X(aa_p) - i, lt_origo.y + LV_CIRC_OCT6_Y(aa_p) - 1, mask,
-                               aa_color_hor_top, aa_opa);
-                    lv_draw_px(rt_origo.x + LV_CIRC_OCT7_X(aa_p) + i, rt_origo.y + LV_CIRC_OCT7_Y(aa_p) - 1, mask,
-                               aa_color_hor_top, aa_opa);
+                    grad_draw_px(&grad, rb_origo.x + LV_CIRC_OCT2_X(aa_p) + i, rb_origo.y + LV_CIRC_OCT2_Y(aa_p) + 1,
+                                 mask, aa_color_hor_bottom, aa_opa);
+                    grad_draw_px(&grad, lb_origo.x + LV_CIRC_OCT3_X(aa_p) - i, lb_origo.y + LV_CIRC_OCT3_Y(aa_p) + 1,
+                                 mask, aa_color_hor_bottom, aa_opa);
+                    grad_draw_px(&grad, lt_origo.x + LV_CIRC_OCT6_X(aa_p) - i, lt_origo.y + LV_CIRC_OCT6_Y(aa_p) - 1,
+                                 mask, aa_color_hor_top, aa_opa);
+                    grad_draw_px(&grad, rt_origo.x + LV_CIRC_OCT7_X(aa_p) + i, rt_origo.y + LV_CIRC_OCT7_Y(aa_p) - 1,
+                                 mask, aa_color_hor_top, aa_opa);
 
                     mix          = (uint32_t)((uint32_t)(radius - out_y_seg_start + i) * 255) / height;
                     aa_color_ver = lv_color_mix(mcolor, gcolor, mix);
-                    lv_draw_px(rb_origo.x + LV_CIRC_OCT1_X(aa_p) + 1, rb_origo.y + LV_CIRC_OCT1_Y(aa_p) + i, mask,
-                               aa_color_ver, aa_opa);
-                    lv_draw_px(lb_origo.x + LV_CIRC_OCT4_X(aa_p) - 1, lb_origo.y + LV_CIRC_OCT4_Y(aa_p) + i, mask,
-                               aa_color_ver, aa_opa);
+                    grad_draw_px(&grad, rb_origo.x + LV_CIRC_OCT1_X(aa_p) + 1, rb_origo.y + LV_CIRC_OCT1_Y(aa_p) + i,
+                                 mask, aa_color_ver, aa_opa);
+                    grad_draw_px(&grad, lb_origo.x + LV_CIRC_OCT4_X(aa_p) - 1, lb_origo.y + LV_CIRC_OCT4_Y(aa_p) + i,
+                                 mask, aa_color_ver, aa_opa);
 
                     aa_color_ver = lv_color_mix(gcolor, mcolor, mix);
-                    lv_draw_px(lt_origo.x + LV_CIRC_OCT5_X(aa_p) - 1, lt_origo.y + LV_CIRC_OCT5_Y(aa_p) - i, mask,
-                               aa_color_ver, aa_opa);
-                    lv_draw_px(rt_origo.x + LV_CIRC_OCT8_X(aa_p) + 1, rt_origo.y + LV_CIRC_OCT8_Y(aa_p) - i, mask,
-                               aa_color_ver, aa_opa);
+                    grad_draw_px(&grad, lt_origo.x + LV_CIRC_OCT5_X(aa_p) - 1, lt_origo.y + LV_CIRC_OCT5_Y(aa_p) - i,
+                                 mask, aa_color_ver, aa_opa);
+                    grad_draw_px(&grad, rt_origo.x + LV_CIRC_OCT8_X(aa_p) + 1, rt_origo.y + LV_CIRC_OCT8_Y(aa_p) - i,
+                                 mask, aa_color_ver, aa_opa);
                 }
 
                 out_x_last      = cir.x;
@@ -327,44 +324,20 @@ static void lv_draw_rect_main_corner(const lv_area_t * coords, const lv_area_t *
 
         /*Draw the areas which are not disabled*/
         if(edge_top_refr != 0) {
-            if(mcolor.full == gcolor.full)
-                act_color = mcolor;
-            else {
-                mix       = (uint32_t)((uint32_t)(coords->y2 - edge_top_area.y1) * 255) / height;
-                act_color = lv_color_mix(mcolor, gcolor, mix);
-            }
-            lv_draw_fill(&edge_top_area, mask, act_color, opa);
+            grad_fill(&edge_top_area, mask, &grad, opa);
         }
 
         if(mid_top_refr != 0) {
-            if(mcolor.full == gcolor.full)
-                act_color = mcolor;
-            else {
-                mix       = (uint32_t)((uint32_t)(coords->y2 - mid_top_area.y1) * 255) / height;
-                act_color = lv_color_mix(mcolor, gcolor, mix);
-            }
-            lv_draw_fill(&mid_top_area, mask, act_color, opa);
+            grad_fill(&mid_top_area, mask, &grad, opa);
         }
 
         if(mid_bot_refr != 0) {
-            if(mcolor.full == gcolor.full)
-                act_color = mcolor;
-            else {
-                mix       = (uint32_t)((uint32_t)(coords->y2 - mid_bot_area.y1) * 255) / height;
-                act_color = lv_color_mix(mcolor, gcolor, mix);
-            }
-            lv_draw_fill(&mid_bot_area, mask, act_color, opa);
+            grad_fill(&mid_bot_area, mask, &grad, opa);
         }
 
         if(edge_bot_refr != 0) {
 
-            if(mcolor.full == gcolor.full)
-                act_color = mcolor;
-            else {
-                mix       = (uint32_t)((uint32_t)(coords->y2 - edge_bot_area.y1) * 255) / height;
-                act_color = lv_color_mix(mcolor, gcolor, mix);
-            }
-            lv_draw_fill(&edge_bot_area, mask, act_color, opa);
+            grad_fill(&edge_bot_area, mask, &grad, opa);
         }
 
         /*Save the current coordinates*/
@@ -383,42 +356,18 @@ static void lv_draw_rect_main_corner(const lv_area_t * coords, const lv_area_t *
         lv_circ_next(&cir, &cir_tmp);
     }
 
-    if(mcolor.full == gcolor.full)
-        act_color = mcolor;
-    else {
-        mix       = (uint32_t)((uint32_t)(coords->y2 - edge_top_area.y1) * 255) / height;
-        act_color = lv_color_mix(mcolor, gcolor, mix);
-    }
-    lv_draw_fill(&edge_top_area, mask, act_color, opa);
+    grad_fill(&edge_top_area, mask, &grad, opa);
 
     if(edge_top_area.y1 != mid_top_area.y1) {
 
-        if(mcolor.full == gcolor.full)
-            act_color = mcolor;
-        else {
-            mix       = (uint32_t)((uint32_t)(coords->y2 - mid_top_area.y1) * 255) / height;
-            act_color = lv_color_mix(mcolor, gcolor, mix);
-        }
-        lv_draw_fill(&mid_top_area, mask, act_color, opa);
+        grad_fill(&mid_top_area, mask, &grad, opa);
     }
 
-    if(mcolor.full == gcolor.full)
-        act_color = mcolor;
-    else {
-        mix       = (uint32_t)((uint32_t)(coords->y2 - mid_bot_area.y1) * 255) / height;
-        act_color = lv_color_mix(mcolor, gcolor, mix);
-    }
-    lv_draw_fill(&mid_bot_area, mask, act_color, opa);
+    grad_fill(&mid_bot_area, mask, &grad, opa);
 
     if(edge_bot_area.y1 != mid_bot_area.y1) {
 
-        if(mcolor.full == gcolor.full)
-            act_color = mcolor;
-        else {
-            mix       = (uint32_t)((uint32_t)(coords->y2 - edge_bot_area.y1) * 255) / height;
-            act_color = lv_color_mix(mcolor, gcolor, mix);
-        }
-        lv_draw_fill(&edge_bot_area, mask, act_color, opa);
+        grad_fill(&edge_bot_area, mask, &grad, opa);
     }
 
 #if LV_ANTIALIAS
@@ -428,11 +377,13 @@ static void lv_draw_rect_main_corner(const lv_area_t * coords, const lv_area_t *
         edge_top_area.x2 = coords->x2 - radius - 2;
         edge_top_area.y1 = coords->y1;
         edge_top_area.y2 = coords->y1;
-        lv_draw_fill(&edge_top_area, mask, style->body.main_color, opa);
+        if(grad.dir == LV_GRAD_DIR_VER) lv_draw_fill(&edge_top_area, mask, style->body.main_color, opa);
+        else grad_fill(&edge_top_area, mask, &grad, opa);
 
         edge_top_area.y1 = coords->y2;
         edge_top_area.y2 = coords->y2;
-        lv_draw_fill(&edge_top_area, mask, style->body.grad_color, opa);
+        if(grad.dir == LV_GRAD_DIR_VER) lv_draw_fill(&edge_top_area, mask, style->body.grad_color, opa);
+        else grad_fill(&edge_top_area, mask, &grad, opa);
 
         /*Last parts of the anti-alias*/
         out_y_seg_end       = cir.y;
@@ -449,27 +400,27 @@ static void lv_draw_rect_main_corner(const lv_area_t * coords, const lv_area_t *
         lv_coord_t i;
         for(i = 0; i < seg_size; i++) {
             lv_opa_t aa_opa = opa - lv_draw_aa_get_opa(seg_size, i, opa);
-            lv_draw_px(rb_origo.x + LV_CIRC_OCT2_X(aa_p) + i, rb_origo.y + LV_CIRC_OCT2_Y(aa_p) + 1, mask,
-                       aa_color_hor_top, aa_opa);
-            lv_draw_px(lb_origo.x + LV_CIRC_OCT3_X(aa_p) - i, lb_origo.y + LV_CIRC_OCT3_Y(aa_p) + 1, mask,
-                       aa_color_hor_top, aa_opa);
-            lv_draw_px(lt_origo.x + LV_CIRC_OCT6_X(aa_p) - i, lt_origo.y + LV_CIRC_OCT6_Y(aa_p) - 1, mask,
-                       aa_color_hor_bottom, aa_opa);
-            lv_draw_px(rt_origo.x + LV_CIRC_OCT7_X(aa_p) + i, rt_origo.y + LV_CIRC_OCT7_Y(aa_p) - 1, mask,
-                       aa_color_hor_bottom, aa_opa);
+            grad_draw_px(&grad, rb_origo.x + LV_CIRC_OCT2_X(aa_p) + i, rb_origo.y + LV_CIRC_OCT2_Y(aa_p) + 1, mask,
+                         aa_color_hor_top, aa_opa);
+            grad_draw_px(&grad, lb_origo.x + LV_CIRC_OCT3_X(aa_p) - i, lb_origo.y + LV_CIRC_OCT3_Y(aa_p) + 1, mask,
+                         aa_color_hor_top, aa_opa);
+            grad_draw_px(&grad, lt_origo.x + LV_CIRC_OCT6_X(aa_p) - i, lt_origo.y + LV_CIRC_OCT6_Y(aa_p) - 1, mask,
+                         aa_color_hor_bottom, aa_opa);
+            grad_draw_px(&grad, rt_origo.x + LV_CIRC_OCT7_X(aa_p) + i, rt_origo.y + LV_CIRC_OCT7_Y(aa_p) - 1, mask,
+                         aa_color_hor_bottom, aa_opa);
 
             mix          = (uint32_t)((uint32_t)(radius - out_y_seg_start + i) * 255) / height;
             aa_color_ver = lv_color_mix(mcolor, gcolor, mix);
-            lv_draw_px(rb_origo.x + LV_CIRC_OCT1_X(aa_p) + 1, rb_origo.y + LV_CIRC_OCT1_Y(aa_p) + i, mask, aa_color_ver,
-                       aa_opa);
-            lv_draw_px(lb_origo.x + LV_CIRC_OCT4_X(aa_p) - 1, lb_origo.y + LV_CIRC_OCT4_Y(aa_p) + i, mask, aa_color_ver,
-                       aa_opa);
+            grad_draw_px(&grad, rb_origo.x + LV_CIRC_OCT1_X(aa_p) + 1, rb_origo.y + LV_CIRC_OCT1_Y(aa_p) + i, mask,
+                         aa_color_ver, aa_opa);
+            grad_draw_px(&grad, lb_origo.x + LV_CIRC_OCT4_X(aa_p) - 1, lb_origo.y + LV_CIRC_OCT4_Y(aa_p) + i, mask,
+                         aa_color_ver, aa_opa);
 
             aa_color_ver = lv_color_mix(gcolor, mcolor, mix);
-            lv_draw_px(lt_origo.x + LV_CIRC_OCT5_X(aa_p) - 1, lt_origo.y + LV_CIRC_OCT5_Y(aa_p) - i, mask, aa_color_ver,
-                       aa_opa);
-            lv_draw_px(rt_origo.x + LV_CIRC_OCT8_X(aa_p) + 1, rt_origo.y + LV_CIRC_OCT8_Y(aa_p) - i, mask, aa_color_ver,
-                       aa_opa);
+            grad_draw_px(&grad, lt_origo.x + LV_CIRC_OCT5_X(aa_p) - 1, lt_origo.y + LV_CIRC_OCT5_Y(aa_p) - i, mask,
+                         aa_color_ver, aa_opa);
+            grad_draw_px(&grad, rt_origo.x + LV_CIRC_OCT8_X(aa_p) + 1, rt_origo.y + LV_CIRC_OCT8_Y(aa_p) - i, mask,
+                         aa_color_ver, aa_opa);
         }
 
         /*In some cases the last pixel is not drawn*/
@@ -482,14 +433,14 @@ static void lv_draw_rect_main_corner(const lv_area_t * coords, const lv_area_t *
             aa_color_hor_bottom = lv_color_mix(mcolor, gcolor, mix);
 
             lv_opa_t aa_opa = opa >> 1;
-            lv_draw_px(rb_origo.x + LV_CIRC_OCT2_X(aa_p), rb_origo.y + LV_CIRC_OCT2_Y(aa_p), mask, aa_color_hor_bottom,
-                       aa_opa);
-            lv_draw_px(lb_origo.x + LV_CIRC_OCT4_X(aa_p), lb_origo.y + LV_CIRC_OCT4_Y(aa_p), mask, aa_color_hor_bottom,
-                       aa_opa);
-            lv_draw_px(lt_origo.x + LV_CIRC_OCT6_X(aa_p), lt_origo.y + LV_CIRC_OCT6_Y(aa_p), mask, aa_color_hor_top,
-                       aa_opa);
-            lv_draw_px(rt_origo.x + LV_CIRC_OCT8_X(aa_p), rt_origo.y + LV_CIRC_OCT8_Y(aa_p), mask, aa_color_hor_top,
-                       aa_opa);
+            grad_draw_px(&grad, rb_origo.x + LV_CIRC_OCT2_X(aa_p), rb_origo.y + LV_CIRC_OCT2_Y(aa_p), mask,
+                         aa_color_hor_bottom, aa_opa);
+            grad_draw_px(&grad, lb_origo.x + LV_CIRC_OCT4_X(aa_p), lb_origo.y + LV_CIRC_OCT4_Y(aa_p), mask,
+                         aa_color_hor_bottom, aa_opa);
+            grad_draw_px(&grad, lt_origo.x + LV_CIRC_OCT6_X(aa_p), lt_origo.y + LV_CIRC_OCT6_Y(aa_p), mask,
+                         aa_color_hor_top, aa_opa);
+            grad_draw_px(&grad, rt_origo.x + LV_CIRC_OCT8_X(aa_p), rt_origo.y + LV_CIRC_OCT8_Y(aa_p), mask,
+                         aa_color_hor_top, aa_opa);
         }
     }
 #endif
@@ -1462,6 +1413,108 @@ static void lv_draw_shadow_full_straight(const lv_area_t * coords, const lv_area
 
 #endif
 
+/**
+ * Initialize the background color descriptor of a rectangle
+ * @param grad pointer to a descriptor to initialize
+ * @param coords the coordinates of the rectangle
+ * @param style pointer to the rectangle's style
+ */
+static void grad_init(lv_draw_rect_grad_t * grad, const lv_area_t * coords, const lv_style_t * style)
+{
+    grad->coords = coords;
+    grad->color  = style->body.main_color;
+    grad->colors = NULL;
+    grad->len    = 0;
+    grad->dir    = style->body.grad_dir;
+
+    if(style->body.main_color.full == style->body.grad_color.full) return;
+
+    lv_coord_t w = lv_area_get_width(coords);
+    lv_coord_t h = lv_area_get_height(coords);
+    if(grad->dir == LV_GRAD_DIR_HOR) {
+        grad->len = w;
+    } else if(grad->dir == LV_GRAD_DIR_DIAG) {
+        grad->len = w + h - 1;
+    } else {
+        grad->dir = LV_GRAD_DIR_VER;
+        grad->len = h;
+    }
+
+    /*If there is no memory for the colors only `main_color` is drawn*/
+    grad->colors = lv_draw_grad_get(style->body.main_color, style->body.grad_color, grad->len);
+}
+
+/**
+ * Fill an area of a rectangle with its background color
+ * @param area the area to fill. Should be on the rectangle.
+ * @param mask fill only on this area
+ * @param grad pointer to the background color descriptor of the rectangle
+ * @param opa opacity
+ */
+static void grad_fill(const lv_area_t * area, const lv_area_t * mask, const lv_draw_rect_grad_t * grad, lv_opa_t opa)
+{
+    if(grad->colors == NULL) {
+        lv_draw_fill(area, mask, grad->color, opa);
+        return;
+    }
+
+    /*Draw only the rows of the area which are on the mask and the rectangle*/
+    lv_area_t work_area;
+    if(lv_area_intersect(&work_area, area, grad->coords) == false) return;
+
+    lv_coord_t y1 = LV_MATH_MAX(work_area.y1, mask->y1);
+    lv_coord_t y2 = LV_MATH_MIN(work_area.y2, mask->y2);
+    lv_coord_t y;
+
+    if(grad->dir == LV_GRAD_DIR_VER) {
+        /*One color per row*/
+        for(y = y1; y <= y2; y++) {
+            work_area.y1 = y;
+            work_area.y2 = y;
+            lv_draw_fill(&work_area, mask, grad->colors[y - grad->coords->y1], opa);
+        }
+    } else {
+        /*The colors of a horizontal gradient are the same in every row: copy them as a map.
+         *On diagonal gradients they are shifted by one color in every row.*/
+        const lv_color_t * row_colors = &grad->colors[work_area.x1 - grad->coords->x1];
+        for(y = y1; y <= y2; y++) {
+            work_area.y1 = y;
+            work_area.y2 = y;
+            const lv_color_t * map_p = row_colors;
+            if(grad->dir == LV_GRAD_DIR_DIAG) map_p += y - grad->coords->y1;
+            lv_draw_map(&work_area, mask, (const uint8_t *)map_p, opa, false, false, LV_COLOR_BLACK, LV_OPA_TRANSP);
+        }
+    }
+}
+
+#if LV_ANTIALIAS
+/**
+ * Draw a pixel (typically for anti-aliasing) with the background color of a rectangle
+ * @param grad pointer to the background color descriptor of the rectangle
+ * @param x x coordinate of the pixel
+ * @param y y coordinate of the pixel
+ * @param mask draw only on this area
+ * @param ver_color color of the pixel with vertical (or without) gradient
+ * @param opa opacity of the pixel
+ */
+static void grad_draw_px(const lv_draw_rect_grad_t * grad, lv_coord_t x, lv_coord_t y, const lv_area_t * mask,
+                         lv_color_t ver_color, lv_opa_t opa)
+{
+    if(grad->colors == NULL || grad->dir == LV_GRAD_DIR_VER) {
+        lv_draw_px(x, y, mask, ver_color, opa);
+        return;
+    }
+
+    int32_t i = x - grad->coords->x1;
+    if(grad->dir == LV_GRAD_DIR_DIAG) i += y - grad->coords->y1;
+
+    if(i < 0) i = 0;
+    else if(i >= grad->len) i = grad->len - 1;
+
+    lv_draw_px(x, y, mask, grad->colors[i], opa);
+}
+#endif
+
 static uint16_t lv_draw_cont_radius_corr(uint16_t r, lv_coord_t w, lv_coord_t h)
 {
     bool aa = lv_disp_get_antialiasing(lv_refr_get_disp_refreshing());
@@ -0,0 +1,850 @@
+/**
+ * @file lv_draw_sw.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_draw_sw.h"
+
+#include <string.h>
+#include "../lv_hal/lv_hal_disp.h"
+#include "lv_img_decoder.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/*Always fill < 50 px with 'sw_color_fill' because of the hw. init overhead*/
+#define VFILL_HW_ACC_SIZE_LIMIT 50
+
+/*Transparent subpixels before and after a row of a subpixel glyph: 3 for the extra pixel + 2 for the filter*/
+#define SUBPX_MARGIN 5
+
+#ifndef LV_ATTRIBUTE_MEM_ALIGN
+#define LV_ATTRIBUTE_MEM_ALIGN
+#endif
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void sw_fill(lv_disp_drv_t * drv, lv_color_t * buf, lv_coord_t buf_w, const lv_area_t * area,
+                    lv_color_t color, lv_opa_t opa);
+static void sw_blend(lv_disp_drv_t * drv, lv_color_t * buf, lv_coord_t buf_w, const lv_area_t * area,
+                     const lv_color_t * src, lv_coord_t src_w, lv_opa_t opa);
+static void sw_fill_mask(lv_disp_drv_t * drv, lv_color_t * buf, lv_coord_t buf_w, const lv_area_t * area,
+                         const lv_opa_t * mask, lv_coord_t mask_w, lv_color_t color, lv_opa_t opa);
+static void sw_glyph(lv_disp_drv_t * drv, lv_color_t * buf, lv_coord_t buf_w, const lv_area_t * area,
+                     const lv_point_t * pos, const lv_font_glyph_dsc_t * g, const uint8_t * bitmap, bool subpx,
+                     lv_color_t color, lv_opa_t opa);
+static void sw_glyph_subpx(lv_disp_drv_t * drv, lv_color_t * buf, lv_coord_t buf_w, const lv_area_t * area,
+                           const lv_point_t * pos, const lv_font_glyph_dsc_t * g, const uint8_t * bitmap,
+                           lv_color_t color, lv_opa_t opa);
+static const uint8_t * get_bpp_opa_table(uint8_t bpp);
+static void sw_map(lv_disp_drv_t * drv, lv_color_t * buf, lv_coord_t buf_w, const lv_area_t * area,
+                   const uint8_t * map, lv_coord_t map_w, lv_opa_t opa, bool chroma_key, bool alpha_byte,
+                   lv_color_t recolor, lv_opa_t recolor_opa);
+static void sw_mem_blend(lv_color_t * dest, const lv_color_t * src, uint32_t length, lv_opa_t opa);
+static void sw_color_fill(lv_disp_drv_t * drv, lv_color_t * mem, lv_coord_t mem_width, const lv_area_t * fill_area,
+                          lv_color_t color, lv_opa_t opa);
+
+#if LV_COLOR_DEPTH == 32 && LV_COLOR_SCREEN_TRANSP
+static inline lv_color_t color_mix_2_alpha(lv_color_t bg_color, lv_opa_t bg_opa, lv_color_t fg_color, lv_opa_t fg_opa);
+#endif
+
+/**********************
+ *  GLOBAL VARIABLES
+ **********************/
+const lv_draw_backend_t lv_draw_backend_sw = {
+    .fill      = sw_fill,
+    .blend     = sw_blend,
+    .fill_mask = sw_fill_mask,
+    .glyph     = sw_glyph,
+    .map       = sw_map,
+    .wait      = NULL,
+};
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+/**
+ * Draw a pixel with the software backend. Handles `set_px_cb` and `screen_transp` too.
+ * @param drv pointer to the display driver
+ * @param buf pointer to the buffer to draw
+ * @param buf_w width of the buffer
+ * @param x x coordinate relative to the buffer
+ * @param y y coordinate relative to the buffer
+ * @param color color of the pixel
+ * @param opa opacity of the pixel
+ */
+void lv_draw_sw_px(lv_disp_drv_t * drv, lv_color_t * buf, lv_coord_t buf_w, lv_coord_t x, lv_coord_t y,
+                   lv_color_t color, lv_opa_t opa)
+{
+    if(drv->set_px_cb) {
+        drv->set_px_cb(drv, (uint8_t *)buf, buf_w, x, y, color, opa);
+        return;
+    }
+
+    bool scr_transp = false;
+#if LV_COLOR_DEPTH == 32 && LV_COLOR_SCREEN_TRANSP
+    scr_transp = drv->screen_transp;
+#endif
+
+    lv_color_t * px_p = &buf[(uint32_t)y * buf_w + x];
+
+    if(scr_transp == false) {
+        if(opa == LV_OPA_COVER) {
+            *px_p = color;
+        } else {
+            *px_p = lv_color_mix(color, *px_p, opa);
+        }
+    } else {
+#if LV_COLOR_DEPTH == 32 && LV_COLOR_SCREEN_TRANSP
+        *px_p = color_mix_2_alpha(*px_p, (*px_p).ch.alpha, color, opa);
+#endif
+    }
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Fill an area with a color. Uses the GPU callbacks if they are set.
+ * @param drv pointer to the display driver
+ * @param buf pointer to the buffer to draw
+ * @param buf_w width of the buffer
+ * @param area the area to fill relative to `buf`
+ * @param color fill color
+ * @param opa opacity of the area (0..255)
+ */
+static void sw_fill(lv_disp_drv_t * drv, lv_color_t * buf, lv_coord_t buf_w, const lv_area_t * area,
+                    lv_color_t color, lv_opa_t opa)
+{
+#if LV_USE_GPU
+    static LV_ATTRIBUTE_MEM_ALIGN lv_color_t color_array_tmp[LV_HOR_RES_MAX]; /*Used by 'lv_disp_mem_blend'*/
+    static lv_coord_t last_width = -1;
+
+    lv_color_t * buf_tmp = buf + (uint32_t)buf_w * area->y1; /*Move to the first row*/
+    lv_coord_t w         = lv_area_get_width(area);
+    /*Don't use hw. acc. for every small fill (because of the init overhead)*/
+    if(w < VFILL_HW_ACC_SIZE_LIMIT) {
+        sw_color_fill(drv, buf, buf_w, area, color, opa);
+    }
+    /*Not opaque fill*/
+    else if(opa == LV_OPA_COVER) {
+        /*Use hw fill if present*/
+        if(drv->gpu_fill_cb) {
+            drv->gpu_fill_cb(drv, buf, buf_w, area, color);
+        }
+        /*Use hw blend if present and the area is not too small*/
+        else if(lv_area_get_height(area) > VFILL_HW_ACC_SIZE_LIMIT && drv->gpu_blend_cb) {
+            /*Fill a  one line sized buffer with a color and blend this later*/
+            if(color_array_tmp[0].full != color.full || last_width != w) {
+                uint16_t i;
+                for(i = 0; i < w; i++) {
+                    color_array_tmp[i].full = color.full;
+                }
+                last_width = w;
+            }
+
+            /*Blend the filled line to every line VDB line-by-line*/
+            lv_coord_t row;
+            for(row = area->y1; row <= area->y2; row++) {
+                drv->gpu_blend_cb(drv, &buf_tmp[area->x1], color_array_tmp, w, opa);
+                buf_tmp += buf_w;
+            }
+
+        }
+        /*Else use sw fill if no better option*/
+        else {
+            sw_color_fill(drv, buf, buf_w, area, color, opa);
+        }
+
+    }
+    /*Fill with opacity*/
+    else {
+        /*Use hw blend if present*/
+        if(drv->gpu_blend_cb) {
+            if(color_array_tmp[0].full != color.full || last_width != w) {
+                uint16_t i;
+                for(i = 0; i < w; i++) {
+                    color_array_tmp[i].full = color.full;
+                }
+
+                last_width = w;
+            }
+            lv_coord_t row;
+            for(row = area->y1; row <= area->y2; row++) {
+                drv->gpu_blend_cb(drv, &buf_tmp[area->x1], color_array_tmp, w, opa);
+                buf_tmp += buf_w;
+            }
+
+        }
+        /*Use sw fill with opa if no better option*/
+        else {
+            sw_color_fill(drv, buf, buf_w, area, color, opa);
+        }
+    }
+#else
+    sw_color_fill(drv, buf, buf_w, area, color, opa);
+#endif
+}
+
+/**
+ * Blend a color map to an area. Uses `gpu_blend_cb` if it's set.
+ * @param drv pointer to the display driver
+ * @param buf pointer to the buffer to draw
+ * @param buf_w width of the buffer
+ * @param area the area to draw relative to `buf`
+ * @param src the first pixel of the color map to draw on `area`
+ * @param src_w width of the color map
+ * @param opa opacity of the map
+ */
+static void sw_blend(lv_disp_drv_t * drv, lv_color_t * buf, lv_coord_t buf_w, const lv_area_t * area,
+                     const lv_color_t * src, lv_coord_t src_w, lv_opa_t opa)
+{
+    lv_coord_t w = lv_area_get_width(area);
+    lv_coord_t row;
+
+    /*Use the custom VDB write function is exists*/
+    if(drv->set_px_cb) {
+        lv_coord_t col;
+        for(row = area->y1; row <= area->y2; row++) {
+            for(col = 0; col < w; col++) {
+                drv->set_px_cb(drv, (uint8_t *)buf, buf_w, col + area->x1, row, src[col], opa);
+            }
+            src += src_w; /*Next row on the map*/
+        }
+        return;
+    }
+
+    lv_color_t * buf_tmp = buf + (uint32_t)buf_w * area->y1 + area->x1;
+    for(row = area->y1; row <= area->y2; row++) {
+#if LV_USE_GPU
+        if(drv->gpu_blend_cb == false) {
+            sw_mem_blend(buf_tmp, src, w, opa);
+        } else {
+            drv->gpu_blend_cb(drv, buf_tmp, src, w, opa);
+        }
+#else
+        sw_mem_blend(buf_tmp, src, w, opa);
+#endif
+        src += src_w;      /*Next row on the map*/
+        buf_tmp += buf_w;  /*Next row on the VDB*/
+    }
+}
+
+/**
+ * Fill an area with a color using the coverage of the pixels
+ * @param drv pointer to the display driver
+ * @param buf pointer to the buffer to draw
+ * @param buf_w width of the buffer
+ * @param area the area to draw relative to `buf`
+ * @param mask coverage of the first pixel of `area` (`LV_OPA_COVER`: fully covered, `LV_OPA_TRANSP`: not covered)
+ * @param mask_w width of the coverage mask
+ * @param color color of the pixels
+ * @param opa opacity of the fully covered pixels
+ */
+static void sw_fill_mask(lv_disp_drv_t * drv, lv_color_t * buf, lv_coord_t buf_w, const lv_area_t * area,
+                         const lv_opa_t * mask, lv_coord_t mask_w, lv_color_t color, lv_opa_t opa)
+{
+    bool scr_transp = false;
+#if LV_COLOR_DEPTH == 32 && LV_COLOR_SCREEN_TRANSP
+    scr_transp = drv->screen_transp;
+#endif
+
+    lv_coord_t len = lv_area_get_width(area);
+    lv_coord_t row;
+    lv_coord_t i;
+    if(drv->set_px_cb || scr_transp) {
+        /*`lv_draw_sw_px` knows how to handle the special cases*/
+        for(row = area->y1; row <= area->y2; row++) {
+            for(i = 0; i < len; i++) {
+                lv_opa_t px_opa = opa == LV_OPA_COVER ? mask[i] : (uint16_t)((uint16_t)mask[i] * opa) >> 8;
+                if(px_opa < LV_OPA_MIN) continue;
+                if(px_opa > LV_OPA_MAX) px_opa = LV_OPA_COVER;
+                lv_draw_sw_px(drv, buf, buf_w, area->x1 + i, row, color, px_opa);
+            }
+            mask += mask_w;
+        }
+        return;
+    }
+
+    lv_color_t * buf_tmp = buf + (uint32_t)buf_w * area->y1 + area->x1;
+
+    /*The inner pixels of shapes are fully covered and usually on the same background
+     * so remember the last mixed color of them*/
+    lv_opa_t full_opa  = opa == LV_OPA_COVER ? LV_OPA_COVER : (uint16_t)((uint16_t)LV_OPA_COVER * opa) >> 8;
+    lv_color_t bg_tmp  = LV_COLOR_BLACK;
+    lv_color_t opa_tmp = lv_color_mix(color, bg_tmp, full_opa);
+
+    for(row = area->y1; row <= area->y2; row++) {
+        for(i = 0; i < len; i++) {
+            if(mask[i] == LV_OPA_TRANSP) {
+                /*Skip 4 not covered pixels at once if aligned*/
+                if(((lv_uintptr_t)&mask[i] & 0x3) == 0 && i + 4 <= len && *((const uint32_t *)&mask[i]) == 0) i += 3;
+                continue;
+            }
+
+            if(mask[i] == LV_OPA_COVER && full_opa <= LV_OPA_MAX) {
+                if(full_opa < LV_OPA_MIN) continue;
+                if(buf_tmp[i].full != bg_tmp.full) {
+                    bg_tmp  = buf_tmp[i];
+                    opa_tmp = lv_color_mix(color, bg_tmp, full_opa);
+                }
+                buf_tmp[i] = opa_tmp;
+                continue;
+            }
+
+            lv_opa_t px_opa = opa == LV_OPA_COVER ? mask[i] : (uint16_t)((uint16_t)mask[i] * opa) >> 8;
+            if(px_opa > LV_OPA_MAX) {
+                buf_tmp[i] = color;
+            } else if(px_opa >= LV_OPA_MIN) {
+                buf_tmp[i] = lv_color_mix(color, buf_tmp[i], px_opa);
+            }
+        }
+        mask += mask_w;
+        buf_tmp += buf_w;
+    }
+}
+
+/**
+ * Draw a glyph of a font
+ * @param drv pointer to the display driver
+ * @param buf pointer to the buffer to draw
+ * @param buf_w width of the buffer
+ * @param area the part of the glyph's box to draw relative to `buf`
+ * @param pos top left corner of the glyph's box relative to `buf`
+ * @param g descriptor of the glyph. (`box_w` is the width of the bitmap)
+ * @param bitmap the bitmap of the glyph
+ * @param subpx true: the bitmap has 3 values for every pixel (subpixel rendering)
+ * @param color color of the glyph
+ * @param opa opacity of the glyph
+ */
+static void sw_glyph(lv_disp_drv_t * drv, lv_color_t * buf, lv_coord_t buf_w, const lv_area_t * area,
+                     const lv_point_t * pos, const lv_font_glyph_dsc_t * g, const uint8_t * bitmap, bool subpx,
+                     lv_color_t color, lv_opa_t opa)
+{
+    if(subpx) {
+        sw_glyph_subpx(drv, buf, buf_w, area, pos, g, bitmap, color, opa);
+        return;
+    }
+
+    const uint8_t * bpp_opa_table = get_bpp_opa_table(g->bpp);
+    uint8_t bpp                   = g->bpp;
+    uint8_t bitmask_init          = (1 << bpp) - 1;
+    bitmask_init <<= 8 - bpp;
+    uint8_t bitmask;
+
+    lv_coord_t col, row;
+    uint16_t width_bit = g->box_w * bpp; /*Letter width in bits*/
+
+    /* Calculate the col/row start/end on the bitmap*/
+    lv_coord_t col_start = area->x1 - pos->x;
+    lv_coord_t col_end   = area->x2 - pos->x + 1;
+    lv_coord_t row_start = area->y1 - pos->y;
+    lv_coord_t row_end   = area->y2 - pos->y + 1;
+
+    /*Set a pointer on the buffer to the first pixel to draw*/
+    lv_color_t * buf_tmp = buf + (uint32_t)area->y1 * buf_w + area->x1;
+
+    /*Move on the bitmap too*/
+    uint32_t bit_ofs = (row_start * width_bit) + (col_start * bpp);
+    bitmap += bit_ofs >> 3;
+
+    uint8_t letter_px;
+    lv_opa_t px_opa = 0;
+    uint16_t col_bit;
+    col_bit = bit_ofs & 0x7; /* "& 0x7" equals to "% 8" just faster */
+
+    bool scr_transp = false;
+#if LV_COLOR_DEPTH == 32 && LV_COLOR_SCREEN_TRANSP
+    scr_transp = drv->screen_transp;
+#endif
+
+    for(row = row_start; row < row_end; row++) {
+        bitmask = bitmask_init >> col_bit;
+        for(col = col_start; col < col_end; col++) {
+            letter_px = (*bitmap & bitmask) >> (8 - col_bit - bpp);
+
+            if(letter_px != 0) {
+                if(opa == LV_OPA_COVER) {
+                    px_opa = bpp == 8 ? letter_px : bpp_opa_table[letter_px];
+                } else {
+                    px_opa = bpp == 8 ? (uint16_t)((uint16_t)letter_px * opa) >> 8
+                             : (uint16_t)((uint16_t)bpp_opa_table[letter_px] * opa) >> 8;
+                }
+
+                if(drv->set_px_cb) {
+                    drv->set_px_cb(drv, (uint8_t *)buf, buf_w, col + pos->x, row + pos->y, color, px_opa);
+                } else if(buf_tmp->full != color.full) {
+                    if(px_opa > LV_OPA_MAX) {
+                        *buf_tmp = color;
+                    } else if(px_opa > LV_OPA_MIN) {
+                        if(scr_transp == false) {
+                            *buf_tmp = lv_color_mix(color, *buf_tmp, px_opa);
+                        } else {
+#if LV_COLOR_DEPTH == 32 && LV_COLOR_SCREEN_TRANSP
+                            *buf_tmp = color_mix_2_alpha(*buf_tmp, (*buf_tmp).ch.alpha, color, px_opa);
+#endif
+                        }
+                    }
+                }
+            }
+            buf_tmp++;
+
+            if(col_bit < 8 - bpp) {
+                col_bit += bpp;
+                bitmask = bitmask >> bpp;
+            } else {
+                col_bit = 0;
+                bitmask = bitmask_init;
+                bitmap++;
+            }
+        }
+
+        col_bit += ((g->box_w - col_end) + col_start) * bpp;
+
+        bitmap += (col_bit >> 3);
+        col_bit = col_bit & 0x7;
+
+        /*Next row in the buffer*/
+        buf_tmp += buf_w - (col_end - col_start);
+    }
+}
+
+/**
+ * Draw a glyph whose bitmap has 3 values (the coverage of the R, G, B subpixels) for every pixel.
+ * The subpixels are mixed one-by-one with the background so the horizontal resolution is tripled on LCD panels.
+ * @param drv pointer to the display driver
+ * @param buf pointer to the buffer to draw
+ * @param buf_w width of the buffer
+ * @param area the part of the glyph to draw relative to `buf`. Can be 1 pixel wider than the box on both sides.
+ * @param pos top left corner of the glyph's box relative to `buf`
+ * @param g descriptor of the glyph. (`box_w` is the width of the bitmap)
+ * @param bitmap the bitmap of the glyph
+ * @param color color of the glyph
+ * @param opa opacity of the glyph
+ */
+static void sw_glyph_subpx(lv_disp_drv_t * drv, lv_color_t * buf, lv_coord_t buf_w, const lv_area_t * area,
+                           const lv_point_t * pos, const lv_font_glyph_dsc_t * g, const uint8_t * bitmap,
+                           lv_color_t color, lv_opa_t opa)
+{
+#if LV_FONT_SUBPX_FILTER
+    /*FIR filter applied on the neighbor subpixels to reduce the color fringes. (The sum is 256)*/
+    static const uint8_t filter[5] = {8, 77, 86, 77, 8};
+#endif
+
+    const uint8_t * bpp_opa_table = get_bpp_opa_table(g->bpp);
+    uint8_t bpp                   = g->bpp;
+    uint8_t px_mask               = (1 << bpp) - 1;
+
+    /* Coverage of the subpixels of a row in 0..255. The glyph's row starts at `SUBPX_MARGIN`.
+     * The margins are transparent: the filter might color 1 pixel (3 subpixels) more on both sides
+     * and reads 2 more subpixels there.*/
+    uint8_t cov[SUBPX_MARGIN + 255 + SUBPX_MARGIN];
+    memset(cov, 0, sizeof(cov));
+
+    /*The filtered coverage of the subpixels to draw*/
+    uint8_t sub[(255 / 3 + 3) * 3];
+
+    bool scr_transp = false;
+#if LV_COLOR_DEPTH == 32 && LV_COLOR_SCREEN_TRANSP
+    scr_transp = drv->screen_transp;
+#endif
+
+    uint8_t txt_rgb[3] = {LV_COLOR_GET_R(color), LV_COLOR_GET_G(color), LV_COLOR_GET_B(color)};
+
+    lv_color_t * buf_tmp = buf + (uint32_t)area->y1 * buf_w + area->x1;
+    lv_coord_t w         = lv_area_get_width(area);
+    lv_coord_t row_start = area->y1 - pos->y;
+    lv_coord_t row_end   = area->y2 - pos->y;
+
+    /*Index of the first subpixel of `area->x1` in `cov`*/
+    int32_t sub_start = SUBPX_MARGIN + (area->x1 - pos->x) * 3;
+    lv_coord_t sub_cnt = w * 3;
+
+    lv_coord_t row;
+    lv_coord_t col;
+    for(row = row_start; row <= row_end; row++) {
+        /*Decode the row of the bitmap. The rows are continuous, i.e. not aligned to bytes.*/
+        uint32_t bit_ofs    = (uint32_t)row * g->box_w * bpp;
+        const uint8_t * src = bitmap + (bit_ofs >> 3);
+        int8_t shift        = 8 - bpp - (bit_ofs & 0x7);
+        uint8_t * cov_p     = &cov[SUBPX_MARGIN];
+        lv_coord_t i;
+        if(bpp == 8) {
+            memcpy(cov_p, src, g->box_w);
+        } else {
+            for(i = 0; i < g->box_w; i++) {
+                cov_p[i] = bpp_opa_table[(*src >> shift) & px_mask];
+                shift -= bpp;
+                if(shift < 0) {
+                    shift += 8;
+                    src++;
+                }
+            }
+        }
+
+        /*Filter the subpixels of the drawn pixels and apply the opacity*/
+        cov_p = &cov[sub_start];
+        for(i = 0; i < sub_cnt; i++) {
+
+#if LV_FONT_SUBPX_FILTER
+            uint16_t f = (filter[0] * (cov_p[i - 2] + cov_p[i + 2]) + filter[1] * (cov_p[i - 1] + cov_p[i + 1]) +
+                          filter[2] * cov_p[i]) >> 8;
+            if(f > LV_OPA_COVER) f = LV_OPA_COVER;
+#else
+            uint16_t f = cov_p[i];
+#endif
+            sub[i] = opa == LV_OPA_COVER ? f : (uint16_t)(f * opa) >> 8;
+        }
+
+        const uint8_t * sub_p = sub;
+        for(col = 0; col < w; col++, sub_p += 3) {
+            /*Skip the transparent pixels (typical around the glyphs)*/
+            if(sub_p[0] == 0 && sub_p[1] == 0 && sub_p[2] == 0) continue;
+
+            /*The first subpixel is blue on BGR panels*/
+#if LV_FONT_SUBPX_BGR
+            uint8_t cov_r = sub_p[2];
+            uint8_t cov_b = sub_p[0];
+#else
+            uint8_t cov_r = sub_p[0];
+            uint8_t cov_b = sub_p[2];
+#endif
+            uint8_t cov_g = sub_p[1];
+
+            if(drv->set_px_cb || scr_transp) {
+                /*The special pixels can't be mixed per channel so use the average coverage*/
+                lv_opa_t px_opa = ((uint16_t)cov_r + cov_g + cov_g + cov_b) >> 2;
+                if(px_opa >= LV_OPA_MIN) {
+                    lv_draw_sw_px(drv, buf, buf_w, area->x1 + col, area->y1 + row - row_start, color, px_opa);
+                }
+                continue;
+            }
+
+            if(cov_r == LV_OPA_COVER && cov_g == LV_OPA_COVER && cov_b == LV_OPA_COVER) {
+                buf_tmp[col] = color;
+                continue;
+            }
+
+            lv_color_t bg = buf_tmp[col];
+            lv_color_t res;
+            LV_COLOR_SET_R(res, (uint16_t)((uint16_t)txt_rgb[0] * cov_r + LV_COLOR_GET_R(bg) * (255 - cov_r)) >> 8);
+            LV_COLOR_SET_G(res, (uint16_t)((uint16_t)txt_rgb[1] * cov_g + LV_COLOR_GET_G(bg) * (255 - cov_g)) >> 8);
+            LV_COLOR_SET_B(res, (uint16_t)((uint16_t)txt_rgb[2] * cov_b + LV_COLOR_GET_B(bg) * (255 - cov_b)) >> 8);
+#if LV_COLOR_DEPTH == 32
+            res.ch.alpha = bg.ch.alpha;
+#endif
+            buf_tmp[col] = res;
+        }
+
+        buf_tmp += buf_w;
+    }
+}
+
+/**
+ * Get the table to convert the pixel values of a glyph's bitmap to opacity
+ * @param bpp bit per pixel of the bitmap (1, 2, 4 or 8)
+ * @return the table or NULL with 8 bpp (the values are the opacities)
+ */
+static const uint8_t * get_bpp_opa_table(uint8_t bpp)
+{
+    /*clang-format off*/
+    static const uint8_t bpp1_opa_table[2]  = {0, 255};          /*Opacity mapping with bpp = 1 (Just for compatibility)*/
+    static const uint8_t bpp2_opa_table[4]  = {0, 85, 170, 255}; /*Opacity mapping with bpp = 2*/
+    static const uint8_t bpp4_opa_table[16] = {0,  17, 34,  51,  /*Opacity mapping with bpp = 4*/
+                                               68, 85, 102, 119, 136, 153, 170, 187, 204, 221, 238, 255};
+    /*clang-format on*/
+
+    switch(bpp) {
+        case 1: return bpp1_opa_table;
+        case 2: return bpp2_opa_table;
+        case 4: return bpp4_opa_table;
+        default: return NULL;
+    }
+}
+
+/**
+ * Draw an image pixel-by-pixel with alpha byte, chroma keying and/or recoloring
+ * @param drv pointer to the display driver
+ * @param buf pointer to the buffer to draw
+ * @param buf_w width of the buffer
+ * @param area the area to draw relative to `buf`
+ * @param map the first pixel of the image to draw on `area`
+ * @param map_w width of the image
+ * @param opa opacity of the image
+ * @param chroma_keyed true: enable transparency of LV_IMG_LV_COLOR_TRANSP color pixels
+ * @param alpha_byte true: extra alpha byte is inserted for every pixel
+ * @param recolor mix the pixels with this color
+ * @param recolor_opa the intense of recoloring
+ */
+static void sw_map(lv_disp_drv_t * drv, lv_color_t * buf, lv_coord_t buf_w, const lv_area_t * area,
+                   const uint8_t * map, lv_coord_t map_w, lv_opa_t opa, bool chroma_key, bool alpha_byte,
+                   lv_color_t recolor, lv_opa_t recolor_opa)
+{
+    /*The pixel size in byte is different if an alpha byte is added too*/
+    uint8_t px_size_byte = alpha_byte ? LV_IMG_PX_SIZE_ALPHA_BYTE : sizeof(lv_color_t);
+
+    bool scr_transp = false;
+#if LV_COLOR_DEPTH == 32 && LV_COLOR_SCREEN_TRANSP
+    scr_transp = drv->screen_transp;
+#endif
+
+    lv_color_t * buf_tmp = buf + (uint32_t)buf_w * area->y1 + area->x1;
+    lv_coord_t map_useful_w = lv_area_get_width(area);
+
+    lv_coord_t row;
+    lv_coord_t col;
+    lv_color_t last_img_px  = LV_COLOR_BLACK;
+    lv_color_t recolored_px = lv_color_mix(recolor, last_img_px, recolor_opa);
+    for(row = area->y1; row <= area->y2; row++) {
+        for(col = 0; col < map_useful_w; col++) {
+            lv_opa_t opa_result  = opa;
+            const uint8_t * px_color_p = &map[(uint32_t)col * px_size_byte];
+            lv_color_t px_color;
+
+            /*Calculate with the pixel level alpha*/
+            if(alpha_byte) {
+#if LV_COLOR_DEPTH == 8 || LV_COLOR_DEPTH == 1
+                px_color.full = px_color_p[0];
+#elif LV_COLOR_DEPTH == 16
+                /*Because of Alpha byte 16 bit color can start on odd address which can cause
+                 * crash*/
+                px_color.full = px_color_p[0] + (px_color_p[1] << 8);
+#elif LV_COLOR_DEPTH == 32
+                px_color = *((lv_color_t *)px_color_p);
+#endif
+                lv_opa_t px_opa = *(px_color_p + LV_IMG_PX_SIZE_ALPHA_BYTE - 1);
+                if(px_opa == LV_OPA_TRANSP)
+                    continue;
+                else if(px_opa != LV_OPA_COVER)
+                    opa_result = (uint32_t)((uint32_t)px_opa * opa_result) >> 8;
+            } else {
+                px_color = *((lv_color_t *)px_color_p);
+            }
+
+            /*Handle chroma key*/
+            if(chroma_key && px_color.full == drv->color_chroma_key.full) continue;
+
+            /*Re-color the pixel if required*/
+            if(recolor_opa != LV_OPA_TRANSP) {
+                if(last_img_px.full != px_color.full) { /*Minor acceleration: calculate only for
+                                                           new colors (save the last)*/
+                    last_img_px  = px_color;
+                    recolored_px = lv_color_mix(recolor, last_img_px, recolor_opa);
+                }
+                /*Handle custom VDB write is present*/
+                if(drv->set_px_cb) {
+                    drv->set_px_cb(drv, (uint8_t *)buf, buf_w, col + area->x1, row, recolored_px, opa_result);
+                }
+                /*Normal native VDB write*/
+                else {
+                    if(opa_result == LV_OPA_COVER)
+                        buf_tmp[col].full = recolored_px.full;
+                    else
+                        buf_tmp[col] = lv_color_mix(recolored_px, buf_tmp[col], opa_result);
+                }
+            } else {
+                /*Handle custom VDB write is present*/
+                if(drv->set_px_cb) {
+                    drv->set_px_cb(drv, (uint8_t *)buf, buf_w, col + area->x1, row, px_color, opa_result);
+                }
+                /*Normal native VDB write*/
+                else {
+
+                    if(opa_result == LV_OPA_COVER)
+                        buf_tmp[col] = px_color;
+                    else {
+                        if(scr_transp == false) {
+                            buf_tmp[col] = lv_color_mix(px_color, buf_tmp[col], opa_result);
+                        } else {
+#if LV_COLOR_DEPTH == 32 && LV_COLOR_SCREEN_TRANSP
+                            buf_tmp[col] = color_mix_2_alpha(buf_tmp[col], buf_tmp[col].ch.alpha, px_color, opa_result);
+#endif
+                        }
+                    }
+                }
+            }
+        }
+
+        map += (uint32_t)map_w * px_size_byte; /*Next row on the map*/
+        buf_tmp += buf_w;                      /*Next row on the VDB*/
+    }
+}
+
+/**
+ * Blend pixels to destination memory using opacity
+ * @param dest a memory address. Copy 'src' here.
+ * @param src pointer to pixel map. Copy it to 'dest'.
+ * @param length number of pixels in 'src'
+ * @param opa opacity (0, LV_OPA_TRANSP: transparent ... 255, LV_OPA_COVER, fully cover)
+ */
+static void sw_mem_blend(lv_color_t * dest, const lv_color_t * src, uint32_t length, lv_opa_t opa)
+{
+    if(opa == LV_OPA_COVER) {
+        memcpy(dest, src, length * sizeof(lv_color_t));
+    } else {
+        /*The maps are often flat (e.g. layers of widgets) so remember the last mixed pixels*/
+        lv_color_t src_tmp  = LV_COLOR_BLACK;
+        lv_color_t dest_tmp = LV_COLOR_BLACK;
+        lv_color_t res_tmp  = LV_COLOR_BLACK;
+        uint32_t col;
+        for(col = 0; col < length; col++) {
+            if(src[col].full == dest[col].full) continue;
+
+            if(src[col].full != src_tmp.full || dest[col].full != dest_tmp.full) {
+                src_tmp  = src[col];
+                dest_tmp = dest[col];
+                res_tmp  = lv_color_mix(src_tmp, dest_tmp, opa);
+            }
+            dest[col] = res_tmp;
+        }
+    }
+}
+
+/**
+ * Fill an area with a color
+ * @param drv pointer to the display driver
+ * @param mem a memory address. Considered to a rectangular window according to 'mem_area'
+ * @param mem_width width of the 'mem' buffer
+ * @param fill_area coordinates of an area to fill. Relative to 'mem_area'.
+ * @param color fill color
+ * @param opa opacity (0, LV_OPA_TRANSP: transparent ... 255, LV_OPA_COVER, fully cover)
+ */
+static void sw_color_fill(lv_disp_drv_t * drv, lv_color_t * mem, lv_coord_t mem_width, const lv_area_t * fill_area,
+                          lv_color_t color, lv_opa_t opa)
+{
+    /*Set all row in vdb to the given color*/
+    lv_coord_t row;
+    lv_coord_t col;
+
+    if(drv->set_px_cb) {
+        for(col = fill_area->x1; col <= fill_area->x2; col++) {
+            for(row = fill_area->y1; row <= fill_area->y2; row++) {
+                drv->set_px_cb(drv, (uint8_t *)mem, mem_width, col, row, color, opa);
+            }
+        }
+    } else {
+        mem += fill_area->y1 * mem_width; /*Go to the first row*/
+
+        /*Run simpler function without opacity*/
+        if(opa == LV_OPA_COVER) {
+
+            /*Fill the first row with 'color'*/
+            for(col = fill_area->x1; col <= fill_area->x2; col++) {
+                mem[col] = color;
+            }
+
+            /*Copy the first row to all other rows*/
+            lv_color_t * mem_first = &mem[fill_area->x1];
+            lv_coord_t copy_size   = (fill_area->x2 - fill_area->x1 + 1) * sizeof(lv_color_t);
+            mem += mem_width;
+
+            for(row = fill_area->y1 + 1; row <= fill_area->y2; row++) {
+                memcpy(&mem[fill_area->x1], mem_first, copy_size);
+                mem += mem_width;
+            }
+        }
+        /*Calculate with alpha too*/
+        else {
+            bool scr_transp = false;
+#if LV_COLOR_DEPTH == 32 && LV_COLOR_SCREEN_TRANSP
+            scr_transp = drv->screen_transp;
+#endif
+
+            lv_color_t bg_tmp  = LV_COLOR_BLACK;
+            lv_color_t opa_tmp = lv_color_mix(color, bg_tmp, opa);
+            for(row = fill_area->y1; row <= fill_area->y2; row++) {
+                for(col = fill_area->x1; col <= fill_area->x2; col++) {
+                    if(scr_transp == false) {
+                        /*If the bg color changed recalculate the result color*/
+                        if(mem[col].full != bg_tmp.full) {
+                            bg_tmp  = mem[col];
+                            opa_tmp = lv_color_mix(color, bg_tmp, opa);
+                        }
+
+                        mem[col] = opa_tmp;
+
+                    } else {
+#if LV_COLOR_DEPTH == 32 && LV_COLOR_SCREEN_TRANSP
+                        mem[col] = color_mix_2_alpha(mem[col], mem[col].ch.alpha, color, opa);
+#endif
+                    }
+                }
+                mem += mem_width;
+            }
+        }
+    }
+}
+
+#if LV_COLOR_DEPTH == 32 && LV_COLOR_SCREEN_TRANSP
+/**
+ * Mix two colors. Both color can have alpha value. It requires ARGB888 colors.
+ * @param bg_color background color
+ * @param bg_opa alpha of the background color
+ * @param fg_color foreground color
+ * @param fg_opa alpha of the foreground color
+ * @return the mixed color. the alpha channel (color.alpha) contains the result alpha
+ */
+static inline lv_color_t color_mix_2_alpha(lv_color_t bg_color, lv_opa_t bg_opa, lv_color_t fg_color, lv_opa_t fg_opa)
+{
+    /* Pick the foreground if it's fully opaque or the Background is fully transparent*/
+    if(fg_opa > LV_OPA_MAX || bg_opa <= LV_OPA_MIN) {
+        fg_color.ch.alpha = fg_opa;
+        return fg_color;
+    }
+    /*Transparent foreground: use the Background*/
+    else if(fg_opa <= LV_OPA_MIN) {
+        return bg_color;
+    }
+    /*Opaque background: use simple mix*/
+    else if(bg_opa >= LV_OPA_MAX) {
+        return lv_color_mix(fg_color, bg_color, fg_opa);
+    }
+    /*Both colors have alpha. Expensive calculation need to be applied*/
+    else {
+        /*Save the parameters and the result. If they will be asked again don't compute again*/
+        static lv_opa_t fg_opa_save     = 0;
+        static lv_opa_t bg_opa_save     = 0;
+        static lv_color_t fg_color_save = {{0}};
+        static lv_color_t bg_color_save = {{0}};
+        static lv_color_t c             = {{0}};
+
+        if(fg_opa != fg_opa_save || bg_opa != bg_opa_save || fg_color.full != fg_color_save.full ||
+           bg_color.full != bg_color_save.full) {
+            fg_opa_save        = fg_opa;
+            bg_opa_save        = bg_opa;
+            fg_color_save.full = fg_color.full;
+            bg_color_save.full = bg_color.full;
+            /*Info:
+             * https://en.wikipedia.org/wiki/Alpha_compositing#Analytical_derivation_of_the_over_operator*/
+            lv_opa_t alpha_res = 255 - ((uint16_t)((uint16_t)(255 - fg_opa) * (255 - bg_opa)) >> 8);
+            if(alpha_res == 0) {
+                while(1)
+                    ;
+            }
+            lv_opa_t ratio = (uint16_t)((uint16_t)fg_opa * 255) / alpha_res;
+            c              = lv_color_mix(fg_color, bg_color, ratio);
+            c.ch.alpha     = alpha_res;
+        }
+        return c;
+    }
+}
+#endif
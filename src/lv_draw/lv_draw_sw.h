@@ -0,0 +1,55 @@
+/**
+ * @file lv_draw_sw.h
+ *
+ */
+
+#ifndef LV_DRAW_SW_H
+#define LV_DRAW_SW_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_draw_backend.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/** The software draw backend. Used if no other backend is set in the display driver.
+ * Uses `gpu_fill_cb` and `gpu_blend_cb` of the driver if they are set.*/
+extern const lv_draw_backend_t lv_draw_backend_sw;
+
+/**
+ * Draw a pixel with the software backend. Handles `set_px_cb` and `screen_transp` too.
+ * @param drv pointer to the display driver
+ * @param buf pointer to the buffer to draw
+ * @param buf_w width of the buffer
+ * @param x x coordinate relative to the buffer
+ * @param y y coordinate relative to the buffer
+ * @param color color of the pixel
+ * @param opa opacity of the pixel
+ */
+void lv_draw_sw_px(struct _disp_drv_t * drv, lv_color_t * buf, lv_coord_t buf_w, lv_coord_t x, lv_coord_t y,
+                   lv_color_t color, lv_opa_t opa);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /*LV_DRAW_SW_H*/
@@ -0,0 +1,395 @@
+/**
+ * @file lv_draw_thread.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_draw_thread.h"
+#if LV_USE_DRAW_THREAD
+
+#include <pthread.h>
+#include "../lv_hal/lv_hal_disp.h"
+#include "../lv_misc/lv_log.h"
+#include "lv_img_decoder.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+/*Max. number of queued jobs (parts of operations)*/
+#define JOB_MAX ((LV_DRAW_THREAD_CNT + 1) * 4)
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef enum {
+    JOB_FILL,
+    JOB_BLEND,
+    JOB_MAP,
+} job_type_t;
+
+/*A horizontal stripe of an operation*/
+typedef struct
+{
+    lv_disp_drv_t * drv;
+    lv_color_t * buf;
+    lv_coord_t buf_w;
+    lv_area_t area;           /*The stripe to draw relative to `buf`*/
+    const uint8_t * src;      /*The first pixel of the stripe with `JOB_BLEND` and `JOB_MAP`*/
+    lv_coord_t src_w;
+    lv_color_t color;         /*Fill color or recolor*/
+    lv_opa_t opa;
+    lv_opa_t recolor_opa;
+    uint8_t type : 2;         /*An element of `job_type_t`*/
+    uint8_t chroma_key : 1;
+    uint8_t alpha_byte : 1;
+} draw_job_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void th_fill(lv_disp_drv_t * drv, lv_color_t * buf, lv_coord_t buf_w, const lv_area_t * area,
+                    lv_color_t color, lv_opa_t opa);
+static void th_blend(lv_disp_drv_t * drv, lv_color_t * buf, lv_coord_t buf_w, const lv_area_t * area,
+                     const lv_color_t * src, lv_coord_t src_w, lv_opa_t opa);
+static void th_fill_mask(lv_disp_drv_t * drv, lv_color_t * buf, lv_coord_t buf_w, const lv_area_t * area,
+                         const lv_opa_t * mask, lv_coord_t mask_w, lv_color_t color, lv_opa_t opa);
+static void th_glyph(lv_disp_drv_t * drv, lv_color_t * buf, lv_coord_t buf_w, const lv_area_t * area,
+                     const lv_point_t * pos, const lv_font_glyph_dsc_t * g, const uint8_t * bitmap, bool subpx,
+                     lv_color_t color, lv_opa_t opa);
+static void th_map(lv_disp_drv_t * drv, lv_color_t * buf, lv_coord_t buf_w, const lv_area_t * area,
+                   const uint8_t * map, lv_coord_t map_w, lv_opa_t opa, bool chroma_key, bool alpha_byte,
+                   lv_color_t recolor, lv_opa_t recolor_opa);
+static void th_wait(lv_disp_drv_t * drv);
+static bool prepare(lv_disp_drv_t * drv, lv_color_t * buf, const lv_area_t * area);
+static void submit(const draw_job_t * job, uint8_t px_size);
+static void wait_all(void);
+static void job_exec(const draw_job_t * job);
+static void * worker(void * param);
+static void threads_init(void);
+
+/**********************
+ *  GLOBAL VARIABLES
+ **********************/
+const lv_draw_backend_t lv_draw_backend_thread = {
+    .fill      = th_fill,
+    .blend     = th_blend,
+    .fill_mask = th_fill_mask,
+    .glyph     = th_glyph,
+    .map       = th_map,
+    .wait      = th_wait,
+};
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static pthread_t threads[LV_DRAW_THREAD_CNT];
+static uint8_t thread_cnt; /*Number of successfully started workers*/
+static pthread_once_t init_once   = PTHREAD_ONCE_INIT;
+static pthread_mutex_t job_mutex  = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t job_cond    = PTHREAD_COND_INITIALIZER; /*Signaled if new jobs are added*/
+static pthread_cond_t done_cond   = PTHREAD_COND_INITIALIZER; /*Signaled if every job is finished*/
+
+/*Circular queue of the jobs. Protected by `job_mutex`*/
+static draw_job_t jobs[JOB_MAX];
+static uint16_t job_rd;
+static uint16_t job_cnt;     /*Number of jobs in the queue*/
+static uint16_t job_running; /*Number of jobs being executed*/
+
+/*The unfinished jobs draw only on this area of this buffer. Used only by the calling thread.*/
+static lv_color_t * busy_buf;
+static lv_area_t busy_area;
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Fill an area with a color. The large areas are filled by the worker threads in the background.
+ */
+static void th_fill(lv_disp_drv_t * drv, lv_color_t * buf, lv_coord_t buf_w, const lv_area_t * area,
+                    lv_color_t color, lv_opa_t opa)
+{
+    if(prepare(drv, buf, area) == false) {
+        lv_draw_backend_sw.fill(drv, buf, buf_w, area, color, opa);
+        return;
+    }
+
+    draw_job_t job;
+    job.type  = JOB_FILL;
+    job.drv   = drv;
+    job.buf   = buf;
+    job.buf_w = buf_w;
+    job.color = color;
+    job.opa   = opa;
+    lv_area_copy(&job.area, area);
+    submit(&job, 0);
+}
+
+/**
+ * Blend a color map to an area. The large maps are blended by the worker threads and the calling thread together.
+ */
+static void th_blend(lv_disp_drv_t * drv, lv_color_t * buf, lv_coord_t buf_w, const lv_area_t * area,
+                     const lv_color_t * src, lv_coord_t src_w, lv_opa_t opa)
+{
+    if(prepare(drv, buf, area) == false) {
+        lv_draw_backend_sw.blend(drv, buf, buf_w, area, src, src_w, opa);
+        return;
+    }
+
+    draw_job_t job;
+    job.type  = JOB_BLEND;
+    job.drv   = drv;
+    job.buf   = buf;
+    job.buf_w = buf_w;
+    job.src   = (const uint8_t *)src;
+    job.src_w = src_w;
+    job.opa   = opa;
+    lv_area_copy(&job.area, area);
+    submit(&job, sizeof(lv_color_t));
+
+    /*`src` might be reused by the caller*/
+    wait_all();
+}
+
+/**
+ * Fill an area using the coverage of the pixels. The masks are small so it's done by the calling thread.
+ */
+static void th_fill_mask(lv_disp_drv_t * drv, lv_color_t * buf, lv_coord_t buf_w, const lv_area_t * area,
+                         const lv_opa_t * mask, lv_coord_t mask_w, lv_color_t color, lv_opa_t opa)
+{
+    prepare(drv, buf, area);
+    lv_draw_backend_sw.fill_mask(drv, buf, buf_w, area, mask, mask_w, color, opa);
+}
+
+/**
+ * Draw a glyph of a font. The glyphs are small so it's done by the calling thread.
+ */
+static void th_glyph(lv_disp_drv_t * drv, lv_color_t * buf, lv_coord_t buf_w, const lv_area_t * area,
+                     const lv_point_t * pos, const lv_font_glyph_dsc_t * g, const uint8_t * bitmap, bool subpx,
+                     lv_color_t color, lv_opa_t opa)
+{
+    prepare(drv, buf, area);
+    lv_draw_backend_sw.glyph(drv, buf, buf_w, area, pos, g, bitmap, subpx, color, opa);
+}
+
+/**
+ * Draw an image with alpha byte, chroma keying and/or recoloring.
+ * The large images are drawn by the worker threads and the calling thread together.
+ */
+static void th_map(lv_disp_drv_t * drv, lv_color_t * buf, lv_coord_t buf_w, const lv_area_t * area,
+                   const uint8_t * map, lv_coord_t map_w, lv_opa_t opa, bool chroma_key, bool alpha_byte,
+                   lv_color_t recolor, lv_opa_t recolor_opa)
+{
+    if(prepare(drv, buf, area) == false) {
+        lv_draw_backend_sw.map(drv, buf, buf_w, area, map, map_w, opa, chroma_key, alpha_byte, recolor, recolor_opa);
+        return;
+    }
+
+    draw_job_t job;
+    job.type        = JOB_MAP;
+    job.drv         = drv;
+    job.buf         = buf;
+    job.buf_w       = buf_w;
+    job.src         = map;
+    job.src_w       = map_w;
+    job.opa         = opa;
+    job.color       = recolor;
+    job.recolor_opa = recolor_opa;
+    job.chroma_key  = chroma_key ? 1 : 0;
+    job.alpha_byte  = alpha_byte ? 1 : 0;
+    lv_area_copy(&job.area, area);
+    submit(&job, alpha_byte ? LV_IMG_PX_SIZE_ALPHA_BYTE : sizeof(lv_color_t));
+
+    /*`map` might be reused by the caller*/
+    wait_all();
+}
+
+/**
+ * Wait until the every fill is finished
+ */
+static void th_wait(lv_disp_drv_t * drv)
+{
+    (void)drv; /*Unused*/
+    wait_all();
+}
+
+/**
+ * Prepare drawing an area: wait for the unfinished jobs which draw on the same pixels
+ * and tell whether the operation should be split among the threads.
+ * @param drv pointer to the display driver
+ * @param buf the buffer to draw
+ * @param area the area to draw relative to `buf`
+ * @return true: the area is large enough to split it; false: draw it with the calling thread
+ */
+static bool prepare(lv_disp_drv_t * drv, lv_color_t * buf, const lv_area_t * area)
+{
+    if(busy_buf && (busy_buf != buf || lv_area_is_on(&busy_area, area))) wait_all();
+
+    /*The special pixel writing and the GPU callbacks might not be thread safe*/
+    if(drv->set_px_cb) return false;
+#if LV_COLOR_DEPTH == 32 && LV_COLOR_SCREEN_TRANSP
+    if(drv->screen_transp) return false;
+#endif
+#if LV_USE_GPU
+    if(drv->gpu_fill_cb || drv->gpu_blend_cb) return false;
+#endif
+
+    if(lv_area_get_size(area) < LV_DRAW_THREAD_MIN_SIZE || lv_area_get_height(area) < 2) return false;
+
+    pthread_once(&init_once, threads_init);
+
+    return true;
+}
+
+/**
+ * Split an operation into horizontal stripes and add them to the queue
+ * @param job the operation on its whole area
+ * @param px_size size of the source pixels in bytes (0 if there is no source)
+ */
+static void submit(const draw_job_t * job, uint8_t px_size)
+{
+    lv_coord_t h     = lv_area_get_height(&job->area);
+    uint16_t part_cnt = thread_cnt + 1; /*The calling thread can work too while waiting*/
+    if(part_cnt > h) part_cnt = h;
+
+    if(busy_buf == NULL) {
+        busy_buf = job->buf;
+        lv_area_copy(&busy_area, &job->area);
+    } else {
+        lv_area_join(&busy_area, &busy_area, &job->area);
+    }
+
+    pthread_mutex_lock(&job_mutex);
+    uint16_t i;
+    for(i = 0; i < part_cnt; i++) {
+        /*Wait for a free place in the queue*/
+        while(job_cnt == JOB_MAX) {
+            pthread_mutex_unlock(&job_mutex);
+            wait_all();
+            busy_buf = job->buf;
+            lv_area_copy(&busy_area, &job->area);
+            pthread_mutex_lock(&job_mutex);
+        }
+
+        draw_job_t * part = &jobs[(job_rd + job_cnt) % JOB_MAX];
+        *part             = *job;
+        part->area.y1     = job->area.y1 + (lv_coord_t)(((int32_t)h * i) / part_cnt);
+        part->area.y2     = job->area.y1 + (lv_coord_t)(((int32_t)h * (i + 1)) / part_cnt) - 1;
+        if(px_size) {
+            part->src += (uint32_t)(part->area.y1 - job->area.y1) * job->src_w * px_size;
+        }
+        job_cnt++;
+    }
+
+    pthread_cond_broadcast(&job_cond);
+    pthread_mutex_unlock(&job_mutex);
+}
+
+/**
+ * Execute the queued jobs with the calling thread too and wait until every job is finished
+ */
+static void wait_all(void)
+{
+    if(busy_buf == NULL) return;
+
+    pthread_mutex_lock(&job_mutex);
+    while(job_cnt > 0) {
+        draw_job_t job = jobs[job_rd];
+        job_rd         = (job_rd + 1) % JOB_MAX;
+        job_cnt--;
+        job_running++;
+        pthread_mutex_unlock(&job_mutex);
+
+        job_exec(&job);
+
+        pthread_mutex_lock(&job_mutex);
+        job_running--;
+    }
+
+    while(job_running > 0) {
+        pthread_cond_wait(&done_cond, &job_mutex);
+    }
+    pthread_mutex_unlock(&job_mutex);
+
+    busy_buf = NULL;
+}
+
+/**
+ * Draw a stripe with the software backend
+ * @param job pointer to a stripe
+ */
+static void job_exec(const draw_job_t * job)
+{
+    switch(job->type) {
+        case JOB_FILL:
+            lv_draw_backend_sw.fill(job->drv, job->buf, job->buf_w, &job->area, job->color, job->opa);
+            break;
+        case JOB_BLEND:
+            lv_draw_backend_sw.blend(job->drv, job->buf, job->buf_w, &job->area, (const lv_color_t *)job->src,
+                                     job->src_w, job->opa);
+            break;
+        case JOB_MAP:
+            lv_draw_backend_sw.map(job->drv, job->buf, job->buf_w, &job->area, job->src, job->src_w, job->opa,
+                                   job->chroma_key, job->alpha_byte, job->color, job->recolor_opa);
+            break;
+    }
+}
+
+/**
+ * The worker threads: execute the jobs from the queue
+ * @param param unused
+ * @return unused
+ */
+static void * worker(void * param)
+{
+    (void)param; /*Unused*/
+
+    pthread_mutex_lock(&job_mutex);
+    while(1) {
+        while(job_cnt == 0) {
+            pthread_cond_wait(&job_cond, &job_mutex);
+        }
+
+        draw_job_t job = jobs[job_rd];
+        job_rd         = (job_rd + 1) % JOB_MAX;
+        job_cnt--;
+        job_running++;
+        pthread_mutex_unlock(&job_mutex);
+
+        job_exec(&job);
+
+        pthread_mutex_lock(&job_mutex);
+        job_running--;
+        if(job_cnt == 0 && job_running == 0) pthread_cond_broadcast(&done_cond);
+    }
+
+    return NULL;
+}
+
+/**
+ * Start the worker threads. If some of them can't be started the others (or only the calling thread) do the work.
+ */
+static void threads_init(void)
+{
+    uint8_t i;
+    for(i = 0; i < LV_DRAW_THREAD_CNT; i++) {
+        if(pthread_create(&threads[thread_cnt], NULL, worker, NULL) != 0) {
+            LV_LOG_WARN("lv_draw_thread: couldn't start a worker thread");
+            break;
+        }
+        pthread_detach(threads[thread_cnt]);
+        thread_cnt++;
+    }
+}
+
+#endif /*LV_USE_DRAW_THREAD*/
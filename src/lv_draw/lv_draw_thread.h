@@ -0,0 +1,48 @@
+/**
+ * @file lv_draw_thread.h
+ *
+ */
+
+#ifndef LV_DRAW_THREAD_H
+#define LV_DRAW_THREAD_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_draw_backend.h"
+
+#if LV_USE_DRAW_THREAD
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/** Software draw backend which splits the large fills and image blits among `LV_DRAW_THREAD_CNT` worker threads.
+ * The fills are finished in the background while the next operations are prepared.
+ * The displays with `set_px_cb`, `screen_transp` or GPU callbacks are drawn by the calling thread.
+ * The worker threads are started when it's used first.*/
+extern const lv_draw_backend_t lv_draw_backend_thread;
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /*LV_USE_DRAW_THREAD*/
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /*LV_DRAW_THREAD_H*/
@@ -7,22 +7,68 @@
  *      INCLUDES
  *********************/
 #include "lv_draw_triangle.h"
+#include "../lv_core/lv_refr.h"
 #include "../lv_misc/lv_math.h"
+#include "lv_draw_list.h"
 
 /*********************
  *      DEFINES
  *********************/
+/*Number of sampled sub-scanlines in a row of pixels with anti-aliasing (power of 2)*/
+#define POLY_SUB_SHIFT 2
+#define POLY_SUB_CNT (1 << POLY_SUB_SHIFT)
+
+/*The x coordinates of the edges are stored with this many fractional bits*/
+#define POLY_X_SHIFT 16
+
+/*Coverage of a fully covered pixel*/
+#define POLY_COV_FULL 256
 
 /**********************
  *      TYPEDEFS
  **********************/
+typedef struct
+{
+    int32_t x;       /*x coordinate on the current sub-scanline [1/(1 << POLY_X_SHIFT) px], rounded down*/
+    int32_t x_err;   /*The remainder of `x` [1/den]*/
+    int32_t dx;      /*Change of `x` between two sub-scanlines, rounded down*/
+    int32_t dx_err;  /*The remainder of `dx` [1/den]*/
+    int32_t den;     /*Denominator of the remainders*/
+    int32_t k_start; /*First sub-scanline crossing the edge*/
+    int32_t k_end;   /*The sub-scanline after the last one crossing the edge*/
+    int32_t dir;     /*1: the edge goes downward, -1: upward*/
+    lv_coord_t x0;   /*The top point of the edge*/
+    lv_coord_t y0;
+    lv_coord_t x1;   /*The bottom point of the edge*/
+    lv_coord_t y1;
+} poly_edge_t;
+
+/*The parameters of a polygon drawing*/
+typedef struct
+{
+    const lv_point_t * points;
+    uint32_t point_cnt;
+    const lv_area_t * mask;
+    lv_color_t color;
+    lv_opa_t opa;
+    lv_polygon_rule_t rule;
+    bool aa;
+    uint8_t sub_cnt;
+    uint16_t full; /*Coverage of a fully covered pixel on a sub-scanline*/
+} poly_dsc_t;
 
 /**********************
  *  STATIC PROTOTYPES
  **********************/
-void tri_draw_flat(const lv_point_t * points, const lv_area_t * mask, const lv_style_t * style, lv_opa_t opa);
-void tri_draw_tall(const lv_point_t * points, const lv_area_t * mask, const lv_style_t * style, lv_opa_t opa);
-static void point_swap(lv_point_t * p1, lv_point_t * p2);
+static void polygon_draw(const lv_point_t * points, uint32_t point_cnt, const lv_area_t * mask,
+                         const lv_style_t * style, lv_opa_t opa_scale, lv_polygon_rule_t rule);
+static void polygon_draw_split(const poly_dsc_t * dsc, const lv_area_t * area);
+static bool polygon_draw_area(const poly_dsc_t * dsc, const lv_area_t * area);
+static void edge_start(poly_edge_t * e, int32_t k, uint8_t sub_cnt);
+static inline void edge_step(poly_edge_t * e);
+static int32_t div_floor64(int64_t n, int32_t d, int32_t * rem);
+static void span_add(int32_t xa, int32_t xb, bool aa, uint16_t full, int32_t * acc, lv_coord_t acc_x,
+                     lv_coord_t acc_w, lv_coord_t * x1_res, lv_coord_t * x2_res);
 
 /**********************
  *  STATIC VARIABLES
@@ -37,307 +83,437 @@ static void point_swap(lv_point_t * p1, lv_point_t * p2);
  **********************/
 
 /**
- *
+ * Draw a triangle
  * @param points pointer to an array with 3 points
  * @param mask the triangle will be drawn only in this mask
- * @param style style for of the triangle
+ * @param style style for of the triangle (`body.main_color` and `body.opa` is used)
  * @param opa_scale scale down all opacities by the factor (0..255)
  */
 void lv_draw_triangle(const lv_point_t * points, const lv_area_t * mask, const lv_style_t * style, lv_opa_t opa_scale)
 {
-    /*Return if the triangle is degenerated*/
-    if(points[0].x == points[1].x && points[0].y == points[1].y) return;
-    if(points[1].x == points[2].x && points[1].y == points[2].y) return;
-    if(points[0].x == points[2].x && points[0].y == points[2].y) return;
-
-    if(points[0].x == points[1].x && points[1].x == points[2].x) return;
-    if(points[0].y == points[1].y && points[1].y == points[2].y) return;
-
-    lv_opa_t opa = opa_scale == LV_OPA_COVER ? style->body.opa : (uint16_t)((uint16_t)style->body.opa * opa_scale) >> 8;
-
-    /*Is the triangle flat or tall?*/
-    lv_coord_t x_min = LV_MATH_MIN(LV_MATH_MIN(points[0].x, points[1].x), points[2].x);
-    lv_coord_t x_max = LV_MATH_MAX(LV_MATH_MAX(points[0].x, points[1].x), points[2].x);
-    lv_coord_t y_min = LV_MATH_MIN(LV_MATH_MIN(points[0].y, points[1].y), points[2].y);
-    lv_coord_t y_max = LV_MATH_MAX(LV_MATH_MAX(points[0].y, points[1].y), points[2].y);
-
-    /* Draw the tall rectangles from vertical lines
-     * and from the flat triangles from horizontal lines
-     * to minimize the number of lines.
-     * Some pixels are overdrawn on the common edges of the triangles
-     * so use it only if the triangle has no opacity*/
-
-    /* Draw from horizontal lines*/
-    if(x_max - x_min < y_max - y_min) {
-        tri_draw_tall(points, mask, style, opa);
-    }
-    /*Else flat so draw from vertical lines*/
-    else {
-        tri_draw_flat(points, mask, style, opa);
-    }
+    lv_draw_polygon_rule(points, 3, mask, style, opa_scale, LV_POLYGON_RULE_NON_ZERO);
 }
 
 /**
- * Draw a polygon from triangles. Only convex polygons are supported
+ * Draw a polygon with the non-zero fill rule. Concave and self-intersecting polygons are also supported.
  * @param points an array of points
  * @param point_cnt number of points
  * @param mask polygon will be drawn only in this mask
- * @param style style of the polygon
+ * @param style style of the polygon (`body.main_color` and `body.opa` is used)
  * @param opa_scale scale down all opacities by the factor (0..255)
  */
 void lv_draw_polygon(const lv_point_t * points, uint32_t point_cnt, const lv_area_t * mask, const lv_style_t * style,
                      lv_opa_t opa_scale)
+{
+    lv_draw_polygon_rule(points, point_cnt, mask, style, opa_scale, LV_POLYGON_RULE_NON_ZERO);
+}
+
+/**
+ * Draw a polygon with a given fill rule
+ * @param points an array of points. The last point is connected to the first.
+ * @param point_cnt number of points
+ * @param mask polygon will be drawn only in this mask
+ * @param style style of the polygon (`body.main_color` and `body.opa` is used)
+ * @param opa_scale scale down all opacities by the factor (0..255)
+ * @param rule `LV_POLYGON_RULE_NON_ZERO` or `LV_POLYGON_RULE_EVEN_ODD`
+ */
+void lv_draw_polygon_rule(const lv_point_t * points, uint32_t point_cnt, const lv_area_t * mask,
+                          const lv_style_t * style, lv_opa_t opa_scale, lv_polygon_rule_t rule)
 {
     if(point_cnt < 3) return;
     if(points == NULL) return;
 
-    uint32_t i;
-    lv_point_t tri[3];
-    tri[0].x = points[0].x;
-    tri[0].y = points[0].y;
-    for(i = 0; i < point_cnt - 1; i++) {
-        tri[1].x = points[i].x;
-        tri[1].y = points[i].y;
-        tri[2].x = points[i + 1].x;
-        tri[2].y = points[i + 1].y;
-        lv_draw_triangle(tri, mask, style, opa_scale);
+#if LV_USE_DRAW_LIST
+    if(lv_draw_list_is_recording()) {
+        lv_draw_list_add_polygon(points, point_cnt, mask, style, opa_scale, rule);
+        return;
     }
+#endif
+
+    polygon_draw(points, point_cnt, mask, style, opa_scale, rule);
 }
 
 /**********************
  *   STATIC FUNCTIONS
  **********************/
 
-void tri_draw_flat(const lv_point_t * points, const lv_area_t * mask, const lv_style_t * style, lv_opa_t opa)
+/**
+ * Fill a polygon with an active edge table scanline algorithm.
+ * The points are the centers of the pixels. With anti-aliasing every row is sampled on `POLY_SUB_CNT`
+ * sub-scanlines and the horizontal coverage of the spans is exact, else the centers of the pixels are sampled.
+ * The spans of a row are collected and drawn at once.
+ * @param points an array of points
+ * @param point_cnt number of points (>= 3)
+ * @param mask polygon will be drawn only in this mask
+ * @param style style of the polygon
+ * @param opa_scale scale down all opacities by the factor (0..255)
+ * @param rule `LV_POLYGON_RULE_NON_ZERO` or `LV_POLYGON_RULE_EVEN_ODD`
+ */
+static void polygon_draw(const lv_point_t * points, uint32_t point_cnt, const lv_area_t * mask,
+                         const lv_style_t * style, lv_opa_t opa_scale, lv_polygon_rule_t rule)
 {
-    /*Return if the points are out of the mask*/
-    if(points[0].x < mask->x1 && points[1].x < mask->x1 && points[2].x < mask->x1) {
-        return;
-    }
+    poly_dsc_t dsc;
+    dsc.opa = opa_scale == LV_OPA_COVER ? style->body.opa : (uint16_t)((uint16_t)style->body.opa * opa_scale) >> 8;
+    if(dsc.opa < LV_OPA_MIN) return;
+
+    dsc.points    = points;
+    dsc.point_cnt = point_cnt;
+    dsc.mask      = mask;
+    dsc.color     = style->body.main_color;
+    dsc.rule      = rule;
+    dsc.aa        = lv_disp_get_antialiasing(lv_refr_get_disp_refreshing());
+    dsc.sub_cnt   = dsc.aa ? POLY_SUB_CNT : 1;
+    dsc.full      = POLY_COV_FULL / dsc.sub_cnt;
 
-    if(points[0].x > mask->x2 && points[1].x > mask->x2 && points[2].x > mask->x2) {
-        return;
+    lv_area_t draw_area;
+    draw_area.x1 = LV_COORD_MAX;
+    draw_area.y1 = LV_COORD_MAX;
+    draw_area.x2 = LV_COORD_MIN;
+    draw_area.y2 = LV_COORD_MIN;
+    uint32_t i;
+    for(i = 0; i < point_cnt; i++) {
+        draw_area.x1 = LV_MATH_MIN(draw_area.x1, points[i].x);
+        draw_area.y1 = LV_MATH_MIN(draw_area.y1, points[i].y);
+        draw_area.x2 = LV_MATH_MAX(draw_area.x2, points[i].x);
+        draw_area.y2 = LV_MATH_MAX(draw_area.y2, points[i].y);
     }
+    if(lv_area_intersect(&draw_area, &draw_area, mask) == false) return;
 
-    if(points[0].y < mask->y1 && points[1].y < mask->y1 && points[2].y < mask->y1) {
-        return;
-    }
+    polygon_draw_split(&dsc, &draw_area);
+}
 
-    if(points[0].y > mask->y2 && points[1].y > mask->y2 && points[2].y > mask->y2) {
+/**
+ * Draw a part of a polygon. If there is not enough memory to draw it at once
+ * draw its halves (first the rows, then the columns are halved).
+ * The result is the same because the coverage of a pixel doesn't depend on the drawn area.
+ * @param dsc pointer to the parameters of the polygon
+ * @param area the area to draw
+ */
+static void polygon_draw_split(const poly_dsc_t * dsc, const lv_area_t * area)
+{
+    if(polygon_draw_area(dsc, area)) return;
+
+    lv_area_t half1;
+    lv_area_t half2;
+    lv_area_copy(&half1, area);
+    lv_area_copy(&half2, area);
+    if(area->y1 < area->y2) {
+        half1.y2 = area->y1 + (area->y2 - area->y1) / 2;
+        half2.y1 = half1.y2 + 1;
+    } else if(area->x1 < area->x2) {
+        half1.x2 = area->x1 + (area->x2 - area->x1) / 2;
+        half2.x1 = half1.x2 + 1;
+    } else {
+        LV_LOG_WARN("lv_draw_polygon: no memory to draw the polygon");
         return;
     }
 
-    lv_point_t tri[3];
-
-    memcpy(tri, points, sizeof(tri));
-
-    /*Sort the vertices according to their y coordinate (0: y max, 1: y mid, 2:y min)*/
-    if(tri[1].y < tri[0].y) point_swap(&tri[1], &tri[0]);
-    if(tri[2].y < tri[1].y) point_swap(&tri[2], &tri[1]);
-    if(tri[1].y < tri[0].y) point_swap(&tri[1], &tri[0]);
-
-    /*Draw the triangle*/
-    lv_point_t edge1;
-    lv_coord_t dx1  = LV_MATH_ABS(tri[0].x - tri[1].x);
-    lv_coord_t sx1  = tri[0].x < tri[1].x ? 1 : -1;
-    lv_coord_t dy1  = LV_MATH_ABS(tri[0].y - tri[1].y);
-    lv_coord_t sy1  = tri[0].y < tri[1].y ? 1 : -1;
-    lv_coord_t err1 = (dx1 > dy1 ? dx1 : -dy1) / 2;
-    lv_coord_t err_tmp1;
-
-    lv_point_t edge2;
-    lv_coord_t dx2  = LV_MATH_ABS(tri[0].x - tri[2].x);
-    lv_coord_t sx2  = tri[0].x < tri[2].x ? 1 : -1;
-    lv_coord_t dy2  = LV_MATH_ABS(tri[0].y - tri[2].y);
-    lv_coord_t sy2  = tri[0].y < tri[2].y ? 1 : -1;
-    lv_coord_t err2 = (dx1 > dy2 ? dx2 : -dy2) / 2;
-    lv_coord_t err_tmp2;
-
-    lv_coord_t y1_tmp;
-    lv_coord_t y2_tmp;
-
-    edge1.x = tri[0].x;
-    edge1.y = tri[0].y;
-    edge2.x = tri[0].x;
-    edge2.y = tri[0].y;
-    lv_area_t act_area;
-    lv_area_t draw_area;
-
-    while(1) {
-        act_area.x1 = edge1.x;
-        act_area.x2 = edge2.x;
-        act_area.y1 = edge1.y;
-        act_area.y2 = edge2.y;
-
-        /* Get the area of a line.
-         * Adjust it a little bit to perfectly match (no redrawn pixels) with the adjacent triangles*/
-        draw_area.x1 = LV_MATH_MIN(act_area.x1, act_area.x2) + 1;
-        draw_area.x2 = LV_MATH_MAX(act_area.x1, act_area.x2);
-        draw_area.y1 = LV_MATH_MIN(act_area.y1, act_area.y2) - 1;
-        draw_area.y2 = LV_MATH_MAX(act_area.y1, act_area.y2) - 1;
-
-        lv_draw_fill(&draw_area, mask, style->body.main_color, opa);
-
-        /*Calc. the next point of edge1*/
-        y1_tmp = edge1.y;
-        do {
-            if(edge1.x == tri[1].x && edge1.y == tri[1].y) {
-
-                dx1  = LV_MATH_ABS(tri[1].x - tri[2].x);
-                sx1  = tri[1].x < tri[2].x ? 1 : -1;
-                dy1  = LV_MATH_ABS(tri[1].y - tri[2].y);
-                sy1  = tri[1].y < tri[2].y ? 1 : -1;
-                err1 = (dx1 > dy1 ? dx1 : -dy1) / 2;
-            } else if(edge1.x == tri[2].x && edge1.y == tri[2].y) {
-                return;
-            }
-            err_tmp1 = err1;
-            if(err_tmp1 > -dx1) {
-                err1 -= dy1;
-                edge1.x += sx1;
-            }
-            if(err_tmp1 < dy1) {
-                err1 += dx1;
-                edge1.y += sy1;
-            }
-        } while(edge1.y == y1_tmp);
-
-        /*Calc. the next point of edge2*/
-        y2_tmp = edge2.y;
-        do {
-            if(edge2.x == tri[2].x && edge2.y == tri[2].y) return;
-            err_tmp2 = err2;
-            if(err_tmp2 > -dx2) {
-                err2 -= dy2;
-                edge2.x += sx2;
-            }
-            if(err_tmp2 < dy2) {
-                err2 += dx2;
-                edge2.y += sy2;
-            }
-        } while(edge2.y == y2_tmp);
-    }
+    polygon_draw_split(dsc, &half1);
+    polygon_draw_split(dsc, &half2);
 }
 
-void tri_draw_tall(const lv_point_t * points, const lv_area_t * mask, const lv_style_t * style, lv_opa_t opa)
+/**
+ * Draw a part of a polygon.
+ * Only the edges on the area are stored. The edges on the left of the area only change the winding
+ * of the sub-scanlines and the edges on the right of it don't change the spans.
+ * @param dsc pointer to the parameters of the polygon
+ * @param area the area to draw
+ * @return true: ready; false: there is not enough memory, nothing is drawn
+ */
+static bool polygon_draw_area(const poly_dsc_t * dsc, const lv_area_t * area)
 {
-    /*
-     * Better to draw from vertical lines
-     * |\
-     * | |
-     * | |
-     * |  \
-     * |   |
-     * |___|
-     */
-
-    lv_point_t tri[3];
-
-    memcpy(tri, points, sizeof(tri));
-
-    /*Sort the vertices according to their x coordinate (0: x max, 1: x mid, 2:x min)*/
-    if(tri[1].x < tri[0].x) point_swap(&tri[1], &tri[0]);
-    if(tri[2].x < tri[1].x) point_swap(&tri[2], &tri[1]);
-    if(tri[1].x < tri[0].x) point_swap(&tri[1], &tri[0]);
-
-    /*Draw the triangle*/
-    lv_point_t edge1;
-    lv_coord_t dx1  = LV_MATH_ABS(tri[0].x - tri[1].x);
-    lv_coord_t sx1  = tri[0].x < tri[1].x ? 1 : -1;
-    lv_coord_t dy1  = LV_MATH_ABS(tri[0].y - tri[1].y);
-    lv_coord_t sy1  = tri[0].y < tri[1].y ? 1 : -1;
-    lv_coord_t err1 = (dx1 > dy1 ? dx1 : -dy1) / 2;
-    lv_coord_t err_tmp1;
-
-    lv_point_t edge2;
-    lv_coord_t dx2  = LV_MATH_ABS(tri[0].x - tri[2].x);
-    lv_coord_t sx2  = tri[0].x < tri[2].x ? 1 : -1;
-    lv_coord_t dy2  = LV_MATH_ABS(tri[0].y - tri[2].y);
-    lv_coord_t sy2  = tri[0].y < tri[2].y ? 1 : -1;
-    lv_coord_t err2 = (dx1 > dy2 ? dx2 : -dy2) / 2;
-    lv_coord_t err_tmp2;
-
-    lv_coord_t x1_tmp;
-    lv_coord_t x2_tmp;
-
-    edge1.x = tri[0].x;
-    edge1.y = tri[0].y;
-    edge2.x = tri[0].x;
-    edge2.y = tri[0].y;
-    lv_area_t act_area;
-    lv_area_t draw_area;
+    const lv_point_t * points = dsc->points;
+    uint32_t point_cnt        = dsc->point_cnt;
+    uint8_t sub_cnt           = dsc->sub_cnt;
+
+    /*The sub-scanlines of the drawn rows*/
+    int32_t k_first = (int32_t)area->y1 * sub_cnt;
+    int32_t k_last  = ((int32_t)area->y2 + 1) * sub_cnt;
+
+    /* Count the edges on the area and on its left.
+     * The sub-scanline `k` samples the y = (2 * k + 1 - sub_cnt) / (2 * sub_cnt) coordinate.
+     * An edge crosses the sub-scanlines in y0 <= y < y1*/
+    uint32_t edge_cnt = 0;
+    uint32_t left_cnt = 0;
+    uint32_t i;
+    for(i = 0; i < point_cnt; i++) {
+        const lv_point_t * p1 = &points[i];
+        const lv_point_t * p2 = &points[i + 1 < point_cnt ? i + 1 : 0];
+        if(p1->y == p2->y) continue;
+        if(LV_MATH_MIN(p1->x, p2->x) >= area->x2 + 1) continue;
+
+        int32_t k_start = (int32_t)LV_MATH_MIN(p1->y, p2->y) * sub_cnt + (sub_cnt >> 1);
+        int32_t k_end   = (int32_t)LV_MATH_MAX(p1->y, p2->y) * sub_cnt + (sub_cnt >> 1);
+        if(k_end <= k_first || k_start >= k_last) continue;
+
+        if(LV_MATH_MAX(p1->x, p2->x) <= area->x1 - 1) left_cnt++;
+        else edge_cnt++;
+    }
+    if(edge_cnt == 0 && left_cnt == 0) return true;
+
+    /* The edges, the active edges, the winding of the sub-scanlines from the edges on the left,
+     * the accumulated coverage of a row and the final coverage share the draw buffer*/
+    lv_coord_t draw_w  = lv_area_get_width(area);
+    uint32_t act_size  = edge_cnt * sizeof(poly_edge_t *);
+    uint32_t edge_size = edge_cnt * sizeof(poly_edge_t);
+    uint32_t wind_size = left_cnt ? (uint32_t)(k_last - k_first) * sizeof(int32_t) : 0;
+    uint32_t acc_size  = (uint32_t)(draw_w + 2) * sizeof(int32_t);
+    uint8_t * buf      = lv_draw_try_get_buf(act_size + edge_size + wind_size + acc_size + draw_w);
+    if(buf == NULL) return false;
+
+    poly_edge_t ** act  = (poly_edge_t **)buf;
+    poly_edge_t * edges = (poly_edge_t *)(buf + act_size);
+    int32_t * wind_left = left_cnt ? (int32_t *)(buf + act_size + edge_size) : NULL;
+    int32_t * acc       = (int32_t *)(buf + act_size + edge_size + wind_size);
+    lv_opa_t * cov      = (lv_opa_t *)(buf + act_size + edge_size + wind_size + acc_size);
+    memset(acc, 0, acc_size);
+    if(wind_left) memset(wind_left, 0, wind_size);
+
+    /*Collect the edges on the area sorted by their first sub-scanline*/
+    edge_cnt = 0;
+    for(i = 0; i < point_cnt; i++) {
+        const lv_point_t * p1 = &points[i];
+        const lv_point_t * p2 = &points[i + 1 < point_cnt ? i + 1 : 0];
+        if(p1->y == p2->y) continue;
+        if(LV_MATH_MIN(p1->x, p2->x) >= area->x2 + 1) continue;
+
+        poly_edge_t e;
+        if(p1->y < p2->y) {
+            e.x0  = p1->x;
+            e.y0  = p1->y;
+            e.x1  = p2->x;
+            e.y1  = p2->y;
+            e.dir = 1;
+        } else {
+            e.x0  = p2->x;
+            e.y0  = p2->y;
+            e.x1  = p1->x;
+            e.y1  = p1->y;
+            e.dir = -1;
+        }
+
+        e.k_start = (int32_t)e.y0 * sub_cnt + (sub_cnt >> 1);
+        e.k_end   = (int32_t)e.y1 * sub_cnt + (sub_cnt >> 1);
+        if(e.k_end <= k_first || e.k_start >= k_last) continue;
+        if(e.k_start < k_first) e.k_start = k_first;
+
+        if(LV_MATH_MAX(e.x0, e.x1) <= area->x1 - 1) {
+            int32_t k_end = LV_MATH_MIN(e.k_end, k_last);
+            int32_t k;
+            for(k = e.k_start; k < k_end; k++) wind_left[k - k_first] += e.dir;
+            continue;
+        }
+
+        uint32_t j = edge_cnt;
+        while(j > 0 && edges[j - 1].k_start > e.k_start) {
+            edges[j] = edges[j - 1];
+            j--;
+        }
+        edges[j] = e;
+        edge_cnt++;
+    }
 
-    while(1) {
-        act_area.x1 = edge1.x;
-        act_area.x2 = edge2.x;
-        act_area.y1 = edge1.y;
-        act_area.y2 = edge2.y;
-
-        draw_area.x1 = LV_MATH_MIN(act_area.x1, act_area.x2);
-        draw_area.x2 = LV_MATH_MAX(act_area.x1, act_area.x2);
-        draw_area.y1 = LV_MATH_MIN(act_area.y1, act_area.y2);
-        draw_area.y2 = LV_MATH_MAX(act_area.y1, act_area.y2) - 1;
-
-        lv_draw_fill(&draw_area, mask, style->body.main_color, opa);
-
-        /*Calc. the next point of edge1*/
-        x1_tmp = edge1.x;
-        do {
-            if(edge1.y == tri[1].y && edge1.x == tri[1].x) {
-
-                dx1  = LV_MATH_ABS(tri[1].x - tri[2].x);
-                sx1  = tri[1].x < tri[2].x ? 1 : -1;
-                dy1  = LV_MATH_ABS(tri[1].y - tri[2].y);
-                sy1  = tri[1].y < tri[2].y ? 1 : -1;
-                err1 = (dx1 > dy1 ? dx1 : -dy1) / 2;
-            } else if(edge1.y == tri[2].y && edge1.x == tri[2].x) {
-                return;
+    /*The spans inside the polygon on the left and on the right of the edges start and end out of the area*/
+    int32_t span_left  = ((int32_t)area->x1 - 1) * (1 << POLY_X_SHIFT);
+    int32_t span_right = ((int32_t)area->x2 + 1) * (1 << POLY_X_SHIFT);
+
+    uint32_t edge_next = 0;
+    uint32_t act_cnt   = 0;
+    int32_t k          = k_first;
+    lv_coord_t y;
+    for(y = area->y1; y <= area->y2; y++) {
+        lv_coord_t row_x1 = LV_COORD_MAX;
+        lv_coord_t row_x2 = LV_COORD_MIN;
+
+        /*Skip the rows without edges*/
+        if(act_cnt == 0 && wind_left == NULL) {
+            if(edge_next == edge_cnt) break;
+            if(edges[edge_next].k_start >= k + sub_cnt) {
+                k += sub_cnt;
+                continue;
             }
-            err_tmp1 = err1;
-            if(err_tmp1 > -dx1) {
-                err1 -= dy1;
-                edge1.x += sx1;
+        }
+
+        uint8_t s;
+        for(s = 0; s < sub_cnt; s++, k++) {
+            /*Remove the finished edges and step the others*/
+            uint32_t a;
+            uint32_t a_new = 0;
+            for(a = 0; a < act_cnt; a++) {
+                if(act[a]->k_end <= k) continue;
+                edge_step(act[a]);
+                act[a_new] = act[a];
+                a_new++;
             }
-            if(err_tmp1 < dy1) {
-                err1 += dx1;
-                edge1.y += sy1;
+            act_cnt = a_new;
+
+            /*Add the new edges*/
+            while(edge_next < edge_cnt && edges[edge_next].k_start == k) {
+                edge_start(&edges[edge_next], k, sub_cnt);
+                act[act_cnt] = &edges[edge_next];
+                act_cnt++;
+                edge_next++;
             }
-        } while(edge1.x == x1_tmp);
 
-        /*Calc. the next point of edge2*/
-        x2_tmp = edge2.x;
-        do {
-            if(edge2.y == tri[2].y && edge2.x == tri[2].x) {
-                return;
+            int32_t wind = wind_left ? wind_left[k - k_first] : 0;
+            if(dsc->rule == LV_POLYGON_RULE_EVEN_ODD) wind &= 1;
+            if(act_cnt == 0 && wind == 0) continue;
+
+            /*Sort the active edges by x. They are mostly sorted from the previous sub-scanline.*/
+            for(a = 1; a < act_cnt; a++) {
+                poly_edge_t * e = act[a];
+                uint32_t j      = a;
+                while(j > 0 && act[j - 1]->x > e->x) {
+                    act[j] = act[j - 1];
+                    j--;
+                }
+                act[j] = e;
             }
 
-            err_tmp2 = err2;
-            if(err_tmp2 > -dx2) {
-                err2 -= dy2;
-                edge2.x += sx2;
-            }
-            if(err_tmp2 < dy2) {
-                err2 += dx2;
-                edge2.y += sy2;
+            /*Walk through the crossings and add the inner spans*/
+            int32_t span_x = span_left;
+            for(a = 0; a < act_cnt; a++) {
+                bool in_prev = wind != 0;
+                if(dsc->rule == LV_POLYGON_RULE_EVEN_ODD) wind ^= 1;
+                else wind += act[a]->dir;
+                bool in_act = wind != 0;
+
+                if(!in_prev && in_act) {
+                    span_x = act[a]->x;
+                } else if(in_prev && !in_act) {
+                    span_add(span_x, act[a]->x, dsc->aa, dsc->full, acc, area->x1, draw_w, &row_x1, &row_x2);
+                }
             }
-        } while(edge2.x == x2_tmp);
+
+            if(wind != 0) span_add(span_x, span_right, dsc->aa, dsc->full, acc, area->x1, draw_w, &row_x1, &row_x2);
+        }
+
+        if(row_x1 > row_x2) continue;
+
+        /*Sum the coverage changes to get the coverage of the pixels*/
+        int32_t sum = 0;
+        lv_coord_t x;
+        for(x = row_x1; x <= row_x2; x++) {
+            sum += acc[x];
+            acc[x] = 0;
+            cov[x] = sum >= LV_OPA_COVER ? LV_OPA_COVER : (sum <= 0 ? 0 : sum);
+        }
+        acc[row_x2 + 1] = 0;
+
+        lv_draw_cov_row(area->x1 + row_x1, y, row_x2 - row_x1 + 1, &cov[row_x1], dsc->mask, dsc->color, dsc->opa);
     }
+
+    return true;
 }
 
 /**
- * Swap two points
- * p1 pointer to the first point
- * p2 pointer to the second point
+ * Start to use an edge on a sub-scanline
+ * @param e pointer to an edge
+ * @param k the first sub-scanline where the edge is used
+ * @param sub_cnt number of sub-scanlines in a row
  */
-static void point_swap(lv_point_t * p1, lv_point_t * p2)
+static void edge_start(poly_edge_t * e, int32_t k, uint8_t sub_cnt)
 {
-    lv_point_t tmp;
-    tmp.x = p1->x;
-    tmp.y = p1->y;
+    int32_t dx = e->x1 - e->x0;
+    int32_t dy = e->y1 - e->y0;
+
+    /* x on the sub-scanline `k` is x0 + dx * t / den. The remainders are stepped exactly
+     * to get the same x independently of the first sub-scanline (i.e. of the mask)*/
+    int64_t t = (int64_t)(2 * k + 1 - sub_cnt) - 2 * sub_cnt * (int64_t)e->y0;
+    e->den    = 2 * sub_cnt * dy;
+    e->x      = (int32_t)e->x0 * (1 << POLY_X_SHIFT) +
+                div_floor64((int64_t)dx * t * (1 << POLY_X_SHIFT), e->den, &e->x_err);
+    e->dx     = div_floor64((int64_t)dx * 2 * (1 << POLY_X_SHIFT), e->den, &e->dx_err);
+}
 
-    p1->x = p2->x;
-    p1->y = p2->y;
+/**
+ * Step an edge to the next sub-scanline
+ * @param e pointer to an edge
+ */
+static inline void edge_step(poly_edge_t * e)
+{
+    e->x += e->dx;
+    e->x_err += e->dx_err;
+    if(e->x_err >= e->den) {
+        e->x++;
+        e->x_err -= e->den;
+    }
+}
+
+/**
+ * Divide and round down
+ * @param n numerator
+ * @param d denominator (> 0)
+ * @param rem store the non-negative remainder here
+ * @return the rounded down quotient
+ */
+static int32_t div_floor64(int64_t n, int32_t d, int32_t * rem)
+{
+    int64_t q = n / d;
+    int64_t r = n % d;
+    if(r < 0) {
+        q--;
+        r += d;
+    }
+
+    *rem = (int32_t)r;
+    return (int32_t)q;
+}
+
+/**
+ * Add a span of a sub-scanline to the coverage of the row.
+ * `acc` stores the changes of the coverage from one pixel to the next
+ * so the span is added in constant time independently of its length.
+ * @param xa start of the span [1/(1 << POLY_X_SHIFT) px]
+ * @param xb end of the span (exclusive)
+ * @param aa true: add the exact horizontal coverage; false: add the pixels with center in the span
+ * @param full coverage of a fully covered pixel on a sub-scanline
+ * @param acc the coverage changes of the row. `acc[0]` belongs to the `acc_x` coordinate
+ * @param acc_x x coordinate of the first element of `acc`
+ * @param acc_w number of pixels in `acc` (the span is clipped to it)
+ * @param x1_res the first changed element of `acc` is stored here if it's smaller
+ * @param x2_res the last changed pixel of `acc` is stored here if it's larger
+ */
+static void span_add(int32_t xa, int32_t xb, bool aa, uint16_t full, int32_t * acc, lv_coord_t acc_x,
+                     lv_coord_t acc_w, lv_coord_t * x1_res, lv_coord_t * x2_res)
+{
+    int32_t ofs = (int32_t)acc_x * (1 << POLY_X_SHIFT);
+    xa -= ofs;
+    xb -= ofs;
+
+    if(aa == false) {
+        /*The pixel centers in [xa, xb)*/
+        int32_t pa = (xa + (1 << POLY_X_SHIFT) - 1) >> POLY_X_SHIFT;
+        int32_t pb = (xb + (1 << POLY_X_SHIFT) - 1) >> POLY_X_SHIFT;
+        if(pa < 0) pa = 0;
+        if(pb > acc_w) pb = acc_w;
+        if(pa >= pb) return;
+
+        acc[pa] += full;
+        acc[pb] -= full;
+        if(pa < *x1_res) *x1_res = pa;
+        if(pb - 1 > *x2_res) *x2_res = pb - 1;
+        return;
+    }
 
-    p2->x = tmp.x;
-    p2->y = tmp.y;
+    /*The pixels are [x - 0.5, x + 0.5). Use 1/256 px precision from here.*/
+    int32_t a = (xa + (1 << (POLY_X_SHIFT - 1))) >> (POLY_X_SHIFT - 8);
+    int32_t b = (xb + (1 << (POLY_X_SHIFT - 1))) >> (POLY_X_SHIFT - 8);
+    if(a < 0) a = 0;
+    if(b > (int32_t)acc_w << 8) b = (int32_t)acc_w << 8;
+    if(a >= b) return;
+
+    int32_t ia  = a >> 8;
+    int32_t ib  = b >> 8;
+    int32_t c_a = ((a & 0xFF) * full) >> 8;
+    int32_t c_b = ((b & 0xFF) * full) >> 8;
+
+    acc[ia] += full - c_a;
+    acc[ia + 1] += c_a;
+    acc[ib] += c_b - full;
+    acc[ib + 1] -= c_b;
+
+    if(ia < *x1_res) *x1_res = ia;
+    if(c_b == 0) ib--;
+    if(ib > *x2_res) *x2_res = ib;
 }
@@ -23,30 +23,49 @@ extern "C" {
  *      TYPEDEFS
  **********************/
 
+/*Which parts of a self-intersecting polygon are filled*/
+enum {
+    LV_POLYGON_RULE_NON_ZERO, /*Fill where the edges wind around the point at least once*/
+    LV_POLYGON_RULE_EVEN_ODD, /*Fill where a ray from the point crosses an odd number of edges*/
+};
+typedef uint8_t lv_polygon_rule_t;
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
 
 /**
- *
+ * Draw a triangle
  * @param points pointer to an array with 3 points
  * @param mask the triangle will be drawn only in this mask
- * @param style style for of the triangle
+ * @param style style for of the triangle (`body.main_color` and `body.opa` is used)
  * @param opa_scale scale down all opacities by the factor (0..255)
  */
 void lv_draw_triangle(const lv_point_t * points, const lv_area_t * mask, const lv_style_t * style, lv_opa_t opa_scale);
 
 /**
- * Draw a polygon from triangles. Only convex polygons are supported
+ * Draw a polygon with the non-zero fill rule. Concave and self-intersecting polygons are also supported.
  * @param points an array of points
  * @param point_cnt number of points
  * @param mask polygon will be drawn only in this mask
- * @param style style of the polygon
+ * @param style style of the polygon (`body.main_color` and `body.opa` is used)
  * @param opa_scale scale down all opacities by the factor (0..255)
  */
 void lv_draw_polygon(const lv_point_t * points, uint32_t point_cnt, const lv_area_t * mask, const lv_style_t * style,
                      lv_opa_t opa_scale);
 
+/**
+ * Draw a polygon with a given fill rule
+ * @param points an array of points. The last point is connected to the first.
+ * @param point_cnt number of points
+ * @param mask polygon will be drawn only in this mask
+ * @param style style of the polygon (`body.main_color` and `body.opa` is used)
+ * @param opa_scale scale down all opacities by the factor (0..255)
+ * @param rule `LV_POLYGON_RULE_NON_ZERO` or `LV_POLYGON_RULE_EVEN_ODD`
+ */
+void lv_draw_polygon_rule(const lv_point_t * points, uint32_t point_cnt, const lv_area_t * mask,
+                          const lv_style_t * style, lv_opa_t opa_scale, lv_polygon_rule_t rule);
+
 /**********************
  *      MACROS
  **********************/
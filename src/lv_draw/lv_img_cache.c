@@ -19,15 +19,21 @@
 /*********************
  *      DEFINES
  *********************/
-/*Decrement life with this value in every open*/
-#define LV_IMG_CACHE_AGING 1
-
 /*Boost life by this factor (multiply time_to_open with this value)*/
-#define LV_IMG_CACHE_LIFE_GAIN 1
+#define LV_IMG_CACHE_LIFE_GAIN 16
 
 /*Don't let life to be greater than this limit because it would require a lot of time to
  * "die" from very high values */
-#define LV_IMG_CACHE_LIFE_LIMIT 1000
+#define LV_IMG_CACHE_LIFE_LIMIT 16000
+
+/*An image with this size [kB] gets half as much life as a tiny image with the same time to open*/
+#define LV_IMG_CACHE_LIFE_HALF_SIZE 16
+
+/*Rebase the lifes if the age of the cache is greater than this to avoid overflow*/
+#define LV_IMG_CACHE_AGE_LIMIT 0x80000000
+
+/*Marks the end of a hash bucket's list*/
+#define LV_IMG_CACHE_NONE 0xFFFF
 
 #if LV_IMG_CACHE_DEF_SIZE < 1
 #error "LV_IMG_CACHE_DEF_SIZE must be >= 1. See lv_conf.h"
@@ -40,11 +46,24 @@
 /**********************
  *  STATIC PROTOTYPES
  **********************/
+static uint32_t get_hash(const void * src, lv_img_src_t src_type);
+static uint16_t * get_buckets(void);
+static bool entry_match(const lv_img_cache_entry_t * entry, const void * src, lv_img_src_t src_type);
+static void entry_link(lv_img_cache_entry_t * entry);
+static void entry_close(lv_img_cache_entry_t * entry);
+static lv_img_cache_entry_t * get_victim(const lv_img_cache_entry_t * exclude, bool free_ok);
+static void entry_use(lv_img_cache_entry_t * entry);
+static uint32_t get_mem_size(const lv_img_decoder_dsc_t * dsc);
 
 /**********************
  *  STATIC VARIABLES
  **********************/
 static uint16_t entry_cnt;
+static uint16_t bucket_cnt; /*Power of 2*/
+static uint32_t cache_age;
+static uint32_t use_cnt;
+static uint32_t mem_limit = LV_IMG_CACHE_DEF_MEM_LIMIT;
+static lv_img_cache_stat_t cache_stat;
 
 /**********************
  *      MACROS
@@ -70,78 +89,81 @@ lv_img_cache_entry_t * lv_img_cache_open(const void * src, const lv_style_t * st
     }
 
     lv_img_cache_entry_t * cache = LV_GC_ROOT(_lv_img_cache_array);
+    lv_img_src_t src_type        = lv_img_src_get_type(src);
+    uint32_t hash                = get_hash(src, src_type);
 
-    /*Decrement all lifes. Make the entries older*/
-    uint16_t i;
-    for(i = 0; i < entry_cnt; i++) {
-        if(cache[i].life > INT32_MIN + LV_IMG_CACHE_AGING) {
-            cache[i].life -= LV_IMG_CACHE_AGING;
+    /*Is the image cached? Look for it only among the entries with the same hash*/
+    uint16_t i = get_buckets()[hash & (bucket_cnt - 1)];
+    while(i != LV_IMG_CACHE_NONE) {
+        lv_img_cache_entry_t * entry = &cache[i];
+        /*Variables are decoded with the style's color so they need to be cached per style*/
+        if(entry->hash == hash && entry_match(entry, src, src_type) &&
+           (src_type != LV_IMG_SRC_VARIABLE || entry->dec_dsc.style == style)) {
+            cache_stat.hit++;
+            entry_use(entry);
+            LV_LOG_TRACE("image draw: image found in the cache");
+            return entry;
         }
+        i = entry->next;
     }
 
-    /*Is the image cached?*/
-    lv_img_cache_entry_t * cached_src = NULL;
-    for(i = 0; i < entry_cnt; i++) {
-        bool match = false;
-        lv_img_src_t src_type = lv_img_src_get_type(cache[i].dec_dsc.src);
-        if(src_type == LV_IMG_SRC_VARIABLE) {
-            if(cache[i].dec_dsc.src == src && cache[i].dec_dsc.style == style) match = true;
-        } else if(src_type == LV_IMG_SRC_FILE) {
-            if(strcmp(cache[i].dec_dsc.src, src) == 0) match = true;
-        }
+    cache_stat.miss++;
 
-        if(match) {
-            /* If opened increment its life.
-             * Image difficult to open should live longer to keep avoid frequent their recaching.
-             * Therefore increase `life` with `time_to_open`*/
-            cached_src = &cache[i];
-            cached_src->life += cached_src->dec_dsc.time_to_open * LV_IMG_CACHE_LIFE_GAIN;
-            if(cached_src->life > LV_IMG_CACHE_LIFE_LIMIT) cached_src->life = LV_IMG_CACHE_LIFE_LIMIT;
-            LV_LOG_TRACE("image draw: image found in the cache");
-            break;
-        }
+    /*The image is not cached then cache it now. Use a free entry or the entry with the least life*/
+    lv_img_cache_entry_t * cached_src = get_victim(NULL, true);
+
+    /*Close the decoder to reuse if it was opened (has a valid source)*/
+    if(cached_src->dec_dsc.src) {
+        entry_close(cached_src);
+        cache_stat.evict++;
+        LV_LOG_INFO("image draw: cache miss, close and reuse an entry");
+    } else {
+        LV_LOG_INFO("image draw: cache miss, cached to an empty entry");
     }
 
-    /*The image is not cached then cache it now*/
-    if(cached_src == NULL) {
-        /*Find an entry to reuse. Select the entry with the least life*/
-        cached_src = &cache[0];
-        for(i = 1; i < entry_cnt; i++) {
-            if(cache[i].life < cached_src->life) {
-                cached_src = &cache[i];
-            }
-        }
+    /*Open the image and measure the time to open*/
+    uint32_t t_start;
+    t_start                          = lv_tick_get();
+    cached_src->dec_dsc.time_to_open = 0;
+    cached_src->dec_dsc.mem_size     = 0;
+    lv_res_t open_res                = lv_img_decoder_open(&cached_src->dec_dsc, src, style);
+    if(open_res == LV_RES_INV) {
+        LV_LOG_WARN("Image draw cannot open the image resource");
+        lv_img_decoder_close(&cached_src->dec_dsc);
+        memset(cached_src, 0, sizeof(lv_img_cache_entry_t));
+        cached_src->next = LV_IMG_CACHE_NONE;
+        return NULL;
+    }
 
-        /*Close the decoder to reuse if it was opened (has a valid source)*/
-        if(cached_src->dec_dsc.src) {
-            lv_img_decoder_close(&cached_src->dec_dsc);
-            LV_LOG_INFO("image draw: cache miss, close and reuse an entry");
-        } else {
-            LV_LOG_INFO("image draw: cache miss, cached to an empty entry");
-        }
+    /*If `time_to_open` was not set in the open function set it here*/
+    if(cached_src->dec_dsc.time_to_open == 0) {
+        cached_src->dec_dsc.time_to_open = lv_tick_elaps(t_start);
+    }
 
-        /*Open the image and measure the time to open*/
-        uint32_t t_start;
-        t_start                          = lv_tick_get();
-        cached_src->dec_dsc.time_to_open = 0;
-        lv_res_t open_res                = lv_img_decoder_open(&cached_src->dec_dsc, src, style);
-        if(open_res == LV_RES_INV) {
-            LV_LOG_WARN("Image draw cannot open the image resource");
-            lv_img_decoder_close(&cached_src->dec_dsc);
-            memset(&cached_src->dec_dsc, 0, sizeof(lv_img_decoder_dsc_t));
-            memset(cached_src, 0, sizeof(lv_img_cache_entry_t));
-            cached_src->life = INT32_MIN; /*Make the empty entry very "weak" to force its use  */
-            return NULL;
-        }
+    if(cached_src->dec_dsc.time_to_open == 0) cached_src->dec_dsc.time_to_open = 1;
+
+    cached_src->dec_dsc.mem_size = get_mem_size(&cached_src->dec_dsc);
+    cached_src->hash             = hash;
+    entry_link(cached_src);
+    entry_use(cached_src);
 
-        cached_src->life = 0;
+    cache_stat.entry_used++;
+    cache_stat.mem_used += cached_src->dec_dsc.mem_size;
 
-        /*If `time_to_open` was not set in the open function set it here*/
-        if(cached_src->dec_dsc.time_to_open == 0) {
-            cached_src->dec_dsc.time_to_open = lv_tick_elaps(t_start);
+    /*Close the least valuable images until the new image fits into the memory limit*/
+    if(mem_limit != 0) {
+        while(cache_stat.mem_used > mem_limit) {
+            lv_img_cache_entry_t * victim = get_victim(cached_src, false);
+            if(victim == NULL) break;
+
+            entry_close(victim);
+            cache_stat.evict++;
+            LV_LOG_INFO("image draw: close an entry to keep the memory limit");
         }
 
-        if(cached_src->dec_dsc.time_to_open == 0) cached_src->dec_dsc.time_to_open = 1;
+        if(cache_stat.mem_used > mem_limit) {
+            LV_LOG_WARN("lv_img_cache_open: the image is larger than the memory limit of the cache");
+        }
     }
 
     return cached_src;
@@ -161,23 +183,79 @@ void lv_img_cache_set_size(uint16_t new_entry_cnt)
         lv_mem_free(LV_GC_ROOT(_lv_img_cache_array));
     }
 
-    /*Reallocate the cache*/
-    LV_GC_ROOT(_lv_img_cache_array) = lv_mem_alloc(sizeof(lv_img_cache_entry_t) * new_entry_cnt);
+    /*Use at least as many hash buckets as entries*/
+    uint16_t new_bucket_cnt = 1;
+    while(new_bucket_cnt < new_entry_cnt && new_bucket_cnt < 0x8000) new_bucket_cnt = new_bucket_cnt << 1;
+
+    /*Reallocate the cache. The hash buckets are stored after the entries*/
+    LV_GC_ROOT(_lv_img_cache_array) =
+        lv_mem_alloc(sizeof(lv_img_cache_entry_t) * new_entry_cnt + sizeof(uint16_t) * new_bucket_cnt);
     LV_ASSERT_MEM(LV_GC_ROOT(_lv_img_cache_array));
     if(LV_GC_ROOT(_lv_img_cache_array) == NULL) {
-        entry_cnt = 0;
+        entry_cnt  = 0;
+        bucket_cnt = 0;
         return;
     }
-    entry_cnt = new_entry_cnt;
+    entry_cnt  = new_entry_cnt;
+    bucket_cnt = new_bucket_cnt;
 
     /*Clean the cache*/
     uint16_t i;
     for(i = 0; i < entry_cnt; i++) {
-        memset(&LV_GC_ROOT(_lv_img_cache_array)[i].dec_dsc, 0, sizeof(lv_img_decoder_dsc_t));
         memset(&LV_GC_ROOT(_lv_img_cache_array)[i], 0, sizeof(lv_img_cache_entry_t));
+        LV_GC_ROOT(_lv_img_cache_array)[i].next = LV_IMG_CACHE_NONE;
+    }
+
+    uint16_t * buckets = get_buckets();
+    for(i = 0; i < bucket_cnt; i++) buckets[i] = LV_IMG_CACHE_NONE;
+
+    cache_age             = 0;
+    use_cnt               = 0;
+    cache_stat.mem_used   = 0;
+    cache_stat.entry_used = 0;
+}
+
+/**
+ * Limit the RAM used by the images opened in the cache.
+ * If a new image doesn't fit the least valuable images are closed.
+ * @param new_mem_limit the limit in bytes. 0: no limit
+ */
+void lv_img_cache_set_mem_limit(uint32_t new_mem_limit)
+{
+    mem_limit = new_mem_limit;
+
+    if(mem_limit == 0) return;
+
+    /*Apply the new limit on the already opened images*/
+    while(cache_stat.mem_used > mem_limit) {
+        lv_img_cache_entry_t * victim = get_victim(NULL, false);
+        if(victim == NULL) break;
+
+        entry_close(victim);
+        cache_stat.evict++;
     }
 }
 
+/**
+ * Get the statistics of the image cache
+ * @param stat store the statistics here
+ */
+void lv_img_cache_get_stat(lv_img_cache_stat_t * stat)
+{
+    memcpy(stat, &cache_stat, sizeof(lv_img_cache_stat_t));
+    stat->entry_cnt = entry_cnt;
+}
+
+/**
+ * Reset the hit, miss and eviction counters of the image cache
+ */
+void lv_img_cache_reset_stat(void)
+{
+    cache_stat.hit   = 0;
+    cache_stat.miss  = 0;
+    cache_stat.evict = 0;
+}
+
 /**
  * Invalidate an image source in the cache.
  * Useful if the image source is updated therefore it needs to be cached again.
@@ -185,22 +263,197 @@ void lv_img_cache_set_size(uint16_t new_entry_cnt)
  */
 void lv_img_cache_invalidate_src(const void * src)
 {
+    if(entry_cnt == 0) return;
 
     lv_img_cache_entry_t * cache = LV_GC_ROOT(_lv_img_cache_array);
 
-    uint16_t i;
-    for(i = 0; i < entry_cnt; i++) {
-        if(cache[i].dec_dsc.src == src || src == NULL) {
-            if(cache[i].dec_dsc.src != NULL) {
-                lv_img_decoder_close(&cache[i].dec_dsc);
-            }
-
-            memset(&cache[i].dec_dsc, 0, sizeof(lv_img_decoder_dsc_t));
-            memset(&cache[i], 0, sizeof(lv_img_cache_entry_t));
+    if(src == NULL) {
+        uint16_t i;
+        for(i = 0; i < entry_cnt; i++) {
+            if(cache[i].dec_dsc.src != NULL) entry_close(&cache[i]);
         }
+        return;
+    }
+
+    /*Close all entries of the source (a variable can be cached with more styles)*/
+    lv_img_src_t src_type = lv_img_src_get_type(src);
+    uint32_t hash         = get_hash(src, src_type);
+    uint16_t i            = get_buckets()[hash & (bucket_cnt - 1)];
+    while(i != LV_IMG_CACHE_NONE) {
+        lv_img_cache_entry_t * entry = &cache[i];
+        i = entry->next; /*Save the next before the entry is closed*/
+        if(entry->hash == hash && entry_match(entry, src, src_type)) entry_close(entry);
     }
 }
 
 /**********************
  *   STATIC FUNCTIONS
  **********************/
+
+/**
+ * Get the hash of an image source. The style is not included to find all entries of a source.
+ * @param src the image source
+ * @param src_type type of `src`
+ * @return the hash
+ */
+static uint32_t get_hash(const void * src, lv_img_src_t src_type)
+{
+    uint32_t hash;
+    if(src_type == LV_IMG_SRC_FILE) {
+        /*FNV-1a on the file name*/
+        const uint8_t * fn = src;
+        hash               = 2166136261u;
+        while(*fn != '\0') {
+            hash ^= *fn;
+            hash *= 16777619u;
+            fn++;
+        }
+    } else {
+        /*The lower bits of the addresses are mostly the same because of the alignment*/
+        hash = (uint32_t)((lv_uintptr_t)src >> 2) * 2654435761u;
+    }
+
+    return hash ^ (hash >> 16);
+}
+
+/**
+ * Get the hash buckets. They are stored after the entries.
+ * @return pointer to the first bucket. A bucket stores the index of its first entry.
+ */
+static uint16_t * get_buckets(void)
+{
+    return (uint16_t *)&LV_GC_ROOT(_lv_img_cache_array)[entry_cnt];
+}
+
+/**
+ * Tell whether an entry caches an image source (independently from the style)
+ * @param entry pointer to a cache entry
+ * @param src an image source
+ * @param src_type type of `src`
+ * @return true: `entry` caches `src`
+ */
+static bool entry_match(const lv_img_cache_entry_t * entry, const void * src, lv_img_src_t src_type)
+{
+    if(entry->dec_dsc.src == NULL || entry->dec_dsc.src_type != src_type) return false;
+
+    if(src_type == LV_IMG_SRC_VARIABLE) return entry->dec_dsc.src == src;
+    if(src_type == LV_IMG_SRC_FILE) return strcmp(entry->dec_dsc.src, src) == 0;
+
+    return false;
+}
+
+/**
+ * Add an entry to its hash bucket
+ * @param entry pointer to a cache entry with valid `hash`
+ */
+static void entry_link(lv_img_cache_entry_t * entry)
+{
+    uint16_t * bucket = &get_buckets()[entry->hash & (bucket_cnt - 1)];
+    entry->next       = *bucket;
+    *bucket           = entry - LV_GC_ROOT(_lv_img_cache_array);
+}
+
+/**
+ * Close the image of an entry, remove it from its hash bucket and make it free
+ * @param entry pointer to a cache entry with an opened image
+ */
+static void entry_close(lv_img_cache_entry_t * entry)
+{
+    lv_img_cache_entry_t * cache = LV_GC_ROOT(_lv_img_cache_array);
+    uint16_t id                  = entry - cache;
+
+    /*Find the reference to the entry in the bucket and skip the entry*/
+    uint16_t * ref = &get_buckets()[entry->hash & (bucket_cnt - 1)];
+    while(*ref != LV_IMG_CACHE_NONE && *ref != id) ref = &cache[*ref].next;
+    if(*ref == id) *ref = entry->next;
+
+    /*The entry's life shows how valuable were the entries not used since the last eviction.
+     * Let the cache "age" to it so the others have to be used again to stay longer.*/
+    if(entry->life > cache_age) cache_age = entry->life;
+
+    cache_stat.mem_used -= entry->dec_dsc.mem_size;
+    cache_stat.entry_used--;
+
+    lv_img_decoder_close(&entry->dec_dsc);
+    memset(entry, 0, sizeof(lv_img_cache_entry_t));
+    entry->next = LV_IMG_CACHE_NONE;
+}
+
+/**
+ * Find the entry to close: a free entry or the one with the least life.
+ * @param exclude don't select this entry. Can be NULL.
+ * @param free_ok true: a free entry can be selected too; false: select only entries with an opened image
+ * @return the selected entry or NULL if there is no entry to select
+ */
+static lv_img_cache_entry_t * get_victim(const lv_img_cache_entry_t * exclude, bool free_ok)
+{
+    lv_img_cache_entry_t * cache  = LV_GC_ROOT(_lv_img_cache_array);
+    lv_img_cache_entry_t * victim = NULL;
+
+    uint16_t i;
+    for(i = 0; i < entry_cnt; i++) {
+        lv_img_cache_entry_t * entry = &cache[i];
+        if(entry == exclude) continue;
+        if(entry->dec_dsc.src == NULL) {
+            if(free_ok) return entry; /*A free entry is the best choice*/
+            continue;
+        }
+
+        /*Less life or the same life but older use loses*/
+        if(victim == NULL || entry->life < victim->life ||
+           (entry->life == victim->life && use_cnt - entry->last_use > use_cnt - victim->last_use)) {
+            victim = entry;
+        }
+    }
+
+    return victim;
+}
+
+/**
+ * Refresh the life of an entry because it's used.
+ * Images difficult to open should live longer to avoid their frequent recaching.
+ * Therefore its life is increased with `time_to_open` but large images are kept for shorter time.
+ * @param entry pointer to a cache entry with an opened image
+ */
+static void entry_use(lv_img_cache_entry_t * entry)
+{
+    /*Rebase the lifes to the current age to avoid overflow*/
+    if(cache_age >= LV_IMG_CACHE_AGE_LIMIT) {
+        lv_img_cache_entry_t * cache = LV_GC_ROOT(_lv_img_cache_array);
+        uint16_t i;
+        for(i = 0; i < entry_cnt; i++) {
+            cache[i].life = cache[i].life > cache_age ? cache[i].life - cache_age : 0;
+        }
+        cache_age = 0;
+    }
+
+    uint32_t credit = entry->dec_dsc.time_to_open * LV_IMG_CACHE_LIFE_GAIN;
+    if(credit > LV_IMG_CACHE_LIFE_LIMIT) credit = LV_IMG_CACHE_LIFE_LIMIT;
+    credit = (credit * LV_IMG_CACHE_LIFE_HALF_SIZE) / (LV_IMG_CACHE_LIFE_HALF_SIZE + (entry->dec_dsc.mem_size >> 10));
+
+    use_cnt++;
+    entry->life     = cache_age + credit;
+    entry->last_use = use_cnt;
+}
+
+/**
+ * Get the RAM used by an opened image
+ * @param dsc pointer to an opened decoder descriptor
+ * @return the used memory in bytes
+ */
+static uint32_t get_mem_size(const lv_img_decoder_dsc_t * dsc)
+{
+    /*Use the size given by the decoder*/
+    if(dsc->mem_size != 0) return dsc->mem_size;
+
+    /*Without the whole decoded image only some small data might be allocated*/
+    if(dsc->img_data == NULL) return 0;
+
+    /*The data of variables is simply passed (typically from the flash)*/
+    if(dsc->src_type == LV_IMG_SRC_VARIABLE && dsc->img_data == ((const lv_img_dsc_t *)dsc->src)->data) return 0;
+
+    uint32_t size = lv_img_buf_get_img_size(dsc->header.w, dsc->header.h, dsc->header.cf);
+    if(size == 0) size = (uint32_t)dsc->header.w * dsc->header.h * LV_IMG_PX_SIZE_ALPHA_BYTE;
+
+    return size;
+}
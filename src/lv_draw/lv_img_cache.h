@@ -32,12 +32,30 @@ typedef struct
 {
     lv_img_decoder_dsc_t dec_dsc; /**< Image information */
 
-    /** Count the cache entries's life. Add `time_tio_open` to `life` when the entry is used.
-     * Decrement all lifes by one every in every ::lv_img_cache_open.
-     * If life == 0 the entry can be reused */
-    int32_t life;
+    /** Count the cache entries's life. When the entry is used `life` is set to the age of the cache
+     * plus a credit which is higher for images taking longer to open and using less memory.
+     * The entry with the least life is reused first and its life becomes the new age of the cache.
+     * So the not used entries are getting older without touching them.*/
+    uint32_t life;
+
+    uint32_t last_use; /**< Value of a use counter when the entry was used last time. Decides between equal lives*/
+    uint32_t hash;     /**< Hash of the source (not the style) to find the entry quickly*/
+    uint16_t next;     /**< Index of the next entry in the same hash bucket*/
 } lv_img_cache_entry_t;
 
+/**
+ * Statistics of the image cache
+ */
+typedef struct
+{
+    uint32_t hit;        /**< Number of images found in the cache*/
+    uint32_t miss;       /**< Number of images not found in the cache (had to be opened)*/
+    uint32_t evict;      /**< Number of images closed to make room for others*/
+    uint32_t mem_used;   /**< RAM used by the images in the cache now [bytes]*/
+    uint16_t entry_used; /**< Number of images in the cache now*/
+    uint16_t entry_cnt;  /**< Number of images which can be cached*/
+} lv_img_cache_stat_t;
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -60,6 +78,24 @@ lv_img_cache_entry_t * lv_img_cache_open(const void * src, const lv_style_t * st
  */
 void lv_img_cache_set_size(uint16_t new_slot_num);
 
+/**
+ * Limit the RAM used by the images opened in the cache.
+ * If a new image doesn't fit the least valuable images are closed.
+ * @param mem_limit the limit in bytes. 0: no limit
+ */
+void lv_img_cache_set_mem_limit(uint32_t mem_limit);
+
+/**
+ * Get the statistics of the image cache
+ * @param stat store the statistics here
+ */
+void lv_img_cache_get_stat(lv_img_cache_stat_t * stat);
+
+/**
+ * Reset the hit, miss and eviction counters of the image cache
+ */
+void lv_img_cache_reset_stat(void);
+
 /**
  * Invalidate an image source in the cache.
  * Useful if the image source is updated therefore it needs to be cached again.
@@ -7,10 +7,12 @@
  *      INCLUDES
  *********************/
 #include "lv_img_decoder.h"
+#include "lv_img_cache.h"
 #include "../lv_core/lv_debug.h"
 #include "../lv_draw/lv_draw_img.h"
 #include "../lv_misc/lv_ll.h"
 #include "../lv_misc/lv_color.h"
+#include "../lv_misc/lv_math.h"
 #include "../lv_misc/lv_gc.h"
 
 #if defined(LV_GC_INCLUDE)
@@ -21,7 +23,17 @@
  *      DEFINES
  *********************/
 #define CF_BUILT_IN_FIRST LV_IMG_CF_TRUE_COLOR
-#define CF_BUILT_IN_LAST LV_IMG_CF_ALPHA_8BIT
+#define CF_BUILT_IN_LAST LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED_RLE
+
+#define CF_IS_RLE(cf)                                                                                                  \
+    ((cf) == LV_IMG_CF_TRUE_COLOR_RLE || (cf) == LV_IMG_CF_TRUE_COLOR_ALPHA_RLE ||                                     \
+     (cf) == LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED_RLE)
+
+/*A run-length encoded row consists of chunks. A chunk starts with a control byte:
+ * - 0x00..0x7F: (ctrl + 1) pixels follow as they are
+ * - 0x80..0xFF: the next pixel is repeated (ctrl - 0x80 + 1) times*/
+#define RLE_CTRL_RUN 0x80
+#define RLE_CTRL_CNT_MASK 0x7F
 
 /**********************
  *      TYPEDEFS
@@ -33,21 +45,50 @@ typedef struct
 #endif
     lv_color_t * palette;
     lv_opa_t * opa;
+    uint8_t * ram_data; /*The whole image decoded into the RAM*/
+    uint32_t ram_size;
+#if LV_IMG_CF_RLE
+    const uint8_t * rle_data; /*Data of a compressed variable: row offset table and rows*/
+    uint32_t * rle_ofs;       /*Row offset table read from a compressed file*/
+    uint8_t * rle_row;        /*Buffer for a compressed row read from a file*/
+#endif
 } lv_img_decoder_built_in_data_t;
 
+/*An image source to decode into RAM*/
+typedef struct
+{
+    const void * src; /*File name (allocated) or pointer to an `lv_img_dsc_t`*/
+} lv_img_decoder_ram_src_t;
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
+static lv_img_decoder_ram_src_t * get_ram_src(const void * src);
+static void lv_img_decoder_built_in_decode_to_ram(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc);
 static lv_res_t lv_img_decoder_built_in_line_true_color(lv_img_decoder_dsc_t * dsc, lv_coord_t x, lv_coord_t y,
-                                                        lv_coord_t len, uint8_t * buf);
+                                                        uint32_t len, uint8_t * buf);
+static lv_res_t lv_img_decoder_built_in_area_true_color(lv_img_decoder_dsc_t * dsc, const lv_area_t * area,
+                                                        uint8_t * buf);
 static lv_res_t lv_img_decoder_built_in_line_alpha(lv_img_decoder_dsc_t * dsc, lv_coord_t x, lv_coord_t y,
                                                    lv_coord_t len, uint8_t * buf);
 static lv_res_t lv_img_decoder_built_in_line_indexed(lv_img_decoder_dsc_t * dsc, lv_coord_t x, lv_coord_t y,
                                                      lv_coord_t len, uint8_t * buf);
+#if LV_IMG_CF_RLE
+static lv_res_t lv_img_decoder_built_in_rle_open(lv_img_decoder_dsc_t * dsc);
+static void lv_img_decoder_built_in_rle_free(lv_img_decoder_built_in_data_t * user_data);
+static lv_res_t lv_img_decoder_built_in_line_rle(lv_img_decoder_dsc_t * dsc, lv_coord_t x, lv_coord_t y,
+                                                 lv_coord_t len, uint8_t * buf);
+static lv_res_t rle_decode_row(const uint8_t * in, const uint8_t * in_end, uint8_t px_size, lv_coord_t x,
+                               lv_coord_t len, uint8_t * buf);
+static inline uint32_t rle_get_u32(const uint8_t * p);
+#endif
 
 /**********************
  *  STATIC VARIABLES
  **********************/
+static bool ram_all;
+static uint32_t ram_limit = LV_IMG_DECODE_RAM_LIMIT;
+static uint32_t ram_used;
 
 /**********************
  *      MACROS
@@ -63,6 +104,9 @@ static lv_res_t lv_img_decoder_built_in_line_indexed(lv_img_decoder_dsc_t * dsc,
 void lv_img_decoder_init(void)
 {
     lv_ll_init(&LV_GC_ROOT(_lv_img_defoder_ll), sizeof(lv_img_decoder_t));
+    lv_ll_init(&LV_GC_ROOT(_lv_img_ram_src_ll), sizeof(lv_img_decoder_ram_src_t));
+    ram_all  = false;
+    ram_used = 0;
 
     lv_img_decoder_t * decoder;
 
@@ -77,6 +121,7 @@ void lv_img_decoder_init(void)
     lv_img_decoder_set_info_cb(decoder, lv_img_decoder_built_in_info);
     lv_img_decoder_set_open_cb(decoder, lv_img_decoder_built_in_open);
     lv_img_decoder_set_read_line_cb(decoder, lv_img_decoder_built_in_read_line);
+    lv_img_decoder_set_read_area_cb(decoder, lv_img_decoder_built_in_read_area);
     lv_img_decoder_set_close_cb(decoder, lv_img_decoder_built_in_close);
 }
 
@@ -176,6 +221,83 @@ lv_res_t lv_img_decoder_read_line(lv_img_decoder_dsc_t * dsc, lv_coord_t x, lv_c
     return res;
 }
 
+/**
+ * Read an area from an opened image.
+ * Uses the decoder's `read_area_cb` if set, else reads the area line by line with `read_line_cb`.
+ * @param dsc pointer to `lv_img_decoder_dsc_t` used in `lv_img_decoder_open`
+ * @param area the area to read relative to the image's top left corner
+ * @param buf store the data here. The lines are stored continuously.
+ *            Its size should be `lv_area_get_size(area) * lv_img_decoder_get_px_size(dsc)` bytes.
+ * @return LV_RES_OK: success; LV_RES_INV: an error occurred
+ */
+lv_res_t lv_img_decoder_read_area(lv_img_decoder_dsc_t * dsc, const lv_area_t * area, uint8_t * buf)
+{
+    if(dsc->decoder->read_area_cb) return dsc->decoder->read_area_cb(dsc->decoder, dsc, area, buf);
+    if(dsc->decoder->read_line_cb == NULL) return LV_RES_INV;
+
+    lv_coord_t w         = lv_area_get_width(area);
+    uint32_t line_size   = (uint32_t)w * lv_img_decoder_get_px_size(dsc);
+    lv_coord_t y;
+    for(y = area->y1; y <= area->y2; y++) {
+        lv_res_t res = dsc->decoder->read_line_cb(dsc->decoder, dsc, area->x1, y, w, buf);
+        if(res != LV_RES_OK) return res;
+        buf += line_size;
+    }
+
+    return LV_RES_OK;
+}
+
+/**
+ * Get the size of a pixel decoded by `lv_img_decoder_read_line/area`
+ * @param dsc pointer to `lv_img_decoder_dsc_t` used in `lv_img_decoder_open`
+ * @return size of a decoded pixel in bytes
+ */
+uint8_t lv_img_decoder_get_px_size(const lv_img_decoder_dsc_t * dsc)
+{
+    return lv_img_color_format_has_alpha(dsc->header.cf) ? LV_IMG_PX_SIZE_ALPHA_BYTE : sizeof(lv_color_t);
+}
+
+/**
+ * Get the not decoded indices or alpha values of an indexed or alpha only image to draw it directly
+ * with `lv_draw_map_indexed()` instead of decoding it line by line.
+ * Only the images opened by the built-in decoder from a variable are supported.
+ * @param dsc pointer to `lv_img_decoder_dsc_t` used in `lv_img_decoder_open`
+ * @param map store the pointer to the first row of the indices or alpha values here
+ * @param palette store the palette converted to `lv_color_t` here. NULL for alpha only images.
+ * @param palette_opa store the opacity of the palette's colors here. NULL for alpha only images.
+ * @return LV_RES_OK: the pointers are set; LV_RES_INV: the image needs to be decoded line by line
+ */
+lv_res_t lv_img_decoder_get_indexed_map(const lv_img_decoder_dsc_t * dsc, const uint8_t ** map,
+                                        const lv_color_t ** palette, const lv_opa_t ** palette_opa)
+{
+    if(dsc->decoder == NULL || dsc->decoder->open_cb != lv_img_decoder_built_in_open) return LV_RES_INV;
+    if(dsc->src_type != LV_IMG_SRC_VARIABLE || dsc->img_data != NULL) return LV_RES_INV;
+
+    lv_img_cf_t cf = dsc->header.cf;
+    const uint8_t * data = ((const lv_img_dsc_t *)dsc->src)->data;
+
+    if(cf == LV_IMG_CF_INDEXED_1BIT || cf == LV_IMG_CF_INDEXED_2BIT || cf == LV_IMG_CF_INDEXED_4BIT ||
+       cf == LV_IMG_CF_INDEXED_8BIT) {
+        lv_img_decoder_built_in_data_t * user_data = dsc->user_data;
+        if(user_data == NULL || user_data->palette == NULL || user_data->opa == NULL) return LV_RES_INV;
+
+        /*The indices are after the palette*/
+        uint32_t palette_size = 1 << lv_img_color_format_get_px_size(cf);
+        *map                  = &data[palette_size * sizeof(lv_color32_t)];
+        *palette              = user_data->palette;
+        *palette_opa          = user_data->opa;
+        return LV_RES_OK;
+    } else if(cf == LV_IMG_CF_ALPHA_1BIT || cf == LV_IMG_CF_ALPHA_2BIT || cf == LV_IMG_CF_ALPHA_4BIT ||
+              cf == LV_IMG_CF_ALPHA_8BIT) {
+        *map         = data;
+        *palette     = NULL;
+        *palette_opa = NULL;
+        return LV_RES_OK;
+    }
+
+    return LV_RES_INV;
+}
+
 /**
  * Close a decoding session
  * @param dsc pointer to `lv_img_decoder_dsc_t` used in `lv_img_decoder_open`
@@ -248,6 +370,17 @@ void lv_img_decoder_set_read_line_cb(lv_img_decoder_t * decoder, lv_img_decoder_
     decoder->read_line_cb = read_line_cb;
 }
 
+/**
+ * Set a callback to decode an area of an image at once.
+ * Optional, but decoders working in blocks (e.g. tiles) should set it.
+ * @param decoder pointer to an image decoder
+ * @param read_area_cb a function to read an area of an image
+ */
+void lv_img_decoder_set_read_area_cb(lv_img_decoder_t * decoder, lv_img_decoder_read_area_f_t read_area_cb)
+{
+    decoder->read_area_cb = read_area_cb;
+}
+
 /**
  * Set a callback to close a decoding session. E.g. close files and free other resources.
  * @param decoder pointer to an image decoder
@@ -258,6 +391,70 @@ void lv_img_decoder_set_close_cb(lv_img_decoder_t * decoder, lv_img_decoder_clos
     decoder->close_cb = close_cb;
 }
 
+/**
+ * Enable or disable decoding an image source into the RAM when it's opened.
+ * Decoded images are drawn as quickly as true color images from the flash
+ * but they use `width * height * pixel size` bytes of RAM while they are open (e.g. in the image cache).
+ * Only true color files, indexed and compressed images are decoded by the built-in decoder.
+ * The RAM used by the decoded images is limited by `lv_img_decoder_set_ram_limit()`.
+ * @param src the image source: path to a file or pointer to an `lv_img_dsc_t` variable.
+ *            NULL to enable/disable decoding of every image.
+ * @param en true: decode to RAM; false: decode line by line while drawing
+ */
+void lv_img_decoder_set_decode_to_ram(const void * src, bool en)
+{
+    if(src == NULL) {
+        ram_all = en;
+    } else {
+        lv_img_decoder_ram_src_t * ram_src = get_ram_src(src);
+        if(en && ram_src == NULL) {
+            ram_src = lv_ll_ins_head(&LV_GC_ROOT(_lv_img_ram_src_ll));
+            LV_ASSERT_MEM(ram_src);
+            if(ram_src == NULL) return;
+
+            if(lv_img_src_get_type(src) == LV_IMG_SRC_FILE) {
+                char * fn = lv_mem_alloc(strlen(src) + 1);
+                LV_ASSERT_MEM(fn);
+                if(fn == NULL) {
+                    lv_ll_rem(&LV_GC_ROOT(_lv_img_ram_src_ll), ram_src);
+                    lv_mem_free(ram_src);
+                    return;
+                }
+                strcpy(fn, src);
+                ram_src->src = fn;
+            } else {
+                ram_src->src = src;
+            }
+        } else if(!en && ram_src != NULL) {
+            if(lv_img_src_get_type(ram_src->src) == LV_IMG_SRC_FILE) lv_mem_free(ram_src->src);
+            lv_ll_rem(&LV_GC_ROOT(_lv_img_ram_src_ll), ram_src);
+            lv_mem_free(ram_src);
+        }
+    }
+
+    /*Open the images again with the new setting*/
+    lv_img_cache_invalidate_src(src);
+}
+
+/**
+ * Set the max. RAM which can be used by the images decoded to RAM.
+ * Already decoded images are not closed if the new limit is less than the currently used RAM.
+ * @param limit the limit in bytes. 0: don't decode to RAM
+ */
+void lv_img_decoder_set_ram_limit(uint32_t limit)
+{
+    ram_limit = limit;
+}
+
+/**
+ * Get the RAM used by the images decoded to RAM
+ * @return the used RAM in bytes
+ */
+uint32_t lv_img_decoder_get_ram_used(void)
+{
+    return ram_used;
+}
+
 /**
  * Get info about a built-in image
  * @param decoder the decoder where this function belongs
@@ -364,8 +561,9 @@ lv_res_t lv_img_decoder_built_in_open(lv_img_decoder_t * decoder, lv_img_decoder
             dsc->img_data = ((lv_img_dsc_t *)dsc->src)->data;
             return LV_RES_OK;
         } else {
-            /*If it's a file it need to be read line by line later*/
+            /*If it's a file it need to be read line by line later or decoded into the RAM now*/
             dsc->img_data = NULL;
+            lv_img_decoder_built_in_decode_to_ram(decoder, dsc);
             return LV_RES_OK;
         }
     }
@@ -424,6 +622,7 @@ lv_res_t lv_img_decoder_built_in_open(lv_img_decoder_t * decoder, lv_img_decoder
         }
 
         dsc->img_data = NULL;
+        lv_img_decoder_built_in_decode_to_ram(decoder, dsc);
         return LV_RES_OK;
 #else
         LV_LOG_WARN("Indexed (palette) images are not enabled in lv_conf.h. See LV_IMG_CF_INDEXED");
@@ -439,6 +638,23 @@ lv_res_t lv_img_decoder_built_in_open(lv_img_decoder_t * decoder, lv_img_decoder
 #else
         LV_LOG_WARN("Alpha indexed images are not enabled in lv_conf.h. See LV_IMG_CF_ALPHA");
         return LV_RES_INV;
+#endif
+    }
+    /*Run-length compressed true color images. Find the rows here and decode them later*/
+    else if(CF_IS_RLE(cf)) {
+#if LV_IMG_CF_RLE
+        if(lv_img_decoder_built_in_rle_open(dsc) != LV_RES_OK) {
+            lv_img_decoder_built_in_close(decoder, dsc);
+            return LV_RES_INV;
+        }
+
+        dsc->img_data = NULL;
+        lv_img_decoder_built_in_decode_to_ram(decoder, dsc);
+        return LV_RES_OK;
+#else
+        LV_LOG_WARN("Compressed images are not enabled in lv_conf.h. See LV_IMG_CF_RLE");
+        lv_img_decoder_built_in_close(decoder, dsc);
+        return LV_RES_INV;
 #endif
     }
     /*Unknown format. Can't decode it.*/
@@ -483,7 +699,13 @@ lv_res_t lv_img_decoder_built_in_read_line(lv_img_decoder_t * decoder, lv_img_de
     } else if(dsc->header.cf == LV_IMG_CF_INDEXED_1BIT || dsc->header.cf == LV_IMG_CF_INDEXED_2BIT ||
               dsc->header.cf == LV_IMG_CF_INDEXED_4BIT || dsc->header.cf == LV_IMG_CF_INDEXED_8BIT) {
         res = lv_img_decoder_built_in_line_indexed(dsc, x, y, len, buf);
-    } else {
+    }
+#if LV_IMG_CF_RLE
+    else if(CF_IS_RLE(dsc->header.cf)) {
+        res = lv_img_decoder_built_in_line_rle(dsc, x, y, len, buf);
+    }
+#endif
+    else {
         LV_LOG_WARN("Built-in image decoder read not supports the color format");
         return LV_RES_INV;
     }
@@ -491,6 +713,58 @@ lv_res_t lv_img_decoder_built_in_read_line(lv_img_decoder_t * decoder, lv_img_de
     return res;
 }
 
+/**
+ * Decode the pixels of an area and store them in `buf` line by line.
+ * Required only if the "open" function can't return with the whole decoded pixel array.
+ * @param decoder pointer to the decoder the function associated with
+ * @param dsc pointer to decoder descriptor
+ * @param area the area to decode relative to the image's top left corner
+ * @param buf a buffer to store the decoded pixels
+ * @return LV_RES_OK: ok; LV_RES_INV: failed
+ */
+lv_res_t lv_img_decoder_built_in_read_area(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc,
+                                           const lv_area_t * area, uint8_t * buf)
+{
+    (void)decoder; /*Unused*/
+
+    lv_res_t (*line_cb)(lv_img_decoder_dsc_t *, lv_coord_t, lv_coord_t, lv_coord_t, uint8_t *);
+
+    if(dsc->header.cf == LV_IMG_CF_TRUE_COLOR || dsc->header.cf == LV_IMG_CF_TRUE_COLOR_ALPHA ||
+       dsc->header.cf == LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED) {
+        /* For TRUE_COLOR images read area required only for files.
+         * For variables the image data was returned in `open`*/
+        if(dsc->src_type != LV_IMG_SRC_FILE) return LV_RES_INV;
+        return lv_img_decoder_built_in_area_true_color(dsc, area, buf);
+    } else if(dsc->header.cf == LV_IMG_CF_ALPHA_1BIT || dsc->header.cf == LV_IMG_CF_ALPHA_2BIT ||
+              dsc->header.cf == LV_IMG_CF_ALPHA_4BIT || dsc->header.cf == LV_IMG_CF_ALPHA_8BIT) {
+        line_cb = lv_img_decoder_built_in_line_alpha;
+    } else if(dsc->header.cf == LV_IMG_CF_INDEXED_1BIT || dsc->header.cf == LV_IMG_CF_INDEXED_2BIT ||
+              dsc->header.cf == LV_IMG_CF_INDEXED_4BIT || dsc->header.cf == LV_IMG_CF_INDEXED_8BIT) {
+        line_cb = lv_img_decoder_built_in_line_indexed;
+    }
+#if LV_IMG_CF_RLE
+    else if(CF_IS_RLE(dsc->header.cf)) {
+        line_cb = lv_img_decoder_built_in_line_rle;
+    }
+#endif
+    else {
+        LV_LOG_WARN("Built-in image decoder read not supports the color format");
+        return LV_RES_INV;
+    }
+
+    /*The color format is checked only once, then decode the lines one after the other*/
+    lv_coord_t w       = lv_area_get_width(area);
+    uint32_t line_size = (uint32_t)w * lv_img_decoder_get_px_size(dsc);
+    lv_coord_t y;
+    for(y = area->y1; y <= area->y2; y++) {
+        lv_res_t res = line_cb(dsc, area->x1, y, w, buf);
+        if(res != LV_RES_OK) return res;
+        buf += line_size;
+    }
+
+    return LV_RES_OK;
+}
+
 /**
  * Close the pending decoding. Free resources etc.
  * @param decoder pointer to the decoder the function associated with
@@ -510,6 +784,13 @@ void lv_img_decoder_built_in_close(lv_img_decoder_t * decoder, lv_img_decoder_ds
 #endif
         if(user_data->palette) lv_mem_free(user_data->palette);
         if(user_data->opa) lv_mem_free(user_data->opa);
+#if LV_IMG_CF_RLE
+        lv_img_decoder_built_in_rle_free(user_data);
+#endif
+        if(user_data->ram_data) {
+            lv_mem_free(user_data->ram_data);
+            ram_used -= user_data->ram_size;
+        }
 
         lv_mem_free(user_data);
 
@@ -522,8 +803,122 @@ void lv_img_decoder_built_in_close(lv_img_decoder_t * decoder, lv_img_decoder_ds
  *   STATIC FUNCTIONS
  **********************/
 
+/**
+ * Find an image source among the sources to decode into RAM
+ * @param src path to a file or pointer to an `lv_img_dsc_t` variable
+ * @return pointer to the registered source or NULL if not found
+ */
+static lv_img_decoder_ram_src_t * get_ram_src(const void * src)
+{
+    lv_img_src_t src_type = lv_img_src_get_type(src);
+
+    lv_img_decoder_ram_src_t * ram_src;
+    LV_LL_READ(LV_GC_ROOT(_lv_img_ram_src_ll), ram_src)
+    {
+        if(src_type == LV_IMG_SRC_VARIABLE && ram_src->src == src) return ram_src;
+        if(src_type == LV_IMG_SRC_FILE && lv_img_src_get_type(ram_src->src) == LV_IMG_SRC_FILE &&
+           strcmp(ram_src->src, src) == 0) {
+            return ram_src;
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * Decode an opened image into the RAM if it's enabled for its source and fits into the RAM limit.
+ * On success `dsc->img_data` points to the decoded image and the resources needed to decode it are freed.
+ * On failure the image remains readable line by line.
+ * @param decoder the decoder where this function belongs
+ * @param dsc pointer to an opened decoder descriptor
+ */
+static void lv_img_decoder_built_in_decode_to_ram(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc)
+{
+    lv_img_decoder_built_in_data_t * user_data = dsc->user_data;
+    if(user_data == NULL) return;
+    if(ram_limit == 0) return;
+    if(!ram_all && get_ram_src(dsc->src) == NULL) return;
+
+    uint8_t px_size   = lv_img_decoder_get_px_size(dsc);
+    uint32_t px_cnt   = (uint32_t)dsc->header.w * dsc->header.h;
+    uint32_t ram_size = px_cnt * px_size;
+    if(ram_used + ram_size > ram_limit) {
+        LV_LOG_INFO("Built-in image decoder: the image doesn't fit into the RAM limit, read it line by line");
+        return;
+    }
+
+    uint8_t * ram_data = lv_mem_alloc(ram_size);
+    if(ram_data == NULL) {
+        LV_LOG_WARN("Built-in image decoder: out of memory to decode the image, read it line by line");
+        return;
+    }
+
+    lv_area_t area;
+    lv_area_set(&area, 0, 0, dsc->header.w - 1, dsc->header.h - 1);
+    if(lv_img_decoder_built_in_read_area(decoder, dsc, &area, ram_data) != LV_RES_OK) {
+        LV_LOG_WARN("Built-in image decoder: failed to decode the image to RAM, read it line by line");
+        lv_mem_free(ram_data);
+        return;
+    }
+
+    /*Opaque images don't need the alpha bytes. Remove them to save RAM and to draw without blending.*/
+    if(px_size == LV_IMG_PX_SIZE_ALPHA_BYTE) {
+        uint32_t i;
+        for(i = 0; i < px_cnt; i++) {
+            if(ram_data[i * LV_IMG_PX_SIZE_ALPHA_BYTE + LV_IMG_PX_SIZE_ALPHA_BYTE - 1] != LV_OPA_COVER) break;
+        }
+
+        if(i == px_cnt) {
+            /*The color is stored on the first bytes of a pixel so they can be moved forward in place*/
+            for(i = 0; i < px_cnt; i++) {
+                memmove(&ram_data[i * sizeof(lv_color_t)], &ram_data[i * LV_IMG_PX_SIZE_ALPHA_BYTE],
+                        sizeof(lv_color_t));
+            }
+
+            ram_size = px_cnt * sizeof(lv_color_t);
+            uint8_t * ram_data_new = lv_mem_realloc(ram_data, ram_size);
+            if(ram_data_new) ram_data = ram_data_new;
+
+            dsc->header.cf = lv_img_color_format_is_chroma_keyed(dsc->header.cf) ? LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED
+                                                                                 : LV_IMG_CF_TRUE_COLOR;
+        }
+    }
+
+    /*The file and the palette are not required anymore*/
+#if LV_USE_FILESYSTEM
+    if(user_data->f) {
+        lv_fs_close(user_data->f);
+        lv_mem_free(user_data->f);
+        user_data->f = NULL;
+    }
+#endif
+    if(user_data->palette) {
+        lv_mem_free(user_data->palette);
+        user_data->palette = NULL;
+    }
+    if(user_data->opa) {
+        lv_mem_free(user_data->opa);
+        user_data->opa = NULL;
+    }
+#if LV_IMG_CF_RLE
+    lv_img_decoder_built_in_rle_free(user_data);
+#endif
+
+    /*The decoded pixels are not compressed anymore*/
+    if(dsc->header.cf == LV_IMG_CF_TRUE_COLOR_RLE) dsc->header.cf = LV_IMG_CF_TRUE_COLOR;
+    else if(dsc->header.cf == LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED_RLE) dsc->header.cf = LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED;
+    else if(dsc->header.cf == LV_IMG_CF_TRUE_COLOR_ALPHA_RLE) dsc->header.cf = LV_IMG_CF_TRUE_COLOR_ALPHA;
+
+    user_data->ram_data = ram_data;
+    user_data->ram_size = ram_size;
+    ram_used += ram_size;
+
+    dsc->img_data = ram_data;
+    dsc->mem_size = ram_size;
+}
+
 static lv_res_t lv_img_decoder_built_in_line_true_color(lv_img_decoder_dsc_t * dsc, lv_coord_t x, lv_coord_t y,
-                                                        lv_coord_t len, uint8_t * buf)
+                                                        uint32_t len, uint8_t * buf)
 {
 #if LV_USE_FILESYSTEM
     lv_img_decoder_built_in_data_t * user_data = dsc->user_data;
@@ -552,6 +947,28 @@ static lv_res_t lv_img_decoder_built_in_line_true_color(lv_img_decoder_dsc_t * d
 #endif
 }
 
+static lv_res_t lv_img_decoder_built_in_area_true_color(lv_img_decoder_dsc_t * dsc, const lv_area_t * area,
+                                                        uint8_t * buf)
+{
+    lv_coord_t w = lv_area_get_width(area);
+
+    /*Whole lines follow each other in the file so read them with one seek and read*/
+    if(area->x1 == 0 && w == (lv_coord_t)dsc->header.w) {
+        uint32_t len = (uint32_t)w * lv_area_get_height(area);
+        return lv_img_decoder_built_in_line_true_color(dsc, 0, area->y1, len, buf);
+    }
+
+    uint32_t line_size = (uint32_t)w * (lv_img_color_format_get_px_size(dsc->header.cf) >> 3);
+    lv_coord_t y;
+    for(y = area->y1; y <= area->y2; y++) {
+        lv_res_t res = lv_img_decoder_built_in_line_true_color(dsc, area->x1, y, w, buf);
+        if(res != LV_RES_OK) return res;
+        buf += line_size;
+    }
+
+    return LV_RES_OK;
+}
+
 static lv_res_t lv_img_decoder_built_in_line_alpha(lv_img_decoder_dsc_t * dsc, lv_coord_t x, lv_coord_t y,
                                                    lv_coord_t len, uint8_t * buf)
 {
@@ -754,3 +1171,190 @@ static lv_res_t lv_img_decoder_built_in_line_indexed(lv_img_decoder_dsc_t * dsc,
     return LV_RES_INV;
 #endif
 }
+
+#if LV_IMG_CF_RLE
+/**
+ * Prepare a run-length compressed image for reading its rows.
+ * The image data starts with a table of `h + 1` little endian 32 bit offsets
+ * (relative to the beginning of the data) of the rows. The last offset is the end of the last row.
+ * @param dsc pointer to the decoder descriptor
+ * @return LV_RES_OK: ready to read the rows; LV_RES_INV: error
+ */
+static lv_res_t lv_img_decoder_built_in_rle_open(lv_img_decoder_dsc_t * dsc)
+{
+    if(dsc->user_data == NULL) {
+        dsc->user_data = lv_mem_alloc(sizeof(lv_img_decoder_built_in_data_t));
+        LV_ASSERT_MEM(dsc->user_data);
+        if(dsc->user_data == NULL) return LV_RES_INV;
+        memset(dsc->user_data, 0, sizeof(lv_img_decoder_built_in_data_t));
+    }
+
+    lv_img_decoder_built_in_data_t * user_data = dsc->user_data;
+
+    /*The rows of variables can be reached directly*/
+    if(dsc->src_type == LV_IMG_SRC_VARIABLE) {
+        user_data->rle_data = ((lv_img_dsc_t *)dsc->src)->data;
+        return LV_RES_OK;
+    }
+
+#if LV_USE_FILESYSTEM
+    /*Read the offset table of the file to seek to the rows quickly*/
+    uint32_t ofs_size  = ((uint32_t)dsc->header.h + 1) * sizeof(uint32_t);
+    user_data->rle_ofs = lv_mem_alloc(ofs_size);
+    LV_ASSERT_MEM(user_data->rle_ofs);
+    if(user_data->rle_ofs == NULL) return LV_RES_INV;
+
+    uint32_t br = 0;
+    lv_fs_seek(user_data->f, 4); /*Skip the header*/
+    lv_fs_res_t res = lv_fs_read(user_data->f, user_data->rle_ofs, ofs_size, &br);
+    if(res != LV_FS_RES_OK || br != ofs_size) {
+        LV_LOG_WARN("Built-in image decoder can't read the row offsets");
+        return LV_RES_INV;
+    }
+
+    /*Convert the offsets to the native byte order and find the longest row*/
+    uint32_t row_size_max = 0;
+    uint32_t i;
+    for(i = 0; i <= dsc->header.h; i++) {
+        user_data->rle_ofs[i] = rle_get_u32((uint8_t *)&user_data->rle_ofs[i]);
+        if(i > 0) {
+            if(user_data->rle_ofs[i] < user_data->rle_ofs[i - 1]) {
+                LV_LOG_WARN("Built-in image decoder: invalid row offsets");
+                return LV_RES_INV;
+            }
+            row_size_max = LV_MATH_MAX(row_size_max, user_data->rle_ofs[i] - user_data->rle_ofs[i - 1]);
+        }
+    }
+
+    user_data->rle_row = lv_mem_alloc(row_size_max > 0 ? row_size_max : 1);
+    LV_ASSERT_MEM(user_data->rle_row);
+    if(user_data->rle_row == NULL) return LV_RES_INV;
+
+    return LV_RES_OK;
+#else
+    LV_LOG_WARN("Image built-in decoder cannot read file because LV_USE_FILESYSTEM = 0");
+    return LV_RES_INV;
+#endif
+}
+
+/**
+ * Free the resources allocated to read a run-length compressed image
+ * @param user_data the decoder's data of an opened image
+ */
+static void lv_img_decoder_built_in_rle_free(lv_img_decoder_built_in_data_t * user_data)
+{
+    if(user_data->rle_ofs) {
+        lv_mem_free(user_data->rle_ofs);
+        user_data->rle_ofs = NULL;
+    }
+    if(user_data->rle_row) {
+        lv_mem_free(user_data->rle_row);
+        user_data->rle_row = NULL;
+    }
+    user_data->rle_data = NULL;
+}
+
+static lv_res_t lv_img_decoder_built_in_line_rle(lv_img_decoder_dsc_t * dsc, lv_coord_t x, lv_coord_t y,
+                                                 lv_coord_t len, uint8_t * buf)
+{
+    lv_img_decoder_built_in_data_t * user_data = dsc->user_data;
+    uint8_t px_size                            = lv_img_decoder_get_px_size(dsc);
+
+    /*Find the compressed row*/
+    const uint8_t * row;
+    const uint8_t * row_end;
+    if(user_data->rle_data) {
+        row     = &user_data->rle_data[rle_get_u32(&user_data->rle_data[y * sizeof(uint32_t)])];
+        row_end = &user_data->rle_data[rle_get_u32(&user_data->rle_data[(y + 1) * sizeof(uint32_t)])];
+    }
+#if LV_USE_FILESYSTEM
+    else if(user_data->rle_ofs) {
+        uint32_t row_size = user_data->rle_ofs[y + 1] - user_data->rle_ofs[y];
+        uint32_t br       = 0;
+        lv_fs_res_t res   = lv_fs_seek(user_data->f, 4 + user_data->rle_ofs[y]);
+        if(res == LV_FS_RES_OK) res = lv_fs_read(user_data->f, user_data->rle_row, row_size, &br);
+        if(res != LV_FS_RES_OK || br != row_size) {
+            LV_LOG_WARN("Built-in image decoder read failed");
+            return LV_RES_INV;
+        }
+        row     = user_data->rle_row;
+        row_end = &user_data->rle_row[row_size];
+    }
+#endif
+    else {
+        return LV_RES_INV;
+    }
+
+    lv_res_t res = rle_decode_row(row, row_end, px_size, x, len, buf);
+    if(res != LV_RES_OK) LV_LOG_WARN("Built-in image decoder: corrupted compressed row");
+
+    return res;
+}
+
+/**
+ * Decode a part of a run-length encoded row
+ * @param in pointer to the beginning of the compressed row
+ * @param in_end pointer after the last byte of the compressed row
+ * @param px_size size of a pixel in bytes
+ * @param x index of the first pixel to decode
+ * @param len number of pixels to decode
+ * @param buf store the pixels here
+ * @return LV_RES_OK: decoded; LV_RES_INV: the row has less pixels than required or it's corrupted
+ */
+static lv_res_t rle_decode_row(const uint8_t * in, const uint8_t * in_end, uint8_t px_size, lv_coord_t x,
+                               lv_coord_t len, uint8_t * buf)
+{
+    while(len > 0) {
+        if(in >= in_end) return LV_RES_INV;
+
+        uint8_t ctrl   = *in;
+        lv_coord_t cnt = (ctrl & RLE_CTRL_CNT_MASK) + 1;
+        bool run       = ctrl & RLE_CTRL_RUN ? true : false;
+        const uint8_t * data      = in + 1;
+        const uint8_t * chunk_end = data + (run ? px_size : (uint32_t)cnt * px_size);
+        if(chunk_end > in_end) return LV_RES_INV;
+        in = chunk_end;
+
+        /*Skip the chunks before `x`*/
+        if(x >= cnt) {
+            x -= cnt;
+            continue;
+        }
+
+        /*Use only the part of the chunk from `x`*/
+        cnt -= x;
+        if(!run) data += (uint32_t)x * px_size;
+        x = 0;
+        if(cnt > len) cnt = len;
+
+        uint32_t size = (uint32_t)cnt * px_size;
+        if(run) {
+            /*Copy the pixel once and double the copied pixels until the run is filled*/
+            memcpy(buf, data, px_size);
+            uint32_t filled = px_size;
+            while(filled < size) {
+                uint32_t copy = LV_MATH_MIN(filled, size - filled);
+                memcpy(&buf[filled], buf, copy);
+                filled += copy;
+            }
+        } else {
+            memcpy(buf, data, size);
+        }
+
+        buf += size;
+        len -= cnt;
+    }
+
+    return LV_RES_OK;
+}
+
+/**
+ * Read a little endian 32 bit number from any address
+ * @param p pointer to the first byte
+ * @return the number
+ */
+static inline uint32_t rle_get_u32(const uint8_t * p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+#endif /*LV_IMG_CF_RLE*/
@@ -94,9 +94,11 @@ enum {
     LV_IMG_CF_ALPHA_4BIT, /**< Can have one color but 16 different alpha value*/
     LV_IMG_CF_ALPHA_8BIT, /**< Can have one color but 256 different alpha value*/
 
-    LV_IMG_CF_RESERVED_15,              /**< Reserved for further use. */
-    LV_IMG_CF_RESERVED_16,              /**< Reserved for further use. */
-    LV_IMG_CF_RESERVED_17,              /**< Reserved for further use. */
+    LV_IMG_CF_TRUE_COLOR_RLE,              /**< `LV_IMG_CF_TRUE_COLOR` compressed row by row with run-length encoding*/
+    LV_IMG_CF_TRUE_COLOR_ALPHA_RLE,        /**< `LV_IMG_CF_TRUE_COLOR_ALPHA` compressed row by row with run-length
+                                              encoding*/
+    LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED_RLE, /**< `LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED` compressed row by row with
+                                              run-length encoding*/
     LV_IMG_CF_RESERVED_18,              /**< Reserved for further use. */
     LV_IMG_CF_RESERVED_19,              /**< Reserved for further use. */
     LV_IMG_CF_RESERVED_20,              /**< Reserved for further use. */
@@ -160,6 +162,20 @@ typedef lv_res_t (*lv_img_decoder_open_f_t)(struct _lv_img_decoder * decoder, st
 typedef lv_res_t (*lv_img_decoder_read_line_f_t)(struct _lv_img_decoder * decoder, struct _lv_img_decoder_dsc * dsc,
                                                  lv_coord_t x, lv_coord_t y, lv_coord_t len, uint8_t * buf);
 
+/**
+ * Decode the pixels of an area and store them in `buf` line by line.
+ * The lines are stored continuously, i.e. a line is `lv_area_get_width(area)` pixels long
+ * with the same pixel format `read_line` uses.
+ * Optional. If not set `read_line` is called for every line of the area.
+ * @param decoder pointer to the decoder the function associated with
+ * @param dsc pointer to decoder descriptor
+ * @param area the area to decode relative to the image's top left corner
+ * @param buf a buffer to store the decoded pixels
+ * @return LV_RES_OK: ok; LV_RES_INV: failed
+ */
+typedef lv_res_t (*lv_img_decoder_read_area_f_t)(struct _lv_img_decoder * decoder, struct _lv_img_decoder_dsc * dsc,
+                                                 const lv_area_t * area, uint8_t * buf);
+
 /**
  * Close the pending decoding. Free resources etc.
  * @param decoder pointer to the decoder the function associated with
@@ -172,6 +188,7 @@ typedef struct _lv_img_decoder
     lv_img_decoder_info_f_t info_cb;
     lv_img_decoder_open_f_t open_cb;
     lv_img_decoder_read_line_f_t read_line_cb;
+    lv_img_decoder_read_area_f_t read_area_cb;
     lv_img_decoder_close_f_t close_cb;
 
 #if LV_USE_USER_DATA
@@ -205,6 +222,10 @@ typedef struct _lv_img_decoder_dsc
      *  If not set `lv_img_cache` will measure and set the time to open*/
     uint32_t time_to_open;
 
+    /** RAM kept allocated while the image is open (e.g. for the decoded pixels) [bytes].
+     *  If not set `lv_img_cache` will estimate it from `img_data` and `header`*/
+    uint32_t mem_size;
+
     /**A text to display instead of the image when the image can't be opened.
      * Can be set in `open` function or set NULL. */
     const char * error_msg;
@@ -260,6 +281,37 @@ lv_res_t lv_img_decoder_open(lv_img_decoder_dsc_t * dsc, const void * src, const
 lv_res_t lv_img_decoder_read_line(lv_img_decoder_dsc_t * dsc, lv_coord_t x, lv_coord_t y, lv_coord_t len,
                                   uint8_t * buf);
 
+/**
+ * Read an area from an opened image.
+ * Uses the decoder's `read_area_cb` if set, else reads the area line by line with `read_line_cb`.
+ * @param dsc pointer to `lv_img_decoder_dsc_t` used in `lv_img_decoder_open`
+ * @param area the area to read relative to the image's top left corner
+ * @param buf store the data here. The lines are stored continuously.
+ *            Its size should be `lv_area_get_size(area) * lv_img_decoder_get_px_size(dsc)` bytes.
+ * @return LV_RES_OK: success; LV_RES_INV: an error occurred
+ */
+lv_res_t lv_img_decoder_read_area(lv_img_decoder_dsc_t * dsc, const lv_area_t * area, uint8_t * buf);
+
+/**
+ * Get the size of a pixel decoded by `lv_img_decoder_read_line/area`
+ * @param dsc pointer to `lv_img_decoder_dsc_t` used in `lv_img_decoder_open`
+ * @return size of a decoded pixel in bytes
+ */
+uint8_t lv_img_decoder_get_px_size(const lv_img_decoder_dsc_t * dsc);
+
+/**
+ * Get the not decoded indices or alpha values of an indexed or alpha only image to draw it directly
+ * with `lv_draw_map_indexed()` instead of decoding it line by line.
+ * Only the images opened by the built-in decoder from a variable are supported.
+ * @param dsc pointer to `lv_img_decoder_dsc_t` used in `lv_img_decoder_open`
+ * @param map store the pointer to the first row of the indices or alpha values here
+ * @param palette store the palette converted to `lv_color_t` here. NULL for alpha only images.
+ * @param palette_opa store the opacity of the palette's colors here. NULL for alpha only images.
+ * @return LV_RES_OK: the pointers are set; LV_RES_INV: the image needs to be decoded line by line
+ */
+lv_res_t lv_img_decoder_get_indexed_map(const lv_img_decoder_dsc_t * dsc, const uint8_t ** map,
+                                        const lv_color_t ** palette, const lv_opa_t ** palette_opa);
+
 /**
  * Close a decoding session
  * @param dsc pointer to `lv_img_decoder_dsc_t` used in `lv_img_decoder_open`
@@ -299,6 +351,14 @@ void lv_img_decoder_set_open_cb(lv_img_decoder_t * decoder, lv_img_decoder_open_
  */
 void lv_img_decoder_set_read_line_cb(lv_img_decoder_t * decoder, lv_img_decoder_read_line_f_t read_line_cb);
 
+/**
+ * Set a callback to decode an area of an image at once.
+ * Optional, but decoders working in blocks (e.g. tiles) should set it.
+ * @param decoder pointer to an image decoder
+ * @param read_area_cb a function to read an area of an image
+ */
+void lv_img_decoder_set_read_area_cb(lv_img_decoder_t * decoder, lv_img_decoder_read_area_f_t read_area_cb);
+
 /**
  * Set a callback to close a decoding session. E.g. close files and free other resources.
  * @param decoder pointer to an image decoder
@@ -308,6 +368,31 @@ void lv_img_decoder_set_close_cb(lv_img_decoder_t * decoder, lv_img_decoder_clos
 
 
 
+/**
+ * Enable or disable decoding an image source into the RAM when it's opened.
+ * Decoded images are drawn as quickly as true color images from the flash
+ * but they use `width * height * pixel size` bytes of RAM while they are open (e.g. in the image cache).
+ * Only true color files, indexed and compressed images are decoded by the built-in decoder.
+ * The RAM used by the decoded images is limited by `lv_img_decoder_set_ram_limit()`.
+ * @param src the image source: path to a file or pointer to an `lv_img_dsc_t` variable.
+ *            NULL to enable/disable decoding of every image.
+ * @param en true: decode to RAM; false: decode line by line while drawing
+ */
+void lv_img_decoder_set_decode_to_ram(const void * src, bool en);
+
+/**
+ * Set the max. RAM which can be used by the images decoded to RAM.
+ * Already decoded images are not closed if the new limit is less than the currently used RAM.
+ * @param limit the limit in bytes. 0: don't decode to RAM
+ */
+void lv_img_decoder_set_ram_limit(uint32_t limit);
+
+/**
+ * Get the RAM used by the images decoded to RAM
+ * @return the used RAM in bytes
+ */
+uint32_t lv_img_decoder_get_ram_used(void);
+
 /**
  * Get info about a built-in image
  * @param decoder the decoder where this function belongs
@@ -339,6 +424,18 @@ lv_res_t lv_img_decoder_built_in_open(lv_img_decoder_t * decoder, lv_img_decoder
 lv_res_t lv_img_decoder_built_in_read_line(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc, lv_coord_t x,
                                                   lv_coord_t y, lv_coord_t len, uint8_t * buf);
 
+/**
+ * Decode the pixels of an area and store them in `buf` line by line.
+ * Required only if the "open" function can't return with the whole decoded pixel array.
+ * @param decoder pointer to the decoder the function associated with
+ * @param dsc pointer to decoder descriptor
+ * @param area the area to decode relative to the image's top left corner
+ * @param buf a buffer to store the decoded pixels
+ * @return LV_RES_OK: ok; LV_RES_INV: failed
+ */
+lv_res_t lv_img_decoder_built_in_read_area(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc,
+                                           const lv_area_t * area, uint8_t * buf);
+
 /**
  * Close the pending decoding. Free resources etc.
  * @param decoder pointer to the decoder the function associated with
@@ -0,0 +1,609 @@
+/**
+ * @file lv_img_transform.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_img_transform.h"
+#include "lv_draw_img.h"
+#include <string.h>
+#include "../lv_misc/lv_math.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+/*Number of fractional bits of the source coordinates*/
+#define FP_SHIFT 16
+#define FP_ONE (1 << FP_SHIFT)
+#define FP_HALF (1 << (FP_SHIFT - 1))
+
+#define PX_SIZE LV_IMG_PX_SIZE_ALPHA_BYTE
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void get_sin_cos(int16_t angle, int32_t * sin_res, int32_t * cos_res);
+static int64_t div_floor(int64_t n, int32_t d);
+static void clip_span(int64_t a, int32_t s, int32_t lo, int32_t hi, int32_t * k1, int32_t * k2);
+static void row_nearest(const lv_img_transform_dsc_t * dsc, int32_t xs, int32_t ys, int32_t len, uint8_t * buf);
+static void row_bilinear(const lv_img_transform_dsc_t * dsc, int32_t xs, int32_t ys, int32_t len, uint8_t * buf);
+static void row_bilinear_edge(const lv_img_transform_dsc_t * dsc, int32_t xs, int32_t ys, int32_t len,
+                              uint8_t * buf);
+static void get_px(const lv_img_transform_dsc_t * dsc, int32_t x, int32_t y, lv_color_t * c, lv_opa_t * opa);
+static inline void px_set(uint8_t * buf, lv_color_t c, lv_opa_t opa);
+static inline lv_color_t px_get_color(const uint8_t * p);
+static inline void mix4(uint8_t * buf, lv_color_t c00, lv_opa_t o00, lv_color_t c10, lv_opa_t o10, lv_color_t c01,
+                        lv_opa_t o01, lv_color_t c11, lv_opa_t o11, lv_opa_t fx, lv_opa_t fy);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+/**
+ * Prepare a transformation descriptor for sampling
+ * @param dsc pointer to a descriptor with its `img`, `color`, `angle`, `zoom`, `pivot` and `antialias` fields set
+ */
+void lv_img_transform_init(lv_img_transform_dsc_t * dsc)
+{
+    int32_t sinma;
+    int32_t cosma;
+    get_sin_cos(dsc->angle, &sinma, &cosma);
+
+    /*The sampler goes from the destination to the source so divide by the zoom.
+     * `sinma` and `cosma` are upscaled by 2^15 and `zoom` by 2^8 so shift by 9 to get 2^16 upscaled steps*/
+    uint16_t zoom = dsc->zoom == 0 ? 1 : dsc->zoom;
+    dsc->cos_z    = (cosma << 9) / zoom;
+    dsc->sin_z    = (sinma << 9) / zoom;
+
+    dsc->chroma_keyed = lv_img_color_format_is_chroma_keyed(dsc->img->header.cf) ? 1 : 0;
+    dsc->chroma_key   = LV_COLOR_TRANSP;
+}
+
+/**
+ * Sample a row of the transformed image.
+ * The pixels are stored in `buf` with the `LV_IMG_CF_TRUE_COLOR_ALPHA` layout. (Color bytes and an alpha byte)
+ * The pixels outside of the transformed image are fully transparent.
+ * @param dsc pointer to an initialized transformation descriptor
+ * @param x start x coordinate of the row relative to the not transformed image's top left corner
+ * @param y y coordinate of the row relative to the not transformed image's top left corner
+ * @param len number of pixels to sample
+ * @param buf store the pixels here. Its size has to be at least `len * LV_IMG_PX_SIZE_ALPHA_BYTE` bytes
+ */
+void lv_img_transform_row(const lv_img_transform_dsc_t * dsc, lv_coord_t x, lv_coord_t y, lv_coord_t len,
+                          uint8_t * buf)
+{
+    if(len <= 0) return;
+
+    int32_t w  = dsc->img->header.w;
+    int32_t h  = dsc->img->header.h;
+    int32_t dx = dsc->cos_z;  /*Step in the source's x if the destination x is incremented*/
+    int32_t dy = -dsc->sin_z; /*Step in the source's y if the destination x is incremented*/
+
+    /*Source coordinates of the first pixel's center (the center is at +0.5).
+     * With small zoom the steps are large (up to 2^24) so far from the pivot they don't fit into 32 bit.
+     * The pixels on the image always fit so only the coordinates before the clipping are 64 bit.*/
+    int32_t xt   = x - dsc->pivot.x;
+    int32_t yt   = y - dsc->pivot.y;
+    int64_t xs64 = ((int64_t)dsc->pivot.x << FP_SHIFT) + (int64_t)xt * dsc->cos_z + (int64_t)yt * dsc->sin_z +
+                   ((dsc->cos_z + dsc->sin_z) >> 1);
+    int64_t ys64 = ((int64_t)dsc->pivot.y << FP_SHIFT) - (int64_t)xt * dsc->sin_z + (int64_t)yt * dsc->cos_z +
+                   ((dsc->cos_z - dsc->sin_z) >> 1);
+
+    /*Find the first and last pixels of the row which are on the image*/
+    int32_t k1 = 0;
+    int32_t k2 = len - 1;
+    if(dsc->antialias == 0) {
+        clip_span(xs64, dx, 0, w << FP_SHIFT, &k1, &k2);
+        clip_span(ys64, dy, 0, h << FP_SHIFT, &k1, &k2);
+    } else {
+        /*Get the top left pixel of the 4 pixels to mix.
+         * Pixels on the edge are mixed with transparent pixels from outside of the image*/
+        xs64 -= FP_HALF;
+        ys64 -= FP_HALF;
+        clip_span(xs64, dx, -FP_ONE, w << FP_SHIFT, &k1, &k2);
+        clip_span(ys64, dy, -FP_ONE, h << FP_SHIFT, &k1, &k2);
+    }
+
+    if(k1 > k2) {
+        memset(buf, 0x00, (uint32_t)len * PX_SIZE);
+        return;
+    }
+
+    /*Clear the pixels out of the image*/
+    if(k1 > 0) memset(buf, 0x00, (uint32_t)k1 * PX_SIZE);
+    if(k2 < len - 1) memset(&buf[(k2 + 1) * PX_SIZE], 0x00, (uint32_t)(len - 1 - k2) * PX_SIZE);
+
+    int32_t xs = (int32_t)(xs64 + (int64_t)k1 * dx);
+    int32_t ys = (int32_t)(ys64 + (int64_t)k1 * dy);
+    buf += k1 * PX_SIZE;
+    len = k2 - k1 + 1;
+
+    if(dsc->antialias == 0) {
+        row_nearest(dsc, xs, ys, len, buf);
+        return;
+    }
+
+    /*Use the fast sampler where all the 4 pixels are on the image and check the coordinates only on the edges*/
+    int32_t i1 = 0;
+    int32_t i2 = len - 1;
+    clip_span(xs, dx, 0, (w - 1) << FP_SHIFT, &i1, &i2);
+    clip_span(ys, dy, 0, (h - 1) << FP_SHIFT, &i1, &i2);
+
+    if(i1 > i2) {
+        row_bilinear_edge(dsc, xs, ys, len, buf);
+    } else {
+        row_bilinear_edge(dsc, xs, ys, i1, buf);
+        row_bilinear(dsc, xs + i1 * dx, ys + i1 * dy, i2 - i1 + 1, &buf[i1 * PX_SIZE]);
+        row_bilinear_edge(dsc, xs + (i2 + 1) * dx, ys + (i2 + 1) * dy, len - 1 - i2, &buf[(i2 + 1) * PX_SIZE]);
+    }
+}
+
+/**
+ * Get the area covered by a transformed image
+ * @param res store the area here. Relative to the not transformed image's top left corner.
+ * @param w width of the image
+ * @param h height of the image
+ * @param angle rotation angle clockwise [0.1 degree]
+ * @param zoom zoom factor: 256 (LV_IMG_ZOOM_NONE): no zoom
+ * @param pivot rotate and zoom around this point of the image
+ */
+void lv_img_transform_get_area(lv_area_t * res, lv_coord_t w, lv_coord_t h, int16_t angle, uint16_t zoom,
+                               const lv_point_t * pivot)
+{
+    if(angle == 0 && zoom == LV_IMG_ZOOM_NONE) {
+        lv_area_set(res, 0, 0, w - 1, h - 1);
+        return;
+    }
+
+    int32_t sinma;
+    int32_t cosma;
+    get_sin_cos(angle, &sinma, &cosma);
+
+    /*Transform the corners of the image around the pivot*/
+    const int32_t xc[4] = {-pivot->x, w - pivot->x, -pivot->x, w - pivot->x};
+    const int32_t yc[4] = {-pivot->y, -pivot->y, h - pivot->y, h - pivot->y};
+    int32_t x_min = INT32_MAX;
+    int32_t x_max = INT32_MIN;
+    int32_t y_min = INT32_MAX;
+    int32_t y_max = INT32_MIN;
+    uint8_t i;
+    for(i = 0; i < 4; i++) {
+        /*Rotate and get the result upscaled by 2^8*/
+        int32_t xr = (xc[i] * cosma - yc[i] * sinma) >> 7;
+        int32_t yr = (xc[i] * sinma + yc[i] * cosma) >> 7;
+
+        /*Zoom (2^8 upscaled) in two steps to avoid overflow*/
+        xr = (xr >> 8) * zoom + (((xr & 0xFF) * zoom) >> 8);
+        yr = (yr >> 8) * zoom + (((yr & 0xFF) * zoom) >> 8);
+
+        x_min = LV_MATH_MIN(x_min, xr);
+        x_max = LV_MATH_MAX(x_max, xr);
+        y_min = LV_MATH_MIN(y_min, yr);
+        y_max = LV_MATH_MAX(y_max, yr);
+    }
+
+    /*Add a little extra space for the rounding and the anti-aliased edges*/
+    lv_coord_t extra = 1 + (zoom >> 9);
+    res->x1          = pivot->x + (x_min >> 8) - extra;
+    res->x2          = pivot->x + ((x_max + 0xFF) >> 8) - 1 + extra;
+    res->y1          = pivot->y + (y_min >> 8) - extra;
+    res->y2          = pivot->y + ((y_max + 0xFF) >> 8) - 1 + extra;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Get the sine and cosine of an angle with 0.1 degree resolution
+ * @param angle the angle [0.1 degree]
+ * @param sin_res store the sine here (upscaled by 2^15)
+ * @param cos_res store the cosine here (upscaled by 2^15)
+ */
+static void get_sin_cos(int16_t angle, int32_t * sin_res, int32_t * cos_res)
+{
+    angle = angle % 3600;
+    if(angle < 0) angle += 3600;
+
+    /*Interpolate between the whole degrees*/
+    int16_t deg = angle / 10;
+    int32_t rem = angle % 10;
+    int32_t s0  = lv_trigo_sin(deg);
+    int32_t s1  = lv_trigo_sin(deg + 1);
+    int32_t c0  = lv_trigo_sin(deg + 90);
+    int32_t c1  = lv_trigo_sin(deg + 91);
+
+    *sin_res = s0 + ((s1 - s0) * rem) / 10;
+    *cos_res = c0 + ((c1 - c0) * rem) / 10;
+
+    /*Make the right angles exact to keep not rotated (but e.g. zoomed) images sharp*/
+    if(*sin_res == LV_TRIGO_SIN_MAX) *sin_res = 1 << LV_TRIGO_SHIFT;
+    else if(*sin_res == -LV_TRIGO_SIN_MAX) *sin_res = -(1 << LV_TRIGO_SHIFT);
+    if(*cos_res == LV_TRIGO_SIN_MAX) *cos_res = 1 << LV_TRIGO_SHIFT;
+    else if(*cos_res == -LV_TRIGO_SIN_MAX) *cos_res = -(1 << LV_TRIGO_SHIFT);
+}
+
+/**
+ * Divide and round towards minus infinity
+ * @param n numerator
+ * @param d denominator, must be > 0
+ * @return floor(n / d)
+ */
+static int64_t div_floor(int64_t n, int32_t d)
+{
+    int64_t q = n / d;
+    if((n % d != 0) && (n < 0)) q--;
+    return q;
+}
+
+/**
+ * Narrow the `[k1, k2]` range to the `k` values where `lo <= a + k * s < hi`
+ * @param a start value
+ * @param s step
+ * @param lo the lowest allowed value
+ * @param hi the first not allowed value above `lo`
+ * @param k1 first index of the range
+ * @param k2 last index of the range
+ */
+static void clip_span(int64_t a, int32_t s, int32_t lo, int32_t hi, int32_t * k1, int32_t * k2)
+{
+    int64_t k_min;
+    int64_t k_max;
+    if(s == 0) {
+        if(a >= lo && a < hi) return;
+        k_min = 1;
+        k_max = 0;
+    } else if(s > 0) {
+        k_min = -div_floor(a - lo, s);       /*ceil((lo - a) / s)*/
+        k_max = -div_floor(a - hi, s) - 1;   /*ceil((hi - a) / s) - 1*/
+    } else {
+        k_min = div_floor(a - hi, -s) + 1;
+        k_max = div_floor(a - lo, -s);
+    }
+
+    /*Clamp before narrowing to 32 bit: out of `[k1, k2]` only an empty range matters*/
+    if(k_min > *k1) *k1 = k_min > *k2 ? *k2 + 1 : (int32_t)k_min;
+    if(k_max < *k2) *k2 = k_max < *k1 ? *k1 - 1 : (int32_t)k_max;
+}
+
+/**
+ * Sample pixels without filtering. All the pixels have to be on the image.
+ * @param dsc pointer to a transformation descriptor
+ * @param xs x coordinate of the first pixel on the source [1/65536 px]
+ * @param ys y coordinate of the first pixel on the source [1/65536 px]
+ * @param len number of pixels to sample
+ * @param buf store the pixels here
+ */
+static void row_nearest(const lv_img_transform_dsc_t * dsc, int32_t xs, int32_t ys, int32_t len, uint8_t * buf)
+{
+    const lv_img_dsc_t * img = dsc->img;
+    int32_t w                = img->header.w;
+    int32_t dx               = dsc->cos_z;
+    int32_t dy               = -dsc->sin_z;
+    int32_t i;
+
+    switch(img->header.cf) {
+        case LV_IMG_CF_TRUE_COLOR:
+        case LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED: {
+            const lv_color_t * src = (const lv_color_t *)img->data;
+            if(dsc->chroma_keyed == 0) {
+                for(i = 0; i < len; i++) {
+                    px_set(buf, src[(ys >> FP_SHIFT) * w + (xs >> FP_SHIFT)], LV_OPA_COVER);
+                    xs += dx;
+                    ys += dy;
+                    buf += PX_SIZE;
+                }
+            } else {
+                for(i = 0; i < len; i++) {
+                    lv_color_t c = src[(ys >> FP_SHIFT) * w + (xs >> FP_SHIFT)];
+                    px_set(buf, c, c.full == dsc->chroma_key.full ? LV_OPA_TRANSP : LV_OPA_COVER);
+                    xs += dx;
+                    ys += dy;
+                    buf += PX_SIZE;
+                }
+            }
+            break;
+        }
+        case LV_IMG_CF_TRUE_COLOR_ALPHA: {
+            const uint8_t * src = img->data;
+            for(i = 0; i < len; i++) {
+                memcpy(buf, &src[((ys >> FP_SHIFT) * w + (xs >> FP_SHIFT)) * PX_SIZE], PX_SIZE);
+                xs += dx;
+                ys += dy;
+                buf += PX_SIZE;
+            }
+            break;
+        }
+        case LV_IMG_CF_ALPHA_8BIT: {
+            const uint8_t * src = img->data;
+            for(i = 0; i < len; i++) {
+                px_set(buf, dsc->color, src[(ys >> FP_SHIFT) * w + (xs >> FP_SHIFT)]);
+                xs += dx;
+                ys += dy;
+                buf += PX_SIZE;
+            }
+            break;
+        }
+        default: {
+            lv_color_t c;
+            lv_opa_t opa;
+            for(i = 0; i < len; i++) {
+                get_px(dsc, xs >> FP_SHIFT, ys >> FP_SHIFT, &c, &opa);
+                px_set(buf, c, opa);
+                xs += dx;
+                ys += dy;
+                buf += PX_SIZE;
+            }
+            break;
+        }
+    }
+}
+
+/**
+ * Sample pixels with bilinear filtering. All the 4 pixels to mix have to be on the image.
+ * @param dsc pointer to a transformation descriptor
+ * @param xs x coordinate of the top left pixel to mix on the source [1/65536 px]
+ * @param ys y coordinate of the top left pixel to mix on the source [1/65536 px]
+ * @param len number of pixels to sample
+ * @param buf store the pixels here
+ */
+static void row_bilinear(const lv_img_transform_dsc_t * dsc, int32_t xs, int32_t ys, int32_t len, uint8_t * buf)
+{
+    const lv_img_dsc_t * img = dsc->img;
+    int32_t w                = img->header.w;
+    int32_t dx               = dsc->cos_z;
+    int32_t dy               = -dsc->sin_z;
+    int32_t i;
+
+    if(img->header.cf == LV_IMG_CF_TRUE_COLOR && dsc->chroma_keyed == 0) {
+        const lv_color_t * src = (const lv_color_t *)img->data;
+        for(i = 0; i < len; i++) {
+            const lv_color_t * p = &src[(ys >> FP_SHIFT) * w + (xs >> FP_SHIFT)];
+            lv_opa_t fx          = (xs >> (FP_SHIFT - 8)) & 0xFF;
+            lv_opa_t fy          = (ys >> (FP_SHIFT - 8)) & 0xFF;
+            lv_color_t top       = lv_color_mix(p[1], p[0], fx);
+            lv_color_t bottom    = lv_color_mix(p[w + 1], p[w], fx);
+            px_set(buf, lv_color_mix(bottom, top, fy), LV_OPA_COVER);
+            xs += dx;
+            ys += dy;
+            buf += PX_SIZE;
+        }
+    } else if(img->header.cf == LV_IMG_CF_TRUE_COLOR_ALPHA) {
+        const uint8_t * src = img->data;
+        uint32_t stride     = (uint32_t)w * PX_SIZE;
+        for(i = 0; i < len; i++) {
+            const uint8_t * p = &src[((ys >> FP_SHIFT) * w + (xs >> FP_SHIFT)) * PX_SIZE];
+            lv_opa_t fx       = (xs >> (FP_SHIFT - 8)) & 0xFF;
+            lv_opa_t fy       = (ys >> (FP_SHIFT - 8)) & 0xFF;
+            mix4(buf, px_get_color(p), p[PX_SIZE - 1], px_get_color(p + PX_SIZE), p[2 * PX_SIZE - 1],
+                 px_get_color(p + stride), p[stride + PX_SIZE - 1], px_get_color(p + stride + PX_SIZE),
+                 p[stride + 2 * PX_SIZE - 1], fx, fy);
+            xs += dx;
+            ys += dy;
+            buf += PX_SIZE;
+        }
+    } else if(img->header.cf == LV_IMG_CF_ALPHA_8BIT) {
+        const uint8_t * src = img->data;
+        for(i = 0; i < len; i++) {
+            const uint8_t * p = &src[(ys >> FP_SHIFT) * w + (xs >> FP_SHIFT)];
+            uint16_t fx       = (xs >> (FP_SHIFT - 8)) & 0xFF;
+            uint16_t fy       = (ys >> (FP_SHIFT - 8)) & 0xFF;
+            uint16_t top      = (p[0] * (256 - fx) + p[1] * fx) >> 8;
+            uint16_t bottom   = (p[w] * (256 - fx) + p[w + 1] * fx) >> 8;
+            px_set(buf, dsc->color, (top * (256 - fy) + bottom * fy) >> 8);
+            xs += dx;
+            ys += dy;
+            buf += PX_SIZE;
+        }
+    } else {
+        lv_color_t c00, c10, c01, c11;
+        lv_opa_t o00, o10, o01, o11;
+        for(i = 0; i < len; i++) {
+            int32_t x = xs >> FP_SHIFT;
+            int32_t y = ys >> FP_SHIFT;
+            get_px(dsc, x, y, &c00, &o00);
+            get_px(dsc, x + 1, y, &c10, &o10);
+            get_px(dsc, x, y + 1, &c01, &o01);
+            get_px(dsc, x + 1, y + 1, &c11, &o11);
+            mix4(buf, c00, o00, c10, o10, c01, o01, c11, o11, (xs >> (FP_SHIFT - 8)) & 0xFF,
+                 (ys >> (FP_SHIFT - 8)) & 0xFF);
+            xs += dx;
+            ys += dy;
+            buf += PX_SIZE;
+        }
+    }
+}
+
+/**
+ * Sample pixels with bilinear filtering on the edges of the image.
+ * The pixels to mix out of the image are considered transparent.
+ * @param dsc pointer to a transformation descriptor
+ * @param xs x coordinate of the top left pixel to mix on the source [1/65536 px]
+ * @param ys y coordinate of the top left pixel to mix on the source [1/65536 px]
+ * @param len number of pixels to sample
+ * @param buf store the pixels here
+ */
+static void row_bilinear_edge(const lv_img_transform_dsc_t * dsc, int32_t xs, int32_t ys, int32_t len,
+                              uint8_t * buf)
+{
+    lv_color_t c00, c10, c01, c11;
+    lv_opa_t o00, o10, o01, o11;
+    int32_t i;
+    for(i = 0; i < len; i++) {
+        int32_t x = xs >> FP_SHIFT;
+        int32_t y = ys >> FP_SHIFT;
+        get_px(dsc, x, y, &c00, &o00);
+        get_px(dsc, x + 1, y, &c10, &o10);
+        get_px(dsc, x, y + 1, &c01, &o01);
+        get_px(dsc, x + 1, y + 1, &c11, &o11);
+        mix4(buf, c00, o00, c10, o10, c01, o01, c11, o11, (xs >> (FP_SHIFT - 8)) & 0xFF,
+             (ys >> (FP_SHIFT - 8)) & 0xFF);
+        xs += dsc->cos_z;
+        ys -= dsc->sin_z;
+        buf += PX_SIZE;
+    }
+}
+
+/**
+ * Get the color and opacity of a pixel of any color format
+ * @param dsc pointer to a transformation descriptor
+ * @param x x coordinate of the pixel. Can be out of the image.
+ * @param y y coordinate of the pixel. Can be out of the image.
+ * @param c store the color here
+ * @param opa store the opacity here. `LV_OPA_TRANSP` if the pixel is out of the image
+ */
+static void get_px(const lv_img_transform_dsc_t * dsc, int32_t x, int32_t y, lv_color_t * c, lv_opa_t * opa)
+{
+    const lv_img_dsc_t * img = dsc->img;
+    int32_t w                = img->header.w;
+
+    if(x < 0 || y < 0 || x >= w || y >= (int32_t)img->header.h) {
+        c->full = 0;
+        *opa    = LV_OPA_TRANSP;
+        return;
+    }
+
+    const uint8_t * data = img->data;
+    lv_img_cf_t cf       = img->header.cf;
+    switch(cf) {
+        case LV_IMG_CF_TRUE_COLOR:
+        case LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED:
+            *c   = ((const lv_color_t *)data)[y * w + x];
+            *opa = LV_OPA_COVER;
+            break;
+        case LV_IMG_CF_TRUE_COLOR_ALPHA: {
+            const uint8_t * p = &data[(y * w + x) * PX_SIZE];
+            *c                = px_get_color(p);
+            *opa              = p[PX_SIZE - 1];
+            break;
+        }
+        case LV_IMG_CF_ALPHA_1BIT:
+        case LV_IMG_CF_ALPHA_2BIT:
+        case LV_IMG_CF_ALPHA_4BIT:
+        case LV_IMG_CF_ALPHA_8BIT:
+        case LV_IMG_CF_INDEXED_1BIT:
+        case LV_IMG_CF_INDEXED_2BIT:
+        case LV_IMG_CF_INDEXED_4BIT:
+        case LV_IMG_CF_INDEXED_8BIT: {
+            uint8_t bpp  = lv_img_color_format_get_px_size(cf);
+            uint8_t mask = (1 << bpp) - 1;
+            bool indexed = cf >= LV_IMG_CF_INDEXED_1BIT && cf <= LV_IMG_CF_INDEXED_8BIT;
+
+            /*The lines are byte aligned. The indexed images start with the palette.*/
+            const uint8_t * px_data = indexed ? &data[sizeof(lv_color32_t) << bpp] : data;
+            uint32_t stride         = ((uint32_t)w * bpp + 7) >> 3;
+            uint32_t bit            = (uint32_t)x * bpp;
+            uint8_t shift           = 8 - bpp - (bit & 0x7);
+            uint8_t val             = (px_data[y * stride + (bit >> 3)] >> shift) & mask;
+
+            if(indexed) {
+                const lv_color32_t * palette = (const lv_color32_t *)data;
+                *c   = lv_color_make(palette[val].ch.red, palette[val].ch.green, palette[val].ch.blue);
+                *opa = palette[val].ch.alpha;
+            } else {
+                *c   = dsc->color;
+                *opa = (uint16_t)((uint16_t)val * 255) / mask;
+            }
+            break;
+        }
+        default:
+            c->full = 0;
+            *opa    = LV_OPA_TRANSP;
+            return;
+    }
+
+    if(dsc->chroma_keyed && c->full == dsc->chroma_key.full) *opa = LV_OPA_TRANSP;
+}
+
+/**
+ * Store a pixel with the `LV_IMG_CF_TRUE_COLOR_ALPHA` layout
+ * @param buf store the pixel here
+ * @param c color of the pixel
+ * @param opa opacity of the pixel
+ */
+static inline void px_set(uint8_t * buf, lv_color_t c, lv_opa_t opa)
+{
+#if LV_COLOR_DEPTH == 8 || LV_COLOR_DEPTH == 1
+    buf[0] = c.full;
+#elif LV_COLOR_DEPTH == 16
+    /*Because of Alpha byte 16 bit color can start on odd address which can cause crash*/
+    buf[0] = c.full & 0xFF;
+    buf[1] = (c.full >> 8) & 0xFF;
+#elif LV_COLOR_DEPTH == 32
+    *((uint32_t *)buf) = c.full;
+#else
+#error "Invalid LV_COLOR_DEPTH. Check it in lv_conf.h"
+#endif
+    buf[PX_SIZE - 1] = opa;
+}
+
+/**
+ * Get the color of a pixel stored with the `LV_IMG_CF_TRUE_COLOR_ALPHA` layout
+ * @param p pointer to the pixel
+ * @return the color of the pixel
+ */
+static inline lv_color_t px_get_color(const uint8_t * p)
+{
+    lv_color_t c;
+#if LV_COLOR_DEPTH == 8 || LV_COLOR_DEPTH == 1
+    c.full = p[0];
+#elif LV_COLOR_DEPTH == 16
+    c.full = p[0] | (p[1] << 8);
+#elif LV_COLOR_DEPTH == 32
+    c.full = *((const uint32_t *)p);
+#endif
+    return c;
+}
+
+/**
+ * Mix 4 neighbouring pixels and store the result
+ * @param buf store the result pixel here
+ * @param c00 color of the top left pixel
+ * @param o00 opacity of the top left pixel
+ * @param c10 color of the top right pixel
+ * @param o10 opacity of the top right pixel
+ * @param c01 color of the bottom left pixel
+ * @param o01 opacity of the bottom left pixel
+ * @param c11 color of the bottom right pixel
+ * @param o11 opacity of the bottom right pixel
+ * @param fx weight of the right pixels [0..255]
+ * @param fy weight of the bottom pixels [0..255]
+ */
+static inline void mix4(uint8_t * buf, lv_color_t c00, lv_opa_t o00, lv_color_t c10, lv_opa_t o10, lv_color_t c01,
+                        lv_opa_t o01, lv_color_t c11, lv_opa_t o11, lv_opa_t fx, lv_opa_t fy)
+{
+    /*Don't let the color of the transparent pixels to bleed into the result*/
+    lv_color_t top;
+    if(o10 == LV_OPA_TRANSP) top = c00;
+    else if(o00 == LV_OPA_TRANSP) top = c10;
+    else top = lv_color_mix(c10, c00, fx);
+
+    lv_color_t bottom;
+    if(o11 == LV_OPA_TRANSP) bottom = c01;
+    else if(o01 == LV_OPA_TRANSP) bottom = c11;
+    else bottom = lv_color_mix(c11, c01, fx);
+
+    uint16_t top_opa    = (o00 * (256 - fx) + o10 * fx) >> 8;
+    uint16_t bottom_opa = (o01 * (256 - fx) + o11 * fx) >> 8;
+
+    lv_color_t c;
+    if(bottom_opa == LV_OPA_TRANSP) c = top;
+    else if(top_opa == LV_OPA_TRANSP) c = bottom;
+    else c = lv_color_mix(bottom, top, fy);
+
+    px_set(buf, c, (top_opa * (256 - fy) + bottom_opa * fy) >> 8);
+}
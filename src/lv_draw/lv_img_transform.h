@@ -0,0 +1,92 @@
+/**
+ * @file lv_img_transform.h
+ *
+ */
+
+#ifndef LV_IMG_TRANSFORM_H
+#define LV_IMG_TRANSFORM_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_img_decoder.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+/*Zoom factor of the original size*/
+#define LV_IMG_ZOOM_NONE 256
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**
+ * Describe how to rotate and zoom an image.
+ * The transformed image is sampled row by row in fixed point, so it can be drawn in real-time.
+ */
+typedef struct
+{
+    /*Set these before `lv_img_transform_init()`*/
+    const lv_img_dsc_t * img; /**< The source image. Its pixels need to be in the memory*/
+    lv_color_t color;         /**< Color of `LV_IMG_CF_ALPHA_...` images*/
+    int16_t angle;            /**< Rotation angle clockwise [0.1 degree]*/
+    uint16_t zoom;            /**< Zoom factor: 256 (LV_IMG_ZOOM_NONE): no zoom, 128: half size, 512: double size*/
+    lv_point_t pivot;         /**< Rotate and zoom around this point of the image*/
+    uint8_t antialias : 1;    /**< 1: bilinear filtering; 0: nearest neighbour*/
+
+    /*Calculated by `lv_img_transform_init()`*/
+    uint8_t chroma_keyed : 1; /**< 1: the `chroma_key` colored pixels are transparent*/
+    lv_color_t chroma_key;    /**< LV_COLOR_TRANSP by default. Can be changed after `lv_img_transform_init()`*/
+    int32_t cos_z;            /**< cos(angle) / zoom: the step in the source when moving in the destination [1/65536 px]*/
+    int32_t sin_z;            /**< sin(angle) / zoom: the step in the source when moving in the destination [1/65536 px]*/
+} lv_img_transform_dsc_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Prepare a transformation descriptor for sampling
+ * @param dsc pointer to a descriptor with its `img`, `color`, `angle`, `zoom`, `pivot` and `antialias` fields set
+ */
+void lv_img_transform_init(lv_img_transform_dsc_t * dsc);
+
+/**
+ * Sample a row of the transformed image.
+ * The pixels are stored in `buf` with the `LV_IMG_CF_TRUE_COLOR_ALPHA` layout. (Color bytes and an alpha byte)
+ * The pixels outside of the transformed image are fully transparent.
+ * @param dsc pointer to an initialized transformation descriptor
+ * @param x start x coordinate of the row relative to the not transformed image's top left corner
+ * @param y y coordinate of the row relative to the not transformed image's top left corner
+ * @param len number of pixels to sample
+ * @param buf store the pixels here. Its size has to be at least `len * LV_IMG_PX_SIZE_ALPHA_BYTE` bytes
+ */
+void lv_img_transform_row(const lv_img_transform_dsc_t * dsc, lv_coord_t x, lv_coord_t y, lv_coord_t len,
+                          uint8_t * buf);
+
+/**
+ * Get the area covered by a transformed image
+ * @param res store the area here. Relative to the not transformed image's top left corner.
+ * @param w width of the image
+ * @param h height of the image
+ * @param angle rotation angle clockwise [0.1 degree]
+ * @param zoom zoom factor: 256 (LV_IMG_ZOOM_NONE): no zoom
+ * @param pivot rotate and zoom around this point of the image
+ */
+void lv_img_transform_get_area(lv_area_t * res, lv_coord_t w, lv_coord_t h, int16_t angle, uint16_t zoom,
+                               const lv_point_t * pivot);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /*LV_IMG_TRANSFORM_H*/
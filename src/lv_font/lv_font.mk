@@ -1,5 +1,6 @@
 CSRCS += lv_font.c
 CSRCS += lv_font_fmt_txt.c
+CSRCS += lv_font_loader.c
 CSRCS += lv_font_roboto_12.c
 CSRCS += lv_font_roboto_16.c
 CSRCS += lv_font_roboto_22.c
@@ -155,6 +155,30 @@ bool lv_font_get_glyph_dsc_fmt_txt(const lv_font_t * font, lv_font_glyph_dsc_t *
     return true;
 }
 
+/**
+ * Get the index of a glyph in the `glyph_dsc` array of a font in LittelvGL's native font format.
+ * @param font pointer to font
+ * @param unicode_letter an UNICODE letter code
+ * @return index of the glyph or 0 if the letter was not found
+ */
+uint32_t lv_font_get_glyph_id_fmt_txt(const lv_font_t * font, uint32_t unicode_letter)
+{
+    return get_glyph_dsc_id(font, unicode_letter);
+}
+
+/**
+ * Decompress a glyph's bitmap compressed with RLE and XOR prefilter (`LV_FONT_FMT_TXT_COMPRESSED`)
+ * @param in the compressed bitmap
+ * @param out buffer to store the result. (`w * h` pixels with `bpp` bit-per-pixel)
+ * @param w width of the glyph
+ * @param h height of the glyph
+ * @param bpp bit per pixel (bpp = 3 will be converted to bpp = 4)
+ */
+void lv_font_decompress_fmt_txt(const uint8_t * in, uint8_t * out, lv_coord_t w, lv_coord_t h, uint8_t bpp)
+{
+    decompress(in, out, w, h, bpp);
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -197,7 +221,7 @@ static uint32_t get_glyph_dsc_id(const lv_font_t * font, uint32_t letter)
             if(p) {
                 lv_uintptr_t ofs = (lv_uintptr_t)(p - (uint8_t*) fdsc->cmaps[i].unicode_list);
                 ofs = ofs >> 1;     /*The list stores `uint16_t` so the get the index divide by 2*/
-                const uint8_t * gid_ofs_16 = fdsc->cmaps[i].glyph_id_ofs_list;
+                const uint16_t * gid_ofs_16 = fdsc->cmaps[i].glyph_id_ofs_list;
                 glyph_id = fdsc->cmaps[i].glyph_id_start + gid_ofs_16[ofs];
             }
         }
@@ -220,6 +220,24 @@ const uint8_t * lv_font_get_bitmap_fmt_txt(const lv_font_t * font, uint32_t lett
  */
 bool lv_font_get_glyph_dsc_fmt_txt(const lv_font_t * font, lv_font_glyph_dsc_t * dsc_out, uint32_t unicode_letter, uint32_t unicode_letter_next);
 
+/**
+ * Get the index of a glyph in the `glyph_dsc` array of a font in LittelvGL's native font format.
+ * @param font pointer to font
+ * @param unicode_letter an UNICODE letter code
+ * @return index of the glyph or 0 if the letter was not found
+ */
+uint32_t lv_font_get_glyph_id_fmt_txt(const lv_font_t * font, uint32_t unicode_letter);
+
+/**
+ * Decompress a glyph's bitmap compressed with RLE and XOR prefilter (`LV_FONT_FMT_TXT_COMPRESSED`)
+ * @param in the compressed bitmap
+ * @param out buffer to store the result. (`w * h` pixels with `bpp` bit-per-pixel)
+ * @param w width of the glyph
+ * @param h height of the glyph
+ * @param bpp bit per pixel (bpp = 3 will be converted to bpp = 4)
+ */
+void lv_font_decompress_fmt_txt(const uint8_t * in, uint8_t * out, lv_coord_t w, lv_coord_t h, uint8_t bpp);
+
 /**********************
  *      MACROS
  **********************/
@@ -0,0 +1,983 @@
+/**
+ * @file lv_font_loader.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_font_loader.h"
+#if LV_USE_FONT_LOADER
+
+#include <string.h>
+#include "lv_font_fmt_txt.h"
+#include "../lv_core/lv_debug.h"
+#include "../lv_misc/lv_fs.h"
+#include "../lv_misc/lv_mem.h"
+#include "../lv_misc/lv_log.h"
+
+#if LV_FONT_LOADER_MMAP
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+/*********************
+ *      DEFINES
+ *********************/
+#if LV_FONT_LOADER_CACHE_SLOTS < 1 || (LV_FONT_LOADER_CACHE_SLOTS & (LV_FONT_LOADER_CACHE_SLOTS - 1)) != 0
+#error "LV_FONT_LOADER_CACHE_SLOTS must be a power of 2. See lv_conf.h"
+#endif
+
+/*Every table starts with its size (4 bytes) and its tag (4 bytes)*/
+#define TABLE_HEADER_SIZE   8
+
+/*Size of the `head` table's fields used by the loader (without the table header)*/
+#define HEAD_SIZE           36
+
+/*Size of a sub-table descriptor in the `cmap` table*/
+#define CMAP_SUBTABLE_SIZE  16
+
+/*The compression methods of the glyph bitmaps in the file*/
+#define COMPRESSION_NONE        0
+#define COMPRESSION_RLE_XOR     1
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/*Character map formats as they are stored in the file*/
+enum {
+    BIN_CMAP_FORMAT0_FULL = 0,
+    BIN_CMAP_SPARSE_FULL,
+    BIN_CMAP_FORMAT0_TINY,
+    BIN_CMAP_SPARSE_TINY,
+};
+
+/*A slot of the glyph bitmap cache*/
+typedef struct
+{
+    uint8_t * buf;
+    uint32_t buf_size;
+    uint32_t glyph_id; /*0: the slot is empty*/
+} glyph_slot_t;
+
+typedef struct
+{
+    /*It must be the first field because the `lv_font_fmt_txt` functions see the descriptor as
+     * `lv_font_fmt_txt_dsc_t`*/
+    lv_font_fmt_txt_dsc_t fmt_dsc;
+
+#if LV_USE_FILESYSTEM
+    lv_fs_file_t file;
+    uint8_t file_opened : 1;
+#endif
+    const uint8_t * map; /*Start of the memory mapped file or NULL if read with `lv_fs`*/
+    uint32_t map_size;
+    uint32_t file_size; /*Size of the font file. UINT32_MAX if the file system can't tell it*/
+
+    uint32_t * glyph_pos; /*File position of the glyphs. (+1 element to know the size of the last glyph too)*/
+    uint32_t glyph_cnt;
+
+    uint8_t * raw_buf; /*Store the raw data of a glyph read from the file*/
+    uint32_t raw_buf_size;
+
+    uint8_t hdr_bits; /*Number of bits before the bitmap in every glyph's data*/
+    uint8_t compressed : 1;
+
+    glyph_slot_t cache[LV_FONT_LOADER_CACHE_SLOTS];
+} font_loader_dsc_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static lv_font_t * font_create(void);
+static bool load_font(lv_font_t * font);
+static uint32_t load_head(lv_font_t * font, uint8_t * head);
+static uint32_t load_cmaps(font_loader_dsc_t * ldsc, uint32_t pos);
+static uint32_t load_loca(font_loader_dsc_t * ldsc, uint32_t pos, uint8_t loca_format);
+static uint32_t load_glyphs(font_loader_dsc_t * ldsc, uint32_t pos, const uint8_t * head);
+static bool check_glyph_ids(font_loader_dsc_t * ldsc);
+static uint32_t load_kern(font_loader_dsc_t * ldsc, uint32_t pos, uint8_t glyph_id_format);
+static const uint8_t * get_glyph_bitmap(const lv_font_t * font, uint32_t unicode_letter);
+static uint8_t * raw_buf_reserve(font_loader_dsc_t * ldsc, uint32_t size);
+static bool font_read(font_loader_dsc_t * ldsc, uint32_t pos, void * buf, uint32_t len);
+static bool font_read_u16_array(font_loader_dsc_t * ldsc, uint32_t pos, uint16_t * buf, uint32_t cnt);
+static uint32_t read_table_header(font_loader_dsc_t * ldsc, uint32_t pos, const char * tag);
+static uint32_t get_bits(const uint8_t * in, uint32_t * bit_pos, uint8_t len);
+static int32_t get_bits_signed(const uint8_t * in, uint32_t * bit_pos, uint8_t len);
+static void bits_align(uint8_t * out, const uint8_t * in, uint32_t bit_ofs, uint32_t out_size, uint32_t in_size);
+static void bits_3bpp_to_4bpp(uint8_t * out, const uint8_t * in, uint32_t bit_ofs, uint32_t px_cnt);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+#define GET_U16(p) ((uint16_t)((p)[0] | ((uint16_t)(p)[1] << 8)))
+#define GET_U32(p) ((uint32_t)(p)[0] | ((uint32_t)(p)[1] << 8) | ((uint32_t)(p)[2] << 16) | ((uint32_t)(p)[3] << 24))
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+#if LV_USE_FILESYSTEM
+/**
+ * Load a font from a binary font file created with `lv_font_conv --format bin`.
+ * Only the header, the character maps, the glyph descriptors and the kerning data are loaded into the RAM.
+ * The file is kept open and the glyph bitmaps are read from it on demand.
+ * @param path path to the font file with the driver letter (e.g. "S:/fonts/roboto_20.bin")
+ * @return pointer to the loaded font or NULL on error. Free it with `lv_font_free()`.
+ */
+lv_font_t * lv_font_load(const char * path)
+{
+    LV_ASSERT_NULL(path);
+
+    lv_font_t * font = font_create();
+    if(font == NULL) return NULL;
+
+    font_loader_dsc_t * ldsc = font->dsc;
+    lv_fs_res_t res = lv_fs_open(&ldsc->file, path, LV_FS_MODE_RD);
+    if(res != LV_FS_RES_OK) {
+        LV_LOG_WARN("lv_font_load: can't open the font file");
+        lv_font_free(font);
+        return NULL;
+    }
+    ldsc->file_opened = 1;
+
+    uint32_t file_size;
+    if(lv_fs_size(&ldsc->file, &file_size) != LV_FS_RES_OK) file_size = UINT32_MAX;
+    ldsc->file_size = file_size;
+
+    if(load_font(font) == false) {
+        LV_LOG_WARN("lv_font_load: invalid or unsupported font file");
+        lv_font_free(font);
+        return NULL;
+    }
+
+    return font;
+}
+#endif
+
+#if LV_FONT_LOADER_MMAP
+/**
+ * Map a binary font file created with `lv_font_conv --format bin` into the memory and load it.
+ * The glyph bitmaps are read directly from the mapping.
+ * @param path path to the font file in the host's file system (e.g. "/usr/share/fonts/roboto_20.bin")
+ * @return pointer to the loaded font or NULL on error. Free it with `lv_font_free()`.
+ */
+lv_font_t * lv_font_load_mmap(const char * path)
+{
+    LV_ASSERT_NULL(path);
+
+    int fd = open(path, O_RDONLY);
+    if(fd < 0) {
+        LV_LOG_WARN("lv_font_load_mmap: can't open the font file");
+        return NULL;
+    }
+
+    struct stat st;
+    if(fstat(fd, &st) != 0 || st.st_size == 0) {
+        close(fd);
+        return NULL;
+    }
+
+    void * map = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd); /*The mapping remains valid after closing the file*/
+    if(map == MAP_FAILED) {
+        LV_LOG_WARN("lv_font_load_mmap: can't map the font file");
+        return NULL;
+    }
+
+    lv_font_t * font = font_create();
+    if(font == NULL) {
+        munmap(map, st.st_size);
+        return NULL;
+    }
+
+    font_loader_dsc_t * ldsc = font->dsc;
+    ldsc->map      = map;
+    ldsc->map_size  = st.st_size;
+    ldsc->file_size = st.st_size;
+
+    if(load_font(font) == false) {
+        LV_LOG_WARN("lv_font_load_mmap: invalid or unsupported font file");
+        lv_font_free(font);
+        return NULL;
+    }
+
+    return font;
+}
+#endif
+
+/**
+ * Free a font loaded by `lv_font_load()` or `lv_font_load_mmap()`. Closes (or unmaps) its file too.
+ * @param font pointer to a loaded font
+ */
+void lv_font_free(lv_font_t * font)
+{
+    if(font == NULL) return;
+
+    font_loader_dsc_t * ldsc = font->dsc;
+    if(ldsc) {
+        lv_font_fmt_txt_dsc_t * fdsc = &ldsc->fmt_dsc;
+
+        if(fdsc->cmaps) {
+            uint16_t i;
+            for(i = 0; i < fdsc->cmap_num; i++) {
+                lv_mem_free(fdsc->cmaps[i].unicode_list);
+                lv_mem_free(fdsc->cmaps[i].glyph_id_ofs_list);
+            }
+            lv_mem_free(fdsc->cmaps);
+        }
+
+        if(fdsc->kern_dsc) {
+            if(fdsc->kern_classes) {
+                const lv_font_fmt_txt_kern_classes_t * kdsc = fdsc->kern_dsc;
+                lv_mem_free(kdsc->class_pair_values);
+                lv_mem_free(kdsc->left_class_mapping);
+                lv_mem_free(kdsc->right_class_mapping);
+            } else {
+                const lv_font_fmt_txt_kern_pair_t * kdsc = fdsc->kern_dsc;
+                lv_mem_free(kdsc->glyph_ids);
+                lv_mem_free(kdsc->values);
+            }
+            lv_mem_free(fdsc->kern_dsc);
+        }
+
+        lv_mem_free(fdsc->glyph_dsc);
+        lv_mem_free(ldsc->glyph_pos);
+        lv_mem_free(ldsc->raw_buf);
+
+        uint32_t i;
+        for(i = 0; i < LV_FONT_LOADER_CACHE_SLOTS; i++) {
+            lv_mem_free(ldsc->cache[i].buf);
+        }
+
+#if LV_USE_FILESYSTEM
+        if(ldsc->file_opened) lv_fs_close(&ldsc->file);
+#endif
+
+#if LV_FONT_LOADER_MMAP
+        if(ldsc->map) munmap((void *)ldsc->map, ldsc->map_size);
+#endif
+        lv_mem_free(ldsc);
+    }
+
+    lv_mem_free(font);
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Allocate an empty font with a loader descriptor
+ * @return the new font or NULL if out of memory
+ */
+static lv_font_t * font_create(void)
+{
+    lv_font_t * font = lv_mem_alloc(sizeof(lv_font_t));
+    LV_ASSERT_MEM(font);
+    if(font == NULL) return NULL;
+    memset(font, 0, sizeof(lv_font_t));
+
+    font_loader_dsc_t * ldsc = lv_mem_alloc(sizeof(font_loader_dsc_t));
+    LV_ASSERT_MEM(ldsc);
+    if(ldsc == NULL) {
+        lv_mem_free(font);
+        return NULL;
+    }
+    memset(ldsc, 0, sizeof(font_loader_dsc_t));
+
+    font->dsc              = ldsc;
+    font->get_glyph_dsc    = lv_font_get_glyph_dsc_fmt_txt;
+    font->get_glyph_bitmap = get_glyph_bitmap;
+
+    return font;
+}
+
+/**
+ * Read the tables of the font file. The tables follow each other in this order:
+ * `head`, `cmap`, `loca`, `glyf` and optionally `kern`.
+ * @param font pointer to a font created by `font_create()`
+ * @return true: the font is loaded; false: invalid or unsupported file
+ */
+static bool load_font(lv_font_t * font)
+{
+    font_loader_dsc_t * ldsc = font->dsc;
+
+    uint32_t head_size = read_table_header(ldsc, 0, "head");
+    if(head_size < TABLE_HEADER_SIZE + HEAD_SIZE) return false;
+
+    uint8_t head[HEAD_SIZE];
+    if(font_read(ldsc, TABLE_HEADER_SIZE, head, HEAD_SIZE) == false) return false;
+
+    uint16_t tables_cnt = load_head(font, head);
+    if(tables_cnt == 0) return false;
+
+    uint32_t pos = head_size;
+    uint32_t size;
+
+    size = load_cmaps(ldsc, pos);
+    if(size == 0) return false;
+    pos += size;
+
+    size = load_loca(ldsc, pos, head[26]);
+    if(size == 0) return false;
+    pos += size;
+
+    if(check_glyph_ids(ldsc) == false) return false;
+
+    size = load_glyphs(ldsc, pos, head);
+    if(size == 0) return false;
+    pos += size;
+
+    /*The kerning table is optional*/
+    if(tables_cnt >= 4) {
+        size = load_kern(ldsc, pos, head[27]);
+        if(size == 0) return false;
+    }
+
+    return true;
+}
+
+/**
+ * Process the `head` table
+ * @param font pointer to the font
+ * @param head the content of the `head` table (without the table header)
+ * @return number of tables after `head` or 0 if the font can't be used
+ */
+static uint32_t load_head(lv_font_t * font, uint8_t * head)
+{
+    font_loader_dsc_t * ldsc = font->dsc;
+
+    uint16_t tables_cnt      = GET_U16(&head[4]);
+    int16_t ascent           = (int16_t)GET_U16(&head[8]);
+    int16_t descent          = (int16_t)GET_U16(&head[10]);
+    uint16_t kern_scale      = GET_U16(&head[24]);
+    uint8_t bpp              = head[29];
+    uint8_t compression_id   = head[33];
+    uint8_t subpx            = head[34];
+
+    if(bpp != 1 && bpp != 2 && bpp != 3 && bpp != 4) {
+        LV_LOG_WARN("lv_font_load: only 1, 2, 3 and 4 bpp fonts are supported");
+        return 0;
+    }
+
+    if(compression_id != COMPRESSION_NONE && compression_id != COMPRESSION_RLE_XOR) {
+        LV_LOG_WARN("lv_font_load: unsupported bitmap compression (use compression with prefilter or none)");
+        return 0;
+    }
+
+    font->line_height = ascent - descent;
+    font->base_line   = -descent;
+    font->subpx       = subpx;
+
+    ldsc->fmt_dsc.bpp           = bpp;
+    ldsc->fmt_dsc.kern_scale    = kern_scale;
+    ldsc->fmt_dsc.bitmap_format = compression_id == COMPRESSION_NONE ? LV_FONT_FMT_TXT_PLAIN : LV_FONT_FMT_TXT_COMPRESSED;
+    ldsc->compressed            = compression_id == COMPRESSION_NONE ? 0 : 1;
+
+    /*The advance width and the bounding box is stored before the bitmap of every glyph*/
+    uint8_t xy_bits    = head[30];
+    uint8_t wh_bits    = head[31];
+    uint8_t adv_w_bits = head[32];
+    if(xy_bits > 8 || wh_bits > 8 || adv_w_bits > 32) {
+        LV_LOG_WARN("lv_font_load: invalid glyph header");
+        return 0;
+    }
+    ldsc->hdr_bits = adv_w_bits + 2 * xy_bits + 2 * wh_bits;
+
+    return tables_cnt;
+}
+
+/**
+ * Load the `cmap` table
+ * @param ldsc pointer to the loader descriptor
+ * @param pos position of the table in the file
+ * @return size of the table or 0 on error
+ */
+static uint32_t load_cmaps(font_loader_dsc_t * ldsc, uint32_t pos)
+{
+    uint32_t table_size = read_table_header(ldsc, pos, "cmap");
+    if(table_size == 0) return 0;
+
+    uint8_t buf[CMAP_SUBTABLE_SIZE];
+    if(font_read(ldsc, pos + TABLE_HEADER_SIZE, buf, 4) == false) return 0;
+    uint32_t cmap_num = GET_U32(buf);
+    if(cmap_num == 0 || cmap_num >= (1 << 10)) return 0;
+
+    lv_font_fmt_txt_cmap_t * cmaps = lv_mem_alloc(sizeof(lv_font_fmt_txt_cmap_t) * cmap_num);
+    LV_ASSERT_MEM(cmaps);
+    if(cmaps == NULL) return 0;
+    memset(cmaps, 0, sizeof(lv_font_fmt_txt_cmap_t) * cmap_num);
+    ldsc->fmt_dsc.cmaps   = cmaps;
+    ldsc->fmt_dsc.cmap_num = cmap_num;
+
+    uint32_t i;
+    for(i = 0; i < cmap_num; i++) {
+        if(font_read(ldsc, pos + TABLE_HEADER_SIZE + 4 + i * CMAP_SUBTABLE_SIZE, buf, CMAP_SUBTABLE_SIZE) == false) {
+            return 0;
+        }
+
+        uint32_t data_pos    = pos + GET_U32(&buf[0]);
+        uint16_t entry_cnt   = GET_U16(&buf[12]);
+        uint8_t format       = buf[14];
+
+        cmaps[i].range_start    = GET_U32(&buf[4]);
+        cmaps[i].range_length   = GET_U16(&buf[8]);
+        cmaps[i].glyph_id_start = GET_U16(&buf[10]);
+        cmaps[i].list_length    = entry_cnt;
+
+        switch(format) {
+            case BIN_CMAP_FORMAT0_FULL: {
+                /*The look up can index the list with `range_length` too. Keep 0 offsets there.*/
+                uint32_t ofs_cnt   = entry_cnt > cmaps[i].range_length ? entry_cnt : cmaps[i].range_length + 1;
+                uint8_t * ofs_list = lv_mem_alloc(ofs_cnt);
+                LV_ASSERT_MEM(ofs_list);
+                if(ofs_list == NULL) return 0;
+                memset(ofs_list, 0, ofs_cnt);
+                cmaps[i].glyph_id_ofs_list = ofs_list;
+                cmaps[i].type              = LV_FONT_FMT_TXT_CMAP_FORMAT0_FULL;
+                if(font_read(ldsc, data_pos, ofs_list, entry_cnt) == false) return 0;
+                break;
+            }
+            case BIN_CMAP_FORMAT0_TINY:
+                cmaps[i].type = LV_FONT_FMT_TXT_CMAP_FORMAT0_TINY;
+                break;
+            case BIN_CMAP_SPARSE_FULL:
+            case BIN_CMAP_SPARSE_TINY: {
+                uint16_t * unicode_list = lv_mem_alloc(entry_cnt * sizeof(uint16_t));
+                LV_ASSERT_MEM(unicode_list);
+                if(unicode_list == NULL) return 0;
+                cmaps[i].unicode_list = unicode_list;
+                if(font_read_u16_array(ldsc, data_pos, unicode_list, entry_cnt) == false) return 0;
+
+                if(format == BIN_CMAP_SPARSE_TINY) {
+                    cmaps[i].type = LV_FONT_FMT_TXT_CMAP_SPARSE_TINY;
+                } else {
+                    uint16_t * ofs_list = lv_mem_alloc(entry_cnt * sizeof(uint16_t));
+                    LV_ASSERT_MEM(ofs_list);
+                    if(ofs_list == NULL) return 0;
+                    cmaps[i].glyph_id_ofs_list = ofs_list;
+                    cmaps[i].type              = LV_FONT_FMT_TXT_CMAP_SPARSE_FULL;
+                    uint32_t ofs_pos = data_pos + entry_cnt * sizeof(uint16_t);
+                    if(font_read_u16_array(ldsc, ofs_pos, ofs_list, entry_cnt) == false) return 0;
+                }
+                break;
+            }
+            default:
+                LV_LOG_WARN("lv_font_load: unknown cmap format");
+                return 0;
+        }
+    }
+
+    return table_size;
+}
+
+/**
+ * Load the `loca` table which stores the offset of the glyphs in the `glyf` table
+ * @param ldsc pointer to the loader descriptor
+ * @param pos position of the table in the file
+ * @param loca_format 0: 16 bit offsets, 1: 32 bit offsets
+ * @return size of the table or 0 on error
+ */
+static uint32_t load_loca(font_loader_dsc_t * ldsc, uint32_t pos, uint8_t loca_format)
+{
+    uint32_t table_size = read_table_header(ldsc, pos, "loca");
+    if(table_size == 0) return 0;
+
+    uint8_t buf[4];
+    if(font_read(ldsc, pos + TABLE_HEADER_SIZE, buf, 4) == false) return 0;
+    uint32_t glyph_cnt = GET_U32(buf);
+    if(glyph_cnt == 0) return 0;
+
+    uint32_t * glyph_pos = lv_mem_alloc((glyph_cnt + 1) * sizeof(uint32_t));
+    LV_ASSERT_MEM(glyph_pos);
+    if(glyph_pos == NULL) return 0;
+    ldsc->glyph_pos = glyph_pos;
+    ldsc->glyph_cnt = glyph_cnt;
+
+    /*Read the offsets into the end of the array and expand them from its beginning*/
+    uint32_t ofs_size = loca_format == 0 ? 2 : 4;
+    uint8_t * raw     = (uint8_t *)glyph_pos + (glyph_cnt + 1) * sizeof(uint32_t) - glyph_cnt * ofs_size;
+    if(font_read(ldsc, pos + TABLE_HEADER_SIZE + 4, raw, glyph_cnt * ofs_size) == false) return 0;
+
+    uint32_t i;
+    for(i = 0; i < glyph_cnt; i++) {
+        glyph_pos[i] = ofs_size == 2 ? GET_U16(&raw[i * 2]) : GET_U32(&raw[i * 4]);
+    }
+
+    return table_size;
+}
+
+/**
+ * Check that the character maps refer only to existing glyphs.
+ * The look up in `lv_font_fmt_txt` accepts `range_length` as relative code point too, so a map can refer
+ * to the glyph after its range. Therefore `glyph_cnt` is accepted as well: it has an empty descriptor.
+ * @param ldsc pointer to the loader descriptor with loaded `cmap` and `loca` tables
+ * @return true: the glyph ids are valid; false: a glyph id is out of range
+ */
+static bool check_glyph_ids(font_loader_dsc_t * ldsc)
+{
+    const lv_font_fmt_txt_dsc_t * fdsc = &ldsc->fmt_dsc;
+
+    uint32_t i;
+    for(i = 0; i < fdsc->cmap_num; i++) {
+        const lv_font_fmt_txt_cmap_t * cmap = &fdsc->cmaps[i];
+        uint32_t gid_max = cmap->glyph_id_start;
+        uint32_t k;
+        switch(cmap->type) {
+            case LV_FONT_FMT_TXT_CMAP_FORMAT0_TINY:
+                gid_max += cmap->range_length;
+                break;
+            case LV_FONT_FMT_TXT_CMAP_SPARSE_TINY:
+                gid_max += cmap->list_length;
+                break;
+            case LV_FONT_FMT_TXT_CMAP_FORMAT0_FULL: {
+                const uint8_t * ofs_list = cmap->glyph_id_ofs_list;
+                uint32_t ofs_max = 0;
+                for(k = 0; k < cmap->list_length; k++) {
+                    if(ofs_list[k] > ofs_max) ofs_max = ofs_list[k];
+                }
+                gid_max += ofs_max;
+                break;
+            }
+            case LV_FONT_FMT_TXT_CMAP_SPARSE_FULL: {
+                const uint16_t * ofs_list = cmap->glyph_id_ofs_list;
+                uint32_t ofs_max = 0;
+                for(k = 0; k < cmap->list_length; k++) {
+                    if(ofs_list[k] > ofs_max) ofs_max = ofs_list[k];
+                }
+                gid_max += ofs_max;
+                break;
+            }
+        }
+
+        if(gid_max > ldsc->glyph_cnt) {
+            LV_LOG_WARN("lv_font_load: invalid glyph id in a character map");
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * Process the `glyf` table. Read the header of every glyph to create the glyph descriptors
+ * but leave the bitmaps in the file.
+ * @param ldsc pointer to the loader descriptor
+ * @param pos position of the table in the file
+ * @param head content of the `head` table
+ * @return size of the table or 0 on error
+ */
+static uint32_t load_glyphs(font_loader_dsc_t * ldsc, uint32_t pos, const uint8_t * head)
+{
+    uint32_t table_size = read_table_header(ldsc, pos, "glyf");
+    if(table_size == 0) return 0;
+
+    uint16_t def_adv_w   = GET_U16(&head[22]);
+    uint8_t adv_w_format = head[28];
+    uint8_t xy_bits      = head[30];
+    uint8_t wh_bits      = head[31];
+    uint8_t adv_w_bits   = head[32];
+
+    /*+1 empty descriptor: the character maps can refer to the glyph after their range (see `check_glyph_ids()`)*/
+    uint32_t glyph_cnt = ldsc->glyph_cnt;
+    lv_font_fmt_txt_glyph_dsc_t * gdsc = lv_mem_alloc((glyph_cnt + 1) * sizeof(lv_font_fmt_txt_glyph_dsc_t));
+    LV_ASSERT_MEM(gdsc);
+    if(gdsc == NULL) return 0;
+    memset(gdsc, 0, (glyph_cnt + 1) * sizeof(lv_font_fmt_txt_glyph_dsc_t));
+    ldsc->fmt_dsc.glyph_dsc = gdsc;
+
+    /*The offsets in `loca` are relative to the start of `glyf`. Convert them to file positions*/
+    uint32_t i;
+    for(i = 0; i < glyph_cnt; i++) {
+        if(ldsc->glyph_pos[i] > table_size) return 0;
+        ldsc->glyph_pos[i] += pos;
+    }
+    ldsc->glyph_pos[glyph_cnt] = pos + table_size;
+
+    uint32_t hdr_size = (ldsc->hdr_bits + 7) >> 3;
+    uint8_t hdr[16];
+    if(hdr_size > sizeof(hdr)) return 0;
+
+    for(i = 0; i < glyph_cnt; i++) {
+        uint32_t glyph_size = ldsc->glyph_pos[i + 1] - ldsc->glyph_pos[i];
+        if(ldsc->glyph_pos[i + 1] < ldsc->glyph_pos[i]) return 0;
+        if(glyph_size == 0) continue;
+
+        uint32_t rd_size = glyph_size < hdr_size ? glyph_size : hdr_size;
+        memset(hdr, 0, sizeof(hdr));
+        if(font_read(ldsc, ldsc->glyph_pos[i], hdr, rd_size) == false) return 0;
+
+        uint32_t bit_pos = 0;
+        uint32_t adv_w;
+        if(adv_w_bits == 0) adv_w = def_adv_w;
+        else adv_w = get_bits(hdr, &bit_pos, adv_w_bits);
+
+        /*Convert integer advance widths to 8.4 format*/
+        if(adv_w_format == 0) adv_w = adv_w << 4;
+
+        gdsc[i].adv_w = adv_w;
+        gdsc[i].ofs_x = get_bits_signed(hdr, &bit_pos, xy_bits);
+        gdsc[i].ofs_y = get_bits_signed(hdr, &bit_pos, xy_bits);
+        gdsc[i].box_w = get_bits(hdr, &bit_pos, wh_bits);
+        gdsc[i].box_h = get_bits(hdr, &bit_pos, wh_bits);
+
+        /*The header and the bitmap has to be in the glyph's data.
+         *The size of the compressed bitmaps is not known, `get_glyph_bitmap()` pads them instead.*/
+        uint32_t px_cnt = (uint32_t)gdsc[i].box_w * gdsc[i].box_h;
+        if(px_cnt == 0) continue;
+        uint32_t data_bits = ldsc->hdr_bits;
+        if(ldsc->compressed == 0) data_bits += px_cnt * ldsc->fmt_dsc.bpp;
+        if(((data_bits + 7) >> 3) > glyph_size) {
+            LV_LOG_WARN("lv_font_load: truncated glyph");
+            return 0;
+        }
+    }
+
+    return table_size;
+}
+
+/**
+ * Load the `kern` table
+ * @param ldsc pointer to the loader descriptor
+ * @param pos position of the table in the file
+ * @param glyph_id_format 0: glyph ids are stored on 1 byte; 1: on 2 bytes
+ * @return size of the table or 0 on error
+ */
+static uint32_t load_kern(font_loader_dsc_t * ldsc, uint32_t pos, uint8_t glyph_id_format)
+{
+    uint32_t table_size = read_table_header(ldsc, pos, "kern");
+    if(table_size == 0) return 0;
+
+    uint8_t buf[8];
+    if(font_read(ldsc, pos + TABLE_HEADER_SIZE, buf, 8) == false) return 0;
+
+    uint8_t kern_format = buf[0];
+    uint32_t data_pos   = pos + TABLE_HEADER_SIZE + 4;
+
+    /*Sorted pairs*/
+    if(kern_format == 0) {
+        lv_font_fmt_txt_kern_pair_t * kdsc = lv_mem_alloc(sizeof(lv_font_fmt_txt_kern_pair_t));
+        LV_ASSERT_MEM(kdsc);
+        if(kdsc == NULL) return 0;
+        memset(kdsc, 0, sizeof(lv_font_fmt_txt_kern_pair_t));
+        ldsc->fmt_dsc.kern_dsc     = kdsc;
+        ldsc->fmt_dsc.kern_classes = 0;
+
+        uint32_t pair_cnt = GET_U32(&buf[4]);
+        uint32_t ids_size = pair_cnt * 2 * (glyph_id_format == 0 ? 1 : 2);
+        kdsc->pair_cnt       = pair_cnt;
+        kdsc->glyph_ids_size = glyph_id_format == 0 ? 0 : 1;
+
+        uint8_t * glyph_ids = lv_mem_alloc(ids_size);
+        LV_ASSERT_MEM(glyph_ids);
+        if(glyph_ids == NULL) return 0;
+        kdsc->glyph_ids = glyph_ids;
+
+        int8_t * values = lv_mem_alloc(pair_cnt);
+        LV_ASSERT_MEM(values);
+        if(values == NULL) return 0;
+        kdsc->values = values;
+
+        data_pos += 4;
+        if(glyph_id_format == 0) {
+            if(font_read(ldsc, data_pos, glyph_ids, ids_size) == false) return 0;
+        } else {
+            if(font_read_u16_array(ldsc, data_pos, (uint16_t *)glyph_ids, pair_cnt * 2) == false) return 0;
+        }
+        if(font_read(ldsc, data_pos + ids_size, values, pair_cnt) == false) return 0;
+    }
+    /*Left and right classes and a class pair array*/
+    else if(kern_format == 3) {
+        lv_font_fmt_txt_kern_classes_t * kdsc = lv_mem_alloc(sizeof(lv_font_fmt_txt_kern_classes_t));
+        LV_ASSERT_MEM(kdsc);
+        if(kdsc == NULL) return 0;
+        memset(kdsc, 0, sizeof(lv_font_fmt_txt_kern_classes_t));
+        ldsc->fmt_dsc.kern_dsc     = kdsc;
+        ldsc->fmt_dsc.kern_classes = 1;
+
+        uint16_t mapping_len = GET_U16(&buf[4]);
+        kdsc->left_class_cnt  = buf[6];
+        kdsc->right_class_cnt = buf[7];
+        uint32_t values_len   = (uint32_t)kdsc->left_class_cnt * kdsc->right_class_cnt;
+
+        /*The mappings are indexed with the glyph ids (max. `glyph_cnt`). The missing glyphs are in class 0.*/
+        uint32_t map_cnt = mapping_len > ldsc->glyph_cnt ? mapping_len : ldsc->glyph_cnt + 1;
+        uint8_t * left  = lv_mem_alloc(map_cnt);
+        uint8_t * right = lv_mem_alloc(map_cnt);
+        int8_t * values = lv_mem_alloc(values_len);
+        kdsc->left_class_mapping  = left;
+        kdsc->right_class_mapping = right;
+        kdsc->class_pair_values   = values;
+        LV_ASSERT_MEM(left);
+        LV_ASSERT_MEM(right);
+        LV_ASSERT_MEM(values);
+        if(left == NULL || right == NULL || values == NULL) return 0;
+        memset(left, 0, map_cnt);
+        memset(right, 0, map_cnt);
+
+        data_pos += 4;
+        if(font_read(ldsc, data_pos, left, mapping_len) == false) return 0;
+        if(font_read(ldsc, data_pos + mapping_len, right, mapping_len) == false) return 0;
+        if(font_read(ldsc, data_pos + 2 * mapping_len, values, values_len) == false) return 0;
+
+        uint32_t i;
+        for(i = 0; i < mapping_len; i++) {
+            if(left[i] > kdsc->left_class_cnt || right[i] > kdsc->right_class_cnt) {
+                LV_LOG_WARN("lv_font_load: invalid kerning class");
+                return 0;
+            }
+        }
+    } else {
+        LV_LOG_WARN("lv_font_load: unknown kerning format");
+        return 0;
+    }
+
+    return table_size;
+}
+
+/**
+ * Used as `get_glyph_bitmap` callback of the loaded fonts.
+ * Look up the glyph in the cache or read (and decompress) it from the file into a cache slot.
+ * @param font pointer to font
+ * @param unicode_letter an unicode letter which bitmap should be get
+ * @return pointer to the bitmap or NULL if not found. Valid until the next glyph is requested from the font.
+ */
+static const uint8_t * get_glyph_bitmap(const lv_font_t * font, uint32_t unicode_letter)
+{
+    font_loader_dsc_t * ldsc = font->dsc;
+    uint32_t gid = lv_font_get_glyph_id_fmt_txt(font, unicode_letter);
+    if(gid == 0 || gid >= ldsc->glyph_cnt) return NULL;
+
+    glyph_slot_t * slot = &ldsc->cache[gid & (LV_FONT_LOADER_CACHE_SLOTS - 1)];
+    if(slot->glyph_id == gid) return slot->buf;
+
+    const lv_font_fmt_txt_glyph_dsc_t * gdsc = &ldsc->fmt_dsc.glyph_dsc[gid];
+    uint32_t px_cnt = (uint32_t)gdsc->box_w * gdsc->box_h;
+    if(px_cnt == 0) return NULL;
+
+    uint8_t bpp       = ldsc->fmt_dsc.bpp;
+    uint32_t raw_pos  = ldsc->glyph_pos[gid];
+    uint32_t raw_size = ldsc->glyph_pos[gid + 1] - raw_pos;
+    const uint8_t * raw;
+
+    /*A malformed compressed stream can make the decompressor read max. `bpp + 7` bits per pixel.
+     *Keep that much space (filled with zeros) in the raw buffer to not read out of it.*/
+    uint32_t buf_size = raw_size;
+    if(ldsc->compressed) {
+        uint32_t rle_size = ((px_cnt * (bpp + 7) + 7) >> 3) + 1;
+        if(rle_size > buf_size) buf_size = rle_size;
+    }
+
+    if(ldsc->map) {
+        raw = &ldsc->map[raw_pos];
+        /*Plain bitmaps starting on byte boundary are already in the format required for drawing*/
+        if(ldsc->compressed == 0 && bpp != 3 && (ldsc->hdr_bits & 0x7) == 0) {
+            return raw + (ldsc->hdr_bits >> 3);
+        }
+    } else {
+        uint8_t * raw_buf = raw_buf_reserve(ldsc, buf_size);
+        if(raw_buf == NULL) return NULL;
+        if(font_read(ldsc, raw_pos, raw_buf, raw_size) == false) return NULL;
+        raw = raw_buf;
+    }
+
+    /*3 bpp glyphs are converted to 4 bpp*/
+    uint8_t out_bpp   = bpp == 3 ? 4 : bpp;
+    uint32_t out_size = (px_cnt * out_bpp + 7) >> 3;
+    if(slot->buf_size < out_size) {
+        uint8_t * new_buf = lv_mem_realloc(slot->buf, out_size);
+        LV_ASSERT_MEM(new_buf);
+        if(new_buf == NULL) return NULL;
+        slot->buf      = new_buf;
+        slot->buf_size = out_size;
+    }
+    slot->glyph_id = 0;
+
+    if(ldsc->compressed) {
+        /*The decompressor needs the stream from a byte boundary. `raw_buf` can be shifted in place.*/
+        uint8_t * aligned = raw_buf_reserve(ldsc, buf_size);
+        if(aligned == NULL) return NULL;
+        bits_align(aligned, raw, ldsc->hdr_bits, buf_size, raw_size);
+        lv_font_decompress_fmt_txt(aligned, slot->buf, gdsc->box_w, gdsc->box_h, bpp);
+    } else if(bpp == 3) {
+        bits_3bpp_to_4bpp(slot->buf, raw, ldsc->hdr_bits, px_cnt);
+    } else {
+        bits_align(slot->buf, raw, ldsc->hdr_bits, out_size, raw_size);
+    }
+
+    slot->glyph_id = gid;
+    return slot->buf;
+}
+
+/**
+ * Make sure the raw buffer of a font is at least `size` large. Its content is kept.
+ * @param ldsc pointer to the loader descriptor
+ * @param size the required size in bytes
+ * @return pointer to the raw buffer or NULL if out of memory
+ */
+static uint8_t * raw_buf_reserve(font_loader_dsc_t * ldsc, uint32_t size)
+{
+    if(ldsc->raw_buf_size < size) {
+        uint8_t * new_buf = lv_mem_realloc(ldsc->raw_buf, size);
+        LV_ASSERT_MEM(new_buf);
+        if(new_buf == NULL) return NULL;
+        ldsc->raw_buf      = new_buf;
+        ldsc->raw_buf_size = size;
+    }
+
+    return ldsc->raw_buf;
+}
+
+/**
+ * Read data from the font file or from the mapped memory
+ * @param ldsc pointer to the loader descriptor
+ * @param pos position in the file
+ * @param buf store the data here
+ * @param len number of bytes to read
+ * @return true: `len` bytes are read; false: error
+ */
+static bool font_read(font_loader_dsc_t * ldsc, uint32_t pos, void * buf, uint32_t len)
+{
+    if(ldsc->map) {
+        if(pos > ldsc->map_size || len > ldsc->map_size - pos) return false;
+        memcpy(buf, &ldsc->map[pos], len);
+        return true;
+    }
+
+#if LV_USE_FILESYSTEM
+    if(lv_fs_seek(&ldsc->file, pos) != LV_FS_RES_OK) return false;
+
+    uint32_t br = 0;
+    if(lv_fs_read(&ldsc->file, buf, len, &br) != LV_FS_RES_OK) return false;
+    return br == len ? true : false;
+#else
+    return false;
+#endif
+}
+
+/**
+ * Read an array of little endian 16 bit values
+ * @param ldsc pointer to the loader descriptor
+ * @param pos position in the file
+ * @param buf store the values here
+ * @param cnt number of values to read
+ * @return true: the values are read; false: error
+ */
+static bool font_read_u16_array(font_loader_dsc_t * ldsc, uint32_t pos, uint16_t * buf, uint32_t cnt)
+{
+    if(font_read(ldsc, pos, buf, cnt * sizeof(uint16_t)) == false) return false;
+
+    /*Convert to the native byte order in place*/
+    uint32_t i;
+    for(i = 0; i < cnt; i++) {
+        uint8_t * p = (uint8_t *)&buf[i];
+        buf[i]      = GET_U16(p);
+    }
+
+    return true;
+}
+
+/**
+ * Verify the header of a table
+ * @param ldsc pointer to the loader descriptor
+ * @param pos position of the table in the file
+ * @param tag the expected 4 character tag of the table
+ * @return size of the table (including the header) or 0 if the header is invalid or the table exceeds the file
+ */
+static uint32_t read_table_header(font_loader_dsc_t * ldsc, uint32_t pos, const char * tag)
+{
+    uint8_t buf[TABLE_HEADER_SIZE];
+    if(font_read(ldsc, pos, buf, TABLE_HEADER_SIZE) == false) return 0;
+    if(memcmp(&buf[4], tag, 4) != 0) return 0;
+
+    uint32_t size = GET_U32(buf);
+    if(size < TABLE_HEADER_SIZE || size > ldsc->file_size - pos) return 0;
+
+    return size;
+}
+
+/**
+ * Read bits from a buffer. The bits are stored MSB first.
+ * @param in the input buffer
+ * @param bit_pos index of the first bit to read. Incremented with `len`.
+ * @param len number of bits to read (<= 32)
+ * @return the read bits
+ */
+static uint32_t get_bits(const uint8_t * in, uint32_t * bit_pos, uint8_t len)
+{
+    uint32_t res = 0;
+    uint8_t i;
+    for(i = 0; i < len; i++) {
+        uint32_t p = *bit_pos + i;
+        res = (res << 1) | ((in[p >> 3] >> (7 - (p & 0x7))) & 0x1);
+    }
+
+    *bit_pos += len;
+    return res;
+}
+
+/**
+ * Read a two's complement signed value from a buffer
+ * @param in the input buffer
+ * @param bit_pos index of the first bit to read. Incremented with `len`.
+ * @param len number of bits to read (<= 32)
+ * @return the read value
+ */
+static int32_t get_bits_signed(const uint8_t * in, uint32_t * bit_pos, uint8_t len)
+{
+    uint32_t v = get_bits(in, bit_pos, len);
+    if(len > 0 && len < 32 && (v & (1UL << (len - 1)))) v |= ~((1UL << len) - 1);
+    return (int32_t)v;
+}
+
+/**
+ * Copy a bit stream starting at an arbitrary bit position to byte boundary.
+ * `out` can be the same as `in`.
+ * @param out store the aligned bits here
+ * @param in the input buffer
+ * @param bit_ofs index of the first bit to copy
+ * @param out_size number of bytes to write
+ * @param in_size size of `in` in bytes. Bytes after it are considered 0.
+ */
+static void bits_align(uint8_t * out, const uint8_t * in, uint32_t bit_ofs, uint32_t out_size, uint32_t in_size)
+{
+    uint32_t byte_ofs = bit_ofs >> 3;
+    uint8_t shift     = bit_ofs & 0x7;
+
+    uint32_t i;
+    for(i = 0; i < out_size; i++) {
+        uint32_t p   = byte_ofs + i;
+        uint8_t cur  = p < in_size ? in[p] : 0;
+        uint8_t next = p + 1 < in_size ? in[p + 1] : 0;
+        out[i]       = shift == 0 ? cur : (uint8_t)((cur << shift) | (next >> (8 - shift)));
+    }
+}
+
+/**
+ * Convert a 3 bpp bitmap to 4 bpp
+ * @param out store the 4 bpp bitmap here
+ * @param in the input buffer
+ * @param bit_ofs index of the first bit of the bitmap in `in`
+ * @param px_cnt number of pixels
+ */
+static void bits_3bpp_to_4bpp(uint8_t * out, const uint8_t * in, uint32_t bit_ofs, uint32_t px_cnt)
+{
+    static const uint8_t opa3_to_4[8] = {0, 2, 4, 6, 9, 11, 13, 15};
+
+    uint32_t i;
+    for(i = 0; i < px_cnt; i++) {
+        uint8_t v = opa3_to_4[get_bits(in, &bit_ofs, 3)];
+        if(i & 0x1) out[i >> 1] |= v;
+        else out[i >> 1] = v << 4;
+    }
+}
+
+#endif /*LV_USE_FONT_LOADER*/
@@ -0,0 +1,75 @@
+/**
+ * @file lv_font_loader.h
+ *
+ */
+
+#ifndef LV_FONT_LOADER_H
+#define LV_FONT_LOADER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#ifdef LV_CONF_INCLUDE_SIMPLE
+#include "lv_conf.h"
+#else
+#include "../../../lv_conf.h"
+#endif
+
+#if LV_USE_FONT_LOADER
+
+#include "lv_font.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+#if LV_USE_FILESYSTEM
+/**
+ * Load a font from a binary font file created with `lv_font_conv --format bin`.
+ * Only the header, the character maps, the glyph descriptors and the kerning data are loaded into the RAM.
+ * The file is kept open and the glyph bitmaps are read from it on demand.
+ * @param path path to the font file with the driver letter (e.g. "S:/fonts/roboto_20.bin")
+ * @return pointer to the loaded font or NULL on error. Free it with `lv_font_free()`.
+ */
+lv_font_t * lv_font_load(const char * path);
+#endif
+
+#if LV_FONT_LOADER_MMAP
+/**
+ * Map a binary font file created with `lv_font_conv --format bin` into the memory and load it.
+ * The glyph bitmaps are read directly from the mapping.
+ * @param path path to the font file in the host's file system (e.g. "/usr/share/fonts/roboto_20.bin")
+ * @return pointer to the loaded font or NULL on error. Free it with `lv_font_free()`.
+ */
+lv_font_t * lv_font_load_mmap(const char * path);
+#endif
+
+/**
+ * Free a font loaded by `lv_font_load()` or `lv_font_load_mmap()`. Closes (or unmaps) its file too.
+ * @param font pointer to a loaded font
+ */
+void lv_font_free(lv_font_t * font);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /*LV_USE_FONT_LOADER*/
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /*LV_FONT_LOADER_H*/
@@ -64,6 +64,12 @@ void lv_disp_drv_init(lv_disp_drv_t * driver)
     driver->rotated          = 0;
     driver->color_chroma_key = LV_COLOR_TRANSP;
 
+#if LV_USE_DISP_OUT_CONV
+    driver->out_fmt    = LV_COLOR_FMT_NATIVE;
+    driver->out_buf    = NULL;
+    driver->out_dither = 0;
+#endif
+
 #if LV_ANTIALIAS
     driver->antialiasing = true;
 #endif
@@ -81,7 +87,8 @@ void lv_disp_drv_init(lv_disp_drv_t * driver)
     driver->user_data = NULL;
 #endif
 
-    driver->set_px_cb = NULL;
+    driver->set_px_cb    = NULL;
+    driver->draw_backend = NULL;
 }
 
 /**
@@ -271,12 +278,20 @@ LV_ATTRIBUTE_FLUSH_READY void lv_disp_flush_ready(lv_disp_drv_t * disp_drv)
 {
     /*If the screen is transparent initialize it when the flushing is ready*/
 #if LV_COLOR_SCREEN_TRANSP
+#if LV_USE_DISP_OUT_CONV
+    /*With output conversion the display buffer was already cleared after the conversion*/
+    if(disp_drv->screen_transp && disp_drv->buffer->out_flushing == 0) {
+#else
     if(disp_drv->screen_transp) {
+#endif
         memset(disp_drv->buffer->buf_act, 0x00, disp_drv->buffer->size * sizeof(lv_color32_t));
     }
 #endif
 
     disp_drv->buffer->flushing = 0;
+#if LV_USE_DISP_OUT_CONV
+    disp_drv->buffer->out_flushing = 0;
+#endif
 }
 
 /**
@@ -54,6 +54,9 @@ typedef struct
     uint32_t size; /*In pixel count*/
     lv_area_t area;
     volatile uint32_t flushing : 1;
+#if LV_USE_DISP_OUT_CONV
+    volatile uint32_t out_flushing : 1; /*`out_buf` of the driver is being flushed*/
+#endif
 } lv_disp_buf_t;
 
 /**
@@ -84,13 +87,33 @@ typedef struct _disp_drv_t
      * called when finished */
     void (*flush_cb)(struct _disp_drv_t * disp_drv, const lv_area_t * area, lv_color_t * color_p);
 
+#if LV_USE_DISP_OUT_CONV
+    /** OPTIONAL: Convert the rendered pixels to this format before `flush_cb`.
+     * `color_p` of `flush_cb` will point to `out_buf` with the converted pixels.
+     * With `LV_COLOR_FMT_L4/L2/I1` the pixels are packed (first pixel in the MSB, every row starts on a new byte)
+     * which fits the memory layout of most gray scale and monochrome (e.g. OLED and e-paper) displays.
+     * `LV_COLOR_FMT_NATIVE` (default): no conversion */
+    lv_color_fmt_t out_fmt;
+
+    /** Buffer for the converted pixels. Its size has to be `lv_color_fmt_get_px_size(out_fmt)` times the size of
+     * the display buffer (in pixel count). The display buffer is released after the conversion so the next part
+     * of the screen can be rendered while `flush_cb` sends `out_buf`.*/
+    void * out_buf;
+
+    /** 1: dither while converting to a format with less color bits (e.g. `LV_COLOR_FMT_RGB565` with
+     * `LV_COLOR_DEPTH 32`). Avoids the banding of gradients on 16 and 8 bit displays
+     * and shows the shades of anti-aliasing and gradients on 1, 2 and 4 bit gray scale displays.*/
+    uint32_t out_dither : 1;
+#endif
+
     /** OPTIONAL: Extend the invalidated areas to match with the display drivers requirements
      * E.g. round `y` to, 8, 16 ..) on a monochrome display*/
     void (*rounder_cb)(struct _disp_drv_t * disp_drv, lv_area_t * area);
 
     /** OPTIONAL: Set a pixel in a buffer according to the special requirements of the display
-     * Can be used for color format not supported in LittelvGL. E.g. 2 bit -> 4 gray scales
-     * @note Much slower then drawing with supported color formats. */
+     * Can be used for color format not supported in LittelvGL.
+     * @note Much slower then drawing with supported color formats.
+     * For 1, 2, 4 and 8 bit gray scale displays use `out_fmt` instead. */
     void (*set_px_cb)(struct _disp_drv_t * disp_drv, uint8_t * buf, lv_coord_t buf_w, lv_coord_t x, lv_coord_t y,
                       lv_color_t color, lv_opa_t opa);
 
@@ -108,6 +131,10 @@ typedef struct _disp_drv_t
                         const lv_area_t * fill_area, lv_color_t color);
 #endif
 
+    /** OPTIONAL: Draw the pixels with this backend (e.g. `&lv_draw_backend_thread`).
+     * `NULL` (default): `lv_draw_backend_sw`*/
+    const struct _lv_draw_backend_t * draw_backend;
+
     /** On CHROMA_KEYED images this color will be transparent.
      * `LV_COLOR_TRANSP` by default. (lv_conf.h)*/
     lv_color_t color_chroma_key;
@@ -19,8 +19,8 @@
 #define LV_BIDI_BRACKLET_DEPTH   4
 
 // Highest bit of the 16-bit pos_conv value specifies whether this pos is RTL or not
-#define GET_POS(x) ((x) & 0x7FFF)
-#define IS_RTL_POS(x) (((x) & 0x8000) != 0)
+#define GET_POS(x) LV_BIDI_POS_GET(x)
+#define IS_RTL_POS(x) LV_BIDI_POS_IS_RTL(x)
 #define SET_RTL_POS(x, is_rtl) (GET_POS(x) | ((is_rtl)? 0x8000: 0))
 
 /**********************
@@ -147,13 +147,7 @@ bool lv_bidi_letter_is_neutral(uint32_t letter)
 
 uint16_t lv_bidi_get_logical_pos(const char * str_in, char **bidi_txt, uint32_t len, lv_bidi_dir_t base_dir, uint32_t visual_pos, bool *is_rtl)
 {
-    uint32_t pos_conv_len = get_txt_len(str_in, len);
-    uint32_t txt_buf_size = len + 1;
-    txt_buf_size = (txt_buf_size + 3) & (~0x3);
-    void *buf = lv_draw_get_buf(txt_buf_size + pos_conv_len * sizeof(uint16_t));
-    if (bidi_txt) *bidi_txt = buf;
-    uint16_t *pos_conv_buf = (uint16_t*) ((char*)buf + txt_buf_size);
-    lv_bidi_process_paragraph(str_in, bidi_txt? *bidi_txt: NULL, len, base_dir, pos_conv_buf, pos_conv_len);
+    uint16_t *pos_conv_buf = lv_bidi_get_pos_conv(str_in, bidi_txt, len, base_dir);
     if (is_rtl) *is_rtl = IS_RTL_POS(pos_conv_buf[visual_pos]);
     return GET_POS(pos_conv_buf[visual_pos]);
 }
@@ -161,12 +155,7 @@ uint16_t lv_bidi_get_logical_pos(const char * str_in, char **bidi_txt, uint32_t
 uint16_t lv_bidi_get_visual_pos(const char * str_in, char **bidi_txt, uint16_t len, lv_bidi_dir_t base_dir, uint32_t logical_pos, bool *is_rtl)
 {
     uint32_t pos_conv_len = get_txt_len(str_in, len);
-    uint32_t txt_buf_size = len + 1;
-    txt_buf_size = (txt_buf_size + 3) & (~0x3);
-    void *buf = lv_draw_get_buf(txt_buf_size + pos_conv_len * sizeof(uint16_t));
-    if (bidi_txt) *bidi_txt = buf;
-    uint16_t *pos_conv_buf = (uint16_t*) ((char*)buf + txt_buf_size);
-    lv_bidi_process_paragraph(str_in, bidi_txt? *bidi_txt: NULL, len, base_dir, pos_conv_buf, pos_conv_len);
+    uint16_t *pos_conv_buf = lv_bidi_get_pos_conv(str_in, bidi_txt, len, base_dir);
     for (uint16_t i = 0; i < pos_conv_len; i++){
         if (GET_POS(pos_conv_buf[i]) == logical_pos){
             if (is_rtl) *is_rtl = IS_RTL_POS(pos_conv_buf[i]);
@@ -176,6 +165,29 @@ uint16_t lv_bidi_get_visual_pos(const char * str_in, char **bidi_txt, uint16_t l
     return (uint16_t) -1;
 }
 
+/**
+ * Process a paragraph into the draw buffer and get the logical position of every visual character.
+ * Process a line only once and use the result for every character instead of calling
+ * `lv_bidi_get_logical_pos/visual_pos` per character.
+ * @param str_in the paragraph to process
+ * @param bidi_txt if not NULL the paragraph in visual order will be stored here (in the draw buffer)
+ * @param len length of the paragraph in bytes
+ * @param base_dir base direction of the paragraph
+ * @return logical position of the visual characters (see `LV_BIDI_POS_GET/IS_RTL`) in the draw buffer.
+ *         Valid until the next `lv_draw_get_buf()`.
+ */
+uint16_t * lv_bidi_get_pos_conv(const char * str_in, char **bidi_txt, uint32_t len, lv_bidi_dir_t base_dir)
+{
+    uint32_t pos_conv_len = get_txt_len(str_in, len);
+    uint32_t txt_buf_size = len + 1;
+    txt_buf_size = (txt_buf_size + 3) & (~0x3);
+    void *buf = lv_draw_get_buf(txt_buf_size + pos_conv_len * sizeof(uint16_t));
+    if (bidi_txt) *bidi_txt = buf;
+    uint16_t *pos_conv_buf = (uint16_t*) ((char*)buf + txt_buf_size);
+    lv_bidi_process_paragraph(str_in, bidi_txt? *bidi_txt: NULL, len, base_dir, pos_conv_buf, pos_conv_len);
+    return pos_conv_buf;
+}
+
 void lv_bidi_process_paragraph(const char * str_in, char * str_out, uint32_t len, lv_bidi_dir_t base_dir, uint16_t *pos_conv_out, uint16_t pos_conv_len)
 {
     uint32_t run_len = 0;
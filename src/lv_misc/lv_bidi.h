@@ -30,6 +30,11 @@ extern "C" {
 #define LV_BIDI_LRO  "\xE2\x80\xAD" /*U+202D*/
 #define LV_BIDI_RLO  "\xE2\x80\xAE" /*U+202E*/
 
+/* The position conversion maps store the logical character position of the visual characters.
+ * The highest bit is set if the character is in an RTL run.*/
+#define LV_BIDI_POS_GET(x)      ((x) & 0x7FFF)
+#define LV_BIDI_POS_IS_RTL(x)   (((x) & 0x8000) != 0)
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -62,6 +67,7 @@ bool lv_bidi_letter_is_rtl(uint32_t letter);
 bool lv_bidi_letter_is_neutral(uint32_t letter);
 uint16_t lv_bidi_get_logical_pos(const char * str_in, char **bidi_txt, uint32_t len, lv_bidi_dir_t base_dir, uint32_t visual_pos, bool *is_rtl);
 uint16_t lv_bidi_get_visual_pos(const char * str_in, char **bidi_txt, uint16_t len, lv_bidi_dir_t base_dir, uint32_t logical_pos, bool *is_rtl);
+uint16_t * lv_bidi_get_pos_conv(const char * str_in, char **bidi_txt, uint32_t len, lv_bidi_dir_t base_dir);
 
 /**********************
  *      MACROS
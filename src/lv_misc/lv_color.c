@@ -6,8 +6,10 @@
 /*********************
  *      INCLUDES
  *********************/
+#include <string.h>
 #include "lv_color.h"
 #include "lv_math.h"
+#include "lv_types.h"
 
 /*********************
  *      DEFINES
@@ -20,21 +22,40 @@
 /**********************
  *  STATIC PROTOTYPES
  **********************/
+static void conv_565(uint16_t * dest, const lv_color_t * src, uint32_t px_cnt, lv_color_fmt_t fmt);
+static void conv_888(uint8_t * dest, const lv_color_t * src, uint32_t px_cnt, lv_color_fmt_t fmt);
+static void conv_8888(uint32_t * dest, const lv_color_t * src, uint32_t px_cnt, lv_color_fmt_t fmt);
+static void conv_332(uint8_t * dest, const lv_color_t * src, uint32_t px_cnt);
+static inline uint32_t px_to_xrgb(lv_color_t c);
+static void conv_gray(uint8_t * dest, const lv_color_t * src, uint32_t px_cnt, uint8_t bpp, const uint8_t * ofs);
+static inline uint8_t px_to_lum(lv_color_t c);
+static inline uint32_t dither_add(uint32_t c, uint32_t th);
 
 /**********************
  *  STATIC VARIABLES
  **********************/
+/*4x4 Bayer matrix: the order of the dither thresholds*/
+static const uint8_t dither_bayer4[4][4] = {
+    { 0,  8,  2, 10},
+    {12,  4, 14,  6},
+    { 3, 11,  1,  9},
+    {15,  7, 13,  5}
+};
 
 /**********************
  *      MACROS
  **********************/
+/*Swap the bytes of both 16 bit pixels in a 32 bit word*/
+#define SWAP_BYTES_2PX(w) ((((w) & 0x00FF00FFU) << 8) | (((w) >> 8) & 0x00FF00FFU))
 
-/**********************
- *   GLOBAL FUNCTIONS
- **********************/
+/*Swap red and blue of both RGB565 pixels in a 32 bit word*/
+#define SWAP_RB_2PX(w) (((w) & 0x07E007E0U) | (((w) >> 11) & 0x001F001FU) | (((w) & 0x001F001FU) << 11))
+
+/*Swap red and blue of an XRGB8888 pixel*/
+#define SWAP_RB_32(w) (((w) & 0xFF00FF00U) | (((w) >> 16) & 0xFFU) | (((w) & 0xFFU) << 16))
 
 /**********************
- *   STATIC FUNCTIONS
+ *   GLOBAL FUNCTIONS
  **********************/
 
 /**
@@ -169,3 +190,356 @@ lv_color_hsv_t lv_color_to_hsv(lv_color_t color)
     color32.full = lv_color_to32(color);
     return lv_color_rgb_to_hsv(color32.ch.red, color32.ch.green, color32.ch.blue);
 }
+
+/**
+ * Get the size of a pixel in a pixel format
+ * @param fmt a pixel format. E.g. `LV_COLOR_FMT_RGB888`
+ * @return size of a pixel in bytes
+ */
+uint8_t lv_color_fmt_get_px_size(lv_color_fmt_t fmt)
+{
+    switch(fmt) {
+        case LV_COLOR_FMT_RGB565:
+        case LV_COLOR_FMT_RGB565_SWAP:
+        case LV_COLOR_FMT_BGR565: return 2;
+        case LV_COLOR_FMT_RGB888:
+        case LV_COLOR_FMT_BGR888: return 3;
+        case LV_COLOR_FMT_XRGB8888:
+        case LV_COLOR_FMT_XBGR8888: return 4;
+        case LV_COLOR_FMT_RGB332:
+        case LV_COLOR_FMT_L8:
+        case LV_COLOR_FMT_L4:
+        case LV_COLOR_FMT_L2:
+        case LV_COLOR_FMT_I1: return 1;
+        default: return sizeof(lv_color_t);
+    }
+}
+
+/**
+ * Get the number of bits of a pixel in a pixel format
+ * @param fmt a pixel format. E.g. `LV_COLOR_FMT_L4`
+ * @return bits per pixel
+ */
+uint8_t lv_color_fmt_get_bpp(lv_color_fmt_t fmt)
+{
+    switch(fmt) {
+        case LV_COLOR_FMT_L4: return 4;
+        case LV_COLOR_FMT_L2: return 2;
+        case LV_COLOR_FMT_I1: return 1;
+        default: return lv_color_fmt_get_px_size(fmt) * 8;
+    }
+}
+
+/**
+ * Get the size of a row of pixels in a pixel format
+ * @param fmt a pixel format. E.g. `LV_COLOR_FMT_I1`
+ * @param px_cnt number of pixels in the row
+ * @return size of the row in bytes
+ */
+uint32_t lv_color_fmt_get_row_size(lv_color_fmt_t fmt, uint32_t px_cnt)
+{
+    return (px_cnt * lv_color_fmt_get_bpp(fmt) + 7) >> 3;
+}
+
+/**
+ * Convert pixels to an other pixel format
+ * @param dest store the converted pixels here. Has to be `px_cnt * lv_color_fmt_get_px_size(fmt)` bytes.
+ * @param src pixels to convert
+ * @param px_cnt number of pixels to convert
+ * @param fmt convert to this pixel format. E.g. `LV_COLOR_FMT_XRGB8888`
+ */
+void lv_color_conv(void * dest, const lv_color_t * src, uint32_t px_cnt, lv_color_fmt_t fmt)
+{
+    switch(fmt) {
+        case LV_COLOR_FMT_RGB565:
+        case LV_COLOR_FMT_RGB565_SWAP:
+        case LV_COLOR_FMT_BGR565: conv_565(dest, src, px_cnt, fmt); break;
+        case LV_COLOR_FMT_RGB888:
+        case LV_COLOR_FMT_BGR888: conv_888(dest, src, px_cnt, fmt); break;
+        case LV_COLOR_FMT_XRGB8888:
+        case LV_COLOR_FMT_XBGR8888: conv_8888(dest, src, px_cnt, fmt); break;
+        case LV_COLOR_FMT_RGB332: conv_332(dest, src, px_cnt); break;
+        case LV_COLOR_FMT_L8:
+        case LV_COLOR_FMT_L4:
+        case LV_COLOR_FMT_L2:
+        case LV_COLOR_FMT_I1: conv_gray(dest, src, px_cnt, lv_color_fmt_get_bpp(fmt), NULL); break;
+        default: memcpy(dest, src, px_cnt * sizeof(lv_color_t)); break;
+    }
+}
+
+/**
+ * Convert a row of pixels to an other pixel format with 4x4 ordered (Bayer) dithering.
+ * Useful to avoid banding of gradients when rendering with 32 bit colors for a 16 or 8 bit display.
+ * Formats which don't lose color bits are converted without dithering.
+ * @param dest store the converted pixels here. Has to be `px_cnt * lv_color_fmt_get_px_size(fmt)` bytes.
+ * @param src pixels to convert
+ * @param px_cnt number of pixels to convert
+ * @param fmt convert to this pixel format. E.g. `LV_COLOR_FMT_RGB565`
+ * @param x x coordinate of the first pixel on the screen
+ * @param y y coordinate of the row on the screen
+ */
+void lv_color_conv_dither(void * dest, const lv_color_t * src, uint32_t px_cnt, lv_color_fmt_t fmt, int32_t x,
+                          int32_t y)
+{
+    /*Number of bits kept from the 8 bit red, green and blue*/
+    uint8_t bits_r;
+    uint8_t bits_g;
+    uint8_t bits_b;
+    switch(fmt) {
+        case LV_COLOR_FMT_RGB565:
+        case LV_COLOR_FMT_RGB565_SWAP:
+        case LV_COLOR_FMT_BGR565:
+#if LV_COLOR_DEPTH <= 16
+            /*No color bits are lost: the thresholds would only change the exact colors*/
+            lv_color_conv(dest, src, px_cnt, fmt);
+            return;
+#else
+            bits_r = 5;
+            bits_g = 6;
+            bits_b = 5;
+            break;
+#endif
+        case LV_COLOR_FMT_RGB332:
+#if LV_COLOR_DEPTH <= 8
+            lv_color_conv(dest, src, px_cnt, fmt);
+            return;
+#else
+            bits_r = 3;
+            bits_g = 3;
+            bits_b = 2;
+            break;
+#endif
+        case LV_COLOR_FMT_L4:
+        case LV_COLOR_FMT_L2:
+        case LV_COLOR_FMT_I1: {
+            /*The thresholds are used as the rounding offset of the gray levels*/
+            const uint8_t * bayer_row = dither_bayer4[y & 0x3];
+            uint8_t ofs[4];
+            uint8_t i;
+            for(i = 0; i < 4; i++) ofs[i] = (bayer_row[(x + i) & 0x3] << 4) + 8;
+            conv_gray(dest, src, px_cnt, lv_color_fmt_get_bpp(fmt), ofs);
+            return;
+        }
+        default: lv_color_conv(dest, src, px_cnt, fmt); return;
+    }
+
+    /*The thresholds repeat in every 4 pixels of the row.
+     *Scale them to [0 .. step of the channel) and add them before dropping the lower bits.*/
+    const uint8_t * bayer_row = dither_bayer4[y & 0x3];
+    uint32_t th[4];
+    uint8_t i;
+    for(i = 0; i < 4; i++) {
+        uint32_t t = bayer_row[(x + i) & 0x3];
+        th[i] = (((t << (8 - bits_r)) >> 4) << 16) | (((t << (8 - bits_g)) >> 4) << 8) | ((t << (8 - bits_b)) >> 4);
+    }
+
+    uint32_t p;
+    if(fmt == LV_COLOR_FMT_RGB332) {
+        uint8_t * d8 = dest;
+        for(p = 0; p < px_cnt; p++) {
+            uint32_t c = dither_add(px_to_xrgb(src[p]), th[p & 0x3]);
+            d8[p]      = (uint8_t)(((c >> 16) & 0xE0) | ((c >> 11) & 0x1C) | ((c >> 6) & 0x03));
+        }
+        return;
+    }
+
+    uint16_t * d16 = dest;
+    if(fmt == LV_COLOR_FMT_BGR565) {
+        for(p = 0; p < px_cnt; p++) {
+            uint32_t c = dither_add(px_to_xrgb(src[p]), th[p & 0x3]);
+            d16[p]     = (uint16_t)(((c << 8) & 0xF800) | ((c >> 5) & 0x07E0) | ((c >> 19) & 0x001F));
+        }
+    } else if(fmt == LV_COLOR_FMT_RGB565_SWAP) {
+        for(p = 0; p < px_cnt; p++) {
+            uint32_t c = dither_add(px_to_xrgb(src[p]), th[p & 0x3]);
+            uint32_t v = ((c >> 8) & 0xF800) | ((c >> 5) & 0x07E0) | ((c >> 3) & 0x001F);
+            d16[p]     = (uint16_t)SWAP_BYTES_2PX(v);
+        }
+    } else {
+        for(p = 0; p < px_cnt; p++) {
+            uint32_t c = dither_add(px_to_xrgb(src[p]), th[p & 0x3]);
+            d16[p]     = (uint16_t)(((c >> 8) & 0xF800) | ((c >> 5) & 0x07E0) | ((c >> 3) & 0x001F));
+        }
+    }
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static void conv_565(uint16_t * dest, const lv_color_t * src, uint32_t px_cnt, lv_color_fmt_t fmt)
+{
+    uint32_t i = 0;
+#if LV_COLOR_DEPTH == 16
+    /*Only the bytes and/or red and blue need to be swapped.
+     *With LV_COLOR_16_SWAP the bytes are swapped back first so red and blue are at their place.*/
+    uint8_t swap_bytes = (fmt == LV_COLOR_FMT_RGB565_SWAP) != (LV_COLOR_16_SWAP != 0);
+    uint8_t swap_rb    = fmt == LV_COLOR_FMT_BGR565;
+    const uint16_t * src16 = (const uint16_t *)src;
+
+    if(swap_bytes == 0 && swap_rb == 0) {
+        memcpy(dest, src, px_cnt * sizeof(uint16_t));
+        return;
+    }
+
+    /*Convert 2 pixels at once in a 32 bit word if both buffers can be aligned to 4 bytes*/
+    if((((lv_uintptr_t)src16 ^ (lv_uintptr_t)dest) & 0x3) == 0) {
+        if(((lv_uintptr_t)src16 & 0x3) && px_cnt > 0) {
+            uint32_t v = src16[0];
+            if(swap_bytes) v = SWAP_BYTES_2PX(v);
+            if(swap_rb) v = SWAP_RB_2PX(v);
+            dest[0] = (uint16_t)v;
+            i = 1;
+        }
+
+        const uint32_t * s32 = (const uint32_t *)(src16 + i);
+        uint32_t * d32       = (uint32_t *)(dest + i);
+        uint32_t w_cnt       = (px_cnt - i) >> 1;
+        uint32_t w;
+        if(swap_bytes && swap_rb) {
+            for(w = 0; w < w_cnt; w++) d32[w] = SWAP_RB_2PX(SWAP_BYTES_2PX(s32[w]));
+        } else if(swap_bytes) {
+            for(w = 0; w < w_cnt; w++) d32[w] = SWAP_BYTES_2PX(s32[w]);
+        } else {
+            for(w = 0; w < w_cnt; w++) d32[w] = SWAP_RB_2PX(s32[w]);
+        }
+        i += w_cnt << 1;
+    }
+
+    for(; i < px_cnt; i++) {
+        uint32_t v = src16[i];
+        if(swap_bytes) v = SWAP_BYTES_2PX(v);
+        if(swap_rb) v = SWAP_RB_2PX(v);
+        dest[i] = (uint16_t)v;
+    }
+#else
+    for(; i < px_cnt; i++) {
+        uint32_t c = px_to_xrgb(src[i]);
+        uint32_t v;
+        if(fmt == LV_COLOR_FMT_BGR565) v = ((c << 8) & 0xF800) | ((c >> 5) & 0x07E0) | ((c >> 19) & 0x001F);
+        else v = ((c >> 8) & 0xF800) | ((c >> 5) & 0x07E0) | ((c >> 3) & 0x001F);
+
+        if(fmt == LV_COLOR_FMT_RGB565_SWAP) v = SWAP_BYTES_2PX(v);
+        dest[i] = (uint16_t)v;
+    }
+#endif
+}
+
+static void conv_888(uint8_t * dest, const lv_color_t * src, uint32_t px_cnt, lv_color_fmt_t fmt)
+{
+    /*Byte index of red and blue in a pixel*/
+    uint8_t r_i = fmt == LV_COLOR_FMT_RGB888 ? 0 : 2;
+    uint8_t b_i = 2 - r_i;
+
+    uint32_t i;
+    for(i = 0; i < px_cnt; i++) {
+        uint32_t c = px_to_xrgb(src[i]);
+        dest[r_i] = (uint8_t)(c >> 16);
+        dest[1]   = (uint8_t)(c >> 8);
+        dest[b_i] = (uint8_t)c;
+        dest += 3;
+    }
+}
+
+static void conv_8888(uint32_t * dest, const lv_color_t * src, uint32_t px_cnt, lv_color_fmt_t fmt)
+{
+    uint32_t i;
+    if(fmt == LV_COLOR_FMT_XRGB8888) {
+        for(i = 0; i < px_cnt; i++) dest[i] = px_to_xrgb(src[i]);
+    } else {
+        for(i = 0; i < px_cnt; i++) dest[i] = SWAP_RB_32(px_to_xrgb(src[i]));
+    }
+}
+
+static void conv_332(uint8_t * dest, const lv_color_t * src, uint32_t px_cnt)
+{
+    uint32_t i;
+    for(i = 0; i < px_cnt; i++) {
+        uint32_t c = px_to_xrgb(src[i]);
+        dest[i]    = (uint8_t)(((c >> 16) & 0xE0) | ((c >> 11) & 0x1C) | ((c >> 6) & 0x03));
+    }
+}
+
+/**
+ * Convert pixels to luminance and pack them into bytes
+ * @param dest store the packed pixels here
+ * @param src pixels to convert
+ * @param px_cnt number of pixels
+ * @param bpp bits per pixel: 1, 2, 4 or 8
+ * @param ofs rounding offsets of 4 consecutive pixels [1/256 gray level] for dithering. NULL: round to the nearest.
+ */
+static void conv_gray(uint8_t * dest, const lv_color_t * src, uint32_t px_cnt, uint8_t bpp, const uint8_t * ofs)
+{
+    uint32_t i;
+    if(bpp == 8) {
+        for(i = 0; i < px_cnt; i++) dest[i] = px_to_lum(src[i]);
+        return;
+    }
+
+    /* Quantize the 0..255 luminance to 0..max levels with (lum * max + ofs) >> 8.
+     * The levels of the pixels are shifted into a byte from the right.*/
+    uint32_t max       = (1 << bpp) - 1;
+    uint8_t px_per_byte = 8 / bpp;
+    uint32_t acc        = 0;
+    uint8_t acc_cnt     = 0;
+    for(i = 0; i < px_cnt; i++) {
+        uint32_t o = ofs ? ofs[i & 0x3] : 128;
+        acc        = (acc << bpp) | ((px_to_lum(src[i]) * max + o) >> 8);
+        acc_cnt++;
+        if(acc_cnt == px_per_byte) {
+            *dest = (uint8_t)acc;
+            dest++;
+            acc     = 0;
+            acc_cnt = 0;
+        }
+    }
+
+    /*The last pixels go to the most significant bits of the last byte*/
+    if(acc_cnt) *dest = (uint8_t)(acc << (bpp * (px_per_byte - acc_cnt)));
+}
+
+/**
+ * Get the luminance of a color. The same as `lv_color_brightness()`
+ * but it's based on `px_to_xrgb()` to be fast with 16 bit colors.
+ */
+static inline uint8_t px_to_lum(lv_color_t c)
+{
+#if LV_COLOR_DEPTH == 1
+    return c.full ? 0xFF : 0x00;
+#else
+    uint32_t v = px_to_xrgb(c);
+    return (uint8_t)((3 * ((v >> 16) & 0xFF) + 4 * ((v >> 8) & 0xFF) + (v & 0xFF)) >> 3);
+#endif
+}
+
+/**
+ * Convert a color to XRGB8888. The same as `lv_color_to32()` with opaque alpha
+ * but with 16 bit colors it works on the raw value so the compiler can vectorize the loops.
+ */
+static inline uint32_t px_to_xrgb(lv_color_t c)
+{
+#if LV_COLOR_DEPTH == 16
+    uint32_t v = c.full;
+#if LV_COLOR_16_SWAP
+    v = SWAP_BYTES_2PX(v);
+#endif
+    uint32_t r = ((v >> 11) * 263 + 7) >> 5;
+    uint32_t g = (((v >> 5) & 0x3F) * 259 + 3) >> 6;
+    uint32_t b = ((v & 0x1F) * 263 + 7) >> 5;
+    return 0xFF000000 | (r << 16) | (g << 8) | b;
+#else
+    return lv_color_to32(c) | 0xFF000000;
+#endif
+}
+
+/**
+ * Add the dither thresholds to the red, green and blue bytes of an XRGB8888 color.
+ * The bytes are added in parallel and saturate at 0xFF.
+ */
+static inline uint32_t dither_add(uint32_t c, uint32_t th)
+{
+    c &= 0x00FFFFFF;
+    uint32_t sum  = ((c & 0x7F7F7F) + th) ^ (c & 0x808080); /*The thresholds are < 0x80: no carry between bytes*/
+    uint32_t ovf  = (c & ~sum) & 0x808080;                  /*The MSB was set but it's cleared by a carry*/
+    return sum | ((ovf >> 7) * 0xFF);
+}
@@ -275,6 +275,26 @@ typedef struct
     uint8_t v;
 } lv_color_hsv_t;
 
+/** Pixel formats to which `lv_color_conv()` can convert `lv_color_t` pixels.
+ * The formats with less than 8 bits are packed: the first pixel is in the most significant bits of a byte
+ * and every row starts on a new byte.*/
+enum {
+    LV_COLOR_FMT_NATIVE = 0,  /**< `lv_color_t`, no conversion*/
+    LV_COLOR_FMT_RGB565,      /**< `uint16_t`: RRRRRGGG GGGBBBBB*/
+    LV_COLOR_FMT_RGB565_SWAP, /**< RGB565 with swapped bytes (e.g. for displays on an 8 bit SPI)*/
+    LV_COLOR_FMT_BGR565,      /**< `uint16_t`: BBBBBGGG GGGRRRRR*/
+    LV_COLOR_FMT_RGB888,      /**< 3 bytes: red, green, blue*/
+    LV_COLOR_FMT_BGR888,      /**< 3 bytes: blue, green, red (e.g. 24 bit Linux frame buffer)*/
+    LV_COLOR_FMT_XRGB8888,    /**< `uint32_t`: 0xFFRRGGBB*/
+    LV_COLOR_FMT_XBGR8888,    /**< `uint32_t`: 0xFFBBGGRR*/
+    LV_COLOR_FMT_RGB332,      /**< `uint8_t`: RRRGGGBB*/
+    LV_COLOR_FMT_L8,          /**< `uint8_t` luminance (gray scale): 0: black, 255: white*/
+    LV_COLOR_FMT_L4,          /**< 4 bit luminance, 2 pixels in a byte*/
+    LV_COLOR_FMT_L2,          /**< 2 bit luminance, 4 pixels in a byte*/
+    LV_COLOR_FMT_I1,          /**< 1 bit monochrome, 8 pixels in a byte. 0: dark, 1: light*/
+};
+typedef uint8_t lv_color_fmt_t;
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -515,6 +535,53 @@ lv_color_hsv_t lv_color_rgb_to_hsv(uint8_t r8, uint8_t g8, uint8_t b8);
  */
 lv_color_hsv_t lv_color_to_hsv(lv_color_t color);
 
+/**
+ * Get the size of a pixel in a pixel format
+ * @param fmt a pixel format. E.g. `LV_COLOR_FMT_RGB888`
+ * @return size of a pixel in bytes (1 with the packed formats, i.e. an upper limit)
+ */
+uint8_t lv_color_fmt_get_px_size(lv_color_fmt_t fmt);
+
+/**
+ * Get the number of bits of a pixel in a pixel format
+ * @param fmt a pixel format. E.g. `LV_COLOR_FMT_L4`
+ * @return bits per pixel
+ */
+uint8_t lv_color_fmt_get_bpp(lv_color_fmt_t fmt);
+
+/**
+ * Get the size of a row of pixels in a pixel format
+ * @param fmt a pixel format. E.g. `LV_COLOR_FMT_I1`
+ * @param px_cnt number of pixels in the row
+ * @return size of the row in bytes
+ */
+uint32_t lv_color_fmt_get_row_size(lv_color_fmt_t fmt, uint32_t px_cnt);
+
+/**
+ * Convert pixels to an other pixel format.
+ * The pixels of the packed formats (e.g. `LV_COLOR_FMT_L4`) are considered as one row.
+ * @param dest store the converted pixels here. Has to be `lv_color_fmt_get_row_size(fmt, px_cnt)` bytes.
+ * @param src pixels to convert
+ * @param px_cnt number of pixels to convert
+ * @param fmt convert to this pixel format. E.g. `LV_COLOR_FMT_XRGB8888`
+ */
+void lv_color_conv(void * dest, const lv_color_t * src, uint32_t px_cnt, lv_color_fmt_t fmt);
+
+/**
+ * Convert a row of pixels to an other pixel format with 4x4 ordered (Bayer) dithering.
+ * Useful to avoid banding of gradients when rendering with 32 bit colors for a 16 or 8 bit display
+ * and to show shades on 1, 2 and 4 bit gray scale displays.
+ * Formats which don't lose color bits are converted without dithering.
+ * @param dest store the converted pixels here. Has to be `lv_color_fmt_get_row_size(fmt, px_cnt)` bytes.
+ * @param src pixels to convert
+ * @param px_cnt number of pixels to convert
+ * @param fmt convert to this pixel format. E.g. `LV_COLOR_FMT_RGB565`
+ * @param x x coordinate of the first pixel on the screen
+ * @param y y coordinate of the row on the screen
+ */
+void lv_color_conv_dither(void * dest, const lv_color_t * src, uint32_t px_cnt, lv_color_fmt_t fmt, int32_t x,
+                          int32_t y);
+
 /**********************
  *      MACROS
  **********************/
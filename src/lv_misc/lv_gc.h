@@ -39,9 +39,12 @@ extern "C" {
     f(lv_ll_t, _lv_anim_ll)                                        \
     f(lv_ll_t, _lv_group_ll)                                       \
     f(lv_ll_t, _lv_img_defoder_ll)                                 \
+    f(lv_ll_t, _lv_img_ram_src_ll)                                 \
     f(lv_img_cache_entry_t*, _lv_img_cache_array)                  \
     f(void*, _lv_task_act)                                         \
-    f(void*, _lv_draw_buf)
+    f(void*, _lv_draw_buf)                                         \
+    f(void*, _lv_draw_list_buf)                                    \
+    f(void*, _lv_grad_cache)
 
 #define LV_DEFINE_ROOT(root_type, root_name) root_type root_name;
 #define LV_ROOTS LV_ITERATE_ROOTS(LV_DEFINE_ROOT)
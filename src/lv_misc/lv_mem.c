@@ -286,6 +286,21 @@ void * lv_mem_realloc(void * data_p, size_t new_size)
 
 #endif /* lv_enable_gc */
 
+/**
+ * Make sure an allocated memory is at least `min_size` bytes large. The old content will be kept.
+ * If it needs to be reallocated it grows with the half of `min_size` more to make the next
+ * (e.g. character by character) extensions cheaper.
+ * @param data pointer to an allocated memory (can be NULL)
+ * @param min_size the required size in bytes
+ * @return pointer to the (maybe) new memory or NULL on error
+ */
+void * lv_mem_grow(void * data_p, size_t min_size)
+{
+    if(data_p != NULL && lv_mem_get_size(data_p) >= min_size) return data_p;
+
+    return lv_mem_realloc(data_p, min_size + (min_size >> 1));
+}
+
 /**
  * Join the adjacent free memory blocks
  */
@@ -22,7 +22,6 @@
 /**********************
  *  STATIC PROTOTYPES
  **********************/
-static inline bool is_break_char(uint32_t letter);
 
 #if LV_TXT_ENC == LV_TXT_ENC_UTF8
 static uint8_t lv_txt_utf8_size(const char * str);
@@ -219,7 +218,7 @@ static uint16_t lv_txt_get_next_word(const char * txt, const lv_font_t * font,
         }
 
         /*Check for new line chars and breakchars*/
-        if(letter == '\n' || letter == '\r' || is_break_char(letter)) {
+        if(letter == '\n' || letter == '\r' || lv_txt_is_break_char(letter)) {
             /* Update the output width on the first character if it fits.
              * Must do this here incase first letter is a break character. */
             if(i == 0 && break_index == NO_BREAK_FOUND && word_w_ptr != NULL) *word_w_ptr = cur_w;
@@ -415,6 +414,27 @@ bool lv_txt_is_cmd(lv_txt_cmd_state_t * state, uint32_t c)
     return ret;
 }
 
+/**
+ * Test if char is break char or not (a text can broken here or not)
+ * @param letter a letter
+ * @return false: 'letter' is not break char
+ */
+bool lv_txt_is_break_char(uint32_t letter)
+{
+    uint8_t i;
+    bool ret = false;
+
+    /*Compare the letter to TXT_BREAK_CHARS*/
+    for(i = 0; LV_TXT_BREAK_CHARS[i] != '\0'; i++) {
+        if(letter == (uint32_t)LV_TXT_BREAK_CHARS[i]) {
+            ret = true; /*If match then it is break char*/
+            break;
+        }
+    }
+
+    return ret;
+}
+
 /**
  * Insert a string into an other
  * @param txt_buf the original text (must be big enough for the result text)
@@ -426,14 +446,10 @@ void lv_txt_ins(char * txt_buf, uint32_t pos, const char * ins_txt)
 {
     size_t old_len = strlen(txt_buf);
     size_t ins_len = strlen(ins_txt);
-    size_t new_len = ins_len + old_len;
     pos              = lv_txt_encoded_get_byte_id(txt_buf, pos); /*Convert to byte index instead of letter index*/
 
-    /*Copy the second part into the end to make place to text to insert*/
-    size_t i;
-    for(i = new_len; i >= pos + ins_len; i--) {
-        txt_buf[i] = txt_buf[i - ins_len];
-    }
+    /*Move the second part (with the closing '\0') to the end to make place to text to insert*/
+    memmove(txt_buf + pos + ins_len, txt_buf + pos, old_len - pos + 1);
 
     /* Copy the text into the new space*/
     memcpy(txt_buf + pos, ins_txt, ins_len);
@@ -454,11 +470,8 @@ void lv_txt_cut(char * txt, uint32_t pos, uint32_t len)
     pos = lv_txt_encoded_get_byte_id(txt, pos); /*Convert to byte index instead of letter index*/
     len = lv_txt_encoded_get_byte_id(&txt[pos], len);
 
-    /*Copy the second part into the end to make place to text to insert*/
-    uint32_t i;
-    for(i = pos; i <= old_len - len; i++) {
-        txt[i] = txt[i + len];
-    }
+    /*Move the second part (with the closing '\0') into the place of the deleted part*/
+    memmove(txt + pos, txt + pos + len, old_len - pos - len + 1);
 }
 
 #if LV_TXT_ENC == LV_TXT_ENC_UTF8
@@ -823,23 +836,3 @@ static uint32_t lv_txt_iso8859_1_get_length(const char * txt)
  *   STATIC FUNCTIONS
  **********************/
 
-/**
- * Test if char is break char or not (a text can broken here or not)
- * @param letter a letter
- * @return false: 'letter' is not break char
- */
-static inline bool is_break_char(uint32_t letter)
-{
-    uint8_t i;
-    bool ret = false;
-
-    /*Compare the letter to TXT_BREAK_CHARS*/
-    for(i = 0; LV_TXT_BREAK_CHARS[i] != '\0'; i++) {
-        if(letter == (uint32_t)LV_TXT_BREAK_CHARS[i]) {
-            ret = true; /*If match then it is break char*/
-            break;
-        }
-    }
-
-    return ret;
-}
@@ -113,6 +113,13 @@ lv_coord_t lv_txt_get_width(const char * txt, uint16_t length, const lv_font_t *
  */
 bool lv_txt_is_cmd(lv_txt_cmd_state_t * state, uint32_t c);
 
+/**
+ * Test if char is break char or not (a text can broken here or not)
+ * @param letter a letter
+ * @return false: 'letter' is not break char
+ */
+bool lv_txt_is_break_char(uint32_t letter);
+
 /**
  * Insert a string into an other
  * @param txt_buf the original text (must be big enough for the result text)
@@ -23,11 +23,30 @@
 /**********************
  *      TYPEDEFS
  **********************/
+/*State of a drawing session (see `lv_canvas_draw_begin()`)*/
+typedef struct
+{
+    lv_disp_t disp;         /*Dummy display to make the `lv_draw_...` functions draw to the canvas*/
+    lv_disp_buf_t disp_buf; /*Display buffer of `disp` on the canvas's buffer*/
+    lv_area_t inv_area;     /*Union of the areas drawn in the session (relative to the canvas)*/
+    uint16_t depth;         /*Number of not closed `lv_canvas_draw_begin()` calls*/
+    uint8_t inv_valid : 1;  /*1: `inv_area` is valid*/
+} lv_canvas_draw_ctx_t;
 
 /**********************
  *  STATIC PROTOTYPES
  **********************/
 static lv_res_t lv_canvas_signal(lv_obj_t * canvas, lv_signal_t sign, void * param);
+static void lv_canvas_blend_row(lv_img_dsc_t * dst, lv_coord_t x, lv_coord_t y, lv_coord_t len,
+                                const uint8_t * buf, const lv_style_t * style);
+static lv_res_t lv_canvas_draw_prepare(lv_obj_t * canvas, const lv_style_t * aa_style, lv_area_t * mask,
+                                       lv_disp_t ** refr_ori);
+static void lv_canvas_draw_finish(lv_obj_t * canvas, lv_disp_t * refr_ori, const lv_area_t * area);
+static void lv_canvas_draw_ctx_init(lv_canvas_draw_ctx_t * ctx, const lv_img_dsc_t * dsc);
+static void lv_canvas_mark_drawn(lv_obj_t * canvas, const lv_area_t * area);
+static void lv_canvas_invalidate_area(lv_obj_t * canvas, const lv_area_t * area);
+static void lv_canvas_get_points_area(const lv_point_t * points, uint32_t point_cnt, lv_coord_t ext_size,
+                                      lv_area_t * res);
 
 /**********************
  *  STATIC VARIABLES
@@ -72,6 +91,7 @@ lv_obj_t * lv_canvas_create(lv_obj_t * par, const lv_obj_t * copy)
     ext->dsc.header.w           = 0;
     ext->dsc.data_size          = 0;
     ext->dsc.data               = NULL;
+    ext->draw_ctx               = NULL;
 
     lv_img_set_src(new_canvas, &ext->dsc);
 
@@ -99,6 +119,7 @@ lv_obj_t * lv_canvas_create(lv_obj_t * par, const lv_obj_t * copy)
 
 /**
  * Set a buffer for the canvas.
+ * If a drawing session is open (see `lv_canvas_draw_begin()`) it continues on the new buffer.
  * @param buf a buffer where the content of the canvas will be.
  * The required size is (lv_img_color_format_get_px_size(cf) * w * h) / 8)
  * It can be allocated with `lv_mem_alloc()` or
@@ -124,6 +145,14 @@ void lv_canvas_set_buffer(lv_obj_t * canvas, void * buf, lv_coord_t w, lv_coord_
     ext->dsc.data      = buf;
     ext->dsc.data_size = (lv_img_color_format_get_px_size(cf) * w * h) / 8;
 
+    /*An open drawing session continues on the new buffer.
+     *The whole canvas is invalidated by `lv_img_set_src()` so the areas drawn so far can be forgotten.*/
+    if(ext->draw_ctx) {
+        lv_canvas_draw_ctx_t * ctx = ext->draw_ctx;
+        lv_canvas_draw_ctx_init(ctx, &ext->dsc);
+        ctx->inv_valid = 0;
+    }
+
     lv_img_set_src(canvas, &ext->dsc);
 }
 
@@ -141,7 +170,15 @@ void lv_canvas_set_px(lv_obj_t * canvas, lv_coord_t x, lv_coord_t y, lv_color_t
     lv_canvas_ext_t * ext = lv_obj_get_ext_attr(canvas);
 
     lv_img_buf_set_px_color(&ext->dsc, x, y, c);
-    lv_obj_invalidate(canvas);
+
+    /*In a drawing session only remember the pixel to invalidate it together with the others*/
+    if(ext->draw_ctx) {
+        lv_area_t px_area;
+        lv_area_set(&px_area, x, y, x, y);
+        lv_canvas_mark_drawn(canvas, &px_area);
+    } else {
+        lv_obj_invalidate(canvas);
+    }
 }
 
 /**
@@ -268,6 +305,10 @@ void lv_canvas_copy_buf(lv_obj_t * canvas, const void * to_copy, lv_coord_t x, l
         px += ext->dsc.header.w * px_size;
         to_copy8 += w * px_size;
     }
+
+    lv_area_t copied;
+    lv_area_set(&copied, x, y, x + w - 1, y + h - 1);
+    lv_canvas_mark_drawn(canvas, &copied);
 }
 
 /**
@@ -291,159 +332,44 @@ void lv_canvas_rotate(lv_obj_t * canvas, lv_img_dsc_t * img, int16_t angle, lv_c
 
     lv_canvas_ext_t * ext_dst = lv_obj_get_ext_attr(canvas);
     const lv_style_t * style  = lv_canvas_get_style(canvas, LV_CANVAS_STYLE_MAIN);
-    int32_t sinma             = lv_trigo_sin(-angle);
-    int32_t cosma             = lv_trigo_sin(-angle + 90); /* cos */
-
-    int32_t img_width   = img->header.w;
-    int32_t img_height  = img->header.h;
-    int32_t dest_width  = ext_dst->dsc.header.w;
-    int32_t dest_height = ext_dst->dsc.header.h;
-
-    int32_t x;
-    int32_t y;
-    for(x = -offset_x; x < dest_width - offset_x; x++) {
-        for(y = -offset_y; y < dest_height - offset_y; y++) {
-            /*Get the target point relative coordinates to the pivot*/
-            int32_t xt = x - pivot_x;
-            int32_t yt = y - pivot_y;
-
-            /*Get the source pixel from the upscaled image*/
-            int32_t xs = ((cosma * xt - sinma * yt) >> (LV_TRIGO_SHIFT - 8)) + pivot_x * 256;
-            int32_t ys = ((sinma * xt + cosma * yt) >> (LV_TRIGO_SHIFT - 8)) + pivot_y * 256;
-
-            /*Get the integer part of the source pixel*/
-            int xs_int = xs >> 8;
-            int ys_int = ys >> 8;
-
-            if(xs_int >= img_width)
-                continue;
-            else if(xs_int < 0)
-                continue;
-
-            if(ys_int >= img_height)
-                continue;
-            else if(ys_int < 0)
-                continue;
-
-            /*Get the fractional part of the source pixel*/
-            int xs_fract = xs & 0xff;
-            int ys_fract = ys & 0xff;
-
-            /* If the fractional < 0x70 mix the source pixel with the left/top pixel
-             * If the fractional > 0x90 mix the source pixel with the right/bottom pixel
-             * In the 0x70..0x90 range use the unchanged source pixel */
-
-            int xn;      /*x neightboor*/
-            lv_opa_t xr; /*x mix ratio*/
-            if(xs_fract < 0x70) {
-                xn = xs_int - 1;
-                xr = xs_fract * 2;
-            } else if(xs_fract > 0x90) {
-                xn = xs_int + 1;
-                xr = (0xFF - xs_fract) * 2;
-            } else {
-                xn = xs_int;
-                xr = 0xFF;
-            }
-
-            /*Handle under/overflow*/
-            if(xn >= img_width)
-                continue;
-            else if(xn < 0)
-                continue;
-
-            int yn;      /*y neightboor*/
-            lv_opa_t yr; /*y mix ratio*/
-            if(ys_fract < 0x70) {
-                yn = ys_int - 1;
-                yr = ys_fract * 2;
-            } else if(ys_fract > 0x90) {
-                yn = ys_int + 1;
-                yr = (0xFF - ys_fract) * 2;
-            } else {
-                yn = ys_int;
-                yr = 0xFF;
-            }
-
-            /*Handle under/overflow*/
-            if(yn >= img_height)
-                continue;
-            else if(yn < 0)
-                continue;
-
-            /*Get the mixture of the original source and the neightboor pixels in both directions*/
-            lv_color_t c_dest_int = lv_img_buf_get_px_color(img, xs_int, ys_int, style);
-
-            if(lv_img_color_format_is_chroma_keyed(img->header.cf)) {
-                lv_color_t ct = LV_COLOR_TRANSP;
-                if(c_dest_int.full == ct.full) continue;
-            }
-
-            lv_color_t c_dest_xn = lv_img_buf_get_px_color(img, xn, ys_int, style);
-            lv_color_t c_dest_yn = lv_img_buf_get_px_color(img, xs_int, yn, style);
-            lv_color_t x_dest    = lv_color_mix(c_dest_int, c_dest_xn, xr);
-            lv_color_t y_dest    = lv_color_mix(c_dest_int, c_dest_yn, yr);
-            lv_color_t color_res = lv_color_mix(x_dest, y_dest, LV_OPA_50);
-
-            if(x + offset_x >= 0 && x + offset_x < dest_width && y + offset_y >= 0 && y + offset_y < dest_height) {
-                /*If the image has no alpha channel just simple set the result color on the canvas*/
-                if(lv_img_color_format_has_alpha(img->header.cf) == false) {
-                    lv_img_buf_set_px_color(&ext_dst->dsc, x + offset_x, y + offset_y, color_res);
-                } else {
-                    /*Get result pixel opacity*/
-                    lv_opa_t opa_int = lv_img_buf_get_px_alpha(img, xs_int, ys_int);
-                    lv_opa_t opa_xn  = lv_img_buf_get_px_alpha(img, xn, ys_int);
-                    lv_opa_t opa_yn  = lv_img_buf_get_px_alpha(img, xs_int, yn);
-                    lv_opa_t opa_x   = (opa_int * xr + (opa_xn * (255 - xr))) >> 8;
-                    lv_opa_t opa_y   = (opa_int * yr + (opa_yn * (255 - yr))) >> 8;
-                    lv_opa_t opa_res = (opa_x + opa_y) / 2;
-                    if(opa_res <= LV_OPA_MIN) continue;
-
-                    lv_color_t bg_color = lv_img_buf_get_px_color(&ext_dst->dsc, x + offset_x, y + offset_y, style);
-
-                    /*If the canvas has no alpha but the image has mix the image's color with
-                     * canvas*/
-                    if(lv_img_color_format_has_alpha(ext_dst->dsc.header.cf) == false) {
-                        if(opa_res < LV_OPA_MAX) color_res = lv_color_mix(color_res, bg_color, opa_res);
-                        lv_img_buf_set_px_color(&ext_dst->dsc, x + offset_x, y + offset_y, color_res);
-                    }
-                    /*Both the image and canvas has alpha channel. Some extra calculation is
-                       required*/
-                    else {
-                        lv_opa_t bg_opa = lv_img_buf_get_px_alpha(&ext_dst->dsc, x + offset_x, y + offset_y);
-                        /* Pick the foreground if it's fully opaque or the Background is fully
-                         * transparent*/
-                        if(opa_res >= LV_OPA_MAX || bg_opa <= LV_OPA_MIN) {
-                            lv_img_buf_set_px_color(&ext_dst->dsc, x + offset_x, y + offset_y, color_res);
-                            lv_img_buf_set_px_alpha(&ext_dst->dsc, x + offset_x, y + offset_y, opa_res);
-                        }
-                        /*Opaque background: use simple mix*/
-                        else if(bg_opa >= LV_OPA_MAX) {
-                            lv_img_buf_set_px_color(&ext_dst->dsc, x + offset_x, y + offset_y,
-                                                    lv_color_mix(color_res, bg_color, opa_res));
-                        }
-                        /*Both colors have alpha. Expensive calculation need to be applied*/
-                        else {
-
-                            /*Info:
-                             * https://en.wikipedia.org/wiki/Alpha_compositing#Analytical_derivation_of_the_over_operator*/
-                            lv_opa_t opa_res_2 = 255 - ((uint16_t)((uint16_t)(255 - opa_res) * (255 - bg_opa)) >> 8);
-                            if(opa_res_2 == 0) {
-                                opa_res_2 = 1; /*never happens, just to be sure*/
-                            }
-                            lv_opa_t ratio = (uint16_t)((uint16_t)opa_res * 255) / opa_res_2;
-
-                            lv_img_buf_set_px_color(&ext_dst->dsc, x + offset_x, y + offset_y,
-                                                    lv_color_mix(color_res, bg_color, ratio));
-                            lv_img_buf_set_px_alpha(&ext_dst->dsc, x + offset_x, y + offset_y, opa_res_2);
-                        }
-                    }
-                }
-            }
-        }
+    lv_img_dsc_t * dst        = &ext_dst->dsc;
+
+    lv_img_transform_dsc_t tr_dsc;
+    tr_dsc.img       = img;
+    tr_dsc.color     = style->image.color;
+    tr_dsc.angle     = (angle % 360) * 10;
+    tr_dsc.zoom      = LV_IMG_ZOOM_NONE;
+    tr_dsc.pivot.x   = pivot_x;
+    tr_dsc.pivot.y   = pivot_y;
+    tr_dsc.antialias = 1;
+    lv_img_transform_init(&tr_dsc);
+
+    /*Only the rows and columns where the rotated image can be need to be processed*/
+    lv_area_t rot_area;
+    lv_img_transform_get_area(&rot_area, img->header.w, img->header.h, tr_dsc.angle, tr_dsc.zoom, &tr_dsc.pivot);
+    lv_area_t dst_area;
+    lv_area_set(&dst_area, 0, 0, dst->header.w - 1, dst->header.h - 1);
+    rot_area.x1 += offset_x;
+    rot_area.y1 += offset_y;
+    rot_area.x2 += offset_x;
+    rot_area.y2 += offset_y;
+    if(lv_area_intersect(&dst_area, &dst_area, &rot_area) == false) return;
+
+    lv_coord_t w  = lv_area_get_width(&dst_area);
+    uint8_t * buf = lv_mem_alloc((uint32_t)w * LV_IMG_PX_SIZE_ALPHA_BYTE);
+    LV_ASSERT_MEM(buf);
+    if(buf == NULL) return;
+
+    lv_coord_t y;
+    for(y = dst_area.y1; y <= dst_area.y2; y++) {
+        /*Sample a whole row of the rotated image and blend it to the canvas*/
+        lv_img_transform_row(&tr_dsc, dst_area.x1 - offset_x, y - offset_y, w, buf);
+        lv_canvas_blend_row(dst, dst_area.x1, y, w, buf, style);
     }
 
-    lv_obj_invalidate(canvas);
+    lv_mem_free(buf);
+
+    lv_canvas_mark_drawn(canvas, &dst_area);
 }
 
 /**
@@ -464,6 +390,61 @@ void lv_canvas_fill_bg(lv_obj_t * canvas, lv_color_t color)
             lv_img_buf_set_px_color(dsc, x, y, color);
         }
     }
+
+    lv_area_t filled;
+    lv_area_set(&filled, 0, 0, dsc->header.w - 1, dsc->header.h - 1);
+    lv_canvas_mark_drawn(canvas, &filled);
+}
+
+/**
+ * Start a drawing session on the canvas.
+ * The `lv_canvas_draw_...` functions and `lv_canvas_set_px()` called until `lv_canvas_draw_end()`
+ * share the same drawing setup and only the union of the drawn areas is invalidated once at the end.
+ * The sessions can be nested.
+ * @param canvas pointer to a canvas object
+ */
+void lv_canvas_draw_begin(lv_obj_t * canvas)
+{
+    LV_ASSERT_OBJ(canvas, LV_OBJX_NAME);
+
+    lv_canvas_ext_t * ext = lv_obj_get_ext_attr(canvas);
+
+    if(ext->draw_ctx) {
+        lv_canvas_draw_ctx_t * ctx = ext->draw_ctx;
+        ctx->depth++;
+        return;
+    }
+
+    lv_canvas_draw_ctx_t * ctx = lv_mem_alloc(sizeof(lv_canvas_draw_ctx_t));
+    LV_ASSERT_MEM(ctx);
+    if(ctx == NULL) return;
+
+    lv_canvas_draw_ctx_init(ctx, &ext->dsc);
+
+    ctx->depth     = 1;
+    ctx->inv_valid = 0;
+    ext->draw_ctx  = ctx;
+}
+
+/**
+ * Close a drawing session started by `lv_canvas_draw_begin()`.
+ * Closing the outermost session invalidates the area drawn in the session.
+ * @param canvas pointer to a canvas object
+ */
+void lv_canvas_draw_end(lv_obj_t * canvas)
+{
+    LV_ASSERT_OBJ(canvas, LV_OBJX_NAME);
+
+    lv_canvas_ext_t * ext      = lv_obj_get_ext_attr(canvas);
+    lv_canvas_draw_ctx_t * ctx = ext->draw_ctx;
+    if(ctx == NULL) return;
+
+    ctx->depth--;
+    if(ctx->depth > 0) return;
+
+    ext->draw_ctx = NULL;
+    if(ctx->inv_valid) lv_canvas_invalidate_area(canvas, &ctx->inv_area);
+    lv_mem_free(ctx);
 }
 
 /**
@@ -481,15 +462,9 @@ void lv_canvas_draw_rect(lv_obj_t * canvas, lv_coord_t x, lv_coord_t y, lv_coord
     LV_ASSERT_OBJ(canvas, LV_OBJX_NAME);
     LV_ASSERT_NULL(style);
 
-    lv_img_dsc_t * dsc = lv_canvas_get_img(canvas);
-
-    /* Create a dummy display to fool the lv_draw function.
-     * It will think it draws to real screen. */
     lv_area_t mask;
-    mask.x1 = 0;
-    mask.x2 = dsc->header.w - 1;
-    mask.y1 = 0;
-    mask.y2 = dsc->header.h - 1;
+    lv_disp_t * refr_ori;
+    if(lv_canvas_draw_prepare(canvas, style, &mask, &refr_ori) != LV_RES_OK) return;
 
     lv_area_t coords;
     coords.x1 = x;
@@ -497,36 +472,15 @@ void lv_canvas_draw_rect(lv_obj_t * canvas, lv_coord_t x, lv_coord_t y, lv_coord
     coords.x2 = x + w - 1;
     coords.y2 = y + h - 1;
 
-    lv_disp_t disp;
-    memset(&disp, 0, sizeof(lv_disp_t));
-
-    lv_disp_buf_t disp_buf;
-    lv_disp_buf_init(&disp_buf, (void *)dsc->data, NULL, dsc->header.w * dsc->header.h);
-    lv_area_copy(&disp_buf.area, &mask);
-
-    lv_disp_drv_init(&disp.driver);
-
-    disp.driver.buffer  = &disp_buf;
-    disp.driver.hor_res = dsc->header.w;
-    disp.driver.ver_res = dsc->header.h;
-
-#if LV_ANTIALIAS
-    /*Disable anti-aliasing if drawing with transparent color to chroma keyed canvas*/
-    lv_color_t ctransp = LV_COLOR_TRANSP;
-    if(dsc->header.cf == LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED &&
-        style->body.main_color.full == ctransp.full &&
-        style->body.grad_color.full == ctransp.full)
-    {
-        disp.driver.antialiasing = 0;
-    }
-#endif
-
-    lv_disp_t * refr_ori = lv_refr_get_disp_refreshing();
-    lv_refr_set_disp_refreshing(&disp);
-
     lv_draw_rect(&coords, &mask, style, LV_OPA_COVER);
 
-    lv_refr_set_disp_refreshing(refr_ori);
+    /*The shadow is drawn out of the rectangle*/
+    lv_coord_t ext_size = style->body.shadow.width;
+    coords.x1 -= ext_size;
+    coords.y1 -= ext_size;
+    coords.x2 += ext_size;
+    coords.y2 += ext_size;
+    lv_canvas_draw_finish(canvas, refr_ori, &coords);
 }
 
 /**
@@ -545,37 +499,15 @@ void lv_canvas_draw_text(lv_obj_t * canvas, lv_coord_t x, lv_coord_t y, lv_coord
     LV_ASSERT_OBJ(canvas, LV_OBJX_NAME);
     LV_ASSERT_NULL(style);
 
-    lv_img_dsc_t * dsc = lv_canvas_get_img(canvas);
-
-    /* Create a dummy display to fool the lv_draw function.
-     * It will think it draws to real screen. */
     lv_area_t mask;
-    mask.x1 = 0;
-    mask.x2 = dsc->header.w - 1;
-    mask.y1 = 0;
-    mask.y2 = dsc->header.h - 1;
+    lv_disp_t * refr_ori;
+    if(lv_canvas_draw_prepare(canvas, NULL, &mask, &refr_ori) != LV_RES_OK) return;
 
     lv_area_t coords;
     coords.x1 = x;
     coords.y1 = y;
     coords.x2 = x + max_w - 1;
-    coords.y2 = dsc->header.h - 1;
-
-    lv_disp_t disp;
-    memset(&disp, 0, sizeof(lv_disp_t));
-
-    lv_disp_buf_t disp_buf;
-    lv_disp_buf_init(&disp_buf, (void *)dsc->data, NULL, dsc->header.w * dsc->header.h);
-    lv_area_copy(&disp_buf.area, &mask);
-
-    lv_disp_drv_init(&disp.driver);
-
-    disp.driver.buffer  = &disp_buf;
-    disp.driver.hor_res = dsc->header.w;
-    disp.driver.ver_res = dsc->header.h;
-
-    lv_disp_t * refr_ori = lv_refr_get_disp_refreshing();
-    lv_refr_set_disp_refreshing(&disp);
+    coords.y2 = mask.y2;
 
     lv_txt_flag_t flag;
     switch(align) {
@@ -585,9 +517,9 @@ void lv_canvas_draw_text(lv_obj_t * canvas, lv_coord_t x, lv_coord_t y, lv_coord
         default: flag = LV_TXT_FLAG_NONE; break;
     }
 
-    lv_draw_label(&coords, &mask, style, LV_OPA_COVER, txt, flag, NULL,  NULL, NULL, lv_obj_get_base_dir(canvas));
+    lv_draw_label(&coords, &mask, style, LV_OPA_COVER, txt, flag, NULL,  NULL, NULL, NULL, lv_obj_get_base_dir(canvas));
 
-    lv_refr_set_disp_refreshing(refr_ori);
+    lv_canvas_draw_finish(canvas, refr_ori, &coords);
 }
 
 /**
@@ -601,16 +533,6 @@ void lv_canvas_draw_img(lv_obj_t * canvas, lv_coord_t x, lv_coord_t y, const voi
     LV_ASSERT_OBJ(canvas, LV_OBJX_NAME);
     LV_ASSERT_NULL(style);
 
-    lv_img_dsc_t * dsc = lv_canvas_get_img(canvas);
-
-    /* Create a dummy display to fool the lv_draw function.
-     * It will think it draws to real screen. */
-    lv_area_t mask;
-    mask.x1 = 0;
-    mask.x2 = dsc->header.w - 1;
-    mask.y1 = 0;
-    mask.y2 = dsc->header.h - 1;
-
     lv_img_header_t header;
     lv_res_t res = lv_img_decoder_get_info(src, &header);
     if(res != LV_RES_OK) {
@@ -618,31 +540,19 @@ void lv_canvas_draw_img(lv_obj_t * canvas, lv_coord_t x, lv_coord_t y, const voi
         return;
     }
 
+    lv_area_t mask;
+    lv_disp_t * refr_ori;
+    if(lv_canvas_draw_prepare(canvas, NULL, &mask, &refr_ori) != LV_RES_OK) return;
+
     lv_area_t coords;
     coords.x1 = x;
     coords.y1 = y;
     coords.x2 = x + header.w - 1;
     coords.y2 = y + header.h - 1;
 
-    lv_disp_t disp;
-    memset(&disp, 0, sizeof(lv_disp_t));
-
-    lv_disp_buf_t disp_buf;
-    lv_disp_buf_init(&disp_buf, (void *)dsc->data, NULL, dsc->header.w * dsc->header.h);
-    lv_area_copy(&disp_buf.area, &mask);
-
-    lv_disp_drv_init(&disp.driver);
-
-    disp.driver.buffer  = &disp_buf;
-    disp.driver.hor_res = dsc->header.w;
-    disp.driver.ver_res = dsc->header.h;
-
-    lv_disp_t * refr_ori = lv_refr_get_disp_refreshing();
-    lv_refr_set_disp_refreshing(&disp);
-
     lv_draw_img(&coords, &mask, src, style, LV_OPA_COVER);
 
-    lv_refr_set_disp_refreshing(refr_ori);
+    lv_canvas_draw_finish(canvas, refr_ori, &coords);
 }
 
 /**
@@ -657,75 +567,19 @@ void lv_canvas_draw_line(lv_obj_t * canvas, const lv_point_t * points, uint32_t
     LV_ASSERT_OBJ(canvas, LV_OBJX_NAME);
     LV_ASSERT_NULL(style);
 
-    lv_img_dsc_t * dsc = lv_canvas_get_img(canvas);
+    if(point_cnt == 0) return;
 
-    /* Create a dummy display to fool the lv_draw function.
-     * It will think it draws to real screen. */
     lv_area_t mask;
-    mask.x1 = 0;
-    mask.x2 = dsc->header.w - 1;
-    mask.y1 = 0;
-    mask.y2 = dsc->header.h - 1;
-
-    lv_disp_t disp;
-    memset(&disp, 0, sizeof(lv_disp_t));
-
-    lv_disp_buf_t disp_buf;
-    lv_disp_buf_init(&disp_buf, (void *)dsc->data, NULL, dsc->header.w * dsc->header.h);
-    lv_area_copy(&disp_buf.area, &mask);
-
-    lv_disp_drv_init(&disp.driver);
-
-    disp.driver.buffer  = &disp_buf;
-    disp.driver.hor_res = dsc->header.w;
-    disp.driver.ver_res = dsc->header.h;
-
-#if LV_ANTIALIAS
-    /*Disable anti-aliasing if drawing with transparent color to chroma keyed canvas*/
-    lv_color_t ctransp = LV_COLOR_TRANSP;
-    if(dsc->header.cf == LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED &&
-        style->body.main_color.full == ctransp.full &&
-        style->body.grad_color.full == ctransp.full)
-    {
-        disp.driver.antialiasing = 0;
-    }
-#endif
+    lv_disp_t * refr_ori;
+    if(lv_canvas_draw_prepare(canvas, style, &mask, &refr_ori) != LV_RES_OK) return;
 
-    lv_disp_t * refr_ori = lv_refr_get_disp_refreshing();
-    lv_refr_set_disp_refreshing(&disp);
+    /*The joints are always rounded. The ends are rounded only if enabled*/
+    lv_line_cap_t cap = style->line.rounded ? LV_LINE_CAP_ROUND : LV_LINE_CAP_BUTT;
+    lv_draw_polyline(points, point_cnt, &mask, style, LV_OPA_COVER, cap);
 
-    lv_style_t circle_style_tmp; /*If rounded...*/
-    if(style->line.rounded) {
-        lv_style_copy(&circle_style_tmp, style);
-        circle_style_tmp.body.radius     = LV_RADIUS_CIRCLE;
-        circle_style_tmp.body.main_color = style->line.color;
-        circle_style_tmp.body.grad_color = style->line.color;
-        circle_style_tmp.body.opa        = style->line.opa;
-    }
-    lv_area_t circle_area;
-    uint32_t i;
-    for(i = 0; i < point_cnt - 1; i++) {
-        lv_draw_line(&points[i], &points[i + 1], &mask, style, LV_OPA_COVER);
-        
-        /*Draw circle on the joints if enabled*/
-        if(style->line.rounded) {
-            circle_area.x1 = points[i].x - ((style->line.width - 1) >> 1) - ((style->line.width - 1) & 0x1);
-            circle_area.y1 = points[i].y - ((style->line.width - 1) >> 1) - ((style->line.width - 1) & 0x1);
-            circle_area.x2 = points[i].x + ((style->line.width - 1) >> 1);
-            circle_area.y2 = points[i].y + ((style->line.width - 1) >> 1);
-            lv_draw_rect(&circle_area, &mask, &circle_style_tmp, LV_OPA_COVER);
-        }
-    }
-    /*Draw circle on the last point too if enabled*/
-    if(style->line.rounded) {
-        circle_area.x1 = points[i].x - ((style->line.width - 1) >> 1) - ((style->line.width - 1) & 0x1);
-        circle_area.y1 = points[i].y - ((style->line.width - 1) >> 1) - ((style->line.width - 1) & 0x1);
-        circle_area.x2 = points[i].x + ((style->line.width - 1) >> 1);
-        circle_area.y2 = points[i].y + ((style->line.width - 1) >> 1);
-        lv_draw_rect(&circle_area, &mask, &circle_style_tmp, LV_OPA_COVER);
-    }
-    
-    lv_refr_set_disp_refreshing(refr_ori);
+    lv_area_t drawn;
+    lv_canvas_get_points_area(points, point_cnt, (style->line.width >> 1) + 2, &drawn);
+    lv_canvas_draw_finish(canvas, refr_ori, &drawn);
 }
 
 /**
@@ -740,46 +594,17 @@ void lv_canvas_draw_polygon(lv_obj_t * canvas, const lv_point_t * points, uint32
     LV_ASSERT_OBJ(canvas, LV_OBJX_NAME);
     LV_ASSERT_NULL(style);
 
-    lv_img_dsc_t * dsc = lv_canvas_get_img(canvas);
+    if(point_cnt == 0) return;
 
-    /* Create a dummy display to fool the lv_draw function.
-     * It will think it draws to real screen. */
     lv_area_t mask;
-    mask.x1 = 0;
-    mask.x2 = dsc->header.w - 1;
-    mask.y1 = 0;
-    mask.y2 = dsc->header.h - 1;
-
-    lv_disp_t disp;
-    memset(&disp, 0, sizeof(lv_disp_t));
-
-    lv_disp_buf_t disp_buf;
-    lv_disp_buf_init(&disp_buf, (void *)dsc->data, NULL, dsc->header.w * dsc->header.h);
-    lv_area_copy(&disp_buf.area, &mask);
-
-    lv_disp_drv_init(&disp.driver);
-
-    disp.driver.buffer  = &disp_buf;
-    disp.driver.hor_res = dsc->header.w;
-    disp.driver.ver_res = dsc->header.h;
-
-#if LV_ANTIALIAS
-    /*Disable anti-aliasing if drawing with transparent color to chroma keyed canvas*/
-    lv_color_t ctransp = LV_COLOR_TRANSP;
-    if(dsc->header.cf == LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED &&
-        style->body.main_color.full == ctransp.full &&
-        style->body.grad_color.full == ctransp.full)
-    {
-        disp.driver.antialiasing = 0;
-    }
-#endif
-
-    lv_disp_t * refr_ori = lv_refr_get_disp_refreshing();
-    lv_refr_set_disp_refreshing(&disp);
+    lv_disp_t * refr_ori;
+    if(lv_canvas_draw_prepare(canvas, style, &mask, &refr_ori) != LV_RES_OK) return;
 
     lv_draw_polygon(points, point_cnt, &mask, style, LV_OPA_COVER);
 
-    lv_refr_set_disp_refreshing(refr_ori);
+    lv_area_t drawn;
+    lv_canvas_get_points_area(points, point_cnt, 1, &drawn);
+    lv_canvas_draw_finish(canvas, refr_ori, &drawn);
 }
 
 /**
@@ -798,46 +623,15 @@ void lv_canvas_draw_arc(lv_obj_t * canvas, lv_coord_t x, lv_coord_t y, lv_coord_
     LV_ASSERT_OBJ(canvas, LV_OBJX_NAME);
     LV_ASSERT_NULL(style);
 
-    lv_img_dsc_t * dsc = lv_canvas_get_img(canvas);
-
-    /* Create a dummy display to fool the lv_draw function.
-     * It will think it draws to real screen. */
     lv_area_t mask;
-    mask.x1 = 0;
-    mask.x2 = dsc->header.w - 1;
-    mask.y1 = 0;
-    mask.y2 = dsc->header.h - 1;
-
-    lv_disp_t disp;
-    memset(&disp, 0, sizeof(lv_disp_t));
-
-    lv_disp_buf_t disp_buf;
-    lv_disp_buf_init(&disp_buf, (void *)dsc->data, NULL, dsc->header.w * dsc->header.h);
-    lv_area_copy(&disp_buf.area, &mask);
-
-    lv_disp_drv_init(&disp.driver);
-
-    disp.driver.buffer  = &disp_buf;
-    disp.driver.hor_res = dsc->header.w;
-    disp.driver.ver_res = dsc->header.h;
-
-#if LV_ANTIALIAS
-    /*Disable anti-aliasing if drawing with transparent color to chroma keyed canvas*/
-    lv_color_t ctransp = LV_COLOR_TRANSP;
-    if(dsc->header.cf == LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED &&
-        style->body.main_color.full == ctransp.full &&
-        style->body.grad_color.full == ctransp.full)
-    {
-        disp.driver.antialiasing = 0;
-    }
-#endif
-
-    lv_disp_t * refr_ori = lv_refr_get_disp_refreshing();
-    lv_refr_set_disp_refreshing(&disp);
+    lv_disp_t * refr_ori;
+    if(lv_canvas_draw_prepare(canvas, style, &mask, &refr_ori) != LV_RES_OK) return;
 
     lv_draw_arc(x, y, r, &mask, start_angle, end_angle, style, LV_OPA_COVER);
 
-    lv_refr_set_disp_refreshing(refr_ori);
+    lv_area_t drawn;
+    lv_area_set(&drawn, x - r - 1, y - r - 1, x + r + 1, y + r + 1);
+    lv_canvas_draw_finish(canvas, refr_ori, &drawn);
 }
 
 /**********************
@@ -861,10 +655,240 @@ static lv_res_t lv_canvas_signal(lv_obj_t * canvas, lv_signal_t sign, void * par
     if(sign == LV_SIGNAL_GET_TYPE) return lv_obj_handle_get_type_signal(param, LV_OBJX_NAME);
 
     if(sign == LV_SIGNAL_CLEANUP) {
-        /*Nothing to cleanup. (No dynamically allocated memory in 'ext')*/
+        /*Free the state of a not closed drawing session*/
+        lv_canvas_ext_t * ext = lv_obj_get_ext_attr(canvas);
+        if(ext->draw_ctx) {
+            lv_mem_free(ext->draw_ctx);
+            ext->draw_ctx = NULL;
+        }
     }
 
     return res;
 }
 
+/**
+ * Blend a row of pixels to an image buffer
+ * @param dst the destination image
+ * @param x start x coordinate on `dst`
+ * @param y y coordinate on `dst`
+ * @param len number of pixels to blend
+ * @param buf pixels with `LV_IMG_CF_TRUE_COLOR_ALPHA` layout
+ * @param style style of the canvas. Used for the colors of the `LV_IMG_CF_INDEXED_...` destinations.
+ */
+static void lv_canvas_blend_row(lv_img_dsc_t * dst, lv_coord_t x, lv_coord_t y, lv_coord_t len,
+                                const uint8_t * buf, const lv_style_t * style)
+{
+    lv_coord_t i;
+    lv_color_t c;
+    lv_opa_t opa;
+
+    if(dst->header.cf == LV_IMG_CF_TRUE_COLOR || dst->header.cf == LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED) {
+        lv_color_t * dst_px = &((lv_color_t *)dst->data)[(uint32_t)y * dst->header.w + x];
+        for(i = 0; i < len; i++) {
+            opa = buf[LV_IMG_PX_SIZE_ALPHA_BYTE - 1];
+            if(opa > LV_OPA_MIN) {
+                memcpy(&c, buf, sizeof(lv_color_t));
+                if(opa >= LV_OPA_MAX) dst_px[i] = c;
+                else dst_px[i] = lv_color_mix(c, dst_px[i], opa);
+            }
+            buf += LV_IMG_PX_SIZE_ALPHA_BYTE;
+        }
+    } else if(dst->header.cf == LV_IMG_CF_TRUE_COLOR_ALPHA) {
+        uint8_t * dst_px = &((uint8_t *)dst->data)[((uint32_t)y * dst->header.w + x) * LV_IMG_PX_SIZE_ALPHA_BYTE];
+        for(i = 0; i < len; i++) {
+            opa = buf[LV_IMG_PX_SIZE_ALPHA_BYTE - 1];
+            if(opa > LV_OPA_MIN) {
+                lv_opa_t bg_opa = dst_px[LV_IMG_PX_SIZE_ALPHA_BYTE - 1];
+                /* Pick the foreground if it's fully opaque or the Background is fully transparent*/
+                if(opa >= LV_OPA_MAX || bg_opa <= LV_OPA_MIN) {
+                    memcpy(dst_px, buf, LV_IMG_PX_SIZE_ALPHA_BYTE);
+                } else {
+                    lv_color_t bg_color;
+                    memcpy(&c, buf, LV_IMG_PX_SIZE_ALPHA_BYTE - 1);
+                    memcpy(&bg_color, dst_px, LV_IMG_PX_SIZE_ALPHA_BYTE - 1);
+                    /*Opaque background: use simple mix*/
+                    if(bg_opa >= LV_OPA_MAX) {
+                        c = lv_color_mix(c, bg_color, opa);
+                    }
+                    /*Both colors have alpha. Info:
+                     * https://en.wikipedia.org/wiki/Alpha_compositing#Analytical_derivation_of_the_over_operator*/
+                    else {
+                        lv_opa_t opa_res = 255 - ((uint16_t)((uint16_t)(255 - opa) * (255 - bg_opa)) >> 8);
+                        if(opa_res == 0) opa_res = 1; /*never happens, just to be sure*/
+                        lv_opa_t ratio = (uint16_t)((uint16_t)opa * 255) / opa_res;
+                        c              = lv_color_mix(c, bg_color, ratio);
+                        dst_px[LV_IMG_PX_SIZE_ALPHA_BYTE - 1] = opa_res;
+                    }
+                    memcpy(dst_px, &c, LV_IMG_PX_SIZE_ALPHA_BYTE - 1);
+                }
+            }
+            buf += LV_IMG_PX_SIZE_ALPHA_BYTE;
+            dst_px += LV_IMG_PX_SIZE_ALPHA_BYTE;
+        }
+    }
+    /*Indexed and alpha only canvases: store the colors and opacities one by one*/
+    else {
+        bool dst_alpha = lv_img_color_format_has_alpha(dst->header.cf);
+        for(i = 0; i < len; i++) {
+            opa = buf[LV_IMG_PX_SIZE_ALPHA_BYTE - 1];
+            if(opa > LV_OPA_MIN) {
+                memcpy(&c, buf, LV_IMG_PX_SIZE_ALPHA_BYTE - 1);
+                if(opa < LV_OPA_MAX) c = lv_color_mix(c, lv_img_buf_get_px_color(dst, x + i, y, style), opa);
+                lv_img_buf_set_px_color(dst, x + i, y, c);
+                if(dst_alpha) lv_img_buf_set_px_alpha(dst, x + i, y, opa);
+            }
+            buf += LV_IMG_PX_SIZE_ALPHA_BYTE;
+        }
+    }
+}
+
+/**
+ * Prepare the drawing of a primitive to the canvas.
+ * Starts a drawing session if there is no one and makes the `lv_draw_...` functions draw to the canvas.
+ * @param canvas pointer to a canvas object
+ * @param aa_style the style of the primitive to decide if anti-aliasing can be used. `NULL` to not check.
+ * @param mask store the area of the canvas here
+ * @param refr_ori store the original refreshing display here
+ * @return LV_RES_OK: ready to draw; LV_RES_INV: out of memory
+ */
+static lv_res_t lv_canvas_draw_prepare(lv_obj_t * canvas, const lv_style_t * aa_style, lv_area_t * mask,
+                                       lv_disp_t ** refr_ori)
+{
+    lv_canvas_ext_t * ext = lv_obj_get_ext_attr(canvas);
+
+    lv_canvas_draw_begin(canvas);
+    lv_canvas_draw_ctx_t * ctx = ext->draw_ctx;
+    if(ctx == NULL) return LV_RES_INV;
+
+    lv_area_set(mask, 0, 0, ext->dsc.header.w - 1, ext->dsc.header.h - 1);
+
+#if LV_ANTIALIAS
+    ctx->disp.driver.antialiasing = 1;
+    /*Disable anti-aliasing if drawing with transparent color to chroma keyed canvas*/
+    lv_color_t ctransp = LV_COLOR_TRANSP;
+    if(aa_style && ext->dsc.header.cf == LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED &&
+       aa_style->body.main_color.full == ctransp.full && aa_style->body.grad_color.full == ctransp.full) {
+        ctx->disp.driver.antialiasing = 0;
+    }
+#else
+    (void)aa_style; /*Unused*/
+#endif
+
+    *refr_ori = lv_refr_get_disp_refreshing();
+    lv_refr_set_disp_refreshing(&ctx->disp);
+
+    return LV_RES_OK;
+}
+
+/**
+ * Finish the drawing of a primitive started with `lv_canvas_draw_prepare()`
+ * @param canvas pointer to a canvas object
+ * @param refr_ori the original refreshing display
+ * @param area the area touched by the primitive (relative to the canvas)
+ */
+static void lv_canvas_draw_finish(lv_obj_t * canvas, lv_disp_t * refr_ori, const lv_area_t * area)
+{
+    lv_refr_set_disp_refreshing(refr_ori);
+
+    lv_canvas_mark_drawn(canvas, area);
+    lv_canvas_draw_end(canvas);
+}
+
+/**
+ * Set up the dummy display of a drawing session to draw to the buffer of a canvas
+ * @param ctx pointer to a drawing session
+ * @param dsc the image descriptor of the canvas
+ */
+static void lv_canvas_draw_ctx_init(lv_canvas_draw_ctx_t * ctx, const lv_img_dsc_t * dsc)
+{
+    /* Create a dummy display to fool the lv_draw function.
+     * It will think it draws to real screen. */
+    lv_area_t mask;
+    lv_area_set(&mask, 0, 0, dsc->header.w - 1, dsc->header.h - 1);
+
+    memset(&ctx->disp, 0, sizeof(lv_disp_t));
+    lv_disp_buf_init(&ctx->disp_buf, (void *)dsc->data, NULL, dsc->header.w * dsc->header.h);
+    lv_area_copy(&ctx->disp_buf.area, &mask);
+
+    lv_disp_drv_init(&ctx->disp.driver);
+    ctx->disp.driver.buffer  = &ctx->disp_buf;
+    ctx->disp.driver.hor_res = dsc->header.w;
+    ctx->disp.driver.ver_res = dsc->header.h;
+}
+
+/**
+ * Mark an area of the canvas as changed.
+ * In a drawing session it's added to the area to invalidate at the end, else it's invalidated immediately.
+ * @param canvas pointer to a canvas object
+ * @param area the changed area (relative to the canvas)
+ */
+static void lv_canvas_mark_drawn(lv_obj_t * canvas, const lv_area_t * area)
+{
+    lv_canvas_ext_t * ext = lv_obj_get_ext_attr(canvas);
+
+    lv_area_t canvas_area;
+    lv_area_t drawn;
+    lv_area_set(&canvas_area, 0, 0, ext->dsc.header.w - 1, ext->dsc.header.h - 1);
+    if(lv_area_intersect(&drawn, area, &canvas_area) == false) return;
+
+    lv_canvas_draw_ctx_t * ctx = ext->draw_ctx;
+    if(ctx == NULL) {
+        lv_canvas_invalidate_area(canvas, &drawn);
+    } else if(ctx->inv_valid == 0) {
+        lv_area_copy(&ctx->inv_area, &drawn);
+        ctx->inv_valid = 1;
+    } else {
+        lv_area_join(&ctx->inv_area, &ctx->inv_area, &drawn);
+    }
+}
+
+/**
+ * Invalidate an area of the canvas
+ * @param canvas pointer to a canvas object
+ * @param area the area to invalidate (relative to the canvas)
+ */
+static void lv_canvas_invalidate_area(lv_obj_t * canvas, const lv_area_t * area)
+{
+    lv_canvas_ext_t * ext = lv_obj_get_ext_attr(canvas);
+
+    /*If the canvas is not simply drawn 1:1 (tiled, shifted or transformed) invalidate the whole object*/
+    if(lv_obj_get_width(canvas) != ext->dsc.header.w || lv_obj_get_height(canvas) != ext->dsc.header.h ||
+       ext->img.offset.x != 0 || ext->img.offset.y != 0 || ext->img.angle != 0 || ext->img.zoom != LV_IMG_ZOOM_NONE) {
+        lv_obj_invalidate(canvas);
+        return;
+    }
+
+    lv_area_t inv_area;
+    inv_area.x1 = area->x1 + canvas->coords.x1;
+    inv_area.y1 = area->y1 + canvas->coords.y1;
+    inv_area.x2 = area->x2 + canvas->coords.x1;
+    inv_area.y2 = area->y2 + canvas->coords.y1;
+    lv_obj_invalidate_area(canvas, &inv_area);
+}
+
+/**
+ * Get the bounding box of points
+ * @param points array of points
+ * @param point_cnt number of points (> 0)
+ * @param ext_size enlarge the area by this value in every direction
+ * @param res store the result here
+ */
+static void lv_canvas_get_points_area(const lv_point_t * points, uint32_t point_cnt, lv_coord_t ext_size,
+                                      lv_area_t * res)
+{
+    lv_area_set(res, points[0].x, points[0].y, points[0].x, points[0].y);
+    uint32_t i;
+    for(i = 1; i < point_cnt; i++) {
+        res->x1 = LV_MATH_MIN(res->x1, points[i].x);
+        res->y1 = LV_MATH_MIN(res->y1, points[i].y);
+        res->x2 = LV_MATH_MAX(res->x2, points[i].x);
+        res->y2 = LV_MATH_MAX(res->y2, points[i].y);
+    }
+
+    res->x1 -= ext_size;
+    res->y1 -= ext_size;
+    res->x2 += ext_size;
+    res->y2 += ext_size;
+}
+
 #endif
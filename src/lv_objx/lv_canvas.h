@@ -38,6 +38,7 @@ typedef struct
     lv_img_ext_t img; /*Ext. of ancestor*/
     /*New data for this type */
     lv_img_dsc_t dsc;
+    void * draw_ctx; /*State of the drawing session. NULL if there is no session (see `lv_canvas_draw_begin()`)*/
 } lv_canvas_ext_t;
 
 /*Styles*/
@@ -64,6 +65,7 @@ lv_obj_t * lv_canvas_create(lv_obj_t * par, const lv_obj_t * copy);
 
 /**
  * Set a buffer for the canvas.
+ * If a drawing session is open (see `lv_canvas_draw_begin()`) it continues on the new buffer.
  * @param buf a buffer where the content of the canvas will be.
  * The required size is (lv_img_color_format_get_px_size(cf) * w * h) / 8)
  * It can be allocated with `lv_mem_alloc()` or
@@ -173,6 +175,22 @@ void lv_canvas_rotate(lv_obj_t * canvas, lv_img_dsc_t * img, int16_t angle, lv_c
  */
 void lv_canvas_fill_bg(lv_obj_t * canvas, lv_color_t color);
 
+/**
+ * Start a drawing session on the canvas.
+ * The `lv_canvas_draw_...` functions and `lv_canvas_set_px()` called until `lv_canvas_draw_end()`
+ * share the same drawing setup and only the union of the drawn areas is invalidated once at the end.
+ * The sessions can be nested.
+ * @param canvas pointer to a canvas object
+ */
+void lv_canvas_draw_begin(lv_obj_t * canvas);
+
+/**
+ * Close a drawing session started by `lv_canvas_draw_begin()`.
+ * Closing the outermost session invalidates the area drawn in the session.
+ * @param canvas pointer to a canvas object
+ */
+void lv_canvas_draw_end(lv_obj_t * canvas);
+
 /**
  * Draw a rectangle on the canvas
  * @param canvas pointer to a canvas object
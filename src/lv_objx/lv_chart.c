@@ -853,16 +853,14 @@ static void lv_chart_draw_div(lv_obj_t * chart, const lv_area_t * mask)
 static void lv_chart_draw_lines(lv_obj_t * chart, const lv_area_t * mask)
 {
     lv_chart_ext_t * ext = lv_obj_get_ext_attr(chart);
+    if(ext->point_cnt < 2) return;
 
     uint16_t i;
-    lv_point_t p1;
-    lv_point_t p2;
     lv_coord_t w     = lv_obj_get_width(chart);
     lv_coord_t h     = lv_obj_get_height(chart);
     lv_coord_t x_ofs = chart->coords.x1;
     lv_coord_t y_ofs = chart->coords.y1;
     int32_t y_tmp;
-    lv_coord_t p_prev;
     lv_coord_t p_act;
     lv_chart_series_t * ser;
     lv_opa_t opa_scale = lv_obj_get_opa_scale(chart);
@@ -871,39 +869,41 @@ static void lv_chart_draw_lines(lv_obj_t * chart, const lv_area_t * mask)
     style.line.opa   = ext->series.opa;
     style.line.width = ext->series.width;
 
+    /*The connected points of a series are drawn at once*/
+    lv_point_t * points = lv_mem_alloc(sizeof(lv_point_t) * ext->point_cnt);
+    LV_ASSERT_MEM(points);
+    if(points == NULL) return;
+
     /*Go through all data lines*/
     LV_LL_READ_BACK(ext->series_ll, ser)
     {
         style.line.color = ser->color;
 
         lv_coord_t start_point = ext->update_mode == LV_CHART_UPDATE_MODE_SHIFT ? ser->start_point : 0;
+        uint16_t run_cnt       = 0;
 
-        p1.x = 0 + x_ofs;
-        p2.x = 0 + x_ofs;
-
-        p_prev = start_point;
-        y_tmp  = (int32_t)((int32_t)ser->points[p_prev] - ext->ymin) * h;
-        y_tmp  = y_tmp / (ext->ymax - ext->ymin);
-        p2.y   = h - y_tmp + y_ofs;
-
-        for(i = 1; i < ext->point_cnt; i++) {
-            p1.x = p2.x;
-            p1.y = p2.y;
-
-            p2.x = ((w * i) / (ext->point_cnt - 1)) + x_ofs;
-
+        for(i = 0; i < ext->point_cnt; i++) {
             p_act = (start_point + i) % ext->point_cnt;
 
+            /*A missing point breaks the line*/
+            if(ser->points[p_act] == LV_CHART_POINT_DEF) {
+                lv_draw_polyline(points, run_cnt, mask, &style, opa_scale, LV_LINE_CAP_BUTT);
+                run_cnt = 0;
+                continue;
+            }
+
             y_tmp = (int32_t)((int32_t)ser->points[p_act] - ext->ymin) * h;
             y_tmp = y_tmp / (ext->ymax - ext->ymin);
-            p2.y  = h - y_tmp + y_ofs;
-
-            if(ser->points[p_prev] != LV_CHART_POINT_DEF && ser->points[p_act] != LV_CHART_POINT_DEF)
-                lv_draw_line(&p1, &p2, mask, &style, opa_scale);
 
-            p_prev = p_act;
+            points[run_cnt].x = ((w * i) / (ext->point_cnt - 1)) + x_ofs;
+            points[run_cnt].y = h - y_tmp + y_ofs;
+            run_cnt++;
         }
+
+        lv_draw_polyline(points, run_cnt, mask, &style, opa_scale, LV_LINE_CAP_BUTT);
     }
+
+    lv_mem_free(points);
 }
 
 /**
@@ -1097,61 +1097,60 @@ static void lv_chart_draw_vertical_lines(lv_obj_t * chart, const lv_area_t * mas
 static void lv_chart_draw_areas(lv_obj_t * chart, const lv_area_t * mask)
 {
     lv_chart_ext_t * ext = lv_obj_get_ext_attr(chart);
+    if(ext->point_cnt < 2) return;
 
     uint16_t i;
-    lv_point_t p1;
-    lv_point_t p2;
     lv_coord_t w     = lv_obj_get_width(chart);
     lv_coord_t h     = lv_obj_get_height(chart);
     lv_coord_t x_ofs = chart->coords.x1;
     lv_coord_t y_ofs = chart->coords.y1;
     int32_t y_tmp;
-    lv_coord_t p_prev;
     lv_coord_t p_act;
     lv_chart_series_t * ser;
     lv_opa_t opa_scale = lv_obj_get_opa_scale(chart);
     lv_style_t style;
     lv_style_copy(&style, &lv_style_plain);
 
+    /*The connected points of a series and the 2 bottom corners are drawn as one polygon*/
+    lv_point_t * points = lv_mem_alloc(sizeof(lv_point_t) * (ext->point_cnt + 2));
+    LV_ASSERT_MEM(points);
+    if(points == NULL) return;
+
     /*Go through all data lines*/
     LV_LL_READ_BACK(ext->series_ll, ser)
     {
-        lv_coord_t start_point = ext->update_mode == LV_CHART_UPDATE_MODE_SHIFT ? ser->start_point : 0;
-        style.body.main_color  = ser->color;
-        style.body.opa         = ext->series.opa;
-
-        p2.x = 0 + x_ofs;
+        style.body.main_color = ser->color;
+        style.body.opa        = ext->series.opa;
 
-        p_prev = start_point;
-        y_tmp  = (int32_t)((int32_t)ser->points[p_prev] - ext->ymin) * h;
-        y_tmp  = y_tmp / (ext->ymax - ext->ymin);
-        p2.y   = h - y_tmp + y_ofs;
-
-        for(i = 1; i < ext->point_cnt; i++) {
-            p1.x = p2.x;
-            p1.y = p2.y;
+        lv_coord_t start_point = ext->update_mode == LV_CHART_UPDATE_MODE_SHIFT ? ser->start_point : 0;
+        uint16_t run_cnt       = 0;
 
+        for(i = 0; i <= ext->point_cnt; i++) {
             p_act = (start_point + i) % ext->point_cnt;
-            p2.x  = ((w * i) / (ext->point_cnt - 1)) + x_ofs;
+
+            /*A missing point (or the end of the series) closes the area*/
+            if(i == ext->point_cnt || ser->points[p_act] == LV_CHART_POINT_DEF) {
+                if(run_cnt >= 2) {
+                    points[run_cnt].x     = points[run_cnt - 1].x;
+                    points[run_cnt].y     = chart->coords.y2;
+                    points[run_cnt + 1].x = points[0].x;
+                    points[run_cnt + 1].y = chart->coords.y2;
+                    lv_draw_polygon(points, run_cnt + 2, mask, &style, opa_scale);
+                }
+                run_cnt = 0;
+                continue;
+            }
 
             y_tmp = (int32_t)((int32_t)ser->points[p_act] - ext->ymin) * h;
             y_tmp = y_tmp / (ext->ymax - ext->ymin);
-            p2.y  = h - y_tmp + y_ofs;
 
-            if(ser->points[p_prev] != LV_CHART_POINT_DEF && ser->points[p_act] != LV_CHART_POINT_DEF) {
-                lv_point_t triangle_points[3];
-                triangle_points[0]   = p1;
-                triangle_points[1]   = p2;
-                triangle_points[2].x = p1.x;
-                triangle_points[2].y = chart->coords.y2;
-                lv_draw_triangle(triangle_points, mask, &style, opa_scale);
-                triangle_points[2].x = p2.x;
-                triangle_points[0].y = chart->coords.y2;
-                lv_draw_triangle(triangle_points, mask, &style, opa_scale);
-            }
-            p_prev = p_act;
+            points[run_cnt].x = ((w * i) / (ext->point_cnt - 1)) + x_ofs;
+            points[run_cnt].y = h - y_tmp + y_ofs;
+            run_cnt++;
         }
     }
+
+    lv_mem_free(points);
 }
 
 /**
@@ -1379,7 +1378,7 @@ static void lv_chart_draw_y_ticks(lv_obj_t * chart, const lv_area_t * mask, uint
                         a.x2 = p2.x + size.x + LV_CHART_AXIS_TO_LABEL_DISTANCE;
                     }
 
-                    lv_draw_label(&a, mask, style, opa_scale, buf, LV_TXT_FLAG_CENTER, NULL, NULL, NULL, lv_obj_get_base_dir(chart));
+                    lv_draw_label(&a, mask, style, opa_scale, buf, LV_TXT_FLAG_CENTER, NULL, NULL, NULL, NULL, lv_obj_get_base_dir(chart));
                 }
             }
 
@@ -1465,7 +1464,7 @@ static void lv_chart_draw_x_ticks(lv_obj_t * chart, const lv_area_t * mask)
                     /* set the area at some distance of the major tick len under of the tick */
                     lv_area_t a = {(p2.x - size.x / 2), (p2.y + LV_CHART_AXIS_TO_LABEL_DISTANCE), (p2.x + size.x / 2),
                                    (p2.y + size.y + LV_CHART_AXIS_TO_LABEL_DISTANCE)};
-                    lv_draw_label(&a, mask, style, opa_scale, buf, LV_TXT_FLAG_CENTER, NULL, NULL, NULL, lv_obj_get_base_dir(chart));
+                    lv_draw_label(&a, mask, style, opa_scale, buf, LV_TXT_FLAG_CENTER, NULL, NULL, NULL, NULL, lv_obj_get_base_dir(chart));
                 }
             }
         }
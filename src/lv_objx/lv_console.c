@@ -0,0 +1,710 @@
+/**
+ * @file lv_console.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_console.h"
+#if LV_USE_CONSOLE != 0
+
+#include "../lv_core/lv_debug.h"
+#include "../lv_core/lv_indev.h"
+#include "../lv_themes/lv_theme.h"
+#include "../lv_draw/lv_draw.h"
+#include "../lv_misc/lv_math.h"
+#include <string.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+#define LV_OBJX_NAME "lv_console"
+
+#define LV_CONSOLE_WIDTH_DEF (LV_DPI * 2)
+#define LV_CONSOLE_HEIGHT_DEF (LV_DPI)
+#define LV_CONSOLE_TXT_SIZE_MIN 4
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static bool lv_console_design(lv_obj_t * console, const lv_area_t * mask, lv_design_mode_t mode);
+static lv_res_t lv_console_signal(lv_obj_t * console, lv_signal_t sign, void * param);
+static lv_console_line_t * line_get(const lv_console_ext_t * ext, uint16_t id);
+static void line_del_first(lv_console_ext_t * ext);
+static uint16_t line_add(lv_console_ext_t * ext, const char * txt, uint32_t len);
+static uint16_t line_extend(lv_console_ext_t * ext, const char * txt, uint32_t len);
+static uint16_t txt_free(lv_console_ext_t * ext, uint32_t pos, uint32_t len, uint16_t keep);
+static uint32_t txt_trunc(const char * txt, uint32_t len, uint32_t max);
+static void get_content_area(const lv_obj_t * console, lv_area_t * area);
+static lv_coord_t get_row_h(const lv_obj_t * console);
+static uint16_t get_row_cnt(const lv_obj_t * console);
+static uint16_t get_scroll_max(const lv_obj_t * console);
+static void invalidate_rows(const lv_obj_t * console, uint16_t row_first, uint16_t row_last);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static lv_design_cb_t ancestor_design;
+static lv_signal_cb_t ancestor_signal;
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+/**
+ * Create a console object.
+ * A console shows the last lines of a continuously growing text (e.g. a log) using a fixed size buffer.
+ * The lines are not wrapped and only the visible lines are drawn.
+ * @param par pointer to an object, it will be the parent of the new console
+ * @param copy pointer to a console object, if not NULL then the new object will be copied from it
+ * @return pointer to the created console
+ */
+lv_obj_t * lv_console_create(lv_obj_t * par, const lv_obj_t * copy)
+{
+    LV_LOG_TRACE("console create started");
+
+    /*Create the ancestor basic object*/
+    lv_obj_t * new_console = lv_obj_create(par, copy);
+    LV_ASSERT_MEM(new_console);
+    if(new_console == NULL) return NULL;
+
+    if(ancestor_signal == NULL) ancestor_signal = lv_obj_get_signal_cb(new_console);
+    if(ancestor_design == NULL) ancestor_design = lv_obj_get_design_cb(new_console);
+
+    /*Allocate the object type specific extended data*/
+    lv_console_ext_t * ext = lv_obj_allocate_ext_attr(new_console, sizeof(lv_console_ext_t));
+    LV_ASSERT_MEM(ext);
+    if(ext == NULL) return NULL;
+
+    ext->txt_buf    = NULL;
+    ext->lines      = NULL;
+    ext->txt_size   = 0;
+    ext->line_max   = 0;
+    ext->line_first = 0;
+    ext->line_cnt   = 0;
+    ext->scroll     = 0;
+    ext->drag_sum   = 0;
+    ext->line_open  = 0;
+    ext->recolor    = 0;
+
+    lv_obj_set_signal_cb(new_console, lv_console_signal);
+    lv_obj_set_design_cb(new_console, lv_console_design);
+
+    /*Init the new console object*/
+    if(copy == NULL) {
+        lv_console_set_buf_size(new_console, LV_CONSOLE_DEF_LINE_MAX, LV_CONSOLE_DEF_TXT_SIZE);
+        lv_obj_set_size(new_console, LV_CONSOLE_WIDTH_DEF, LV_CONSOLE_HEIGHT_DEF);
+
+        /*Set the default styles*/
+        lv_theme_t * th = lv_theme_get_current();
+        if(th) {
+            lv_console_set_style(new_console, LV_CONSOLE_STYLE_MAIN, th->style.panel);
+        } else {
+            lv_console_set_style(new_console, LV_CONSOLE_STYLE_MAIN, &lv_style_pretty);
+        }
+    }
+    /*Copy an existing object*/
+    else {
+        lv_console_ext_t * copy_ext = lv_obj_get_ext_attr(copy);
+        lv_console_set_buf_size(new_console, copy_ext->line_max, copy_ext->txt_size);
+        if(ext->txt_size == copy_ext->txt_size && ext->line_max == copy_ext->line_max && ext->txt_buf &&
+           ext->lines && copy_ext->txt_buf && copy_ext->lines) {
+            memcpy(ext->txt_buf, copy_ext->txt_buf, ext->txt_size);
+            memcpy(ext->lines, copy_ext->lines, ext->line_max * sizeof(lv_console_line_t));
+            ext->line_first = copy_ext->line_first;
+            ext->line_cnt   = copy_ext->line_cnt;
+            ext->line_open  = copy_ext->line_open;
+            ext->scroll     = copy_ext->scroll;
+        }
+        ext->recolor = copy_ext->recolor;
+
+        /*Refresh the style with new signal function*/
+        lv_obj_refresh_style(new_console);
+    }
+
+    LV_LOG_INFO("console created");
+
+    return new_console;
+}
+
+/*======================
+ * Add/remove functions
+ *=====================*/
+
+/**
+ * Add text to a console. A '\n' closes the current line, the text after the last '\n' is continued
+ * by the next call. If the buffer is full the oldest lines are deleted.
+ * The lines longer than the half of the text buffer are truncated.
+ * @param console pointer to a console object
+ * @param txt the text to add
+ */
+void lv_console_add_text(lv_obj_t * console, const char * txt)
+{
+    LV_ASSERT_OBJ(console, LV_OBJX_NAME);
+    LV_ASSERT_STR(txt);
+
+    lv_console_ext_t * ext = lv_obj_get_ext_attr(console);
+    if(ext->txt_buf == NULL || ext->lines == NULL || txt[0] == '\0') return;
+
+    uint16_t chg_first = ext->line_open ? ext->line_cnt - 1 : ext->line_cnt;
+    uint32_t new_cnt   = 0;
+    uint32_t del_cnt   = 0;
+
+    /*Add the text line by line*/
+    while(txt[0] != '\0') {
+        const char * end = strchr(txt, '\n');
+        uint32_t len     = end ? (uint32_t)(end - txt) : strlen(txt);
+
+        if(ext->line_open) {
+            del_cnt += line_extend(ext, txt, len);
+        } else {
+            del_cnt += line_add(ext, txt, len);
+            new_cnt++;
+        }
+
+        ext->line_open = end ? 0 : 1;
+        if(end == NULL) break;
+        txt = end + 1;
+    }
+
+    /*If scrolled back keep showing the same lines. The new lines are not visible then.*/
+    if(ext->scroll != 0) {
+        uint16_t scroll_max = get_scroll_max(console);
+        if(ext->scroll + new_cnt > scroll_max) {
+            ext->scroll = scroll_max;
+            lv_obj_invalidate(console);
+        } else {
+            ext->scroll += new_cnt;
+        }
+        return;
+    }
+
+    /*If the lines are not moved (the console is not full yet) redraw only the changed ones*/
+    if(del_cnt == 0 && ext->line_cnt <= get_row_cnt(console)) {
+        invalidate_rows(console, chg_first, ext->line_cnt - 1);
+    } else {
+        lv_obj_invalidate(console);
+    }
+}
+
+/**
+ * Delete all lines of a console
+ * @param console pointer to a console object
+ */
+void lv_console_clear(lv_obj_t * console)
+{
+    LV_ASSERT_OBJ(console, LV_OBJX_NAME);
+
+    lv_console_ext_t * ext = lv_obj_get_ext_attr(console);
+    ext->line_first        = 0;
+    ext->line_cnt          = 0;
+    ext->line_open         = 0;
+    ext->scroll            = 0;
+
+    lv_obj_invalidate(console);
+}
+
+/*=====================
+ * Setter functions
+ *====================*/
+
+/**
+ * Set the buffer size of a console. The current lines are deleted.
+ * If a buffer can't be allocated with the new size the old one is kept.
+ * @param console pointer to a console object
+ * @param line_max max. number of stored lines
+ * @param txt_size size of the text buffer in bytes. Every line uses its length + 1 bytes.
+ */
+void lv_console_set_buf_size(lv_obj_t * console, uint16_t line_max, uint32_t txt_size)
+{
+    LV_ASSERT_OBJ(console, LV_OBJX_NAME);
+
+    lv_console_ext_t * ext = lv_obj_get_ext_attr(console);
+
+    if(line_max == 0) line_max = 1;
+    if(txt_size < LV_CONSOLE_TXT_SIZE_MIN) txt_size = LV_CONSOLE_TXT_SIZE_MIN;
+
+    /*If a buffer can't be reallocated the old one is kept with its old size*/
+    char * txt_buf = lv_mem_realloc(ext->txt_buf, txt_size);
+    LV_ASSERT_MEM(txt_buf);
+    if(txt_buf != NULL) {
+        ext->txt_buf  = txt_buf;
+        ext->txt_size = txt_size;
+    }
+
+    lv_console_line_t * lines = lv_mem_realloc(ext->lines, line_max * sizeof(lv_console_line_t));
+    LV_ASSERT_MEM(lines);
+    if(lines != NULL) {
+        ext->lines    = lines;
+        ext->line_max = line_max;
+    }
+
+    lv_console_clear(console);
+}
+
+/**
+ * Scroll back a console to show older lines.
+ * @param console pointer to a console object
+ * @param scroll number of lines to scroll back from the newest line. 0: follow the new lines
+ */
+void lv_console_set_scroll(lv_obj_t * console, uint16_t scroll)
+{
+    LV_ASSERT_OBJ(console, LV_OBJX_NAME);
+
+    lv_console_ext_t * ext = lv_obj_get_ext_attr(console);
+
+    uint16_t scroll_max = get_scroll_max(console);
+    if(scroll > scroll_max) scroll = scroll_max;
+    if(ext->scroll == scroll) return;
+
+    ext->scroll = scroll;
+    lv_obj_invalidate(console);
+}
+
+/**
+ * Enable the recoloring by in-line commands (e.g. "#ff0000 error#")
+ * @param console pointer to a console object
+ * @param en true: enable recoloring, false: disable
+ */
+void lv_console_set_recolor(lv_obj_t * console, bool en)
+{
+    LV_ASSERT_OBJ(console, LV_OBJX_NAME);
+
+    lv_console_ext_t * ext = lv_obj_get_ext_attr(console);
+    if(ext->recolor == en) return;
+
+    ext->recolor = en ? 1 : 0;
+    lv_obj_invalidate(console);
+}
+
+/*=====================
+ * Getter functions
+ *====================*/
+
+/**
+ * Get the number of lines stored in a console
+ * @param console pointer to a console object
+ * @return number of lines
+ */
+uint16_t lv_console_get_line_cnt(const lv_obj_t * console)
+{
+    LV_ASSERT_OBJ(console, LV_OBJX_NAME);
+
+    lv_console_ext_t * ext = lv_obj_get_ext_attr(console);
+    return ext->line_cnt;
+}
+
+/**
+ * Get the text of a line of a console
+ * @param console pointer to a console object
+ * @param id index of the line (0: the oldest line)
+ * @return the text of the line or NULL if `id` is invalid. Valid until the next `lv_console_add_text()`.
+ */
+const char * lv_console_get_line(const lv_obj_t * console, uint16_t id)
+{
+    LV_ASSERT_OBJ(console, LV_OBJX_NAME);
+
+    lv_console_ext_t * ext = lv_obj_get_ext_attr(console);
+    if(id >= ext->line_cnt) return NULL;
+
+    return &ext->txt_buf[line_get(ext, id)->start];
+}
+
+/**
+ * Get how many lines a console is scrolled back
+ * @param console pointer to a console object
+ * @return number of lines scrolled back from the newest line
+ */
+uint16_t lv_console_get_scroll(const lv_obj_t * console)
+{
+    LV_ASSERT_OBJ(console, LV_OBJX_NAME);
+
+    lv_console_ext_t * ext = lv_obj_get_ext_attr(console);
+    return ext->scroll;
+}
+
+/**
+ * Get the recoloring attribute of a console
+ * @param console pointer to a console object
+ * @return true: recoloring is enabled, false: disabled
+ */
+bool lv_console_get_recolor(const lv_obj_t * console)
+{
+    LV_ASSERT_OBJ(console, LV_OBJX_NAME);
+
+    lv_console_ext_t * ext = lv_obj_get_ext_attr(console);
+    return ext->recolor == 0 ? false : true;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Handle the drawing related tasks of the consoles
+ * @param console pointer to an object
+ * @param mask the object will be drawn only in this area
+ * @param mode LV_DESIGN_COVER_CHK: only check if the object fully covers the 'mask_p' area
+ *                                  (return 'true' if yes)
+ *             LV_DESIGN_DRAW: draw the object (always return 'true')
+ *             LV_DESIGN_DRAW_POST: drawing after every children are drawn
+ * @param return true/false, depends on 'mode'
+ */
+static bool lv_console_design(lv_obj_t * console, const lv_area_t * mask, lv_design_mode_t mode)
+{
+    if(mode == LV_DESIGN_COVER_CHK) {
+        /*Return false if the object is not covers the mask area*/
+        return ancestor_design(console, mask, mode);
+    } else if(mode == LV_DESIGN_DRAW_MAIN) {
+        /*Draw the background*/
+        ancestor_design(console, mask, mode);
+
+        lv_console_ext_t * ext = lv_obj_get_ext_attr(console);
+        if(ext->line_cnt == 0) return true;
+
+        lv_area_t content;
+        lv_area_t txt_mask;
+        get_content_area(console, &content);
+        if(lv_area_intersect(&txt_mask, mask, &content) == false) return true;
+
+        /*Get the lines to show. If there are less lines than rows they are shown from the top*/
+        uint16_t row_cnt = get_row_cnt(console);
+        uint16_t line_first;
+        uint16_t shown_cnt;
+        if(ext->line_cnt <= row_cnt) {
+            line_first = 0;
+            shown_cnt  = ext->line_cnt;
+        } else {
+            uint16_t scroll_max = ext->line_cnt - row_cnt;
+            line_first          = scroll_max - LV_MATH_MIN(ext->scroll, scroll_max);
+            shown_cnt           = row_cnt;
+        }
+
+        /*Draw only the rows on the mask*/
+        const lv_style_t * style = lv_obj_get_style(console);
+        lv_coord_t row_h         = get_row_h(console);
+        lv_coord_t font_h        = lv_font_get_line_height(style->text.font);
+        int32_t row              = (txt_mask.y1 - content.y1) / row_h;
+        int32_t row_last         = (txt_mask.y2 - content.y1) / row_h;
+        if(row_last > shown_cnt - 1) row_last = shown_cnt - 1;
+
+        lv_opa_t opa_scale = lv_obj_get_opa_scale(console);
+        lv_txt_flag_t flag = LV_TXT_FLAG_EXPAND;
+        lv_bidi_dir_t bidi = lv_obj_get_base_dir(console);
+        if(ext->recolor) flag |= LV_TXT_FLAG_RECOLOR;
+
+        lv_area_t row_area;
+        row_area.x1 = content.x1;
+        row_area.x2 = content.x2;
+        for(; row <= row_last; row++) {
+            row_area.y1 = content.y1 + row * row_h;
+            row_area.y2 = row_area.y1 + font_h - 1;
+
+            lv_console_line_t * line = line_get(ext, line_first + row);
+            lv_draw_label(&row_area, &txt_mask, style, opa_scale, &ext->txt_buf[line->start], flag, NULL, NULL, NULL,
+                          NULL, bidi);
+        }
+    }
+    return true;
+}
+
+/**
+ * Signal function of the console
+ * @param console pointer to a console object
+ * @param sign a signal type from lv_signal_t enum
+ * @param param pointer to a signal specific variable
+ * @return LV_RES_OK: the object is not deleted in the function; LV_RES_INV: the object is deleted
+ */
+static lv_res_t lv_console_signal(lv_obj_t * console, lv_signal_t sign, void * param)
+{
+    lv_res_t res;
+
+    /* Include the ancient signal function */
+    res = ancestor_signal(console, sign, param);
+    if(res != LV_RES_OK) return res;
+    if(sign == LV_SIGNAL_GET_TYPE) return lv_obj_handle_get_type_signal(param, LV_OBJX_NAME);
+
+    lv_console_ext_t * ext = lv_obj_get_ext_attr(console);
+
+    if(sign == LV_SIGNAL_CLEANUP) {
+        lv_mem_free(ext->txt_buf);
+        lv_mem_free(ext->lines);
+        ext->txt_buf = NULL;
+        ext->lines   = NULL;
+    } else if(sign == LV_SIGNAL_PRESSED) {
+        ext->drag_sum = 0;
+    } else if(sign == LV_SIGNAL_PRESSING) {
+        /*Scroll by dragging: dragging down shows the older lines*/
+        lv_indev_t * indev = lv_indev_get_act();
+        if(indev && lv_indev_get_type(indev) == LV_INDEV_TYPE_POINTER) {
+            lv_point_t vect;
+            lv_indev_get_vect(indev, &vect);
+            ext->drag_sum += vect.y;
+
+            lv_coord_t row_h = get_row_h(console);
+            int32_t rows     = ext->drag_sum / row_h;
+            if(rows != 0) {
+                ext->drag_sum -= rows * row_h;
+                int32_t scroll = ext->scroll + rows;
+                if(scroll < 0) scroll = 0;
+                if(scroll > UINT16_MAX) scroll = UINT16_MAX;
+                lv_console_set_scroll(console, scroll);
+            }
+        }
+    } else if(sign == LV_SIGNAL_CONTROL) {
+        char c = *((char *)param);
+        if(c == LV_KEY_UP) {
+            if(ext->scroll < UINT16_MAX) lv_console_set_scroll(console, ext->scroll + 1);
+        } else if(c == LV_KEY_DOWN) {
+            if(ext->scroll > 0) lv_console_set_scroll(console, ext->scroll - 1);
+        }
+    }
+
+    return res;
+}
+
+/**
+ * Get a line of a console
+ * @param ext pointer to the console's ext. data
+ * @param id index of the line (0: the oldest line)
+ * @return pointer to the line in the ring buffer
+ */
+static lv_console_line_t * line_get(const lv_console_ext_t * ext, uint16_t id)
+{
+    uint32_t i = (uint32_t)ext->line_first + id;
+    if(i >= ext->line_max) i -= ext->line_max;
+
+    return &ext->lines[i];
+}
+
+/**
+ * Delete the oldest line of a console
+ * @param ext pointer to the console's ext. data
+ */
+static void line_del_first(lv_console_ext_t * ext)
+{
+    ext->line_first++;
+    if(ext->line_first >= ext->line_max) ext->line_first = 0;
+    ext->line_cnt--;
+}
+
+/**
+ * Add a new line after the newest line. Delete the oldest lines if there is no free space.
+ * @param ext pointer to the console's ext. data
+ * @param txt text of the line (not '\0' terminated)
+ * @param len length of the line in bytes
+ * @return number of deleted lines
+ */
+static uint16_t line_add(lv_console_ext_t * ext, const char * txt, uint32_t len)
+{
+    uint16_t del_cnt = 0;
+
+    len = txt_trunc(txt, len, ext->txt_size / 2 - 1);
+
+    if(ext->line_cnt == ext->line_max) {
+        line_del_first(ext);
+        del_cnt++;
+    }
+
+    /*Store the line after the newest line or at the beginning of the buffer if it doesn't fit to the end*/
+    uint32_t pos = 0;
+    if(ext->line_cnt != 0) {
+        lv_console_line_t * last = line_get(ext, ext->line_cnt - 1);
+        pos                      = last->start + last->len + 1;
+    }
+    if(pos + len + 1 > ext->txt_size) pos = 0;
+
+    del_cnt += txt_free(ext, pos, len + 1, 0);
+
+    lv_console_line_t * line = line_get(ext, ext->line_cnt);
+    ext->line_cnt++;
+
+    line->start = pos;
+    line->len   = len;
+    memcpy(&ext->txt_buf[pos], txt, len);
+    ext->txt_buf[pos + len] = '\0';
+
+    return del_cnt;
+}
+
+/**
+ * Append text to the newest line. Delete the oldest lines if there is no free space.
+ * @param ext pointer to the console's ext. data
+ * @param txt text to append (not '\0' terminated)
+ * @param len length of the text in bytes
+ * @return number of deleted lines
+ */
+static uint16_t line_extend(lv_console_ext_t * ext, const char * txt, uint32_t len)
+{
+    uint16_t del_cnt         = 0;
+    lv_console_line_t * last = line_get(ext, ext->line_cnt - 1);
+
+    len = txt_trunc(txt, len, ext->txt_size / 2 - 1 - last->len);
+    if(len == 0) return 0;
+
+    uint32_t new_len = last->len + len;
+    if(last->start + new_len + 1 <= ext->txt_size) {
+        del_cnt += txt_free(ext, last->start + last->len + 1, len, 1);
+    } else {
+        /*Move the line to the beginning of the buffer. As a line is max. half of the buffer it's free there.*/
+        del_cnt += txt_free(ext, 0, new_len + 1, 1);
+        memcpy(ext->txt_buf, &ext->txt_buf[last->start], last->len);
+        last->start = 0;
+    }
+
+    memcpy(&ext->txt_buf[last->start + last->len], txt, len);
+    last->len                             = new_len;
+    ext->txt_buf[last->start + last->len] = '\0';
+
+    return del_cnt;
+}
+
+/**
+ * Delete the oldest lines which are stored in an area of the text buffer.
+ * If the area is before the end of the newest line (the writing continues from the beginning
+ * of the buffer) the lines stored after the newest line are deleted first.
+ * @param ext pointer to the console's ext. data
+ * @param pos start of the area
+ * @param len length of the area
+ * @param keep number of the newest lines which can't be deleted
+ * @return number of deleted lines
+ */
+static uint16_t txt_free(lv_console_ext_t * ext, uint32_t pos, uint32_t len, uint16_t keep)
+{
+    if(ext->line_cnt == 0) return 0;
+
+    uint16_t del_cnt         = 0;
+    lv_console_line_t * last = line_get(ext, ext->line_cnt - 1);
+    uint32_t head            = last->start + last->len + 1;
+
+    if(pos < head) {
+        while(ext->line_cnt > keep && line_get(ext, 0)->start >= head) {
+            line_del_first(ext);
+            del_cnt++;
+        }
+    }
+
+    while(ext->line_cnt > keep) {
+        uint32_t start = line_get(ext, 0)->start;
+        if(start < pos || start >= pos + len) break;
+
+        line_del_first(ext);
+        del_cnt++;
+    }
+
+    return del_cnt;
+}
+
+/**
+ * Truncate a text to a max. length without cutting an UTF-8 character
+ * @param txt pointer to a text
+ * @param len length of the text
+ * @param max the max. length
+ * @return the new length
+ */
+static uint32_t txt_trunc(const char * txt, uint32_t len, uint32_t max)
+{
+    if(len <= max) return len;
+
+    len = max;
+#if LV_TXT_ENC == LV_TXT_ENC_UTF8
+    while(len > 0 && (txt[len] & 0xC0) == 0x80) len--;
+#else
+    (void)txt; /*Unused*/
+#endif
+
+    return len;
+}
+
+/**
+ * Get the area of a console where the lines are drawn (the coordinates without the paddings)
+ * @param console pointer to a console object
+ * @param area store the result area here
+ */
+static void get_content_area(const lv_obj_t * console, lv_area_t * area)
+{
+    const lv_style_t * style = lv_obj_get_style(console);
+
+    lv_obj_get_coords(console, area);
+    area->x1 += style->body.padding.left;
+    area->x2 -= style->body.padding.right;
+    area->y1 += style->body.padding.top;
+    area->y2 -= style->body.padding.bottom;
+}
+
+/**
+ * Get the height of a row of a console (line height + line space)
+ * @param console pointer to a console object
+ * @return the height of a row (min. 1)
+ */
+static lv_coord_t get_row_h(const lv_obj_t * console)
+{
+    const lv_style_t * style = lv_obj_get_style(console);
+
+    lv_coord_t row_h = lv_font_get_line_height(style->text.font) + style->text.line_space;
+    return row_h > 0 ? row_h : 1;
+}
+
+/**
+ * Get how many rows fit into a console
+ * @param console pointer to a console object
+ * @return number of rows (min. 1)
+ */
+static uint16_t get_row_cnt(const lv_obj_t * console)
+{
+    const lv_style_t * style = lv_obj_get_style(console);
+    lv_area_t content;
+    get_content_area(console, &content);
+
+    int32_t row_cnt = (lv_area_get_height(&content) + style->text.line_space) / get_row_h(console);
+    if(row_cnt < 1) row_cnt = 1;
+    if(row_cnt > UINT16_MAX) row_cnt = UINT16_MAX;
+
+    return row_cnt;
+}
+
+/**
+ * Get how many lines a console can be scrolled back
+ * @param console pointer to a console object
+ * @return number of lines
+ */
+static uint16_t get_scroll_max(const lv_obj_t * console)
+{
+    lv_console_ext_t * ext = lv_obj_get_ext_attr(console);
+    uint16_t row_cnt       = get_row_cnt(console);
+
+    return ext->line_cnt > row_cnt ? ext->line_cnt - row_cnt : 0;
+}
+
+/**
+ * Invalidate some rows of a console
+ * @param console pointer to a console object
+ * @param row_first the first row to invalidate (0: top row)
+ * @param row_last the last row to invalidate
+ */
+static void invalidate_rows(const lv_obj_t * console, uint16_t row_first, uint16_t row_last)
+{
+    lv_area_t area;
+    get_content_area(console, &area);
+
+    lv_coord_t row_h = get_row_h(console);
+    int32_t y1       = area.y1 + (int32_t)row_first * row_h;
+    int32_t y2       = area.y1 + ((int32_t)row_last + 1) * row_h - 1;
+    if(y1 > area.y2) return;
+
+    area.y1 = y1;
+    if(y2 < area.y2) area.y2 = y2;
+
+    lv_obj_invalidate_area(console, &area);
+}
+
+#endif
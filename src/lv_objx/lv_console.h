@@ -0,0 +1,191 @@
+/**
+ * @file lv_console.h
+ *
+ */
+
+#ifndef LV_CONSOLE_H
+#define LV_CONSOLE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#ifdef LV_CONF_INCLUDE_SIMPLE
+#include "lv_conf.h"
+#else
+#include "../../../lv_conf.h"
+#endif
+
+#if LV_USE_CONSOLE != 0
+
+#include "../lv_core/lv_obj.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/*A line stored in the text buffer of a console*/
+typedef struct
+{
+    uint32_t start; /*Byte index of the first character in the text buffer*/
+    uint32_t len;   /*Length of the line in bytes (without the closing '\0')*/
+} lv_console_line_t;
+
+/*Data of console*/
+typedef struct
+{
+    /*No inherited ext.*/
+    /*New data for this type */
+    char * txt_buf;            /*Ring buffer of the texts. Every line is stored continuously with a closing '\0'*/
+    lv_console_line_t * lines; /*Ring buffer of the lines*/
+    uint32_t txt_size;         /*Size of `txt_buf` in bytes*/
+    uint16_t line_max;         /*Size of `lines`, i.e. the max. number of stored lines*/
+    uint16_t line_first;       /*Index of the oldest line in `lines`*/
+    uint16_t line_cnt;         /*Number of stored lines*/
+    uint16_t scroll;           /*Number of lines scrolled back from the newest line*/
+    lv_coord_t drag_sum;       /*Dragged distance which is not scrolled yet*/
+    uint8_t line_open : 1;     /*1: the newest line is not closed with '\n' yet*/
+    uint8_t recolor : 1;       /*1: enable recoloring with the command characters*/
+} lv_console_ext_t;
+
+/*Styles*/
+enum {
+    LV_CONSOLE_STYLE_MAIN,
+};
+typedef uint8_t lv_console_style_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Create a console object.
+ * A console shows the last lines of a continuously growing text (e.g. a log) using a fixed size buffer.
+ * The lines are not wrapped and only the visible lines are drawn.
+ * @param par pointer to an object, it will be the parent of the new console
+ * @param copy pointer to a console object, if not NULL then the new object will be copied from it
+ * @return pointer to the created console
+ */
+lv_obj_t * lv_console_create(lv_obj_t * par, const lv_obj_t * copy);
+
+/*======================
+ * Add/remove functions
+ *=====================*/
+
+/**
+ * Add text to a console. A '\n' closes the current line, the text after the last '\n' is continued
+ * by the next call. If the buffer is full the oldest lines are deleted.
+ * The lines longer than the half of the text buffer are truncated.
+ * @param console pointer to a console object
+ * @param txt the text to add
+ */
+void lv_console_add_text(lv_obj_t * console, const char * txt);
+
+/**
+ * Delete all lines of a console
+ * @param console pointer to a console object
+ */
+void lv_console_clear(lv_obj_t * console);
+
+/*=====================
+ * Setter functions
+ *====================*/
+
+/**
+ * Set the buffer size of a console. The current lines are deleted.
+ * If a buffer can't be allocated with the new size the old one is kept.
+ * @param console pointer to a console object
+ * @param line_max max. number of stored lines
+ * @param txt_size size of the text buffer in bytes. Every line uses its length + 1 bytes.
+ */
+void lv_console_set_buf_size(lv_obj_t * console, uint16_t line_max, uint32_t txt_size);
+
+/**
+ * Scroll back a console to show older lines.
+ * @param console pointer to a console object
+ * @param scroll number of lines to scroll back from the newest line. 0: follow the new lines
+ */
+void lv_console_set_scroll(lv_obj_t * console, uint16_t scroll);
+
+/**
+ * Enable the recoloring by in-line commands (e.g. "#ff0000 error#")
+ * @param console pointer to a console object
+ * @param en true: enable recoloring, false: disable
+ */
+void lv_console_set_recolor(lv_obj_t * console, bool en);
+
+/**
+ * Set the style of a console
+ * @param console pointer to a console object
+ * @param type which style should be set (can be only `LV_CONSOLE_STYLE_MAIN`)
+ * @param style pointer to a style
+ */
+static inline void lv_console_set_style(lv_obj_t * console, lv_console_style_t type, const lv_style_t * style)
+{
+    (void)type; /*Unused*/
+    lv_obj_set_style(console, style);
+}
+
+/*=====================
+ * Getter functions
+ *====================*/
+
+/**
+ * Get the number of lines stored in a console
+ * @param console pointer to a console object
+ * @return number of lines
+ */
+uint16_t lv_console_get_line_cnt(const lv_obj_t * console);
+
+/**
+ * Get the text of a line of a console
+ * @param console pointer to a console object
+ * @param id index of the line (0: the oldest line)
+ * @return the text of the line or NULL if `id` is invalid. Valid until the next `lv_console_add_text()`.
+ */
+const char * lv_console_get_line(const lv_obj_t * console, uint16_t id);
+
+/**
+ * Get how many lines a console is scrolled back
+ * @param console pointer to a console object
+ * @return number of lines scrolled back from the newest line
+ */
+uint16_t lv_console_get_scroll(const lv_obj_t * console);
+
+/**
+ * Get the recoloring attribute of a console
+ * @param console pointer to a console object
+ * @return true: recoloring is enabled, false: disabled
+ */
+bool lv_console_get_recolor(const lv_obj_t * console);
+
+/**
+ * Get the style of a console
+ * @param console pointer to a console object
+ * @param type which style should be get (can be only `LV_CONSOLE_STYLE_MAIN`)
+ * @return pointer to the console's style
+ */
+static inline const lv_style_t * lv_console_get_style(const lv_obj_t * console, lv_console_style_t type)
+{
+    (void)type; /*Unused*/
+    return lv_obj_get_style(console);
+}
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /*LV_USE_CONSOLE*/
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /*LV_CONSOLE_H*/
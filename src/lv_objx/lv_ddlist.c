@@ -609,7 +609,7 @@ static bool lv_ddlist_design(lv_obj_t * ddlist, const lv_area_t * mask, lv_desig
                 new_style.text.opa   = sel_style->text.opa;
                 lv_txt_flag_t flag   = lv_ddlist_get_txt_flag(ddlist);
                 lv_draw_label(&ext->label->coords, &mask_sel, &new_style, opa_scale, lv_label_get_text(ext->label),
-                              flag, NULL, NULL, NULL, lv_obj_get_base_dir(ddlist));
+                              flag, NULL, NULL, NULL, NULL, lv_obj_get_base_dir(ddlist));
             }
         }
 
@@ -644,7 +644,7 @@ static bool lv_ddlist_design(lv_obj_t * ddlist, const lv_area_t * mask, lv_desig
                 if(area_ok) {
                     /*Use a down arrow in ddlist, you can replace it with yourcustom symbol*/
                     lv_draw_label(&area_arrow, &mask_arrow, &new_style, opa_scale, LV_SYMBOL_DOWN, LV_TXT_FLAG_NONE,
-                                  NULL, NULL, NULL, lv_obj_get_base_dir(ddlist));
+                                  NULL, NULL, NULL, NULL, lv_obj_get_base_dir(ddlist));
                 }
             }
         }
@@ -20,6 +20,7 @@
 #include "../lv_misc/lv_fs.h"
 #include "../lv_misc/lv_txt.h"
 #include "../lv_misc/lv_log.h"
+#include "../lv_misc/lv_math.h"
 
 /*********************
  *      DEFINES
@@ -81,6 +82,11 @@ lv_obj_t * lv_img_create(lv_obj_t * par, const lv_obj_t * copy)
     ext->auto_size = 1;
     ext->offset.x  = 0;
     ext->offset.y  = 0;
+    ext->angle     = 0;
+    ext->zoom      = LV_IMG_ZOOM_NONE;
+    ext->pivot.x   = 0;
+    ext->pivot.y   = 0;
+    ext->antialias = 1;
 
     /*Init the new object*/
     lv_obj_set_signal_cb(new_img, lv_img_signal);
@@ -102,6 +108,11 @@ lv_obj_t * lv_img_create(lv_obj_t * par, const lv_obj_t * copy)
         lv_img_ext_t * copy_ext = lv_obj_get_ext_attr(copy);
         ext->auto_size          = copy_ext->auto_size;
         lv_img_set_src(new_img, copy_ext->src);
+        ext->angle     = copy_ext->angle;
+        ext->zoom      = copy_ext->zoom;
+        ext->pivot     = copy_ext->pivot;
+        ext->antialias = copy_ext->antialias;
+        lv_obj_refresh_ext_draw_pad(new_img);
 
         /*Refresh the style with new signal function*/
         lv_obj_refresh_style(new_img);
@@ -194,11 +205,14 @@ void lv_img_set_src(lv_obj_t * img, const void * src_img)
     ext->w        = header.w;
     ext->h        = header.h;
     ext->cf       = header.cf;
+    ext->pivot.x  = header.w / 2;
+    ext->pivot.y  = header.h / 2;
 
     if(lv_img_get_auto_size(img) != false) {
         lv_obj_set_size(img, ext->w, ext->h);
     }
 
+    lv_obj_refresh_ext_draw_pad(img);
     lv_obj_invalidate(img);
 }
 
@@ -253,6 +267,85 @@ void lv_img_set_offset_y(lv_obj_t * img, lv_coord_t y)
     }
 }
 
+/**
+ * Rotate the image around its pivot.
+ * Only the images in the memory (C arrays or `lv_img_decoder_set_decode_to_ram()`) can be transformed.
+ * @param img pointer to an image object
+ * @param angle rotation angle clockwise [0.1 degree] (e.g. 450: 45 degree)
+ */
+void lv_img_set_angle(lv_obj_t * img, int16_t angle)
+{
+    LV_ASSERT_OBJ(img, LV_OBJX_NAME);
+
+    lv_img_ext_t * ext = lv_obj_get_ext_attr(img);
+
+    angle = angle % 3600;
+    if(angle < 0) angle += 3600;
+    if(angle == ext->angle) return;
+
+    lv_obj_invalidate(img);
+    ext->angle = angle;
+    lv_obj_refresh_ext_draw_pad(img);
+    lv_obj_invalidate(img);
+}
+
+/**
+ * Zoom the image around its pivot.
+ * Only the images in the memory (C arrays or `lv_img_decoder_set_decode_to_ram()`) can be transformed.
+ * @param img pointer to an image object
+ * @param zoom the zoom factor: 256 (LV_IMG_ZOOM_NONE): no zoom, 128: half size, 512: double size
+ */
+void lv_img_set_zoom(lv_obj_t * img, uint16_t zoom)
+{
+    LV_ASSERT_OBJ(img, LV_OBJX_NAME);
+
+    lv_img_ext_t * ext = lv_obj_get_ext_attr(img);
+
+    if(zoom == 0) zoom = 1;
+    if(zoom == ext->zoom) return;
+
+    lv_obj_invalidate(img);
+    ext->zoom = zoom;
+    lv_obj_refresh_ext_draw_pad(img);
+    lv_obj_invalidate(img);
+}
+
+/**
+ * Set the rotation and zoom center of the image. Reset to the center of the image by `lv_img_set_src()`.
+ * @param img pointer to an image object
+ * @param pivot_x x coordinate of the pivot relative to the image's top left corner
+ * @param pivot_y y coordinate of the pivot relative to the image's top left corner
+ */
+void lv_img_set_pivot(lv_obj_t * img, lv_coord_t pivot_x, lv_coord_t pivot_y)
+{
+    LV_ASSERT_OBJ(img, LV_OBJX_NAME);
+
+    lv_img_ext_t * ext = lv_obj_get_ext_attr(img);
+
+    if(ext->pivot.x == pivot_x && ext->pivot.y == pivot_y) return;
+
+    lv_obj_invalidate(img);
+    ext->pivot.x = pivot_x;
+    ext->pivot.y = pivot_y;
+    lv_obj_refresh_ext_draw_pad(img);
+    lv_obj_invalidate(img);
+}
+
+/**
+ * Enable/disable the smoothing of the rotated or zoomed image
+ * @param img pointer to an image object
+ * @param antialias true: bilinear filtering; false: nearest pixel (faster)
+ */
+void lv_img_set_antialias(lv_obj_t * img, bool antialias)
+{
+    LV_ASSERT_OBJ(img, LV_OBJX_NAME);
+
+    lv_img_ext_t * ext = lv_obj_get_ext_attr(img);
+
+    ext->antialias = antialias ? 1 : 0;
+    lv_obj_invalidate(img);
+}
+
 /*=====================
  * Getter functions
  *====================*/
@@ -330,6 +423,62 @@ lv_coord_t lv_img_get_offset_y(lv_obj_t * img)
     return ext->offset.y;
 }
 
+/**
+ * Get the rotation angle of the image
+ * @param img pointer to an image object
+ * @return rotation angle clockwise [0.1 degree]
+ */
+int16_t lv_img_get_angle(const lv_obj_t * img)
+{
+    LV_ASSERT_OBJ(img, LV_OBJX_NAME);
+
+    lv_img_ext_t * ext = lv_obj_get_ext_attr(img);
+
+    return ext->angle;
+}
+
+/**
+ * Get the zoom factor of the image
+ * @param img pointer to an image object
+ * @return zoom factor: 256 (LV_IMG_ZOOM_NONE): no zoom
+ */
+uint16_t lv_img_get_zoom(const lv_obj_t * img)
+{
+    LV_ASSERT_OBJ(img, LV_OBJX_NAME);
+
+    lv_img_ext_t * ext = lv_obj_get_ext_attr(img);
+
+    return ext->zoom;
+}
+
+/**
+ * Get the rotation and zoom center of the image
+ * @param img pointer to an image object
+ * @param pivot store the pivot here (relative to the image's top left corner)
+ */
+void lv_img_get_pivot(const lv_obj_t * img, lv_point_t * pivot)
+{
+    LV_ASSERT_OBJ(img, LV_OBJX_NAME);
+
+    lv_img_ext_t * ext = lv_obj_get_ext_attr(img);
+
+    *pivot = ext->pivot;
+}
+
+/**
+ * Get whether the transformed image is smoothed
+ * @param img pointer to an image object
+ * @return true: bilinear filtering; false: nearest pixel
+ */
+bool lv_img_get_antialias(const lv_obj_t * img)
+{
+    LV_ASSERT_OBJ(img, LV_OBJX_NAME);
+
+    lv_img_ext_t * ext = lv_obj_get_ext_attr(img);
+
+    return ext->antialias ? true : false;
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -352,6 +501,7 @@ static bool lv_img_design(lv_obj_t * img, const lv_area_t * mask, lv_design_mode
     if(mode == LV_DESIGN_COVER_CHK) {
         bool cover = false;
         if(ext->src_type == LV_IMG_SRC_UNKNOWN || ext->src_type == LV_IMG_SRC_SYMBOL) return false;
+        if(ext->angle != 0 || ext->zoom != LV_IMG_ZOOM_NONE) return false;
 
         if(ext->cf == LV_IMG_CF_TRUE_COLOR || ext->cf == LV_IMG_CF_RAW) cover = lv_area_is_in(mask, &img->coords);
 
@@ -370,6 +520,19 @@ static bool lv_img_design(lv_obj_t * img, const lv_area_t * mask, lv_design_mode
             coords.x1 -= ext->offset.x;
             coords.y1 -= ext->offset.y;
 
+            /*The transformed image is drawn once (not tiled) around the pivot*/
+            if(ext->angle != 0 || ext->zoom != LV_IMG_ZOOM_NONE) {
+                LV_LOG_TRACE("lv_img_design: start to draw transformed image");
+                lv_area_t cords_tr;
+                cords_tr.x1 = coords.x1;
+                cords_tr.y1 = coords.y1;
+                cords_tr.x2 = coords.x1 + ext->w - 1;
+                cords_tr.y2 = coords.y1 + ext->h - 1;
+                lv_draw_img_transformed(&cords_tr, mask, ext->src, style, opa_scale, ext->angle, ext->zoom,
+                                        &ext->pivot, ext->antialias);
+                return true;
+            }
+
             LV_LOG_TRACE("lv_img_design: start to draw image");
             lv_area_t cords_tmp;
             cords_tmp.y1 = coords.y1;
@@ -387,7 +550,7 @@ static bool lv_img_design(lv_obj_t * img, const lv_area_t * mask, lv_design_mode
             lv_style_t style_mod;
             lv_style_copy(&style_mod, style);
             style_mod.text.color = style->image.color;
-            lv_draw_label(&coords, mask, &style_mod, opa_scale, ext->src, LV_TXT_FLAG_NONE, NULL, NULL, NULL, lv_obj_get_base_dir(img));
+            lv_draw_label(&coords, mask, &style_mod, opa_scale, ext->src, LV_TXT_FLAG_NONE, NULL, NULL, NULL, NULL, lv_obj_get_base_dir(img));
         } else {
             /*Trigger the error handler of image drawer*/
             LV_LOG_WARN("lv_img_design: image source type is unknown");
@@ -427,6 +590,22 @@ static lv_res_t lv_img_signal(lv_obj_t * img, lv_signal_t sign, void * param)
         if(ext->src_type == LV_IMG_SRC_SYMBOL) {
             lv_img_set_src(img, ext->src);
         }
+    } else if(sign == LV_SIGNAL_REFR_EXT_DRAW_PAD) {
+        /*The transformed image can be out of the object*/
+        if(ext->angle != 0 || ext->zoom != LV_IMG_ZOOM_NONE) {
+            lv_area_t a;
+            lv_img_transform_get_area(&a, ext->w, ext->h, ext->angle, ext->zoom, &ext->pivot);
+            a.x1 -= ext->offset.x;
+            a.x2 -= ext->offset.x;
+            a.y1 -= ext->offset.y;
+            a.y2 -= ext->offset.y;
+            lv_coord_t pad = 0;
+            pad = LV_MATH_MAX(pad, -a.x1);
+            pad = LV_MATH_MAX(pad, -a.y1);
+            pad = LV_MATH_MAX(pad, a.x2 - (lv_obj_get_width(img) - 1));
+            pad = LV_MATH_MAX(pad, a.y2 - (lv_obj_get_height(img) - 1));
+            if(pad > img->ext_draw_pad) img->ext_draw_pad = pad;
+        }
     }
 
     return res;
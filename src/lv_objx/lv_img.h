@@ -45,6 +45,10 @@ typedef struct
     uint8_t src_type : 2;  /*See: lv_img_src_t*/
     uint8_t auto_size : 1; /*1: automatically set the object size to the image size*/
     uint8_t cf : 5;        /*Color format from `lv_img_color_format_t`*/
+    uint8_t antialias : 1; /*1: smooth the transformed image; 0: use the nearest pixels (faster)*/
+    int16_t angle;         /*Rotation angle clockwise [0.1 degree]*/
+    uint16_t zoom;         /*Zoom factor: 256 (LV_IMG_ZOOM_NONE): no zoom*/
+    lv_point_t pivot;      /*Rotate and zoom around this point of the image*/
 } lv_img_ext_t;
 
 /*Styles*/
@@ -100,6 +104,37 @@ void lv_img_set_offset_x(lv_obj_t * img, lv_coord_t x);
  */
 void lv_img_set_offset_y(lv_obj_t * img, lv_coord_t y);
 
+/**
+ * Rotate the image around its pivot.
+ * Only the images in the memory (C arrays or `lv_img_decoder_set_decode_to_ram()`) can be transformed.
+ * @param img pointer to an image object
+ * @param angle rotation angle clockwise [0.1 degree] (e.g. 450: 45 degree)
+ */
+void lv_img_set_angle(lv_obj_t * img, int16_t angle);
+
+/**
+ * Zoom the image around its pivot.
+ * Only the images in the memory (C arrays or `lv_img_decoder_set_decode_to_ram()`) can be transformed.
+ * @param img pointer to an image object
+ * @param zoom the zoom factor: 256 (LV_IMG_ZOOM_NONE): no zoom, 128: half size, 512: double size
+ */
+void lv_img_set_zoom(lv_obj_t * img, uint16_t zoom);
+
+/**
+ * Set the rotation and zoom center of the image. Reset to the center of the image by `lv_img_set_src()`.
+ * @param img pointer to an image object
+ * @param pivot_x x coordinate of the pivot relative to the image's top left corner
+ * @param pivot_y y coordinate of the pivot relative to the image's top left corner
+ */
+void lv_img_set_pivot(lv_obj_t * img, lv_coord_t pivot_x, lv_coord_t pivot_y);
+
+/**
+ * Enable/disable the smoothing of the rotated or zoomed image
+ * @param img pointer to an image object
+ * @param antialias true: bilinear filtering; false: nearest pixel (faster)
+ */
+void lv_img_set_antialias(lv_obj_t * img, bool antialias);
+
 /**
  * Set the style of an image
  * @param img pointer to an image object
@@ -151,6 +186,34 @@ lv_coord_t lv_img_get_offset_x(lv_obj_t * img);
  */
 lv_coord_t lv_img_get_offset_y(lv_obj_t * img);
 
+/**
+ * Get the rotation angle of the image
+ * @param img pointer to an image object
+ * @return rotation angle clockwise [0.1 degree]
+ */
+int16_t lv_img_get_angle(const lv_obj_t * img);
+
+/**
+ * Get the zoom factor of the image
+ * @param img pointer to an image object
+ * @return zoom factor: 256 (LV_IMG_ZOOM_NONE): no zoom
+ */
+uint16_t lv_img_get_zoom(const lv_obj_t * img);
+
+/**
+ * Get the rotation and zoom center of the image
+ * @param img pointer to an image object
+ * @param pivot store the pivot here (relative to the image's top left corner)
+ */
+void lv_img_get_pivot(const lv_obj_t * img, lv_point_t * pivot);
+
+/**
+ * Get whether the transformed image is smoothed
+ * @param img pointer to an image object
+ * @return true: bilinear filtering; false: nearest pixel
+ */
+bool lv_img_get_antialias(const lv_obj_t * img);
+
 /**
  * Get the style of an image object
  * @param img pointer to an image object
@@ -42,6 +42,9 @@ static lv_res_t lv_label_signal(lv_obj_t * label, lv_signal_t sign, void * param
 static bool lv_label_design(lv_obj_t * label, const lv_area_t * mask, lv_design_mode_t mode);
 static void lv_label_refr_text(lv_obj_t * label);
 static void lv_label_revert_dots(lv_obj_t * label);
+static void lv_label_invalidate_lines(lv_obj_t * label);
+static lv_draw_label_lines_t * lv_label_get_lines(const lv_obj_t * label);
+static void lv_label_get_txt_size(const lv_obj_t * label, lv_point_t * size_res, lv_coord_t max_w, lv_txt_flag_t flag);
 
 #if LV_USE_ANIMATION
 static void lv_label_set_offset_x(lv_obj_t * label, lv_coord_t x);
@@ -108,6 +111,10 @@ lv_obj_t * lv_label_create(lv_obj_t * par, const lv_obj_t * copy)
     ext->hint.y          = 0;
 #endif
 
+#if LV_LABEL_LINE_CACHE
+    lv_draw_label_lines_init(&ext->lines);
+#endif
+
 #if LV_LABEL_TEXT_SEL
     ext->txt_sel_start = LV_DRAW_LABEL_NO_TXT_SEL;
     ext->txt_sel_end   = LV_DRAW_LABEL_NO_TXT_SEL;
@@ -176,6 +183,8 @@ void lv_label_set_text(lv_obj_t * label, const char * text)
 {
     LV_ASSERT_OBJ(label, LV_OBJX_NAME);
 
+    lv_label_invalidate_lines(label);
+
     lv_obj_invalidate(label);
 
     lv_label_ext_t * ext = lv_obj_get_ext_attr(label);
@@ -224,6 +233,8 @@ void lv_label_set_text_fmt(lv_obj_t * label, const char * fmt, ...)
     LV_ASSERT_OBJ(label, LV_OBJX_NAME);
     LV_ASSERT_STR(fmt);
 
+    lv_label_invalidate_lines(label);
+
     lv_obj_invalidate(label);
 
     lv_label_ext_t * ext = lv_obj_get_ext_attr(label);
@@ -273,6 +284,8 @@ void lv_label_set_array_text(lv_obj_t * label, const char * array, uint16_t size
 {
     LV_ASSERT_OBJ(label, LV_OBJX_NAME);
 
+    lv_label_invalidate_lines(label);
+
     lv_obj_invalidate(label);
 
     lv_label_ext_t * ext = lv_obj_get_ext_attr(label);
@@ -309,6 +322,8 @@ void lv_label_set_static_text(lv_obj_t * label, const char * text)
 {
     LV_ASSERT_OBJ(label, LV_OBJX_NAME);
 
+    lv_label_invalidate_lines(label);
+
     lv_label_ext_t * ext = lv_obj_get_ext_attr(label);
     if(ext->static_txt == 0 && ext->text != NULL) {
         lv_mem_free(ext->text);
@@ -605,16 +620,29 @@ void lv_label_get_letter_pos(const lv_obj_t * label, uint16_t char_id, lv_point_
         max_w = LV_COORD_MAX;
     }
 
-    uint16_t byte_id = lv_txt_encoded_get_byte_id(txt, char_id);
+    uint16_t byte_id;
+    uint32_t line_i = 0;
+    lv_draw_label_lines_t * lines = lv_label_get_lines(label);
+    if(lines && lines->line_cnt > 0) {
+        /*Find the line of the letter in the line break cache*/
+        line_i          = lv_draw_label_lines_find_char(lines, char_id);
+        line_start      = lines->lines[line_i].start;
+        new_line_start  = lines->lines[line_i + 1].start;
+        byte_id         = line_start + lv_txt_encoded_get_byte_id(&txt[line_start], char_id - lines->lines[line_i].char_start);
+        y               = line_i * (letter_height + style->text.line_space);
+    } else {
+        lines   = NULL;
+        byte_id = lv_txt_encoded_get_byte_id(txt, char_id);
 
-    /*Search the line of the index letter */;
-    while(txt[new_line_start] != '\0') {
-        new_line_start += lv_txt_get_next_line(&txt[line_start], font, style->text.letter_space, max_w, flag);
-        if(byte_id < new_line_start || txt[new_line_start] == '\0')
-            break; /*The line of 'index' letter begins at 'line_start'*/
+        /*Search the line of the index letter */;
+        while(txt[new_line_start] != '\0') {
+            new_line_start += lv_txt_get_next_line(&txt[line_start], font, style->text.letter_space, max_w, flag);
+            if(byte_id < new_line_start || txt[new_line_start] == '\0')
+                break; /*The line of 'index' letter begins at 'line_start'*/
 
-        y += letter_height + style->text.line_space;
-        line_start = new_line_start;
+            y += letter_height + style->text.line_space;
+            line_start = new_line_start;
+        }
     }
 
     /*If the last character is line break then go to the next line*/
@@ -635,12 +663,28 @@ void lv_label_get_letter_pos(const lv_obj_t * label, uint16_t char_id, lv_point_
     }
     else {
         uint16_t line_char_id = lv_txt_encoded_get_char_id(&txt[line_start], byte_id - line_start);
+        uint32_t line_char_cnt = lv_txt_encoded_get_char_id(&txt[line_start], new_line_start - line_start);
+
+        /*Get the line in visual order from the cache or process it now*/
+        const uint16_t * pos_conv = NULL;
+        bidi_txt = NULL;
+        if(lines) bidi_txt = lv_draw_label_lines_get_bidi(lines, txt, line_i, lv_obj_get_base_dir(label), &pos_conv);
+        if(bidi_txt == NULL) {
+            char * bidi_buf;
+            pos_conv = lv_bidi_get_pos_conv(&txt[line_start], &bidi_buf, new_line_start - line_start, lv_obj_get_base_dir(label));
+            bidi_txt = bidi_buf;
+        }
 
-        bool is_rtl;
-        char *mutable_bidi_txt;
-        uint16_t visual_char_pos = lv_bidi_get_visual_pos(&txt[line_start], &mutable_bidi_txt, new_line_start - line_start, lv_obj_get_base_dir(label), line_char_id, &is_rtl);
-        bidi_txt = mutable_bidi_txt;
-        if (is_rtl) visual_char_pos++;
+        /*Find the letter in visual order*/
+        uint16_t visual_char_pos = line_char_id;
+        uint32_t c;
+        for(c = 0; c < line_char_cnt; c++) {
+            if(LV_BIDI_POS_GET(pos_conv[c]) == line_char_id) {
+                visual_char_pos = c;
+                if(LV_BIDI_POS_IS_RTL(pos_conv[c])) visual_char_pos++;
+                break;
+            }
+        }
         visual_byte_pos = lv_txt_encoded_get_byte_id(bidi_txt, visual_char_pos);
     }
 #else
@@ -706,29 +750,62 @@ uint16_t lv_label_get_letter_on(const lv_obj_t * label, lv_point_t * pos)
         max_w = LV_COORD_MAX;
     }
 
-    /*Search the line of the index letter */;
-    while(txt[line_start] != '\0') {
-        new_line_start += lv_txt_get_next_line(&txt[line_start], font, style->text.letter_space, max_w, flag);
+    uint32_t line_char_start;
+    uint32_t line_i = 0;
+    lv_coord_t line_h = letter_height + style->text.line_space;
+    lv_draw_label_lines_t * lines = lv_label_get_lines(label);
+    if(lines && line_h > 0) {
+        /*Get the line of the point from the line break cache*/
+        if(pos->y > letter_height) line_i = (pos->y - letter_height + line_h - 1) / line_h;
+        if(line_i > lines->line_cnt) line_i = lines->line_cnt;
+
+        line_start      = lines->lines[line_i].start;
+        line_char_start = lines->lines[line_i].char_start;
+        if(line_i < lines->line_cnt) {
+            new_line_start = lines->lines[line_i + 1].start;
 
-        if(pos->y <= y + letter_height) {
-            /*The line is found (stored in 'line_start')*/
             /* Include the NULL terminator in the last line */
             uint32_t tmp = new_line_start;
             uint32_t letter;
             letter = lv_txt_encoded_prev(txt, &tmp);
             if(letter != '\n' && txt[new_line_start] == '\0' ) new_line_start++;
-            break;
+        } else {
+            new_line_start = line_start;
         }
-        y += letter_height + style->text.line_space;
+    } else {
+        lines = NULL;
+
+        /*Search the line of the index letter */;
+        while(txt[line_start] != '\0') {
+            new_line_start += lv_txt_get_next_line(&txt[line_start], font, style->text.letter_space, max_w, flag);
+
+            if(pos->y <= y + letter_height) {
+                /*The line is found (stored in 'line_start')*/
+                /* Include the NULL terminator in the last line */
+                uint32_t tmp = new_line_start;
+                uint32_t letter;
+                letter = lv_txt_encoded_prev(txt, &tmp);
+                if(letter != '\n' && txt[new_line_start] == '\0' ) new_line_start++;
+                break;
+            }
+            y += letter_height + style->text.line_space;
 
-        line_start = new_line_start;
+            line_start = new_line_start;
+        }
+        line_char_start = lv_txt_encoded_get_char_id(txt, line_start);
     }
 
 #if LV_USE_BIDI
-    bidi_txt = lv_draw_get_buf(new_line_start - line_start + 1);
+    /*Get the line in visual order from the cache or process it now. The closing '\0' is not processed.*/
     uint16_t txt_len = new_line_start - line_start;
-    if(bidi_txt[new_line_start] == '\0') txt_len--;
-    lv_bidi_process_paragraph(txt + line_start, bidi_txt, txt_len, lv_obj_get_base_dir(label), NULL, 0);
+    if(txt_len > 0 && txt[new_line_start - 1] == '\0') txt_len--;
+
+    const uint16_t * pos_conv = NULL;
+    bidi_txt = NULL;
+    if(lines) bidi_txt = (char *)lv_draw_label_lines_get_bidi(lines, txt, line_i, lv_obj_get_base_dir(label), &pos_conv);
+    if(bidi_txt == NULL) {
+        pos_conv = lv_bidi_get_pos_conv(txt + line_start, &bidi_txt, txt_len, lv_obj_get_base_dir(label));
+    }
 #else
     bidi_txt = (char*)txt + line_start;
 #endif
@@ -782,14 +859,18 @@ uint16_t lv_label_get_letter_on(const lv_obj_t * label, lv_point_t * pos)
 
 #if LV_USE_BIDI
     /*Handle Bidi*/
-    bool is_rtl;
-    logical_pos = lv_bidi_get_logical_pos(&txt[line_start], NULL, txt_len, lv_obj_get_base_dir(label), lv_txt_encoded_get_char_id(bidi_txt, i), &is_rtl);
-    if (is_rtl) logical_pos++;
+    uint16_t visual_pos = lv_txt_encoded_get_char_id(bidi_txt, i);
+    if(visual_pos < lv_txt_encoded_get_char_id(bidi_txt, txt_len)) {
+        logical_pos = LV_BIDI_POS_GET(pos_conv[visual_pos]);
+        if(LV_BIDI_POS_IS_RTL(pos_conv[visual_pos])) logical_pos++;
+    } else {
+        logical_pos = visual_pos;   /*After the last letter*/
+    }
 #else
     logical_pos = lv_txt_encoded_get_char_id(bidi_txt, i);
 #endif
 
-    return  logical_pos + lv_txt_encoded_get_char_id(txt, line_start);
+    return  logical_pos + line_char_start;
 }
 
 /**
@@ -861,14 +942,26 @@ bool lv_label_is_char_under_pos(const lv_obj_t * label, lv_point_t * pos)
         max_w = LV_COORD_MAX;
     }
 
-    /*Search the line of the index letter */;
-    while(txt[line_start] != '\0') {
-        new_line_start += lv_txt_get_next_line(&txt[line_start], font, style->text.letter_space, max_w, flag);
+    lv_coord_t line_h = letter_height + style->text.line_space;
+    lv_draw_label_lines_t * lines = lv_label_get_lines(label);
+    if(lines && line_h > 0) {
+        /*Get the line of the point from the line break cache*/
+        uint32_t line_i = 0;
+        if(pos->y > letter_height) line_i = (pos->y - letter_height + line_h - 1) / line_h;
+        if(line_i > lines->line_cnt) line_i = lines->line_cnt;
+
+        line_start     = lines->lines[line_i].start;
+        new_line_start = line_i < lines->line_cnt ? lines->lines[line_i + 1].start : line_start;
+    } else {
+        /*Search the line of the index letter */;
+        while(txt[line_start] != '\0') {
+            new_line_start += lv_txt_get_next_line(&txt[line_start], font, style->text.letter_space, max_w, flag);
 
-        if(pos->y <= y + letter_height) break; /*The line is found (stored in 'line_start')*/
-        y += letter_height + style->text.line_space;
+            if(pos->y <= y + letter_height) break; /*The line is found (stored in 'line_start')*/
+            y += letter_height + style->text.line_space;
 
-        line_start = new_line_start;
+            line_start = new_line_start;
+        }
     }
 
     /*Calculate the x coordinate*/
@@ -945,19 +1038,29 @@ void lv_label_ins_text(lv_obj_t * label, uint32_t pos, const char * txt)
 
     lv_obj_invalidate(label);
 
-    /*Allocate space for the new text*/
+    /*Allocate space for the new text. Reserve some more to make the next insertions cheaper.*/
     size_t old_len = strlen(ext->text);
     size_t ins_len = strlen(txt);
     size_t new_len = ins_len + old_len;
-    ext->text        = lv_mem_realloc(ext->text, new_len + 1);
+    ext->text        = lv_mem_grow(ext->text, new_len + 1);
     LV_ASSERT_MEM(ext->text);
     if(ext->text == NULL) return;
 
-    if(pos == LV_LABEL_POS_LAST) {
-        pos = lv_txt_get_encoded_length(ext->text);
+    /*Appending doesn't need to count the characters*/
+    uint32_t byte_pos = pos == LV_LABEL_POS_LAST ? old_len : lv_txt_encoded_get_byte_id(ext->text, pos);
+
+    memmove(&ext->text[byte_pos + ins_len], &ext->text[byte_pos], old_len - byte_pos + 1);
+    memcpy(&ext->text[byte_pos], txt, ins_len);
+
+#if LV_LABEL_LINE_CACHE
+    /*Break only the changed lines again. The dots can change the whole text so start again with them.*/
+    if(ext->long_mode == LV_LABEL_LONG_DOT) {
+        lv_label_invalidate_lines(label);
+    } else {
+        lv_draw_label_lines_edit(&ext->lines, ext->text, byte_pos, 0, ins_len);
     }
+#endif
 
-    lv_txt_ins(ext->text, pos, txt);
     lv_label_refr_text(label);
 }
 
@@ -980,9 +1083,23 @@ void lv_label_cut_text(lv_obj_t * label, uint32_t pos, uint32_t cnt)
     lv_obj_invalidate(label);
 
     char * label_txt = lv_label_get_text(label);
+#if LV_LABEL_LINE_CACHE
+    uint32_t byte_pos = lv_txt_encoded_get_byte_id(label_txt, pos);
+    uint32_t byte_len = lv_txt_encoded_get_byte_id(&label_txt[byte_pos], cnt);
+#endif
+
     /*Delete the characters*/
     lv_txt_cut(label_txt, pos, cnt);
 
+#if LV_LABEL_LINE_CACHE
+    /*Break only the changed lines again. The dots can change the whole text so start again with them.*/
+    if(ext->long_mode == LV_LABEL_LONG_DOT) {
+        lv_label_invalidate_lines(label);
+    } else {
+        lv_draw_label_lines_edit(&ext->lines, label_txt, byte_pos, byte_len, 0);
+    }
+#endif
+
     /*Refresh the label*/
     lv_label_refr_text(label);
 }
@@ -1045,8 +1162,7 @@ static bool lv_label_design(lv_obj_t * label, const lv_area_t * mask, lv_design_
         if((ext->long_mode == LV_LABEL_LONG_SROLL || ext->long_mode == LV_LABEL_LONG_SROLL_CIRC) &&
            (ext->align == LV_LABEL_ALIGN_CENTER || ext->align == LV_LABEL_ALIGN_RIGHT)) {
             lv_point_t size;
-            lv_txt_get_size(&size, ext->text, style->text.font, style->text.letter_space, style->text.line_space,
-                            LV_COORD_MAX, flag);
+            lv_label_get_txt_size(label, &size, LV_COORD_MAX, flag);
             if(size.x > lv_obj_get_width(label)) {
                 flag &= ~LV_TXT_FLAG_RIGHT;
                 flag &= ~LV_TXT_FLAG_CENTER;
@@ -1061,17 +1177,23 @@ static bool lv_label_design(lv_obj_t * label, const lv_area_t * mask, lv_design_
         /*Just for compatibility*/
         lv_draw_label_hint_t * hint = NULL;
 #endif
+
+#if LV_LABEL_LINE_CACHE
+        lv_draw_label_lines_t * lines = &ext->lines;
+#else
+        lv_draw_label_lines_t * lines = NULL;
+#endif
+
         lv_draw_label_txt_sel_t sel;
 
         sel.start = lv_label_get_text_sel_start(label);
         sel.end = lv_label_get_text_sel_end(label);
-        lv_draw_label(&coords, mask, style, opa_scale, ext->text, flag, &ext->offset, &sel, hint, lv_obj_get_base_dir(label));
+        lv_draw_label(&coords, mask, style, opa_scale, ext->text, flag, &ext->offset, &sel, hint, lines, lv_obj_get_base_dir(label));
 
 
         if(ext->long_mode == LV_LABEL_LONG_SROLL_CIRC) {
             lv_point_t size;
-            lv_txt_get_size(&size, ext->text, style->text.font, style->text.letter_space, style->text.line_space,
-                            LV_COORD_MAX, flag);
+            lv_label_get_txt_size(label, &size, LV_COORD_MAX, flag);
 
             lv_point_t ofs;
 
@@ -1081,14 +1203,14 @@ static bool lv_label_design(lv_obj_t * label, const lv_area_t * mask, lv_design_
                         lv_font_get_glyph_width(style->text.font, ' ', ' ') * LV_LABEL_WAIT_CHAR_COUNT;
                 ofs.y = ext->offset.y;
 
-                lv_draw_label(&coords, mask, style, opa_scale, ext->text, flag, &ofs, &sel, NULL, lv_obj_get_base_dir(label));
+                lv_draw_label(&coords, mask, style, opa_scale, ext->text, flag, &ofs, &sel, NULL, lines, lv_obj_get_base_dir(label));
             }
 
             /*Draw the text again below the original to make an circular effect */
             if(size.y > lv_obj_get_height(label)) {
                 ofs.x = ext->offset.x;
                 ofs.y = ext->offset.y + size.y + lv_font_get_line_height(style->text.font);
-                lv_draw_label(&coords, mask, style, opa_scale, ext->text, flag, &ofs, &sel, NULL, lv_obj_get_base_dir(label));
+                lv_draw_label(&coords, mask, style, opa_scale, ext->text, flag, &ofs, &sel, NULL, lines, lv_obj_get_base_dir(label));
             }
         }
     }
@@ -1118,6 +1240,7 @@ static lv_res_t lv_label_signal(lv_obj_t * label, lv_signal_t sign, void * param
             ext->text = NULL;
         }
         lv_label_dot_tmp_free(label);
+        lv_label_invalidate_lines(label);
     } else if(sign == LV_SIGNAL_STYLE_CHG) {
         /*Revert dots for proper refresh*/
         lv_label_revert_dots(label);
@@ -1182,7 +1305,7 @@ static void lv_label_refr_text(lv_obj_t * label)
     lv_txt_flag_t flag = LV_TXT_FLAG_NONE;
     if(ext->recolor != 0) flag |= LV_TXT_FLAG_RECOLOR;
     if(ext->expand != 0) flag |= LV_TXT_FLAG_EXPAND;
-    lv_txt_get_size(&size, ext->text, font, style->text.letter_space, style->text.line_space, max_w, flag);
+    lv_label_get_txt_size(label, &size, max_w, flag);
 
     /*Set the full size in expand mode*/
     if(ext->long_mode == LV_LABEL_LONG_EXPAND) {
@@ -1326,6 +1449,7 @@ static void lv_label_refr_text(lv_obj_t * label)
                 }
                 ext->text[byte_id_ori + LV_LABEL_DOT_NUM] = '\0';
                 ext->dot_end                              = letter_id + LV_LABEL_DOT_NUM;
+                lv_label_invalidate_lines(label);
             }
         }
     }
@@ -1358,6 +1482,7 @@ static void lv_label_revert_dots(lv_obj_t * label)
     }
     ext->text[byte_i + i] = dot_tmp[i];
     lv_label_dot_tmp_free(label);
+    lv_label_invalidate_lines(label);
 
     ext->dot_end = LV_LABEL_DOT_END_INV;
 }
@@ -1439,3 +1564,89 @@ static void lv_label_dot_tmp_free(lv_obj_t * label)
 }
 
 #endif
+
+/**
+ * Invalidate the line break cache of a label because its text has changed
+ * @param label pointer to a label object
+ */
+static void lv_label_invalidate_lines(lv_obj_t * label)
+{
+#if LV_LABEL_LINE_CACHE
+    lv_label_ext_t * ext = lv_obj_get_ext_attr(label);
+    lv_draw_label_lines_invalidate(&ext->lines);
+#else
+    (void)label; /*Unused*/
+#endif
+}
+
+/**
+ * Get the line break cache of a label. Build it if it's not built yet or the label has changed.
+ * @param label pointer to a label object
+ * @return pointer to the line break cache or NULL if it's disabled or there is no memory for it
+ */
+static lv_draw_label_lines_t * lv_label_get_lines(const lv_obj_t * label)
+{
+#if LV_LABEL_LINE_CACHE
+    lv_label_ext_t * ext     = lv_obj_get_ext_attr(label);
+    const lv_style_t * style = lv_obj_get_style(label);
+    if(ext->text == NULL) return NULL;
+
+    lv_txt_flag_t flag = LV_TXT_FLAG_NONE;
+    if(ext->recolor != 0) flag |= LV_TXT_FLAG_RECOLOR;
+    if(ext->expand != 0) flag |= LV_TXT_FLAG_EXPAND;
+
+    if(lv_draw_label_lines_update(&ext->lines, ext->text, style->text.font, style->text.letter_space,
+                                  lv_obj_get_width(label), flag) == false) {
+        return NULL;
+    }
+
+    return &ext->lines;
+#else
+    (void)label; /*Unused*/
+    return NULL;
+#endif
+}
+
+/**
+ * Get the size of the text of a label. Same as `lv_txt_get_size()` but uses the line break cache if possible.
+ * @param label pointer to a label object
+ * @param size_res pointer to a 'point_t' variable to store the result
+ * @param max_w max with of the text
+ * @param flag settings for the text from 'txt_flag_t' enum
+ */
+static void lv_label_get_txt_size(const lv_obj_t * label, lv_point_t * size_res, lv_coord_t max_w, lv_txt_flag_t flag)
+{
+    lv_label_ext_t * ext     = lv_obj_get_ext_attr(label);
+    const lv_style_t * style = lv_obj_get_style(label);
+    const lv_font_t * font   = style->text.font;
+
+    /*The cached lines are broken at the label's width*/
+    lv_draw_label_lines_t * lines = NULL;
+    if(max_w == lv_obj_get_width(label) || (flag & LV_TXT_FLAG_EXPAND)) lines = lv_label_get_lines(label);
+
+    if(lines) {
+        lv_coord_t line_h = lv_font_get_line_height(font) + style->text.line_space;
+
+        /*Let `lv_txt_get_size()` handle the too tall texts*/
+        if(line_h > 0 && (unsigned long)lines->line_cnt * line_h <= LV_MAX_OF(lv_coord_t)) {
+            size_res->x = 0;
+            uint32_t i;
+            for(i = 0; i < lines->line_cnt; i++) {
+                size_res->x = LV_MATH_MAX(size_res->x, lines->lines[i].width);
+            }
+
+            size_res->y = lines->line_cnt * line_h;
+
+            /*Make the text one line taller if the last character is '\n' or '\r'*/
+            uint32_t end = lines->lines[lines->line_cnt].start;
+            if(end != 0 && (ext->text[end - 1] == '\n' || ext->text[end - 1] == '\r')) size_res->y += line_h;
+
+            /*Correction with the last line space or set the height manually if the text is empty*/
+            if(size_res->y == 0) size_res->y = lv_font_get_line_height(font);
+            else size_res->y -= style->text.line_space;
+            return;
+        }
+    }
+
+    lv_txt_get_size(size_res, ext->text, font, style->text.letter_space, style->text.line_space, max_w, flag);
+}
@@ -83,6 +83,10 @@ typedef struct
     lv_draw_label_hint_t hint; /*Used to buffer info about large text*/
 #endif
 
+#if LV_LABEL_LINE_CACHE
+    lv_draw_label_lines_t lines; /*Start and width of the lines to draw the text faster*/
+#endif
+
 #if LV_USE_ANIMATION
     uint16_t anim_speed; /*Speed of scroll and roll animation in px/sec unit*/
 #endif
@@ -231,54 +231,25 @@ static bool lv_line_design(lv_obj_t * line, const lv_area_t * mask, lv_design_mo
         lv_obj_get_coords(line, &area);
         lv_coord_t x_ofs = area.x1;
         lv_coord_t y_ofs = area.y1;
-        lv_point_t p1;
-        lv_point_t p2;
         lv_coord_t h = lv_obj_get_height(line);
         uint16_t i;
 
-        lv_style_t circle_style_tmp; /*If rounded...*/
-        if(style->line.rounded) {
-            lv_style_copy(&circle_style_tmp, style);
-            circle_style_tmp.body.radius     = LV_RADIUS_CIRCLE;
-            circle_style_tmp.body.main_color = style->line.color;
-            circle_style_tmp.body.grad_color = style->line.color;
-            circle_style_tmp.body.opa        = style->line.opa;
-        }
-        lv_area_t circle_area;
-
-        /*Read all points and draw the lines*/
-        for(i = 0; i < ext->point_num - 1; i++) {
-
-            p1.x = ext->point_array[i].x + x_ofs;
-            p2.x = ext->point_array[i + 1].x + x_ofs;
-
-            if(ext->y_inv == 0) {
-                p1.y = ext->point_array[i].y + y_ofs;
-                p2.y = ext->point_array[i + 1].y + y_ofs;
-            } else {
-                p1.y = h - ext->point_array[i].y + y_ofs;
-                p2.y = h - ext->point_array[i + 1].y + y_ofs;
-            }
-            lv_draw_line(&p1, &p2, mask, style, opa_scale);
-
-            /*Draw circle on the joints if enabled*/
-            if(style->line.rounded) {
-                circle_area.x1 = p1.x - ((style->line.width - 1) >> 1) - ((style->line.width - 1) & 0x1);
-                circle_area.y1 = p1.y - ((style->line.width - 1) >> 1) - ((style->line.width - 1) & 0x1);
-                circle_area.x2 = p1.x + ((style->line.width - 1) >> 1);
-                circle_area.y2 = p1.y + ((style->line.width - 1) >> 1);
-                lv_draw_rect(&circle_area, mask, &circle_style_tmp, opa_scale);
-            }
-        }
+        /*Convert the points to absolute coordinates*/
+        lv_point_t * points = lv_mem_alloc(sizeof(lv_point_t) * ext->point_num);
+        LV_ASSERT_MEM(points);
+        if(points == NULL) return false;
 
-        /*Draw circle on the last point too if enabled*/
-        if(style->line.rounded) {
-            circle_area.x1 = p2.x - ((style->line.width - 1) >> 1) - ((style->line.width - 1) & 0x1);
-            circle_area.y1 = p2.y - ((style->line.width - 1) >> 1) - ((style->line.width - 1) & 0x1);
-            circle_area.x2 = p2.x + ((style->line.width - 1) >> 1);
-            circle_area.y2 = p2.y + ((style->line.width - 1) >> 1);
-            lv_draw_rect(&circle_area, mask, &circle_style_tmp, opa_scale);
+        for(i = 0; i < ext->point_num; i++) {
+            points[i].x = ext->point_array[i].x + x_ofs;
+            if(ext->y_inv == 0) points[i].y = ext->point_array[i].y + y_ofs;
+            else points[i].y = h - ext->point_array[i].y + y_ofs;
         }
+
+        /*The joints are always rounded. The ends are rounded only if enabled*/
+        lv_line_cap_t cap = style->line.rounded ? LV_LINE_CAP_ROUND : LV_LINE_CAP_BUTT;
+        lv_draw_polyline(points, ext->point_num, mask, style, opa_scale, cap);
+
+        lv_mem_free(points);
     }
     return true;
 }
@@ -23,6 +23,7 @@ CSRCS += lv_ta.c
 CSRCS += lv_spinbox.c
 CSRCS += lv_btnm.c
 CSRCS += lv_cont.c
+CSRCS += lv_console.c
 CSRCS += lv_img.c
 CSRCS += lv_imgbtn.c
 CSRCS += lv_led.c
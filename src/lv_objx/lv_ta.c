@@ -270,7 +270,7 @@ void lv_ta_add_char(lv_obj_t * ta, uint32_t c)
 
     if(ext->pwd_mode != 0) {
 
-        ext->pwd_tmp = lv_mem_realloc(ext->pwd_tmp, strlen(ext->pwd_tmp) + 2); /*+2: the new char + \0 */
+        ext->pwd_tmp = lv_mem_grow(ext->pwd_tmp, strlen(ext->pwd_tmp) + strlen((const char *)letter_buf) + 1);
         LV_ASSERT_MEM(ext->pwd_tmp);
         if(ext->pwd_tmp == NULL) return;
 
@@ -354,7 +354,7 @@ void lv_ta_add_text(lv_obj_t * ta, const char * txt)
     lv_ta_clear_selection(ta);
 
     if(ext->pwd_mode != 0) {
-        ext->pwd_tmp = lv_mem_realloc(ext->pwd_tmp, strlen(ext->pwd_tmp) + strlen(txt) + 1);
+        ext->pwd_tmp = lv_mem_grow(ext->pwd_tmp, strlen(ext->pwd_tmp) + strlen(txt) + 1);
         LV_ASSERT_MEM(ext->pwd_tmp);
         if(ext->pwd_tmp == NULL) return;
 
@@ -418,11 +418,8 @@ void lv_ta_del_char(lv_obj_t * ta)
         }
     }
 
-    char * label_txt = lv_label_get_text(ext->label);
-    /*Delete a character*/
-    lv_txt_cut(label_txt, ext->cursor.pos - 1, 1);
-    /*Refresh the label*/
-    lv_label_set_text(ext->label, label_txt);
+    /*Delete a character. Keep the text buffer to make the next insertions cheaper.*/
+    lv_label_cut_text(ext->label, ext->cursor.pos - 1, 1);
     lv_ta_clear_selection(ta);
 
     /*Don't let 'width == 0' because cursor will not be visible*/
@@ -432,12 +429,7 @@ void lv_ta_del_char(lv_obj_t * ta)
     }
 
     if(ext->pwd_mode != 0) {
-        uint32_t byte_pos = lv_txt_encoded_get_byte_id(ext->pwd_tmp, ext->cursor.pos - 1);
-        lv_txt_cut(ext->pwd_tmp, ext->cursor.pos - 1, lv_txt_encoded_size(&label_txt[byte_pos]));
-
-        ext->pwd_tmp = lv_mem_realloc(ext->pwd_tmp, strlen(ext->pwd_tmp) + 1);
-        LV_ASSERT_MEM(ext->pwd_tmp);
-        if(ext->pwd_tmp == NULL) return;
+        lv_txt_cut(ext->pwd_tmp, ext->cursor.pos - 1, 1);
     }
 
     /*Move the cursor to the place of the deleted character*/
@@ -1396,7 +1388,7 @@ static bool lv_ta_scrollable_design(lv_obj_t * scrl, const lv_area_t * mask, lv_
 
             cur_area.x1 += cur_style.body.padding.left;
             cur_area.y1 += cur_style.body.padding.top;
-            lv_draw_label(&cur_area, mask, &cur_style, opa_scale, letter_buf, LV_TXT_FLAG_NONE, NULL, NULL, NULL, lv_obj_get_base_dir(ta));
+            lv_draw_label(&cur_area, mask, &cur_style, opa_scale, letter_buf, LV_TXT_FLAG_NONE, NULL, NULL, NULL, NULL, lv_obj_get_base_dir(ta));
 
         } else if(ext->cursor.type == LV_CURSOR_OUTLINE) {
             cur_style.body.opa = LV_OPA_TRANSP;
@@ -0,0 +1,68 @@
+#!/usr/bin/env python3
+#
+# Build and run the tests with a few configurations.
+# Usage: python3 build.py  (from any directory, needs gcc)
+# Extra compiler flags can be passed in `CFLAGS`, e.g. CFLAGS="-fsanitize=address"
+
+import os
+import subprocess
+import sys
+from concurrent.futures import ThreadPoolExecutor
+
+test_dir = os.path.dirname(os.path.abspath(__file__))
+lvgl_dir = os.path.dirname(test_dir)
+build_dir = os.path.join(test_dir, "build")
+
+cflags = ["-std=gnu99", "-O2", "-g", "-Wall", "-Wextra", "-Wno-unused-parameter", "-Wshadow",
+          "-Wno-missing-field-initializers", "-DLV_CONF_INCLUDE_SIMPLE", "-I" + test_dir]
+ldflags = ["-lm", "-lpthread"]
+cflags += os.environ.get("CFLAGS", "").split()
+ldflags += os.environ.get("CFLAGS", "").split()
+
+# Name and the defines of the tested configurations
+configs = [
+    ("default", []),
+    ("no_draw_list", ["-DLV_USE_DRAW_LIST=0"]),
+    ("bidi", ["-DLV_USE_BIDI=1"]),
+    ("draw_thread_1", ["-DLV_USE_DRAW_THREAD=1", "-DLV_DRAW_THREAD_CNT=1"]),
+    ("draw_thread", ["-DLV_USE_DRAW_THREAD=1"]),
+]
+
+
+def sources():
+    files = []
+    for d in (os.path.join(lvgl_dir, "src"), test_dir):
+        for root, _, names in os.walk(d):
+            if root.startswith(build_dir):
+                continue
+            files += [os.path.join(root, n) for n in names if n.endswith(".c")]
+    return sorted(files)
+
+
+def build(name, defines):
+    out_dir = os.path.join(build_dir, name)
+    os.makedirs(out_dir, exist_ok=True)
+    srcs = sources()
+    objs = [os.path.join(out_dir, os.path.relpath(s, lvgl_dir).replace(os.sep, "_")[:-2] + ".o") for s in srcs]
+
+    def compile_one(src, obj):
+        subprocess.check_call(["gcc", "-c"] + cflags + defines + [src, "-o", obj])
+
+    with ThreadPoolExecutor(os.cpu_count()) as pool:
+        list(pool.map(compile_one, srcs, objs))
+
+    exe = os.path.join(out_dir, "lv_test")
+    subprocess.check_call(["gcc"] + objs + ldflags + ["-o", exe])
+    return exe
+
+
+failed = []
+for name, defines in configs:
+    print("=== " + name + " ===")
+    sys.stdout.flush()
+    if subprocess.call([build(name, defines)]) != 0:
+        failed.append(name)
+
+if failed:
+    print("Failed configurations: " + ", ".join(failed))
+    sys.exit(1)
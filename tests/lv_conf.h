@@ -0,0 +1,61 @@
+/**
+ * @file lv_conf.h
+ * Configuration of the tests. The options not set here get their default value from `lv_conf_checker.h`.
+ * The options in `#ifndef` are set by `build.py` to test the different configurations.
+ */
+
+#ifndef LV_CONF_H
+#define LV_CONF_H
+
+#include <stdint.h>
+
+#define LV_HOR_RES_MAX          (480)
+#define LV_VER_RES_MAX          (320)
+#define LV_COLOR_DEPTH          16
+
+#define LV_MEM_SIZE             (128U * 1024U)
+
+/*Stop the tests on a failed assert instead of hanging in it*/
+#include <stdio.h>
+#include <stdlib.h>
+#define LV_DEBUG_ASSERT(expr, msg, value)                                             \
+    {                                                                                \
+        if(!(expr)) {                                                                \
+            fprintf(stderr, "Assert failed: %s (%s:%d)\n", msg, __FILE__, __LINE__); \
+            abort();                                                                 \
+        }                                                                            \
+    }
+
+typedef int16_t lv_coord_t;
+typedef void * lv_anim_user_data_t;
+typedef void * lv_group_user_data_t;
+typedef void * lv_fs_drv_user_data_t;
+typedef void * lv_img_decoder_user_data_t;
+typedef void * lv_disp_drv_user_data_t;
+typedef void * lv_indev_drv_user_data_t;
+typedef void * lv_font_user_data_t;
+typedef void * lv_obj_user_data_t;
+
+#ifndef LV_USE_DRAW_LIST
+#define LV_USE_DRAW_LIST        1
+#endif
+
+#ifndef LV_USE_OPA_LAYER
+#define LV_USE_OPA_LAYER        1
+#endif
+
+#ifndef LV_USE_BIDI
+#define LV_USE_BIDI             0
+#endif
+
+#ifndef LV_USE_DRAW_THREAD
+#define LV_USE_DRAW_THREAD      0
+#endif
+
+#ifndef LV_USE_CONSOLE
+#define LV_USE_CONSOLE          1
+#endif
+
+#include "../src/lv_conf_checker.h"
+
+#endif /*LV_CONF_H*/
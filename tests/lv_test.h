@@ -0,0 +1,98 @@
+/**
+ * @file lv_test.h
+ * Common helpers of the tests
+ */
+
+#ifndef LV_TEST_H
+#define LV_TEST_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include <stdio.h>
+#include "../lvgl.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+#define LV_TEST_HOR_RES 480
+#define LV_TEST_VER_RES 320
+
+/**********************
+ *      MACROS
+ **********************/
+
+/*Print the failed condition and count the error but continue the test*/
+#define LV_TEST_ASSERT(cond)                                                                                           \
+    do {                                                                                                               \
+        if(!(cond)) {                                                                                                  \
+            printf("%s:%d: assertion failed: %s\n", __FILE__, __LINE__, #cond);                                      \
+            lv_test_error_cnt++;                                                                                       \
+        }                                                                                                              \
+    } while(0)
+
+/**********************
+ *  GLOBAL PROTOTYPES
+ **********************/
+
+extern uint32_t lv_test_error_cnt;
+
+/**
+ * Set the display buffer of the test display.
+ * @param lines number of lines in the display buffer (the screen is refreshed in parts if it's less than the
+ * vertical resolution)
+ * @param set_px true: draw with a `set_px_cb`
+ */
+void lv_test_disp_set_buf(uint32_t lines, bool set_px);
+
+/**
+ * Set the draw backend of the test display
+ * @param backend pointer to a draw backend or NULL to use `lv_draw_backend_sw`
+ */
+void lv_test_disp_set_backend(const lv_draw_backend_t * backend);
+
+/**
+ * Invalidate and redraw the active screen into the frame buffer
+ */
+void lv_test_disp_refresh(void);
+
+/**
+ * Get the frame buffer of the test display
+ * @return pointer to `LV_TEST_HOR_RES * LV_TEST_VER_RES` pixels
+ */
+const lv_color_t * lv_test_disp_get_fb(void);
+
+/**
+ * Count the pixels in the frame buffer which differ from a reference
+ * @param ref pointer to `LV_TEST_HOR_RES * LV_TEST_VER_RES` pixels
+ * @return number of different pixels
+ */
+uint32_t lv_test_disp_diff(const lv_color_t * ref);
+
+/**
+ * Allocate the free memory of `lv_mem` until only a few kB remains.
+ * The draw buffer is freed first to not keep memory allocated before.
+ * @param keep leave about this many bytes free
+ */
+void lv_test_mem_exhaust(uint32_t keep);
+
+/**
+ * Free the memory allocated by `lv_test_mem_exhaust()`
+ */
+void lv_test_mem_release(void);
+
+void lv_test_opa_layer(void);
+void lv_test_label_lines(void);
+void lv_test_draw_thread(void);
+void lv_test_chart_mem(void);
+void lv_test_console(void);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /*LV_TEST_H*/
@@ -0,0 +1,85 @@
+/**
+ * @file lv_test_chart_mem.c
+ * Draw charts with many points when there is only a little free memory.
+ * The lines and the polygons have to be drawn in parts instead of hanging in an assert.
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include <string.h>
+#include "lv_test.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+#define POINT_CNT 1000
+#define BAND_LINES 10
+#define MEM_KEEP (6 * 1024) /*Enough for the chart's points but not for all the segments or edges*/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void check_chart(lv_chart_type_t type, bool same);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static lv_color_t ref[LV_TEST_HOR_RES * LV_TEST_VER_RES];
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_test_chart_mem(void)
+{
+    lv_test_disp_set_buf(BAND_LINES, false);
+
+    /*The lines are drawn in different chunks with less memory, the joints can differ a little*/
+    check_chart(LV_CHART_TYPE_LINE, false);
+
+    /*The polygons are split to exactly the same pixels*/
+    check_chart(LV_CHART_TYPE_AREA, true);
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Draw a chart with full and with exhausted memory and compare the results
+ * @param type type of the chart
+ * @param same true: the results have to be the same; false: only something has to be drawn
+ */
+static void check_chart(lv_chart_type_t type, bool same)
+{
+    lv_obj_t * scr = lv_obj_create(NULL, NULL);
+    lv_scr_load(scr);
+
+    lv_obj_t * chart = lv_chart_create(scr, NULL);
+    lv_obj_set_size(chart, LV_TEST_HOR_RES - 40, LV_TEST_VER_RES - 40);
+    lv_obj_set_pos(chart, 20, 20);
+    lv_chart_set_type(chart, type);
+    lv_chart_set_div_line_count(chart, 0, 0);
+    lv_chart_set_point_count(chart, POINT_CNT);
+    lv_chart_series_t * ser = lv_chart_add_series(chart, LV_COLOR_RED);
+
+    /*Draw the chart without series to see if the series is drawn later*/
+    lv_test_disp_refresh();
+    memcpy(ref, lv_test_disp_get_fb(), sizeof(ref));
+
+    uint32_t i;
+    for(i = 0; i < POINT_CNT; i++) lv_chart_set_next(chart, ser, (i * 37) % 100);
+    lv_test_disp_refresh();
+    LV_TEST_ASSERT(lv_test_disp_diff(ref) != 0);
+    if(same) memcpy(ref, lv_test_disp_get_fb(), sizeof(ref));
+
+    lv_test_mem_exhaust(MEM_KEEP);
+    lv_test_disp_refresh();
+    lv_test_mem_release();
+
+    if(same) LV_TEST_ASSERT(lv_test_disp_diff(ref) == 0);
+    else LV_TEST_ASSERT(lv_test_disp_diff(ref) != 0);
+
+    lv_obj_del(scr);
+}
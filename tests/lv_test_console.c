@@ -0,0 +1,161 @@
+/**
+ * @file lv_test_console.c
+ * Add random texts to consoles with different buffer sizes and compare the stored lines
+ * with the last lines of the added text. The ring buffers wrap around many times.
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include <stdlib.h>
+#include <string.h>
+#include "lv_test.h"
+
+#if LV_USE_CONSOLE
+
+/*********************
+ *      DEFINES
+ *********************/
+#define ADD_CNT 5000
+#define MODEL_LINE_MAX 128 /*More than the `line_max` of the tested consoles*/
+#define MODEL_LINE_LEN 512 /*More than the half of the tested text buffers*/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef struct
+{
+    uint16_t line_max;
+    uint32_t txt_size;
+} buf_size_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void model_add(const char * txt, uint32_t len_max);
+static bool lines_eq(const lv_obj_t * console, uint32_t txt_size);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static const char * pieces[] = {
+    "a", "b", "log ", "warning: ", "\n", "\n", "\n", "line\n", "\n\n", "12345678901234567890",
+    "#ff0000 red# ", "xxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxx",
+};
+
+/*Limited by the lines or by the text buffer, and buffers which fit only a few lines*/
+static const buf_size_t sizes[] = {{16, 256}, {64, 100}, {4, 64}, {8, 20}, {3, 4}};
+
+/*The lines of the text added to the console (the last `MODEL_LINE_MAX` lines)*/
+static char model[MODEL_LINE_MAX][MODEL_LINE_LEN];
+static uint32_t model_cnt;
+static bool model_open;
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_test_console(void)
+{
+    lv_obj_t * scr = lv_obj_create(NULL, NULL);
+    lv_scr_load(scr);
+    lv_obj_t * console = lv_console_create(scr, NULL);
+    lv_obj_set_size(console, LV_TEST_HOR_RES / 2, LV_TEST_VER_RES / 2);
+
+    uint32_t s;
+    for(s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        lv_console_set_buf_size(console, sizes[s].line_max, sizes[s].txt_size);
+        LV_TEST_ASSERT(lv_console_get_line_cnt(console) == 0);
+
+        srand(s + 1);
+        model_cnt  = 0;
+        model_open = false;
+
+        uint32_t i;
+        for(i = 0; i < ADD_CNT; i++) {
+            char txt[512];
+            txt[0]        = '\0';
+            uint32_t p_cnt = 1 + rand() % 3;
+            while(p_cnt--) strcat(txt, pieces[rand() % (sizeof(pieces) / sizeof(pieces[0]))]);
+
+            lv_console_add_text(console, txt);
+            model_add(txt, sizes[s].txt_size / 2 - 1);
+
+            uint16_t line_cnt = lv_console_get_line_cnt(console);
+            LV_TEST_ASSERT(line_cnt >= 1 && line_cnt <= sizes[s].line_max);
+            if(lines_eq(console, sizes[s].txt_size) == false) {
+                printf("console %u/%u: different lines after %u texts\n", (unsigned)sizes[s].line_max,
+                       (unsigned)sizes[s].txt_size, (unsigned)i);
+                lv_test_error_cnt++;
+                break;
+            }
+        }
+
+        lv_test_disp_refresh();
+    }
+
+    lv_obj_del(scr);
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Add a text to the model the same way as `lv_console_add_text()` adds it
+ * @param txt the text to add
+ * @param len_max max. length of a line
+ */
+static void model_add(const char * txt, uint32_t len_max)
+{
+    while(txt[0] != '\0') {
+        const char * end = strchr(txt, '\n');
+        uint32_t len     = end ? (uint32_t)(end - txt) : strlen(txt);
+
+        if(model_open == false) {
+            model[model_cnt % MODEL_LINE_MAX][0] = '\0';
+            model_cnt++;
+        }
+
+        char * line      = model[(model_cnt - 1) % MODEL_LINE_MAX];
+        uint32_t old_len = strlen(line);
+        if(old_len + len > len_max) len = len_max - old_len;
+        memcpy(&line[old_len], txt, len);
+        line[old_len + len] = '\0';
+
+        model_open = end ? false : true;
+        if(end == NULL) break;
+        txt = end + 1;
+    }
+}
+
+/**
+ * Compare the lines of a console with the last lines of the model
+ * @param console pointer to a console
+ * @param txt_size size of the console's text buffer
+ * @return true: the lines are the same and fit into the text buffer
+ */
+static bool lines_eq(const lv_obj_t * console, uint32_t txt_size)
+{
+    uint16_t line_cnt = lv_console_get_line_cnt(console);
+    if(line_cnt > model_cnt) return false;
+
+    uint32_t txt_sum = 0;
+    uint16_t i;
+    for(i = 0; i < line_cnt; i++) {
+        const char * line = lv_console_get_line(console, i);
+        if(line == NULL) return false;
+        if(strcmp(line, model[(model_cnt - line_cnt + i) % MODEL_LINE_MAX]) != 0) return false;
+        txt_sum += strlen(line) + 1;
+    }
+
+    return txt_sum <= txt_size;
+}
+
+#else
+
+void lv_test_console(void)
+{
+}
+
+#endif /*LV_USE_CONSOLE*/
@@ -0,0 +1,123 @@
+/**
+ * @file lv_test_disp.c
+ * A display which draws into a frame buffer in RAM
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include <string.h>
+#include "lv_test.h"
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void flush_cb(lv_disp_drv_t * disp_drv, const lv_area_t * area, lv_color_t * color_p);
+static void set_px_cb(lv_disp_drv_t * disp_drv, uint8_t * buf, lv_coord_t buf_w, lv_coord_t x, lv_coord_t y,
+                      lv_color_t color, lv_opa_t opa);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static lv_color_t fb[LV_TEST_HOR_RES * LV_TEST_VER_RES];
+static lv_color_t vdb_buf[LV_TEST_HOR_RES * LV_TEST_VER_RES];
+static lv_disp_buf_t vdb;
+static lv_disp_drv_t drv;
+static lv_disp_t * disp;
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+/**
+ * Set the display buffer of the test display.
+ * @param lines number of lines in the display buffer (the screen is refreshed in parts if it's less than the
+ * vertical resolution)
+ * @param set_px true: draw with a `set_px_cb`
+ */
+void lv_test_disp_set_buf(uint32_t lines, bool set_px)
+{
+    lv_disp_buf_init(&vdb, vdb_buf, NULL, LV_TEST_HOR_RES * lines);
+
+    if(disp == NULL) {
+        lv_disp_drv_init(&drv);
+        drv.hor_res  = LV_TEST_HOR_RES;
+        drv.ver_res  = LV_TEST_VER_RES;
+        drv.flush_cb = flush_cb;
+        drv.buffer   = &vdb;
+        disp         = lv_disp_drv_register(&drv);
+    }
+
+    drv.set_px_cb = set_px ? set_px_cb : NULL;
+    lv_disp_drv_update(disp, &drv);
+}
+
+/**
+ * Set the draw backend of the test display
+ * @param backend pointer to a draw backend or NULL to use `lv_draw_backend_sw`
+ */
+void lv_test_disp_set_backend(const lv_draw_backend_t * backend)
+{
+    drv.draw_backend = backend;
+    lv_disp_drv_update(disp, &drv);
+}
+
+/**
+ * Invalidate and redraw the active screen into the frame buffer
+ */
+void lv_test_disp_refresh(void)
+{
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(disp);
+}
+
+/**
+ * Get the frame buffer of the test display
+ * @return pointer to `LV_TEST_HOR_RES * LV_TEST_VER_RES` pixels
+ */
+const lv_color_t * lv_test_disp_get_fb(void)
+{
+    return fb;
+}
+
+/**
+ * Count the pixels in the frame buffer which differ from a reference
+ * @param ref pointer to `LV_TEST_HOR_RES * LV_TEST_VER_RES` pixels
+ * @return number of different pixels
+ */
+uint32_t lv_test_disp_diff(const lv_color_t * ref)
+{
+    uint32_t cnt = 0;
+    uint32_t i;
+    for(i = 0; i < LV_TEST_HOR_RES * LV_TEST_VER_RES; i++) {
+        if(fb[i].full != ref[i].full) cnt++;
+    }
+
+    return cnt;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static void flush_cb(lv_disp_drv_t * disp_drv, const lv_area_t * area, lv_color_t * color_p)
+{
+    lv_coord_t w = lv_area_get_width(area);
+    lv_coord_t y;
+    for(y = area->y1; y <= area->y2; y++) {
+        memcpy(&fb[y * LV_TEST_HOR_RES + area->x1], color_p, w * sizeof(lv_color_t));
+        color_p += w;
+    }
+
+    lv_disp_flush_ready(disp_drv);
+}
+
+/*Write the pixels the same way as the normal drawing to get the same result*/
+static void set_px_cb(lv_disp_drv_t * disp_drv, uint8_t * buf, lv_coord_t buf_w, lv_coord_t x, lv_coord_t y,
+                      lv_color_t color, lv_opa_t opa)
+{
+    (void)disp_drv;
+    lv_color_t * px = (lv_color_t *)buf + (uint32_t)y * buf_w + x;
+    if(opa >= LV_OPA_MAX) *px = color;
+    else *px = lv_color_mix(color, *px, opa);
+}
@@ -0,0 +1,166 @@
+/**
+ * @file lv_test_draw_thread.c
+ * Draw a scene of large fills and image blits with `lv_draw_backend_thread` and `lv_draw_backend_sw`.
+ * The result has to be the same. The refresh time of both is printed to compare them.
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include <string.h>
+#include <time.h>
+#include "lv_test.h"
+
+#if LV_USE_DRAW_THREAD
+
+/*********************
+ *      DEFINES
+ *********************/
+#define IMG_W 400
+#define IMG_H 250
+#define FRAME_CNT 50
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void create_scene(lv_obj_t * scr);
+static double refresh_time(void);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static lv_color_t img_map[IMG_W * IMG_H];
+static lv_color_t ref[LV_TEST_HOR_RES * LV_TEST_VER_RES];
+
+/*Number of lines in the display buffer: the full screen and bands*/
+static const uint32_t buf_lines[] = {LV_TEST_VER_RES, 40, 10};
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_test_draw_thread(void)
+{
+    lv_obj_t * scr = lv_obj_create(NULL, NULL);
+    lv_scr_load(scr);
+    create_scene(scr);
+
+    uint32_t i;
+    for(i = 0; i < sizeof(buf_lines) / sizeof(buf_lines[0]); i++) {
+        lv_test_disp_set_buf(buf_lines[i], false);
+
+        lv_test_disp_set_backend(NULL);
+        lv_test_disp_refresh();
+        memcpy(ref, lv_test_disp_get_fb(), sizeof(ref));
+        double sw_ms = refresh_time();
+
+        lv_test_disp_set_backend(&lv_draw_backend_thread);
+        lv_test_disp_refresh();
+        LV_TEST_ASSERT(lv_test_disp_diff(ref) == 0);
+        double thread_ms = refresh_time();
+
+        printf("draw_thread: workers %u, buffer %3u lines: sw %.3f ms, thread %.3f ms per frame\n",
+               (unsigned)LV_DRAW_THREAD_CNT, (unsigned)buf_lines[i], sw_ms, thread_ms);
+    }
+
+    lv_test_disp_set_backend(NULL);
+    lv_test_disp_set_buf(LV_TEST_VER_RES, false);
+    lv_obj_del(scr);
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Create a screen with overlapping images (plain, opa, recolor) and large fills
+ * @param scr the screen
+ */
+static void create_scene(lv_obj_t * scr)
+{
+    static lv_style_t scr_style;
+    lv_style_copy(&scr_style, &lv_style_plain);
+    scr_style.body.main_color = LV_COLOR_MAKE(0x20, 0x40, 0x60);
+    scr_style.body.grad_color = scr_style.body.main_color;
+    lv_obj_set_style(scr, &scr_style);
+
+    uint32_t i;
+    for(i = 0; i < IMG_W * IMG_H; i++) {
+        img_map[i] = LV_COLOR_MAKE(i % IMG_W, (i / IMG_W) % 256, (i * 7) & 0xff);
+    }
+
+    static lv_img_dsc_t img;
+    img.header.always_zero = 0;
+    img.header.w           = IMG_W;
+    img.header.h           = IMG_H;
+    img.header.cf          = LV_IMG_CF_TRUE_COLOR;
+    img.data_size          = sizeof(img_map);
+    img.data               = (const uint8_t *)img_map;
+
+    static lv_style_t opa_style;
+    lv_style_copy(&opa_style, &lv_style_plain);
+    opa_style.image.opa = LV_OPA_70;
+
+    static lv_style_t recolor_style;
+    lv_style_copy(&recolor_style, &lv_style_plain);
+    recolor_style.image.color   = LV_COLOR_RED;
+    recolor_style.image.intense = LV_OPA_40;
+
+    lv_obj_t * img1 = lv_img_create(scr, NULL);
+    lv_img_set_src(img1, &img);
+    lv_obj_set_pos(img1, 30, 30);
+
+    lv_obj_t * img2 = lv_img_create(scr, NULL);
+    lv_img_set_src(img2, &img);
+    lv_obj_set_pos(img2, 60, 50);
+    lv_img_set_style(img2, LV_IMG_STYLE_MAIN, &opa_style);
+
+    lv_obj_t * img3 = lv_img_create(scr, NULL);
+    lv_img_set_src(img3, &img);
+    lv_obj_set_pos(img3, 100, 80);
+    lv_img_set_style(img3, LV_IMG_STYLE_MAIN, &recolor_style);
+
+    static lv_style_t rect_style;
+    lv_style_copy(&rect_style, &lv_style_plain);
+    rect_style.body.main_color = LV_COLOR_YELLOW;
+    rect_style.body.grad_color = LV_COLOR_YELLOW;
+    rect_style.body.opa        = LV_OPA_50;
+
+    lv_obj_t * rect = lv_obj_create(scr, NULL);
+    lv_obj_set_style(rect, &rect_style);
+    lv_obj_set_pos(rect, 10, 150);
+    lv_obj_set_size(rect, 460, 160);
+
+    lv_obj_t * label = lv_label_create(scr, NULL);
+    lv_label_set_text(label, "Threaded draw backend test");
+    lv_obj_set_pos(label, 20, 200);
+
+    lv_obj_t * btn = lv_btn_create(scr, NULL);
+    lv_obj_set_pos(btn, 300, 220);
+    lv_obj_set_size(btn, 150, 80);
+}
+
+/**
+ * Measure the average time of refreshing the screen
+ * @return time of a frame in milliseconds
+ */
+static double refresh_time(void)
+{
+    struct timespec t_start;
+    struct timespec t_end;
+    clock_gettime(CLOCK_MONOTONIC, &t_start);
+
+    uint32_t i;
+    for(i = 0; i < FRAME_CNT; i++) lv_test_disp_refresh();
+
+    clock_gettime(CLOCK_MONOTONIC, &t_end);
+    return ((t_end.tv_sec - t_start.tv_sec) * 1e3 + (t_end.tv_nsec - t_start.tv_nsec) / 1e6) / FRAME_CNT;
+}
+
+#else
+
+void lv_test_draw_thread(void)
+{
+}
+
+#endif /*LV_USE_DRAW_THREAD*/
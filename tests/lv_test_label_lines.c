@@ -0,0 +1,159 @@
+/**
+ * @file lv_test_label_lines.c
+ * Edit a text randomly and compare the updated line break cache with a cache built from the new text.
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include <stdlib.h>
+#include <string.h>
+#include "lv_test.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+#define TXT_MAX 4096
+#define EDIT_CNT 3000
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static uint32_t rand_piece(char * buf);
+static bool lines_eq(lv_draw_label_lines_t * a, lv_draw_label_lines_t * b, const char * txt);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+/* The text is mostly typed letter by letter so the words often become long enough
+ * (`LV_TXT_LINE_BREAK_LONG_LEN`) to be broken inside the word, or short enough not to be broken.*/
+static const char * letters[] = {"a", "b", "e", "i", "m", "o", "s", "t", "w", "é", "ő", " ", "-", "\n"};
+static const char * pieces[]  = {
+    " ", "text ", "Lorem ipsum", ", ", ".", "abcdefghijklmnopqrstuvwxyz", "mmmmmmmmmmmmmmmmmm",
+#if LV_USE_BIDI
+    "אבג", "שלום ", "עולם", "(12)",
+#endif
+};
+
+/*Test with these widths of the lines (with a different random seed)*/
+static const lv_coord_t widths[] = {200, 150, 100, 60};
+
+static char test_txt[TXT_MAX + 64];
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_test_label_lines(void)
+{
+    const lv_font_t * font = LV_FONT_DEFAULT;
+    uint32_t w_i;
+
+    for(w_i = 0; w_i < sizeof(widths) / sizeof(widths[0]); w_i++) {
+        lv_coord_t w = widths[w_i];
+        srand(w_i + 1);
+        test_txt[0] = '\0';
+
+        lv_draw_label_lines_t lines;
+        lv_draw_label_lines_init(&lines);
+        lv_draw_label_lines_update(&lines, test_txt, font, 0, w, LV_TXT_FLAG_NONE);
+
+        uint32_t i;
+        for(i = 0; i < EDIT_CNT; i++) {
+            uint32_t len      = strlen(test_txt);
+            uint32_t char_cnt = lv_txt_get_encoded_length(test_txt);
+
+            /*Insert a piece or delete some characters, or both. Delete more if the text is long.*/
+            char ins[64];
+            uint32_t ins_len = 0;
+            uint32_t del_char_cnt = 0;
+            uint32_t r = rand() % 10;
+            if(r < 6 || len < 16) ins_len = rand_piece(ins);
+            if(r >= 5 && char_cnt > 0) del_char_cnt = 1 + rand() % (len > TXT_MAX / 2 ? 40 : 3);
+
+            uint32_t char_pos = rand() % (char_cnt + 1);
+            if(char_pos + del_char_cnt > char_cnt) del_char_cnt = char_cnt - char_pos;
+            uint32_t pos     = lv_txt_encoded_get_byte_id(test_txt, char_pos);
+            uint32_t del_len = lv_txt_encoded_get_byte_id(&test_txt[pos], del_char_cnt);
+            if(len - del_len + ins_len > TXT_MAX) ins_len = 0;
+
+            memmove(&test_txt[pos + ins_len], &test_txt[pos + del_len], len - pos - del_len + 1);
+            memcpy(&test_txt[pos], ins, ins_len);
+
+#if LV_USE_BIDI
+            /*Use the visual order of some lines to keep them processed in the cache*/
+            if(lines.line_cnt) lv_draw_label_lines_get_bidi(&lines, test_txt, rand() % lines.line_cnt, LV_BIDI_DIR_AUTO, NULL);
+#endif
+            lv_draw_label_lines_edit(&lines, test_txt, pos, del_len, ins_len);
+            lv_draw_label_lines_update(&lines, test_txt, font, 0, w, LV_TXT_FLAG_NONE);
+
+            lv_draw_label_lines_t ref;
+            lv_draw_label_lines_init(&ref);
+            lv_draw_label_lines_update(&ref, test_txt, font, 0, w, LV_TXT_FLAG_NONE);
+
+            bool eq = lines_eq(&lines, &ref, test_txt);
+            lv_draw_label_lines_invalidate(&ref);
+            if(eq == false) {
+                printf("label_lines: width %d edit %u (pos %u, del %u, ins %u): different lines\n", w,
+                       (unsigned)i, (unsigned)pos, (unsigned)del_len, (unsigned)ins_len);
+                LV_TEST_ASSERT(eq);
+                break;
+            }
+        }
+
+        lv_draw_label_lines_invalidate(&lines);
+    }
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Put a random letter or a piece of text into a buffer
+ * @param buf buffer for at least 64 bytes
+ * @return length of the text in bytes (without the closing '\0')
+ */
+static uint32_t rand_piece(char * buf)
+{
+    const char * p;
+    if(rand() % 8) p = letters[rand() % (sizeof(letters) / sizeof(letters[0]))];
+    else p = pieces[rand() % (sizeof(pieces) / sizeof(pieces[0]))];
+
+    strcpy(buf, p);
+    return strlen(p);
+}
+
+/**
+ * Compare two line break caches of a text
+ * @param a pointer to a built line break cache
+ * @param b pointer to a built line break cache
+ * @param txt the text of the caches
+ * @return true: the caches have the same lines
+ */
+static bool lines_eq(lv_draw_label_lines_t * a, lv_draw_label_lines_t * b, const char * txt)
+{
+    if(a->line_cnt != b->line_cnt) return false;
+
+    uint32_t i;
+    for(i = 0; i <= a->line_cnt; i++) {
+        if(a->lines[i].start != b->lines[i].start) return false;
+        if(a->lines[i].char_start != b->lines[i].char_start) return false;
+        if(i < a->line_cnt && a->lines[i].width != b->lines[i].width) return false;
+    }
+
+#if LV_USE_BIDI
+    for(i = 0; i < a->line_cnt; i++) {
+        const uint16_t * a_pos;
+        const uint16_t * b_pos;
+        const char * a_txt = lv_draw_label_lines_get_bidi(a, txt, i, LV_BIDI_DIR_AUTO, &a_pos);
+        const char * b_txt = lv_draw_label_lines_get_bidi(b, txt, i, LV_BIDI_DIR_AUTO, &b_pos);
+        if(a_txt == NULL || b_txt == NULL || strcmp(a_txt, b_txt) != 0) return false;
+
+        uint32_t char_cnt = a->lines[i + 1].char_start - a->lines[i].char_start;
+        if(memcmp(a_pos, b_pos, char_cnt * sizeof(uint16_t)) != 0) return false;
+    }
+#endif
+
+    return true;
+}
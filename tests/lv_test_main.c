@@ -0,0 +1,39 @@
+/**
+ * @file lv_test_main.c
+ * Run all tests. Build and run them with `build.py`.
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include <stdlib.h>
+#include "lv_test.h"
+
+/**********************
+ *  GLOBAL VARIABLES
+ **********************/
+uint32_t lv_test_error_cnt;
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+int main(void)
+{
+    lv_init();
+    lv_test_disp_set_buf(LV_TEST_VER_RES, false);
+
+    lv_test_opa_layer();
+    lv_test_label_lines();
+    lv_test_draw_thread();
+    lv_test_chart_mem();
+    lv_test_console();
+
+    if(lv_test_error_cnt) {
+        printf("FAILED: %u error(s)\n", (unsigned)lv_test_error_cnt);
+        return EXIT_FAILURE;
+    }
+
+    printf("PASSED\n");
+    return EXIT_SUCCESS;
+}
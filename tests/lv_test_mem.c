@@ -0,0 +1,54 @@
+/**
+ * @file lv_test_mem.c
+ * Run the tests with little free memory
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_test.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+#define MEM_BLOCK_MAX 64
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static void * mem_blocks[MEM_BLOCK_MAX];
+static uint32_t mem_block_cnt;
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+/**
+ * Allocate the free memory of `lv_mem` until only a few kB remains.
+ * The draw buffer is freed first to not keep memory allocated before.
+ * @param keep leave about this many bytes free
+ */
+void lv_test_mem_exhaust(uint32_t keep)
+{
+    lv_draw_free_buf();
+
+    lv_mem_monitor_t mon;
+    while(mem_block_cnt < MEM_BLOCK_MAX) {
+        lv_mem_monitor(&mon);
+        if(mon.free_biggest_size < keep + 2048) break;
+        mem_blocks[mem_block_cnt] = lv_mem_alloc(mon.free_biggest_size - keep);
+        if(mem_blocks[mem_block_cnt] == NULL) break;
+        mem_block_cnt++;
+    }
+}
+
+/**
+ * Free the memory allocated by `lv_test_mem_exhaust()`
+ */
+void lv_test_mem_release(void)
+{
+    while(mem_block_cnt) {
+        mem_block_cnt--;
+        lv_mem_free(mem_blocks[mem_block_cnt]);
+    }
+}
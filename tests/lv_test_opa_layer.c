@@ -0,0 +1,132 @@
+/**
+ * @file lv_test_opa_layer.c
+ * If an opacity layer can't be created the object has to look the same as without a layer,
+ * also if the drawing is recorded into the draw list and replayed in bands.
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include <stdlib.h>
+#include <string.h>
+#include "lv_test.h"
+
+#if LV_USE_OPA_LAYER
+
+/*********************
+ *      DEFINES
+ *********************/
+#define BAND_LINES 10   /*The display buffer's height: the screen is drawn in 32 bands*/
+#define NEST_CNT 5      /*Nested layers. One more than the max. depth of the layers.*/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static lv_obj_t * create_layered(lv_obj_t * parent);
+static void check_fallback(const char * name, lv_obj_t * obj);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static lv_color_t ref[LV_TEST_HOR_RES * LV_TEST_VER_RES];
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_test_opa_layer(void)
+{
+    lv_obj_t * scr = lv_obj_create(NULL, NULL);
+    lv_scr_load(scr);
+
+    lv_obj_t * label = lv_label_create(scr, NULL);
+    lv_label_set_text(label, "Text behind the layers");
+    lv_obj_set_pos(label, 20, 100);
+
+    lv_obj_t * cont = create_layered(scr);
+    lv_obj_set_pos(cont, 40, 40);
+
+    /*The layer is really used: with a layer the overlapping children look different*/
+    lv_test_disp_set_buf(BAND_LINES, false);
+    lv_obj_set_opa_layer(cont, false);
+    lv_test_disp_refresh();
+    memcpy(ref, lv_test_disp_get_fb(), sizeof(ref));
+    lv_obj_set_opa_layer(cont, true);
+    lv_test_disp_refresh();
+    LV_TEST_ASSERT(lv_test_disp_diff(ref) != 0);
+
+    /*The layer can't be used with `set_px_cb`*/
+    lv_test_disp_set_buf(BAND_LINES, true);
+    check_fallback("set_px_cb", cont);
+    lv_test_disp_set_buf(BAND_LINES, false);
+
+    /*No memory for the layer*/
+    lv_test_mem_exhaust(2048);
+    check_fallback("no memory", cont);
+    lv_test_mem_release();
+
+    /*Too deeply nested layers: the innermost can't be created*/
+    lv_obj_t * inner = cont;
+    uint32_t i;
+    for(i = 1; i < NEST_CNT; i++) {
+        inner = create_layered(inner);
+        lv_obj_set_pos(inner, 10, 10);
+    }
+    check_fallback("depth", inner);
+
+    lv_obj_del(scr);
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Create a semi transparent container with a layer and overlapping children
+ * @param parent the parent of the container
+ * @return the container
+ */
+static lv_obj_t * create_layered(lv_obj_t * parent)
+{
+    lv_obj_t * cont = lv_cont_create(parent, NULL);
+    lv_obj_set_size(cont, 300, 200);
+    lv_obj_set_opa_scale_enable(cont, true);
+    lv_obj_set_opa_scale(cont, LV_OPA_50);
+    lv_obj_set_opa_layer(cont, true);
+
+    uint32_t i;
+    for(i = 0; i < 3; i++) {
+        lv_obj_t * btn = lv_btn_create(cont, NULL);
+        lv_obj_set_pos(btn, 20 + i * 50, 20 + i * 30);
+        lv_obj_set_size(btn, 120, 60);
+    }
+
+    return cont;
+}
+
+/**
+ * Check that an object whose layer can't be created looks like the object without a layer
+ * @param name name of the case to print on error
+ * @param obj an object with a layer
+ */
+static void check_fallback(const char * name, lv_obj_t * obj)
+{
+    lv_obj_set_opa_layer(obj, false);
+    lv_test_disp_refresh();
+    memcpy(ref, lv_test_disp_get_fb(), sizeof(ref));
+
+    lv_obj_set_opa_layer(obj, true);
+    lv_test_disp_refresh();
+
+    uint32_t diff = lv_test_disp_diff(ref);
+    if(diff) printf("opa_layer %s: %u different pixels\n", name, (unsigned)diff);
+    LV_TEST_ASSERT(diff == 0);
+}
+
+#else
+
+void lv_test_opa_layer(void)
+{
+}
+
+#endif /*LV_USE_OPA_LAYER*/